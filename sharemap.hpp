@@ -1,14 +1,19 @@
 #pragma once
 
 #include <climits>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <array>
+#include <bitset>
 #include <chrono>
+#include <limits>
+#include <span>
 #include <string>
 #include <string_view>
 #include <type_traits>
+#include <vector>
 
 namespace anysignal {
 
@@ -61,11 +66,14 @@ void sharemap_unpack_field(const std::uint8_t *in, T &out)
 template <typename T, std::enable_if_t<std::is_integral_v<T> and not std::is_same_v<T, bool>, bool> = true>
 void sharemap_unpack_field(const std::uint8_t *in, T &out)
 {
-    out = T{};
+    // shift on the unsigned type, so no byte narrows into or shifts through a sign bit
+    using U = std::make_unsigned_t<T>;
+    U value{};
     for (std::size_t i = 0; i < sizeof(T); ++i)
     {
-        out |= T{in[i]} << ((sizeof(T) - i - 1) * CHAR_BIT);
+        value |= static_cast<U>(static_cast<U>(in[i]) << ((sizeof(T) - i - 1) * CHAR_BIT));
     }
+    out = static_cast<T>(value);
 }
 
 template <typename T, std::enable_if_t<std::is_floating_point_v<T>, bool> = true>
@@ -74,6 +82,252 @@ void sharemap_unpack_field(const std::uint8_t *in, T &out)
     std::memcpy(&out, in, sizeof(T));
 }
 
+// Wire types of sharemap fields, see SCHEMA_TYPES in sharemap_lib.py
+enum class sharemap_type_t : std::uint8_t
+{
+    u8,
+    u16,
+    u32,
+    u64,
+    i8,
+    i16,
+    i32,
+    i64,
+    f32,
+    f64,
+    boolean,
+    string,
+};
+
+// Entry of a sharemap's FIELDS table, for code that walks packed frames field by field
+struct sharemap_field_t
+{
+    std::string_view name;
+    sharemap_type_t type;
+    std::size_t offset; // in the packed frame
+    std::size_t size;   // packed bytes
+    bool counter;       // monotonic count (counter: true in the schema)
+};
+
+// Kinds of compiled alarm rules, see alarms.yaml and compile_alarms in sharemap_gen.py
+enum class sharemap_alarm_kind_t : std::uint8_t
+{
+    above,     // raised while the field is above set, until it is at or below clear
+    below,     // raised while the field is below set, until it is at or above clear
+    increases, // raised while the field grows from one frame to the next
+};
+
+// Entry of a sharemap's ALARMS table
+struct sharemap_alarm_t
+{
+    std::string_view name;
+    std::size_t field; // index in FIELDS
+    sharemap_alarm_kind_t kind;
+    double set;
+    double clear;
+};
+
+// Value of a packed numeric field (any type but string) as a double
+static inline double sharemap_unpack_number(const sharemap_field_t &field, const std::uint8_t *in)
+{
+    const auto unpack = [in]<typename T>(T value) {
+        sharemap_unpack_field(in, value);
+        return double(value);
+    };
+    switch (field.type)
+    {
+    case sharemap_type_t::u8:
+        return unpack(std::uint8_t{});
+    case sharemap_type_t::u16:
+        return unpack(std::uint16_t{});
+    case sharemap_type_t::u32:
+        return unpack(std::uint32_t{});
+    case sharemap_type_t::u64:
+        return unpack(std::uint64_t{});
+    case sharemap_type_t::i8:
+        return unpack(std::int8_t{});
+    case sharemap_type_t::i16:
+        return unpack(std::int16_t{});
+    case sharemap_type_t::i32:
+        return unpack(std::int32_t{});
+    case sharemap_type_t::i64:
+        return unpack(std::int64_t{});
+    case sharemap_type_t::f32:
+        return unpack(float{});
+    case sharemap_type_t::f64:
+        return unpack(double{});
+    case sharemap_type_t::boolean:
+        return unpack(bool{});
+    default:
+        return 0.0;
+    }
+}
+
+// Value of a packed integer or boolean field as 64 bits, sign extended for signed types, 0 for others
+static inline std::uint64_t sharemap_unpack_integer(const sharemap_field_t &field, const std::uint8_t *in)
+{
+    const auto unpack = [in]<typename T>(T value) {
+        sharemap_unpack_field(in, value);
+        return static_cast<std::uint64_t>(value);
+    };
+    switch (field.type)
+    {
+    case sharemap_type_t::u8:
+        return unpack(std::uint8_t{});
+    case sharemap_type_t::u16:
+        return unpack(std::uint16_t{});
+    case sharemap_type_t::u32:
+        return unpack(std::uint32_t{});
+    case sharemap_type_t::u64:
+        return unpack(std::uint64_t{});
+    case sharemap_type_t::i8:
+        return unpack(std::int8_t{});
+    case sharemap_type_t::i16:
+        return unpack(std::int16_t{});
+    case sharemap_type_t::i32:
+        return unpack(std::int32_t{});
+    case sharemap_type_t::i64:
+        return unpack(std::int64_t{});
+    case sharemap_type_t::boolean:
+        return unpack(bool{});
+    default:
+        return 0;
+    }
+}
+
+// Kinds of validation rules, see compile_rules in sharemap_gen.py
+enum class sharemap_rule_kind_t : std::uint8_t
+{
+    range,   // min <= a <= max
+    step,    // a is min plus a whole number of steps
+    options, // a is one of options
+    mutex,   // not both a and b
+    divides, // b is a whole multiple of a
+    equal,   // a == b while both when_a and when_b are true
+};
+
+// A member of a sharemap struct read by a rule
+struct sharemap_member_t
+{
+    sharemap_type_t type;
+    std::size_t offset; // in the struct, SHAREMAP_NO_MEMBER for none
+};
+
+static constexpr std::size_t SHAREMAP_NO_MEMBER{~std::size_t(0)};
+
+// Entry of a sharemap's RULES table, generated from min, max, step, options, mutex_with,
+// divides, shared_by and active_when in the schema
+struct sharemap_rule_t
+{
+    std::string_view name;
+    sharemap_rule_kind_t kind;
+    sharemap_member_t a;
+    sharemap_member_t b;
+    sharemap_member_t when_a;
+    sharemap_member_t when_b;
+    double min;
+    double max;
+    double step;
+    std::size_t first_option; // in OPTIONS
+    std::size_t options;
+};
+
+// Value of a numeric member of a sharemap struct as a double, 1 for no member
+static inline double sharemap_member_number(const std::uint8_t *in, const sharemap_member_t &member)
+{
+    if (member.offset == SHAREMAP_NO_MEMBER)
+    {
+        return 1.0;
+    }
+    const auto read = [in = in + member.offset]<typename T>(T value) {
+        std::memcpy(&value, in, sizeof(value));
+        return double(value);
+    };
+    switch (member.type)
+    {
+    case sharemap_type_t::u8:
+        return read(std::uint8_t{});
+    case sharemap_type_t::u16:
+        return read(std::uint16_t{});
+    case sharemap_type_t::u32:
+        return read(std::uint32_t{});
+    case sharemap_type_t::u64:
+        return read(std::uint64_t{});
+    case sharemap_type_t::i8:
+        return read(std::int8_t{});
+    case sharemap_type_t::i16:
+        return read(std::int16_t{});
+    case sharemap_type_t::i32:
+        return read(std::int32_t{});
+    case sharemap_type_t::i64:
+        return read(std::int64_t{});
+    case sharemap_type_t::f32:
+        return read(float{});
+    case sharemap_type_t::f64:
+        return read(double{});
+    case sharemap_type_t::boolean:
+        return read(bool{});
+    default:
+        return 0.0;
+    }
+}
+
+// Check a sharemap struct at in against every rule, bit i of the result is set when rules[i] is broken
+template <std::size_t N>
+[[nodiscard]] static inline std::bitset<N> sharemap_validate_rules(const std::uint8_t *in, const std::array<sharemap_rule_t, N> &rules,
+                                                                   std::span<const std::string_view> options)
+{
+    std::bitset<N> errors;
+    for (std::size_t i = 0; i < N; i++)
+    {
+        const auto &rule = rules[i];
+        bool ok = true;
+        if (rule.kind == sharemap_rule_kind_t::options)
+        {
+            const auto *chars = reinterpret_cast<const char *>(in + rule.a.offset);
+            const std::string_view value(chars, strnlen(chars, STRING_BUFFER_SIZE));
+            ok = false;
+            for (std::size_t o = rule.first_option; o < rule.first_option + rule.options; o++)
+            {
+                ok = ok or value == options[o];
+            }
+            errors[i] = not ok;
+            continue;
+        }
+
+        const auto a = sharemap_member_number(in, rule.a);
+        const auto b = sharemap_member_number(in, rule.b);
+        switch (rule.kind)
+        {
+        case sharemap_rule_kind_t::range:
+            ok = a >= rule.min and a <= rule.max;
+            break;
+        case sharemap_rule_kind_t::step:
+        {
+            const auto steps = (a - rule.min) / rule.step;
+            ok = std::abs(steps - std::round(steps)) <= 1e-4;
+            break;
+        }
+        case sharemap_rule_kind_t::mutex:
+            ok = a == 0.0 or b == 0.0;
+            break;
+        case sharemap_rule_kind_t::divides:
+        {
+            const auto ratio = b / a;
+            ok = a > 0.0 and std::abs(ratio - std::round(ratio)) <= 1e-9 * ratio;
+            break;
+        }
+        case sharemap_rule_kind_t::equal:
+            ok = a == b or sharemap_member_number(in, rule.when_a) == 0.0 or sharemap_member_number(in, rule.when_b) == 0.0;
+            break;
+        default:
+            break;
+        }
+        errors[i] = not ok;
+    }
+    return errors;
+}
+
 [[nodiscard]] static inline std::int64_t time_ns_since_epoch(void)
 {
     const auto ts = std::chrono::system_clock::now();
@@ -173,12 +427,77 @@ struct sharemap_config_packed_t
     std::uint8_t anylink_active_tx_channel[64]{};
 } __attribute__((packed));
 
+struct sharemap_config_columns_t;
+
 struct sharemap_config_t
 {
     static constexpr std::string_view NAME{"config"};
     static constexpr std::uint64_t HASH{0xa20b7ede39c02e9e};
     using packed_t = sharemap_config_packed_t;
+    using columns_t = sharemap_config_columns_t;
     static constexpr size_t PACKED_SIZE{sizeof(packed_t)};
+    static constexpr size_t SCHEMA_HASH_OFFSET{offsetof(packed_t, schema_hash)};
+    static constexpr bool HAS_SEQUENCE{false};
+    // false if a frame is too large for a bundle of SHAREMAP_BUNDLE_MTU_PAYLOAD bytes, needing jumbo frames
+    static constexpr bool FITS_MTU_BUNDLE{true};
+    static constexpr std::array<sharemap_field_t, 52> FIELDS{ {
+        {"source_id", sharemap_type_t::u16, offsetof(packed_t, source_id), 2, false},
+        {"schema_hash", sharemap_type_t::u64, offsetof(packed_t, schema_hash), 8, false},
+        {"unix_timestamp_ns", sharemap_type_t::i64, offsetof(packed_t, unix_timestamp_ns), 8, false},
+        {"psk_cc_tx_force_on", sharemap_type_t::boolean, offsetof(packed_t, psk_cc_tx_force_on), 1, false},
+        {"psk_cc_tx_idle_timeout_s", sharemap_type_t::u64, offsetof(packed_t, psk_cc_tx_idle_timeout_s), 8, false},
+        {"psk_cc_tx_fe_frequency", sharemap_type_t::f64, offsetof(packed_t, psk_cc_tx_fe_frequency), 8, false},
+        {"psk_cc_tx_fe_stx1_enable", sharemap_type_t::boolean, offsetof(packed_t, psk_cc_tx_fe_stx1_enable), 1, false},
+        {"psk_cc_tx_fe_stx1_gain", sharemap_type_t::f64, offsetof(packed_t, psk_cc_tx_fe_stx1_gain), 8, false},
+        {"psk_cc_tx_fe_stx1_atten", sharemap_type_t::f64, offsetof(packed_t, psk_cc_tx_fe_stx1_atten), 8, false},
+        {"psk_cc_tx_fe_stx2_enable", sharemap_type_t::boolean, offsetof(packed_t, psk_cc_tx_fe_stx2_enable), 1, false},
+        {"psk_cc_tx_fe_stx2_gain", sharemap_type_t::f64, offsetof(packed_t, psk_cc_tx_fe_stx2_gain), 8, false},
+        {"psk_cc_tx_fe_stx2_atten", sharemap_type_t::f64, offsetof(packed_t, psk_cc_tx_fe_stx2_atten), 8, false},
+        {"psk_cc_tx_fe_sample_rate", sharemap_type_t::f64, offsetof(packed_t, psk_cc_tx_fe_sample_rate), 8, false},
+        {"psk_cc_tx_symbol_rate", sharemap_type_t::f64, offsetof(packed_t, psk_cc_tx_symbol_rate), 8, false},
+        {"psk_cc_tx_modulation", sharemap_type_t::string, offsetof(packed_t, psk_cc_tx_modulation), 64, false},
+        {"psk_cc_rx_force_on", sharemap_type_t::boolean, offsetof(packed_t, psk_cc_rx_force_on), 1, false},
+        {"psk_cc_rx_idle_timeout_s", sharemap_type_t::u64, offsetof(packed_t, psk_cc_rx_idle_timeout_s), 8, false},
+        {"psk_cc_rx_low_power_timeout_s", sharemap_type_t::u64, offsetof(packed_t, psk_cc_rx_low_power_timeout_s), 8, false},
+        {"psk_cc_rx_gain_mode", sharemap_type_t::string, offsetof(packed_t, psk_cc_rx_gain_mode), 64, false},
+        {"psk_cc_rx_auto_antenna_selection", sharemap_type_t::boolean, offsetof(packed_t, psk_cc_rx_auto_antenna_selection), 1, false},
+        {"psk_cc_rx_fe_frequency", sharemap_type_t::f64, offsetof(packed_t, psk_cc_rx_fe_frequency), 8, false},
+        {"psk_cc_rx_fe_srx1_enable", sharemap_type_t::boolean, offsetof(packed_t, psk_cc_rx_fe_srx1_enable), 1, false},
+        {"psk_cc_rx_fe_srx1_gain", sharemap_type_t::f64, offsetof(packed_t, psk_cc_rx_fe_srx1_gain), 8, false},
+        {"psk_cc_rx_fe_srx1_atten", sharemap_type_t::f64, offsetof(packed_t, psk_cc_rx_fe_srx1_atten), 8, false},
+        {"psk_cc_rx_fe_srx2_enable", sharemap_type_t::boolean, offsetof(packed_t, psk_cc_rx_fe_srx2_enable), 1, false},
+        {"psk_cc_rx_fe_srx2_gain", sharemap_type_t::f64, offsetof(packed_t, psk_cc_rx_fe_srx2_gain), 8, false},
+        {"psk_cc_rx_fe_srx2_atten", sharemap_type_t::f64, offsetof(packed_t, psk_cc_rx_fe_srx2_atten), 8, false},
+        {"psk_cc_rx_fe_sample_rate", sharemap_type_t::f64, offsetof(packed_t, psk_cc_rx_fe_sample_rate), 8, false},
+        {"psk_cc_rx_symbol_rate", sharemap_type_t::f64, offsetof(packed_t, psk_cc_rx_symbol_rate), 8, false},
+        {"psk_cc_rx_modulation", sharemap_type_t::string, offsetof(packed_t, psk_cc_rx_modulation), 64, false},
+        {"dvbs2_tx_force_on", sharemap_type_t::boolean, offsetof(packed_t, dvbs2_tx_force_on), 1, false},
+        {"dvbs2_tx_idle_timeout_s", sharemap_type_t::u64, offsetof(packed_t, dvbs2_tx_idle_timeout_s), 8, false},
+        {"dvbs2_tx_fe_frequency", sharemap_type_t::f64, offsetof(packed_t, dvbs2_tx_fe_frequency), 8, false},
+        {"dvbs2_tx_fe_gain", sharemap_type_t::f64, offsetof(packed_t, dvbs2_tx_fe_gain), 8, false},
+        {"dvbs2_tx_fe_sample_rate", sharemap_type_t::f64, offsetof(packed_t, dvbs2_tx_fe_sample_rate), 8, false},
+        {"dvbs2_tx_symbol_rate", sharemap_type_t::f64, offsetof(packed_t, dvbs2_tx_symbol_rate), 8, false},
+        {"dvbs2_tx_modulation", sharemap_type_t::string, offsetof(packed_t, dvbs2_tx_modulation), 64, false},
+        {"dvbs2_tx_coding", sharemap_type_t::string, offsetof(packed_t, dvbs2_tx_coding), 64, false},
+        {"dvbs2_tx_rolloff", sharemap_type_t::string, offsetof(packed_t, dvbs2_tx_rolloff), 64, false},
+        {"dvbs2_tx_frame_length", sharemap_type_t::string, offsetof(packed_t, dvbs2_tx_frame_length), 64, false},
+        {"dvbs2_tx_signal_scaling", sharemap_type_t::f64, offsetof(packed_t, dvbs2_tx_signal_scaling), 8, false},
+        {"gfsk_tx_force_on", sharemap_type_t::boolean, offsetof(packed_t, gfsk_tx_force_on), 1, false},
+        {"gfsk_tx_idle_timeout_s", sharemap_type_t::u64, offsetof(packed_t, gfsk_tx_idle_timeout_s), 8, false},
+        {"gfsk_tx_fe_frequency", sharemap_type_t::f64, offsetof(packed_t, gfsk_tx_fe_frequency), 8, false},
+        {"gfsk_tx_fe_gain", sharemap_type_t::f64, offsetof(packed_t, gfsk_tx_fe_gain), 8, false},
+        {"gfsk_tx_fe_atten", sharemap_type_t::f64, offsetof(packed_t, gfsk_tx_fe_atten), 8, false},
+        {"gfsk_tx_fe_sample_rate", sharemap_type_t::f64, offsetof(packed_t, gfsk_tx_fe_sample_rate), 8, false},
+        {"gfsk_tx_symbol_rate", sharemap_type_t::f64, offsetof(packed_t, gfsk_tx_symbol_rate), 8, false},
+        {"gfsk_tx_mod_index", sharemap_type_t::f32, offsetof(packed_t, gfsk_tx_mod_index), 4, false},
+        {"gfsk_tx_max_payload_len", sharemap_type_t::u32, offsetof(packed_t, gfsk_tx_max_payload_len), 4, false},
+        {"gfsk_tx_bt", sharemap_type_t::f32, offsetof(packed_t, gfsk_tx_bt), 4, false},
+        {"anylink_active_tx_channel", sharemap_type_t::string, offsetof(packed_t, anylink_active_tx_channel), 64, false},
+    } };
+    static constexpr std::array<sharemap_alarm_t, 0> ALARMS{ {
+    } };
+    static const std::array<std::string_view, 45> OPTIONS;
+    static const std::array<sharemap_rule_t, 61> RULES; // defined below, they take offsets in this struct
     
     // id of where the data comes from
     std::uint16_t source_id{};
@@ -452,62 +771,202 @@ struct sharemap_config_t
     }
 };
 
-static inline sharemap_config_packed_t sharemap_pack(sharemap_config_t &in)
+inline constexpr std::array<std::string_view, 45> sharemap_config_t::OPTIONS{ {
+    "BPSK",
+    "QPSK",
+    "MANUAL",
+    "SLOW_AGC",
+    "FAST_AGC",
+    "HYBRID_AGC",
+    "BPSK",
+    "QPSK",
+    "unmodulated",
+    "QPSK",
+    "8PSK",
+    "16APSK",
+    "32APSK",
+    "1/4",
+    "1/3",
+    "2/5",
+    "1/2",
+    "3/5",
+    "2/3",
+    "3/4",
+    "4/5",
+    "5/6",
+    "8/9",
+    "9/10",
+    "11/45",
+    "4/15",
+    "14/45",
+    "7/15",
+    "8/15",
+    "26/45",
+    "32/45",
+    "35%",
+    "25%",
+    "20%",
+    "15%",
+    "10%",
+    "5%",
+    "",
+    "SHORT",
+    "NORMAL",
+    "LONG",
+    "tx_uhf",
+    "tx_sband",
+    "tx_xband",
+    "",
+} };
+
+inline constexpr std::array<sharemap_rule_t, 61> sharemap_config_t::RULES{ {
+    {"psk_cc_tx_idle_timeout_s min/max", sharemap_rule_kind_t::range, {sharemap_type_t::u64, offsetof(sharemap_config_t, psk_cc_tx_idle_timeout_s)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.0, 3600.0, 0.0, 0, 0},
+    {"psk_cc_tx_fe_frequency min/max", sharemap_rule_kind_t::range, {sharemap_type_t::f64, offsetof(sharemap_config_t, psk_cc_tx_fe_frequency)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 1000000.0, 10000000000.0, 0.0, 0, 0},
+    {"psk_cc_tx_fe_stx1_enable mutex_with psk_cc_tx_fe_stx2_enable", sharemap_rule_kind_t::mutex, {sharemap_type_t::boolean, offsetof(sharemap_config_t, psk_cc_tx_fe_stx1_enable)}, {sharemap_type_t::boolean, offsetof(sharemap_config_t, psk_cc_tx_fe_stx2_enable)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.0, 0.0, 0.0, 0, 0},
+    {"psk_cc_tx_fe_stx1_gain min/max", sharemap_rule_kind_t::range, {sharemap_type_t::f64, offsetof(sharemap_config_t, psk_cc_tx_fe_stx1_gain)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.0, 89.75, 0.0, 0, 0},
+    {"psk_cc_tx_fe_stx1_gain step", sharemap_rule_kind_t::step, {sharemap_type_t::f64, offsetof(sharemap_config_t, psk_cc_tx_fe_stx1_gain)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.0, 0.0, 0.25, 0, 0},
+    {"psk_cc_tx_fe_stx1_atten min/max", sharemap_rule_kind_t::range, {sharemap_type_t::f64, offsetof(sharemap_config_t, psk_cc_tx_fe_stx1_atten)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.0, 31.75, 0.0, 0, 0},
+    {"psk_cc_tx_fe_stx1_atten step", sharemap_rule_kind_t::step, {sharemap_type_t::f64, offsetof(sharemap_config_t, psk_cc_tx_fe_stx1_atten)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.0, 0.0, 0.25, 0, 0},
+    {"psk_cc_tx_fe_stx2_gain min/max", sharemap_rule_kind_t::range, {sharemap_type_t::f64, offsetof(sharemap_config_t, psk_cc_tx_fe_stx2_gain)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.0, 89.75, 0.0, 0, 0},
+    {"psk_cc_tx_fe_stx2_gain step", sharemap_rule_kind_t::step, {sharemap_type_t::f64, offsetof(sharemap_config_t, psk_cc_tx_fe_stx2_gain)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.0, 0.0, 0.25, 0, 0},
+    {"psk_cc_tx_fe_stx2_atten min/max", sharemap_rule_kind_t::range, {sharemap_type_t::f64, offsetof(sharemap_config_t, psk_cc_tx_fe_stx2_atten)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.0, 31.75, 0.0, 0, 0},
+    {"psk_cc_tx_fe_stx2_atten step", sharemap_rule_kind_t::step, {sharemap_type_t::f64, offsetof(sharemap_config_t, psk_cc_tx_fe_stx2_atten)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.0, 0.0, 0.25, 0, 0},
+    {"psk_cc_tx_fe_sample_rate min/max", sharemap_rule_kind_t::range, {sharemap_type_t::f64, offsetof(sharemap_config_t, psk_cc_tx_fe_sample_rate)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 521000.0, 61440000.0, 0.0, 0, 0},
+    {"psk_cc_tx_symbol_rate min/max", sharemap_rule_kind_t::range, {sharemap_type_t::f64, offsetof(sharemap_config_t, psk_cc_tx_symbol_rate)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 1000.0, 30720000.0, 0.0, 0, 0},
+    {"psk_cc_tx_modulation options", sharemap_rule_kind_t::options, {sharemap_type_t::string, offsetof(sharemap_config_t, psk_cc_tx_modulation)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.0, 0.0, 0.0, 0, 2},
+    {"psk_cc_rx_idle_timeout_s min/max", sharemap_rule_kind_t::range, {sharemap_type_t::u64, offsetof(sharemap_config_t, psk_cc_rx_idle_timeout_s)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.0, 3600.0, 0.0, 0, 0},
+    {"psk_cc_rx_low_power_timeout_s min/max", sharemap_rule_kind_t::range, {sharemap_type_t::u64, offsetof(sharemap_config_t, psk_cc_rx_low_power_timeout_s)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.0, 3600.0, 0.0, 0, 0},
+    {"psk_cc_rx_gain_mode options", sharemap_rule_kind_t::options, {sharemap_type_t::string, offsetof(sharemap_config_t, psk_cc_rx_gain_mode)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.0, 0.0, 0.0, 2, 4},
+    {"psk_cc_rx_fe_frequency min/max", sharemap_rule_kind_t::range, {sharemap_type_t::f64, offsetof(sharemap_config_t, psk_cc_rx_fe_frequency)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 1000000.0, 10000000000.0, 0.0, 0, 0},
+    {"psk_cc_rx_fe_srx1_enable mutex_with psk_cc_rx_fe_srx2_enable", sharemap_rule_kind_t::mutex, {sharemap_type_t::boolean, offsetof(sharemap_config_t, psk_cc_rx_fe_srx1_enable)}, {sharemap_type_t::boolean, offsetof(sharemap_config_t, psk_cc_rx_fe_srx2_enable)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.0, 0.0, 0.0, 0, 0},
+    {"psk_cc_rx_fe_srx1_gain min/max", sharemap_rule_kind_t::range, {sharemap_type_t::f64, offsetof(sharemap_config_t, psk_cc_rx_fe_srx1_gain)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.0, 76.0, 0.0, 0, 0},
+    {"psk_cc_rx_fe_srx1_gain step", sharemap_rule_kind_t::step, {sharemap_type_t::f64, offsetof(sharemap_config_t, psk_cc_rx_fe_srx1_gain)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.0, 0.0, 1.0, 0, 0},
+    {"psk_cc_rx_fe_srx1_atten min/max", sharemap_rule_kind_t::range, {sharemap_type_t::f64, offsetof(sharemap_config_t, psk_cc_rx_fe_srx1_atten)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.0, 31.75, 0.0, 0, 0},
+    {"psk_cc_rx_fe_srx1_atten step", sharemap_rule_kind_t::step, {sharemap_type_t::f64, offsetof(sharemap_config_t, psk_cc_rx_fe_srx1_atten)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.0, 0.0, 0.25, 0, 0},
+    {"psk_cc_rx_fe_srx2_gain min/max", sharemap_rule_kind_t::range, {sharemap_type_t::f64, offsetof(sharemap_config_t, psk_cc_rx_fe_srx2_gain)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.0, 76.0, 0.0, 0, 0},
+    {"psk_cc_rx_fe_srx2_gain step", sharemap_rule_kind_t::step, {sharemap_type_t::f64, offsetof(sharemap_config_t, psk_cc_rx_fe_srx2_gain)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.0, 0.0, 1.0, 0, 0},
+    {"psk_cc_rx_fe_srx2_atten min/max", sharemap_rule_kind_t::range, {sharemap_type_t::f64, offsetof(sharemap_config_t, psk_cc_rx_fe_srx2_atten)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.0, 31.75, 0.0, 0, 0},
+    {"psk_cc_rx_fe_srx2_atten step", sharemap_rule_kind_t::step, {sharemap_type_t::f64, offsetof(sharemap_config_t, psk_cc_rx_fe_srx2_atten)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.0, 0.0, 0.25, 0, 0},
+    {"psk_cc_rx_fe_sample_rate min/max", sharemap_rule_kind_t::range, {sharemap_type_t::f64, offsetof(sharemap_config_t, psk_cc_rx_fe_sample_rate)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 521000.0, 61440000.0, 0.0, 0, 0},
+    {"psk_cc_rx_symbol_rate min/max", sharemap_rule_kind_t::range, {sharemap_type_t::f64, offsetof(sharemap_config_t, psk_cc_rx_symbol_rate)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 1000.0, 30720000.0, 0.0, 0, 0},
+    {"psk_cc_rx_modulation options", sharemap_rule_kind_t::options, {sharemap_type_t::string, offsetof(sharemap_config_t, psk_cc_rx_modulation)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.0, 0.0, 0.0, 6, 2},
+    {"dvbs2_tx_idle_timeout_s min/max", sharemap_rule_kind_t::range, {sharemap_type_t::u64, offsetof(sharemap_config_t, dvbs2_tx_idle_timeout_s)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.0, 3600.0, 0.0, 0, 0},
+    {"dvbs2_tx_fe_frequency min/max", sharemap_rule_kind_t::range, {sharemap_type_t::f64, offsetof(sharemap_config_t, dvbs2_tx_fe_frequency)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 1000000.0, 12000000000.0, 0.0, 0, 0},
+    {"dvbs2_tx_fe_gain min/max", sharemap_rule_kind_t::range, {sharemap_type_t::f64, offsetof(sharemap_config_t, dvbs2_tx_fe_gain)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.0, 89.75, 0.0, 0, 0},
+    {"dvbs2_tx_fe_gain step", sharemap_rule_kind_t::step, {sharemap_type_t::f64, offsetof(sharemap_config_t, dvbs2_tx_fe_gain)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.0, 0.0, 0.25, 0, 0},
+    {"dvbs2_tx_fe_sample_rate min/max", sharemap_rule_kind_t::range, {sharemap_type_t::f64, offsetof(sharemap_config_t, dvbs2_tx_fe_sample_rate)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 521000.0, 61440000.0, 0.0, 0, 0},
+    {"dvbs2_tx_symbol_rate min/max", sharemap_rule_kind_t::range, {sharemap_type_t::f64, offsetof(sharemap_config_t, dvbs2_tx_symbol_rate)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 1000.0, 30720000.0, 0.0, 0, 0},
+    {"dvbs2_tx_symbol_rate divides dvbs2_tx_fe_sample_rate", sharemap_rule_kind_t::divides, {sharemap_type_t::f64, offsetof(sharemap_config_t, dvbs2_tx_symbol_rate)}, {sharemap_type_t::f64, offsetof(sharemap_config_t, dvbs2_tx_fe_sample_rate)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.0, 0.0, 0.0, 0, 0},
+    {"dvbs2_tx_modulation options", sharemap_rule_kind_t::options, {sharemap_type_t::string, offsetof(sharemap_config_t, dvbs2_tx_modulation)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.0, 0.0, 0.0, 8, 5},
+    {"dvbs2_tx_coding options", sharemap_rule_kind_t::options, {sharemap_type_t::string, offsetof(sharemap_config_t, dvbs2_tx_coding)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.0, 0.0, 0.0, 13, 18},
+    {"dvbs2_tx_rolloff options", sharemap_rule_kind_t::options, {sharemap_type_t::string, offsetof(sharemap_config_t, dvbs2_tx_rolloff)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.0, 0.0, 0.0, 31, 7},
+    {"dvbs2_tx_frame_length options", sharemap_rule_kind_t::options, {sharemap_type_t::string, offsetof(sharemap_config_t, dvbs2_tx_frame_length)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.0, 0.0, 0.0, 38, 3},
+    {"dvbs2_tx_signal_scaling min/max", sharemap_rule_kind_t::range, {sharemap_type_t::f64, offsetof(sharemap_config_t, dvbs2_tx_signal_scaling)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.0, 10.0, 0.0, 0, 0},
+    {"dvbs2_tx_signal_scaling step", sharemap_rule_kind_t::step, {sharemap_type_t::f64, offsetof(sharemap_config_t, dvbs2_tx_signal_scaling)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.0, 0.0, 0.1, 0, 0},
+    {"gfsk_tx_idle_timeout_s min/max", sharemap_rule_kind_t::range, {sharemap_type_t::u64, offsetof(sharemap_config_t, gfsk_tx_idle_timeout_s)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.0, 3600.0, 0.0, 0, 0},
+    {"gfsk_tx_fe_frequency min/max", sharemap_rule_kind_t::range, {sharemap_type_t::f64, offsetof(sharemap_config_t, gfsk_tx_fe_frequency)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 1000000.0, 1000000000.0, 0.0, 0, 0},
+    {"gfsk_tx_fe_gain min/max", sharemap_rule_kind_t::range, {sharemap_type_t::f64, offsetof(sharemap_config_t, gfsk_tx_fe_gain)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, -10.0, 20.0, 0.0, 0, 0},
+    {"gfsk_tx_fe_gain step", sharemap_rule_kind_t::step, {sharemap_type_t::f64, offsetof(sharemap_config_t, gfsk_tx_fe_gain)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, -10.0, 0.0, 0.5, 0, 0},
+    {"gfsk_tx_fe_atten min/max", sharemap_rule_kind_t::range, {sharemap_type_t::f64, offsetof(sharemap_config_t, gfsk_tx_fe_atten)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.0, 31.75, 0.0, 0, 0},
+    {"gfsk_tx_fe_atten step", sharemap_rule_kind_t::step, {sharemap_type_t::f64, offsetof(sharemap_config_t, gfsk_tx_fe_atten)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.0, 0.0, 0.25, 0, 0},
+    {"gfsk_tx_fe_sample_rate min/max", sharemap_rule_kind_t::range, {sharemap_type_t::f64, offsetof(sharemap_config_t, gfsk_tx_fe_sample_rate)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 100000.0, 10000000.0, 0.0, 0, 0},
+    {"gfsk_tx_symbol_rate min/max", sharemap_rule_kind_t::range, {sharemap_type_t::f64, offsetof(sharemap_config_t, gfsk_tx_symbol_rate)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 1000.0, 1000000.0, 0.0, 0, 0},
+    {"gfsk_tx_symbol_rate divides gfsk_tx_fe_sample_rate", sharemap_rule_kind_t::divides, {sharemap_type_t::f64, offsetof(sharemap_config_t, gfsk_tx_symbol_rate)}, {sharemap_type_t::f64, offsetof(sharemap_config_t, gfsk_tx_fe_sample_rate)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.0, 0.0, 0.0, 0, 0},
+    {"gfsk_tx_mod_index min/max", sharemap_rule_kind_t::range, {sharemap_type_t::f32, offsetof(sharemap_config_t, gfsk_tx_mod_index)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.1, 2.0, 0.0, 0, 0},
+    {"gfsk_tx_mod_index step", sharemap_rule_kind_t::step, {sharemap_type_t::f32, offsetof(sharemap_config_t, gfsk_tx_mod_index)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.1, 0.0, 0.01, 0, 0},
+    {"gfsk_tx_max_payload_len min/max", sharemap_rule_kind_t::range, {sharemap_type_t::u32, offsetof(sharemap_config_t, gfsk_tx_max_payload_len)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 1.0, 65535.0, 0.0, 0, 0},
+    {"gfsk_tx_bt min/max", sharemap_rule_kind_t::range, {sharemap_type_t::f32, offsetof(sharemap_config_t, gfsk_tx_bt)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.1, 2.0, 0.0, 0, 0},
+    {"gfsk_tx_bt step", sharemap_rule_kind_t::step, {sharemap_type_t::f32, offsetof(sharemap_config_t, gfsk_tx_bt)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.1, 0.0, 0.1, 0, 0},
+    {"anylink_active_tx_channel options", sharemap_rule_kind_t::options, {sharemap_type_t::string, offsetof(sharemap_config_t, anylink_active_tx_channel)}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, {sharemap_type_t::boolean, SHAREMAP_NO_MEMBER}, 0.0, 0.0, 0.0, 41, 4},
+    {"ad9361: psk_cc_tx_fe_sample_rate == psk_cc_rx_fe_sample_rate", sharemap_rule_kind_t::equal, {sharemap_type_t::f64, offsetof(sharemap_config_t, psk_cc_tx_fe_sample_rate)}, {sharemap_type_t::f64, offsetof(sharemap_config_t, psk_cc_rx_fe_sample_rate)}, {sharemap_type_t::boolean, offsetof(sharemap_config_t, psk_cc_tx_force_on)}, {sharemap_type_t::boolean, offsetof(sharemap_config_t, psk_cc_rx_force_on)}, 0.0, 0.0, 0.0, 0, 0},
+    {"ad9361: psk_cc_tx_fe_sample_rate == dvbs2_tx_fe_sample_rate", sharemap_rule_kind_t::equal, {sharemap_type_t::f64, offsetof(sharemap_config_t, psk_cc_tx_fe_sample_rate)}, {sharemap_type_t::f64, offsetof(sharemap_config_t, dvbs2_tx_fe_sample_rate)}, {sharemap_type_t::boolean, offsetof(sharemap_config_t, psk_cc_tx_force_on)}, {sharemap_type_t::boolean, offsetof(sharemap_config_t, dvbs2_tx_force_on)}, 0.0, 0.0, 0.0, 0, 0},
+    {"ad9361: psk_cc_rx_fe_sample_rate == dvbs2_tx_fe_sample_rate", sharemap_rule_kind_t::equal, {sharemap_type_t::f64, offsetof(sharemap_config_t, psk_cc_rx_fe_sample_rate)}, {sharemap_type_t::f64, offsetof(sharemap_config_t, dvbs2_tx_fe_sample_rate)}, {sharemap_type_t::boolean, offsetof(sharemap_config_t, psk_cc_rx_force_on)}, {sharemap_type_t::boolean, offsetof(sharemap_config_t, dvbs2_tx_force_on)}, 0.0, 0.0, 0.0, 0, 0},
+} };
+
+// Broken rules of a config sharemap, bit i for RULES[i]
+using sharemap_config_errors_t = std::bitset<61>;
+
+// Check a config sharemap against the rules of its schema, none() when it is valid
+[[nodiscard]] static inline sharemap_config_errors_t sharemap_validate(const sharemap_config_t &in)
+{
+    return sharemap_validate_rules(reinterpret_cast<const std::uint8_t *>(&in), sharemap_config_t::RULES,
+                                   sharemap_config_t::OPTIONS);
+}
+
+// Pack straight into PACKED_SIZE bytes at out
+static inline void sharemap_pack_into(sharemap_config_t &in, std::uint8_t *out)
 {
     in.unix_timestamp_ns = time_ns_since_epoch();
+    anysignal::sharemap_pack_field(in.source_id, out + offsetof(sharemap_config_packed_t, source_id));
+    anysignal::sharemap_pack_field(in.schema_hash, out + offsetof(sharemap_config_packed_t, schema_hash));
+    anysignal::sharemap_pack_field(in.unix_timestamp_ns, out + offsetof(sharemap_config_packed_t, unix_timestamp_ns));
+    anysignal::sharemap_pack_field(in.psk_cc_tx_force_on, out + offsetof(sharemap_config_packed_t, psk_cc_tx_force_on));
+    anysignal::sharemap_pack_field(in.psk_cc_tx_idle_timeout_s, out + offsetof(sharemap_config_packed_t, psk_cc_tx_idle_timeout_s));
+    anysignal::sharemap_pack_field(in.psk_cc_tx_fe_frequency, out + offsetof(sharemap_config_packed_t, psk_cc_tx_fe_frequency));
+    anysignal::sharemap_pack_field(in.psk_cc_tx_fe_stx1_enable, out + offsetof(sharemap_config_packed_t, psk_cc_tx_fe_stx1_enable));
+    anysignal::sharemap_pack_field(in.psk_cc_tx_fe_stx1_gain, out + offsetof(sharemap_config_packed_t, psk_cc_tx_fe_stx1_gain));
+    anysignal::sharemap_pack_field(in.psk_cc_tx_fe_stx1_atten, out + offsetof(sharemap_config_packed_t, psk_cc_tx_fe_stx1_atten));
+    anysignal::sharemap_pack_field(in.psk_cc_tx_fe_stx2_enable, out + offsetof(sharemap_config_packed_t, psk_cc_tx_fe_stx2_enable));
+    anysignal::sharemap_pack_field(in.psk_cc_tx_fe_stx2_gain, out + offsetof(sharemap_config_packed_t, psk_cc_tx_fe_stx2_gain));
+    anysignal::sharemap_pack_field(in.psk_cc_tx_fe_stx2_atten, out + offsetof(sharemap_config_packed_t, psk_cc_tx_fe_stx2_atten));
+    anysignal::sharemap_pack_field(in.psk_cc_tx_fe_sample_rate, out + offsetof(sharemap_config_packed_t, psk_cc_tx_fe_sample_rate));
+    anysignal::sharemap_pack_field(in.psk_cc_tx_symbol_rate, out + offsetof(sharemap_config_packed_t, psk_cc_tx_symbol_rate));
+    anysignal::sharemap_pack_field(in.psk_cc_tx_modulation, out + offsetof(sharemap_config_packed_t, psk_cc_tx_modulation));
+    anysignal::sharemap_pack_field(in.psk_cc_rx_force_on, out + offsetof(sharemap_config_packed_t, psk_cc_rx_force_on));
+    anysignal::sharemap_pack_field(in.psk_cc_rx_idle_timeout_s, out + offsetof(sharemap_config_packed_t, psk_cc_rx_idle_timeout_s));
+    anysignal::sharemap_pack_field(in.psk_cc_rx_low_power_timeout_s, out + offsetof(sharemap_config_packed_t, psk_cc_rx_low_power_timeout_s));
+    anysignal::sharemap_pack_field(in.psk_cc_rx_gain_mode, out + offsetof(sharemap_config_packed_t, psk_cc_rx_gain_mode));
+    anysignal::sharemap_pack_field(in.psk_cc_rx_auto_antenna_selection, out + offsetof(sharemap_config_packed_t, psk_cc_rx_auto_antenna_selection));
+    anysignal::sharemap_pack_field(in.psk_cc_rx_fe_frequency, out + offsetof(sharemap_config_packed_t, psk_cc_rx_fe_frequency));
+    anysignal::sharemap_pack_field(in.psk_cc_rx_fe_srx1_enable, out + offsetof(sharemap_config_packed_t, psk_cc_rx_fe_srx1_enable));
+    anysignal::sharemap_pack_field(in.psk_cc_rx_fe_srx1_gain, out + offsetof(sharemap_config_packed_t, psk_cc_rx_fe_srx1_gain));
+    anysignal::sharemap_pack_field(in.psk_cc_rx_fe_srx1_atten, out + offsetof(sharemap_config_packed_t, psk_cc_rx_fe_srx1_atten));
+    anysignal::sharemap_pack_field(in.psk_cc_rx_fe_srx2_enable, out + offsetof(sharemap_config_packed_t, psk_cc_rx_fe_srx2_enable));
+    anysignal::sharemap_pack_field(in.psk_cc_rx_fe_srx2_gain, out + offsetof(sharemap_config_packed_t, psk_cc_rx_fe_srx2_gain));
+    anysignal::sharemap_pack_field(in.psk_cc_rx_fe_srx2_atten, out + offsetof(sharemap_config_packed_t, psk_cc_rx_fe_srx2_atten));
+    anysignal::sharemap_pack_field(in.psk_cc_rx_fe_sample_rate, out + offsetof(sharemap_config_packed_t, psk_cc_rx_fe_sample_rate));
+    anysignal::sharemap_pack_field(in.psk_cc_rx_symbol_rate, out + offsetof(sharemap_config_packed_t, psk_cc_rx_symbol_rate));
+    anysignal::sharemap_pack_field(in.psk_cc_rx_modulation, out + offsetof(sharemap_config_packed_t, psk_cc_rx_modulation));
+    anysignal::sharemap_pack_field(in.dvbs2_tx_force_on, out + offsetof(sharemap_config_packed_t, dvbs2_tx_force_on));
+    anysignal::sharemap_pack_field(in.dvbs2_tx_idle_timeout_s, out + offsetof(sharemap_config_packed_t, dvbs2_tx_idle_timeout_s));
+    anysignal::sharemap_pack_field(in.dvbs2_tx_fe_frequency, out + offsetof(sharemap_config_packed_t, dvbs2_tx_fe_frequency));
+    anysignal::sharemap_pack_field(in.dvbs2_tx_fe_gain, out + offsetof(sharemap_config_packed_t, dvbs2_tx_fe_gain));
+    anysignal::sharemap_pack_field(in.dvbs2_tx_fe_sample_rate, out + offsetof(sharemap_config_packed_t, dvbs2_tx_fe_sample_rate));
+    anysignal::sharemap_pack_field(in.dvbs2_tx_symbol_rate, out + offsetof(sharemap_config_packed_t, dvbs2_tx_symbol_rate));
+    anysignal::sharemap_pack_field(in.dvbs2_tx_modulation, out + offsetof(sharemap_config_packed_t, dvbs2_tx_modulation));
+    anysignal::sharemap_pack_field(in.dvbs2_tx_coding, out + offsetof(sharemap_config_packed_t, dvbs2_tx_coding));
+    anysignal::sharemap_pack_field(in.dvbs2_tx_rolloff, out + offsetof(sharemap_config_packed_t, dvbs2_tx_rolloff));
+    anysignal::sharemap_pack_field(in.dvbs2_tx_frame_length, out + offsetof(sharemap_config_packed_t, dvbs2_tx_frame_length));
+    anysignal::sharemap_pack_field(in.dvbs2_tx_signal_scaling, out + offsetof(sharemap_config_packed_t, dvbs2_tx_signal_scaling));
+    anysignal::sharemap_pack_field(in.gfsk_tx_force_on, out + offsetof(sharemap_config_packed_t, gfsk_tx_force_on));
+    anysignal::sharemap_pack_field(in.gfsk_tx_idle_timeout_s, out + offsetof(sharemap_config_packed_t, gfsk_tx_idle_timeout_s));
+    anysignal::sharemap_pack_field(in.gfsk_tx_fe_frequency, out + offsetof(sharemap_config_packed_t, gfsk_tx_fe_frequency));
+    anysignal::sharemap_pack_field(in.gfsk_tx_fe_gain, out + offsetof(sharemap_config_packed_t, gfsk_tx_fe_gain));
+    anysignal::sharemap_pack_field(in.gfsk_tx_fe_atten, out + offsetof(sharemap_config_packed_t, gfsk_tx_fe_atten));
+    anysignal::sharemap_pack_field(in.gfsk_tx_fe_sample_rate, out + offsetof(sharemap_config_packed_t, gfsk_tx_fe_sample_rate));
+    anysignal::sharemap_pack_field(in.gfsk_tx_symbol_rate, out + offsetof(sharemap_config_packed_t, gfsk_tx_symbol_rate));
+    anysignal::sharemap_pack_field(in.gfsk_tx_mod_index, out + offsetof(sharemap_config_packed_t, gfsk_tx_mod_index));
+    anysignal::sharemap_pack_field(in.gfsk_tx_max_payload_len, out + offsetof(sharemap_config_packed_t, gfsk_tx_max_payload_len));
+    anysignal::sharemap_pack_field(in.gfsk_tx_bt, out + offsetof(sharemap_config_packed_t, gfsk_tx_bt));
+    anysignal::sharemap_pack_field(in.anylink_active_tx_channel, out + offsetof(sharemap_config_packed_t, anylink_active_tx_channel));
+}
+
+// Pack into caller storage, e.g. part of a send buffer or iovec.
+// Returns the bytes written, 0 if out is smaller than PACKED_SIZE.
+static inline std::size_t sharemap_pack(sharemap_config_t &in, std::span<std::uint8_t> out)
+{
+    if (out.size() < sharemap_config_t::PACKED_SIZE)
+    {
+        return 0;
+    }
+    sharemap_pack_into(in, out.data());
+    return sharemap_config_t::PACKED_SIZE;
+}
+
+static inline sharemap_config_packed_t sharemap_pack(sharemap_config_t &in)
+{
     sharemap_config_packed_t out{};
-    anysignal_sharemap_pack_field(in, out, source_id);
-    anysignal_sharemap_pack_field(in, out, schema_hash);
-    anysignal_sharemap_pack_field(in, out, unix_timestamp_ns);
-    anysignal_sharemap_pack_field(in, out, psk_cc_tx_force_on);
-    anysignal_sharemap_pack_field(in, out, psk_cc_tx_idle_timeout_s);
-    anysignal_sharemap_pack_field(in, out, psk_cc_tx_fe_frequency);
-    anysignal_sharemap_pack_field(in, out, psk_cc_tx_fe_stx1_enable);
-    anysignal_sharemap_pack_field(in, out, psk_cc_tx_fe_stx1_gain);
-    anysignal_sharemap_pack_field(in, out, psk_cc_tx_fe_stx1_atten);
-    anysignal_sharemap_pack_field(in, out, psk_cc_tx_fe_stx2_enable);
-    anysignal_sharemap_pack_field(in, out, psk_cc_tx_fe_stx2_gain);
-    anysignal_sharemap_pack_field(in, out, psk_cc_tx_fe_stx2_atten);
-    anysignal_sharemap_pack_field(in, out, psk_cc_tx_fe_sample_rate);
-    anysignal_sharemap_pack_field(in, out, psk_cc_tx_symbol_rate);
-    anysignal_sharemap_pack_field(in, out, psk_cc_tx_modulation);
-    anysignal_sharemap_pack_field(in, out, psk_cc_rx_force_on);
-    anysignal_sharemap_pack_field(in, out, psk_cc_rx_idle_timeout_s);
-    anysignal_sharemap_pack_field(in, out, psk_cc_rx_low_power_timeout_s);
-    anysignal_sharemap_pack_field(in, out, psk_cc_rx_gain_mode);
-    anysignal_sharemap_pack_field(in, out, psk_cc_rx_auto_antenna_selection);
-    anysignal_sharemap_pack_field(in, out, psk_cc_rx_fe_frequency);
-    anysignal_sharemap_pack_field(in, out, psk_cc_rx_fe_srx1_enable);
-    anysignal_sharemap_pack_field(in, out, psk_cc_rx_fe_srx1_gain);
-    anysignal_sharemap_pack_field(in, out, psk_cc_rx_fe_srx1_atten);
-    anysignal_sharemap_pack_field(in, out, psk_cc_rx_fe_srx2_enable);
-    anysignal_sharemap_pack_field(in, out, psk_cc_rx_fe_srx2_gain);
-    anysignal_sharemap_pack_field(in, out, psk_cc_rx_fe_srx2_atten);
-    anysignal_sharemap_pack_field(in, out, psk_cc_rx_fe_sample_rate);
-    anysignal_sharemap_pack_field(in, out, psk_cc_rx_symbol_rate);
-    anysignal_sharemap_pack_field(in, out, psk_cc_rx_modulation);
-    anysignal_sharemap_pack_field(in, out, dvbs2_tx_force_on);
-    anysignal_sharemap_pack_field(in, out, dvbs2_tx_idle_timeout_s);
-    anysignal_sharemap_pack_field(in, out, dvbs2_tx_fe_frequency);
-    anysignal_sharemap_pack_field(in, out, dvbs2_tx_fe_gain);
-    anysignal_sharemap_pack_field(in, out, dvbs2_tx_fe_sample_rate);
-    anysignal_sharemap_pack_field(in, out, dvbs2_tx_symbol_rate);
-    anysignal_sharemap_pack_field(in, out, dvbs2_tx_modulation);
-    anysignal_sharemap_pack_field(in, out, dvbs2_tx_coding);
-    anysignal_sharemap_pack_field(in, out, dvbs2_tx_rolloff);
-    anysignal_sharemap_pack_field(in, out, dvbs2_tx_frame_length);
-    anysignal_sharemap_pack_field(in, out, dvbs2_tx_signal_scaling);
-    anysignal_sharemap_pack_field(in, out, gfsk_tx_force_on);
-    anysignal_sharemap_pack_field(in, out, gfsk_tx_idle_timeout_s);
-    anysignal_sharemap_pack_field(in, out, gfsk_tx_fe_frequency);
-    anysignal_sharemap_pack_field(in, out, gfsk_tx_fe_gain);
-    anysignal_sharemap_pack_field(in, out, gfsk_tx_fe_atten);
-    anysignal_sharemap_pack_field(in, out, gfsk_tx_fe_sample_rate);
-    anysignal_sharemap_pack_field(in, out, gfsk_tx_symbol_rate);
-    anysignal_sharemap_pack_field(in, out, gfsk_tx_mod_index);
-    anysignal_sharemap_pack_field(in, out, gfsk_tx_max_payload_len);
-    anysignal_sharemap_pack_field(in, out, gfsk_tx_bt);
-    anysignal_sharemap_pack_field(in, out, anylink_active_tx_channel);
+    sharemap_pack_into(in, reinterpret_cast<std::uint8_t *>(&out));
     return out;
 }
 
@@ -569,6 +1028,473 @@ static inline sharemap_config_t sharemap_unpack(const sharemap_config_packed_t &
     return out;
 }
 
+// Unpack straight from a received buffer, false if length is not PACKED_SIZE
+static inline bool sharemap_unpack(const std::uint8_t *in, const std::size_t length, sharemap_config_t &out)
+{
+    if (length != sharemap_config_t::PACKED_SIZE)
+    {
+        return false;
+    }
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, source_id), out.source_id);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, schema_hash), out.schema_hash);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, unix_timestamp_ns), out.unix_timestamp_ns);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_tx_force_on), out.psk_cc_tx_force_on);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_tx_idle_timeout_s), out.psk_cc_tx_idle_timeout_s);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_tx_fe_frequency), out.psk_cc_tx_fe_frequency);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_tx_fe_stx1_enable), out.psk_cc_tx_fe_stx1_enable);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_tx_fe_stx1_gain), out.psk_cc_tx_fe_stx1_gain);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_tx_fe_stx1_atten), out.psk_cc_tx_fe_stx1_atten);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_tx_fe_stx2_enable), out.psk_cc_tx_fe_stx2_enable);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_tx_fe_stx2_gain), out.psk_cc_tx_fe_stx2_gain);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_tx_fe_stx2_atten), out.psk_cc_tx_fe_stx2_atten);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_tx_fe_sample_rate), out.psk_cc_tx_fe_sample_rate);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_tx_symbol_rate), out.psk_cc_tx_symbol_rate);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_tx_modulation), out.psk_cc_tx_modulation);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_rx_force_on), out.psk_cc_rx_force_on);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_rx_idle_timeout_s), out.psk_cc_rx_idle_timeout_s);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_rx_low_power_timeout_s), out.psk_cc_rx_low_power_timeout_s);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_rx_gain_mode), out.psk_cc_rx_gain_mode);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_rx_auto_antenna_selection), out.psk_cc_rx_auto_antenna_selection);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_rx_fe_frequency), out.psk_cc_rx_fe_frequency);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_rx_fe_srx1_enable), out.psk_cc_rx_fe_srx1_enable);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_rx_fe_srx1_gain), out.psk_cc_rx_fe_srx1_gain);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_rx_fe_srx1_atten), out.psk_cc_rx_fe_srx1_atten);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_rx_fe_srx2_enable), out.psk_cc_rx_fe_srx2_enable);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_rx_fe_srx2_gain), out.psk_cc_rx_fe_srx2_gain);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_rx_fe_srx2_atten), out.psk_cc_rx_fe_srx2_atten);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_rx_fe_sample_rate), out.psk_cc_rx_fe_sample_rate);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_rx_symbol_rate), out.psk_cc_rx_symbol_rate);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_rx_modulation), out.psk_cc_rx_modulation);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, dvbs2_tx_force_on), out.dvbs2_tx_force_on);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, dvbs2_tx_idle_timeout_s), out.dvbs2_tx_idle_timeout_s);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, dvbs2_tx_fe_frequency), out.dvbs2_tx_fe_frequency);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, dvbs2_tx_fe_gain), out.dvbs2_tx_fe_gain);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, dvbs2_tx_fe_sample_rate), out.dvbs2_tx_fe_sample_rate);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, dvbs2_tx_symbol_rate), out.dvbs2_tx_symbol_rate);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, dvbs2_tx_modulation), out.dvbs2_tx_modulation);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, dvbs2_tx_coding), out.dvbs2_tx_coding);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, dvbs2_tx_rolloff), out.dvbs2_tx_rolloff);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, dvbs2_tx_frame_length), out.dvbs2_tx_frame_length);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, dvbs2_tx_signal_scaling), out.dvbs2_tx_signal_scaling);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, gfsk_tx_force_on), out.gfsk_tx_force_on);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, gfsk_tx_idle_timeout_s), out.gfsk_tx_idle_timeout_s);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, gfsk_tx_fe_frequency), out.gfsk_tx_fe_frequency);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, gfsk_tx_fe_gain), out.gfsk_tx_fe_gain);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, gfsk_tx_fe_atten), out.gfsk_tx_fe_atten);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, gfsk_tx_fe_sample_rate), out.gfsk_tx_fe_sample_rate);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, gfsk_tx_symbol_rate), out.gfsk_tx_symbol_rate);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, gfsk_tx_mod_index), out.gfsk_tx_mod_index);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, gfsk_tx_max_payload_len), out.gfsk_tx_max_payload_len);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, gfsk_tx_bt), out.gfsk_tx_bt);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, anylink_active_tx_channel), out.anylink_active_tx_channel);
+    return true;
+}
+
+// config sharemap as one vector per field, for bulk analysis of many frames.
+// Booleans are kept as std::uint8_t, so rows can be written from several threads.
+struct sharemap_config_columns_t
+{
+    std::vector<std::uint16_t> source_id;
+    std::vector<std::uint64_t> schema_hash;
+    std::vector<std::int64_t> unix_timestamp_ns;
+    std::vector<std::uint8_t> psk_cc_tx_force_on;
+    std::vector<std::uint64_t> psk_cc_tx_idle_timeout_s;
+    std::vector<double> psk_cc_tx_fe_frequency;
+    std::vector<std::uint8_t> psk_cc_tx_fe_stx1_enable;
+    std::vector<double> psk_cc_tx_fe_stx1_gain;
+    std::vector<double> psk_cc_tx_fe_stx1_atten;
+    std::vector<std::uint8_t> psk_cc_tx_fe_stx2_enable;
+    std::vector<double> psk_cc_tx_fe_stx2_gain;
+    std::vector<double> psk_cc_tx_fe_stx2_atten;
+    std::vector<double> psk_cc_tx_fe_sample_rate;
+    std::vector<double> psk_cc_tx_symbol_rate;
+    std::vector<std::array<char, STRING_BUFFER_SIZE>> psk_cc_tx_modulation;
+    std::vector<std::uint8_t> psk_cc_rx_force_on;
+    std::vector<std::uint64_t> psk_cc_rx_idle_timeout_s;
+    std::vector<std::uint64_t> psk_cc_rx_low_power_timeout_s;
+    std::vector<std::array<char, STRING_BUFFER_SIZE>> psk_cc_rx_gain_mode;
+    std::vector<std::uint8_t> psk_cc_rx_auto_antenna_selection;
+    std::vector<double> psk_cc_rx_fe_frequency;
+    std::vector<std::uint8_t> psk_cc_rx_fe_srx1_enable;
+    std::vector<double> psk_cc_rx_fe_srx1_gain;
+    std::vector<double> psk_cc_rx_fe_srx1_atten;
+    std::vector<std::uint8_t> psk_cc_rx_fe_srx2_enable;
+    std::vector<double> psk_cc_rx_fe_srx2_gain;
+    std::vector<double> psk_cc_rx_fe_srx2_atten;
+    std::vector<double> psk_cc_rx_fe_sample_rate;
+    std::vector<double> psk_cc_rx_symbol_rate;
+    std::vector<std::array<char, STRING_BUFFER_SIZE>> psk_cc_rx_modulation;
+    std::vector<std::uint8_t> dvbs2_tx_force_on;
+    std::vector<std::uint64_t> dvbs2_tx_idle_timeout_s;
+    std::vector<double> dvbs2_tx_fe_frequency;
+    std::vector<double> dvbs2_tx_fe_gain;
+    std::vector<double> dvbs2_tx_fe_sample_rate;
+    std::vector<double> dvbs2_tx_symbol_rate;
+    std::vector<std::array<char, STRING_BUFFER_SIZE>> dvbs2_tx_modulation;
+    std::vector<std::array<char, STRING_BUFFER_SIZE>> dvbs2_tx_coding;
+    std::vector<std::array<char, STRING_BUFFER_SIZE>> dvbs2_tx_rolloff;
+    std::vector<std::array<char, STRING_BUFFER_SIZE>> dvbs2_tx_frame_length;
+    std::vector<double> dvbs2_tx_signal_scaling;
+    std::vector<std::uint8_t> gfsk_tx_force_on;
+    std::vector<std::uint64_t> gfsk_tx_idle_timeout_s;
+    std::vector<double> gfsk_tx_fe_frequency;
+    std::vector<double> gfsk_tx_fe_gain;
+    std::vector<double> gfsk_tx_fe_atten;
+    std::vector<double> gfsk_tx_fe_sample_rate;
+    std::vector<double> gfsk_tx_symbol_rate;
+    std::vector<float> gfsk_tx_mod_index;
+    std::vector<std::uint32_t> gfsk_tx_max_payload_len;
+    std::vector<float> gfsk_tx_bt;
+    std::vector<std::array<char, STRING_BUFFER_SIZE>> anylink_active_tx_channel;
+
+    std::size_t size(void) const { return schema_hash.size(); }
+
+    void resize(const std::size_t n)
+    {
+        source_id.resize(n);
+        schema_hash.resize(n);
+        unix_timestamp_ns.resize(n);
+        psk_cc_tx_force_on.resize(n);
+        psk_cc_tx_idle_timeout_s.resize(n);
+        psk_cc_tx_fe_frequency.resize(n);
+        psk_cc_tx_fe_stx1_enable.resize(n);
+        psk_cc_tx_fe_stx1_gain.resize(n);
+        psk_cc_tx_fe_stx1_atten.resize(n);
+        psk_cc_tx_fe_stx2_enable.resize(n);
+        psk_cc_tx_fe_stx2_gain.resize(n);
+        psk_cc_tx_fe_stx2_atten.resize(n);
+        psk_cc_tx_fe_sample_rate.resize(n);
+        psk_cc_tx_symbol_rate.resize(n);
+        psk_cc_tx_modulation.resize(n);
+        psk_cc_rx_force_on.resize(n);
+        psk_cc_rx_idle_timeout_s.resize(n);
+        psk_cc_rx_low_power_timeout_s.resize(n);
+        psk_cc_rx_gain_mode.resize(n);
+        psk_cc_rx_auto_antenna_selection.resize(n);
+        psk_cc_rx_fe_frequency.resize(n);
+        psk_cc_rx_fe_srx1_enable.resize(n);
+        psk_cc_rx_fe_srx1_gain.resize(n);
+        psk_cc_rx_fe_srx1_atten.resize(n);
+        psk_cc_rx_fe_srx2_enable.resize(n);
+        psk_cc_rx_fe_srx2_gain.resize(n);
+        psk_cc_rx_fe_srx2_atten.resize(n);
+        psk_cc_rx_fe_sample_rate.resize(n);
+        psk_cc_rx_symbol_rate.resize(n);
+        psk_cc_rx_modulation.resize(n);
+        dvbs2_tx_force_on.resize(n);
+        dvbs2_tx_idle_timeout_s.resize(n);
+        dvbs2_tx_fe_frequency.resize(n);
+        dvbs2_tx_fe_gain.resize(n);
+        dvbs2_tx_fe_sample_rate.resize(n);
+        dvbs2_tx_symbol_rate.resize(n);
+        dvbs2_tx_modulation.resize(n);
+        dvbs2_tx_coding.resize(n);
+        dvbs2_tx_rolloff.resize(n);
+        dvbs2_tx_frame_length.resize(n);
+        dvbs2_tx_signal_scaling.resize(n);
+        gfsk_tx_force_on.resize(n);
+        gfsk_tx_idle_timeout_s.resize(n);
+        gfsk_tx_fe_frequency.resize(n);
+        gfsk_tx_fe_gain.resize(n);
+        gfsk_tx_fe_atten.resize(n);
+        gfsk_tx_fe_sample_rate.resize(n);
+        gfsk_tx_symbol_rate.resize(n);
+        gfsk_tx_mod_index.resize(n);
+        gfsk_tx_max_payload_len.resize(n);
+        gfsk_tx_bt.resize(n);
+        anylink_active_tx_channel.resize(n);
+    }
+
+    void reserve(const std::size_t n)
+    {
+        source_id.reserve(n);
+        schema_hash.reserve(n);
+        unix_timestamp_ns.reserve(n);
+        psk_cc_tx_force_on.reserve(n);
+        psk_cc_tx_idle_timeout_s.reserve(n);
+        psk_cc_tx_fe_frequency.reserve(n);
+        psk_cc_tx_fe_stx1_enable.reserve(n);
+        psk_cc_tx_fe_stx1_gain.reserve(n);
+        psk_cc_tx_fe_stx1_atten.reserve(n);
+        psk_cc_tx_fe_stx2_enable.reserve(n);
+        psk_cc_tx_fe_stx2_gain.reserve(n);
+        psk_cc_tx_fe_stx2_atten.reserve(n);
+        psk_cc_tx_fe_sample_rate.reserve(n);
+        psk_cc_tx_symbol_rate.reserve(n);
+        psk_cc_tx_modulation.reserve(n);
+        psk_cc_rx_force_on.reserve(n);
+        psk_cc_rx_idle_timeout_s.reserve(n);
+        psk_cc_rx_low_power_timeout_s.reserve(n);
+        psk_cc_rx_gain_mode.reserve(n);
+        psk_cc_rx_auto_antenna_selection.reserve(n);
+        psk_cc_rx_fe_frequency.reserve(n);
+        psk_cc_rx_fe_srx1_enable.reserve(n);
+        psk_cc_rx_fe_srx1_gain.reserve(n);
+        psk_cc_rx_fe_srx1_atten.reserve(n);
+        psk_cc_rx_fe_srx2_enable.reserve(n);
+        psk_cc_rx_fe_srx2_gain.reserve(n);
+        psk_cc_rx_fe_srx2_atten.reserve(n);
+        psk_cc_rx_fe_sample_rate.reserve(n);
+        psk_cc_rx_symbol_rate.reserve(n);
+        psk_cc_rx_modulation.reserve(n);
+        dvbs2_tx_force_on.reserve(n);
+        dvbs2_tx_idle_timeout_s.reserve(n);
+        dvbs2_tx_fe_frequency.reserve(n);
+        dvbs2_tx_fe_gain.reserve(n);
+        dvbs2_tx_fe_sample_rate.reserve(n);
+        dvbs2_tx_symbol_rate.reserve(n);
+        dvbs2_tx_modulation.reserve(n);
+        dvbs2_tx_coding.reserve(n);
+        dvbs2_tx_rolloff.reserve(n);
+        dvbs2_tx_frame_length.reserve(n);
+        dvbs2_tx_signal_scaling.reserve(n);
+        gfsk_tx_force_on.reserve(n);
+        gfsk_tx_idle_timeout_s.reserve(n);
+        gfsk_tx_fe_frequency.reserve(n);
+        gfsk_tx_fe_gain.reserve(n);
+        gfsk_tx_fe_atten.reserve(n);
+        gfsk_tx_fe_sample_rate.reserve(n);
+        gfsk_tx_symbol_rate.reserve(n);
+        gfsk_tx_mod_index.reserve(n);
+        gfsk_tx_max_payload_len.reserve(n);
+        gfsk_tx_bt.reserve(n);
+        anylink_active_tx_channel.reserve(n);
+    }
+
+    void push_back(const sharemap_config_t &in)
+    {
+        source_id.push_back(in.source_id);
+        schema_hash.push_back(in.schema_hash);
+        unix_timestamp_ns.push_back(in.unix_timestamp_ns);
+        psk_cc_tx_force_on.push_back(in.psk_cc_tx_force_on);
+        psk_cc_tx_idle_timeout_s.push_back(in.psk_cc_tx_idle_timeout_s);
+        psk_cc_tx_fe_frequency.push_back(in.psk_cc_tx_fe_frequency);
+        psk_cc_tx_fe_stx1_enable.push_back(in.psk_cc_tx_fe_stx1_enable);
+        psk_cc_tx_fe_stx1_gain.push_back(in.psk_cc_tx_fe_stx1_gain);
+        psk_cc_tx_fe_stx1_atten.push_back(in.psk_cc_tx_fe_stx1_atten);
+        psk_cc_tx_fe_stx2_enable.push_back(in.psk_cc_tx_fe_stx2_enable);
+        psk_cc_tx_fe_stx2_gain.push_back(in.psk_cc_tx_fe_stx2_gain);
+        psk_cc_tx_fe_stx2_atten.push_back(in.psk_cc_tx_fe_stx2_atten);
+        psk_cc_tx_fe_sample_rate.push_back(in.psk_cc_tx_fe_sample_rate);
+        psk_cc_tx_symbol_rate.push_back(in.psk_cc_tx_symbol_rate);
+        psk_cc_tx_modulation.push_back(in.psk_cc_tx_modulation);
+        psk_cc_rx_force_on.push_back(in.psk_cc_rx_force_on);
+        psk_cc_rx_idle_timeout_s.push_back(in.psk_cc_rx_idle_timeout_s);
+        psk_cc_rx_low_power_timeout_s.push_back(in.psk_cc_rx_low_power_timeout_s);
+        psk_cc_rx_gain_mode.push_back(in.psk_cc_rx_gain_mode);
+        psk_cc_rx_auto_antenna_selection.push_back(in.psk_cc_rx_auto_antenna_selection);
+        psk_cc_rx_fe_frequency.push_back(in.psk_cc_rx_fe_frequency);
+        psk_cc_rx_fe_srx1_enable.push_back(in.psk_cc_rx_fe_srx1_enable);
+        psk_cc_rx_fe_srx1_gain.push_back(in.psk_cc_rx_fe_srx1_gain);
+        psk_cc_rx_fe_srx1_atten.push_back(in.psk_cc_rx_fe_srx1_atten);
+        psk_cc_rx_fe_srx2_enable.push_back(in.psk_cc_rx_fe_srx2_enable);
+        psk_cc_rx_fe_srx2_gain.push_back(in.psk_cc_rx_fe_srx2_gain);
+        psk_cc_rx_fe_srx2_atten.push_back(in.psk_cc_rx_fe_srx2_atten);
+        psk_cc_rx_fe_sample_rate.push_back(in.psk_cc_rx_fe_sample_rate);
+        psk_cc_rx_symbol_rate.push_back(in.psk_cc_rx_symbol_rate);
+        psk_cc_rx_modulation.push_back(in.psk_cc_rx_modulation);
+        dvbs2_tx_force_on.push_back(in.dvbs2_tx_force_on);
+        dvbs2_tx_idle_timeout_s.push_back(in.dvbs2_tx_idle_timeout_s);
+        dvbs2_tx_fe_frequency.push_back(in.dvbs2_tx_fe_frequency);
+        dvbs2_tx_fe_gain.push_back(in.dvbs2_tx_fe_gain);
+        dvbs2_tx_fe_sample_rate.push_back(in.dvbs2_tx_fe_sample_rate);
+        dvbs2_tx_symbol_rate.push_back(in.dvbs2_tx_symbol_rate);
+        dvbs2_tx_modulation.push_back(in.dvbs2_tx_modulation);
+        dvbs2_tx_coding.push_back(in.dvbs2_tx_coding);
+        dvbs2_tx_rolloff.push_back(in.dvbs2_tx_rolloff);
+        dvbs2_tx_frame_length.push_back(in.dvbs2_tx_frame_length);
+        dvbs2_tx_signal_scaling.push_back(in.dvbs2_tx_signal_scaling);
+        gfsk_tx_force_on.push_back(in.gfsk_tx_force_on);
+        gfsk_tx_idle_timeout_s.push_back(in.gfsk_tx_idle_timeout_s);
+        gfsk_tx_fe_frequency.push_back(in.gfsk_tx_fe_frequency);
+        gfsk_tx_fe_gain.push_back(in.gfsk_tx_fe_gain);
+        gfsk_tx_fe_atten.push_back(in.gfsk_tx_fe_atten);
+        gfsk_tx_fe_sample_rate.push_back(in.gfsk_tx_fe_sample_rate);
+        gfsk_tx_symbol_rate.push_back(in.gfsk_tx_symbol_rate);
+        gfsk_tx_mod_index.push_back(in.gfsk_tx_mod_index);
+        gfsk_tx_max_payload_len.push_back(in.gfsk_tx_max_payload_len);
+        gfsk_tx_bt.push_back(in.gfsk_tx_bt);
+        anylink_active_tx_channel.push_back(in.anylink_active_tx_channel);
+    }
+
+    sharemap_config_t row(const std::size_t i) const
+    {
+        sharemap_config_t out{};
+        out.source_id = source_id[i];
+        out.schema_hash = schema_hash[i];
+        out.unix_timestamp_ns = unix_timestamp_ns[i];
+        out.psk_cc_tx_force_on = psk_cc_tx_force_on[i];
+        out.psk_cc_tx_idle_timeout_s = psk_cc_tx_idle_timeout_s[i];
+        out.psk_cc_tx_fe_frequency = psk_cc_tx_fe_frequency[i];
+        out.psk_cc_tx_fe_stx1_enable = psk_cc_tx_fe_stx1_enable[i];
+        out.psk_cc_tx_fe_stx1_gain = psk_cc_tx_fe_stx1_gain[i];
+        out.psk_cc_tx_fe_stx1_atten = psk_cc_tx_fe_stx1_atten[i];
+        out.psk_cc_tx_fe_stx2_enable = psk_cc_tx_fe_stx2_enable[i];
+        out.psk_cc_tx_fe_stx2_gain = psk_cc_tx_fe_stx2_gain[i];
+        out.psk_cc_tx_fe_stx2_atten = psk_cc_tx_fe_stx2_atten[i];
+        out.psk_cc_tx_fe_sample_rate = psk_cc_tx_fe_sample_rate[i];
+        out.psk_cc_tx_symbol_rate = psk_cc_tx_symbol_rate[i];
+        out.psk_cc_tx_modulation = psk_cc_tx_modulation[i];
+        out.psk_cc_rx_force_on = psk_cc_rx_force_on[i];
+        out.psk_cc_rx_idle_timeout_s = psk_cc_rx_idle_timeout_s[i];
+        out.psk_cc_rx_low_power_timeout_s = psk_cc_rx_low_power_timeout_s[i];
+        out.psk_cc_rx_gain_mode = psk_cc_rx_gain_mode[i];
+        out.psk_cc_rx_auto_antenna_selection = psk_cc_rx_auto_antenna_selection[i];
+        out.psk_cc_rx_fe_frequency = psk_cc_rx_fe_frequency[i];
+        out.psk_cc_rx_fe_srx1_enable = psk_cc_rx_fe_srx1_enable[i];
+        out.psk_cc_rx_fe_srx1_gain = psk_cc_rx_fe_srx1_gain[i];
+        out.psk_cc_rx_fe_srx1_atten = psk_cc_rx_fe_srx1_atten[i];
+        out.psk_cc_rx_fe_srx2_enable = psk_cc_rx_fe_srx2_enable[i];
+        out.psk_cc_rx_fe_srx2_gain = psk_cc_rx_fe_srx2_gain[i];
+        out.psk_cc_rx_fe_srx2_atten = psk_cc_rx_fe_srx2_atten[i];
+        out.psk_cc_rx_fe_sample_rate = psk_cc_rx_fe_sample_rate[i];
+        out.psk_cc_rx_symbol_rate = psk_cc_rx_symbol_rate[i];
+        out.psk_cc_rx_modulation = psk_cc_rx_modulation[i];
+        out.dvbs2_tx_force_on = dvbs2_tx_force_on[i];
+        out.dvbs2_tx_idle_timeout_s = dvbs2_tx_idle_timeout_s[i];
+        out.dvbs2_tx_fe_frequency = dvbs2_tx_fe_frequency[i];
+        out.dvbs2_tx_fe_gain = dvbs2_tx_fe_gain[i];
+        out.dvbs2_tx_fe_sample_rate = dvbs2_tx_fe_sample_rate[i];
+        out.dvbs2_tx_symbol_rate = dvbs2_tx_symbol_rate[i];
+        out.dvbs2_tx_modulation = dvbs2_tx_modulation[i];
+        out.dvbs2_tx_coding = dvbs2_tx_coding[i];
+        out.dvbs2_tx_rolloff = dvbs2_tx_rolloff[i];
+        out.dvbs2_tx_frame_length = dvbs2_tx_frame_length[i];
+        out.dvbs2_tx_signal_scaling = dvbs2_tx_signal_scaling[i];
+        out.gfsk_tx_force_on = gfsk_tx_force_on[i];
+        out.gfsk_tx_idle_timeout_s = gfsk_tx_idle_timeout_s[i];
+        out.gfsk_tx_fe_frequency = gfsk_tx_fe_frequency[i];
+        out.gfsk_tx_fe_gain = gfsk_tx_fe_gain[i];
+        out.gfsk_tx_fe_atten = gfsk_tx_fe_atten[i];
+        out.gfsk_tx_fe_sample_rate = gfsk_tx_fe_sample_rate[i];
+        out.gfsk_tx_symbol_rate = gfsk_tx_symbol_rate[i];
+        out.gfsk_tx_mod_index = gfsk_tx_mod_index[i];
+        out.gfsk_tx_max_payload_len = gfsk_tx_max_payload_len[i];
+        out.gfsk_tx_bt = gfsk_tx_bt[i];
+        out.anylink_active_tx_channel = anylink_active_tx_channel[i];
+        return out;
+    }
+
+    // Copy row from of other into row to, both already sized
+    void copy_row(const std::size_t to, const sharemap_config_columns_t &other, const std::size_t from)
+    {
+        source_id[to] = other.source_id[from];
+        schema_hash[to] = other.schema_hash[from];
+        unix_timestamp_ns[to] = other.unix_timestamp_ns[from];
+        psk_cc_tx_force_on[to] = other.psk_cc_tx_force_on[from];
+        psk_cc_tx_idle_timeout_s[to] = other.psk_cc_tx_idle_timeout_s[from];
+        psk_cc_tx_fe_frequency[to] = other.psk_cc_tx_fe_frequency[from];
+        psk_cc_tx_fe_stx1_enable[to] = other.psk_cc_tx_fe_stx1_enable[from];
+        psk_cc_tx_fe_stx1_gain[to] = other.psk_cc_tx_fe_stx1_gain[from];
+        psk_cc_tx_fe_stx1_atten[to] = other.psk_cc_tx_fe_stx1_atten[from];
+        psk_cc_tx_fe_stx2_enable[to] = other.psk_cc_tx_fe_stx2_enable[from];
+        psk_cc_tx_fe_stx2_gain[to] = other.psk_cc_tx_fe_stx2_gain[from];
+        psk_cc_tx_fe_stx2_atten[to] = other.psk_cc_tx_fe_stx2_atten[from];
+        psk_cc_tx_fe_sample_rate[to] = other.psk_cc_tx_fe_sample_rate[from];
+        psk_cc_tx_symbol_rate[to] = other.psk_cc_tx_symbol_rate[from];
+        psk_cc_tx_modulation[to] = other.psk_cc_tx_modulation[from];
+        psk_cc_rx_force_on[to] = other.psk_cc_rx_force_on[from];
+        psk_cc_rx_idle_timeout_s[to] = other.psk_cc_rx_idle_timeout_s[from];
+        psk_cc_rx_low_power_timeout_s[to] = other.psk_cc_rx_low_power_timeout_s[from];
+        psk_cc_rx_gain_mode[to] = other.psk_cc_rx_gain_mode[from];
+        psk_cc_rx_auto_antenna_selection[to] = other.psk_cc_rx_auto_antenna_selection[from];
+        psk_cc_rx_fe_frequency[to] = other.psk_cc_rx_fe_frequency[from];
+        psk_cc_rx_fe_srx1_enable[to] = other.psk_cc_rx_fe_srx1_enable[from];
+        psk_cc_rx_fe_srx1_gain[to] = other.psk_cc_rx_fe_srx1_gain[from];
+        psk_cc_rx_fe_srx1_atten[to] = other.psk_cc_rx_fe_srx1_atten[from];
+        psk_cc_rx_fe_srx2_enable[to] = other.psk_cc_rx_fe_srx2_enable[from];
+        psk_cc_rx_fe_srx2_gain[to] = other.psk_cc_rx_fe_srx2_gain[from];
+        psk_cc_rx_fe_srx2_atten[to] = other.psk_cc_rx_fe_srx2_atten[from];
+        psk_cc_rx_fe_sample_rate[to] = other.psk_cc_rx_fe_sample_rate[from];
+        psk_cc_rx_symbol_rate[to] = other.psk_cc_rx_symbol_rate[from];
+        psk_cc_rx_modulation[to] = other.psk_cc_rx_modulation[from];
+        dvbs2_tx_force_on[to] = other.dvbs2_tx_force_on[from];
+        dvbs2_tx_idle_timeout_s[to] = other.dvbs2_tx_idle_timeout_s[from];
+        dvbs2_tx_fe_frequency[to] = other.dvbs2_tx_fe_frequency[from];
+        dvbs2_tx_fe_gain[to] = other.dvbs2_tx_fe_gain[from];
+        dvbs2_tx_fe_sample_rate[to] = other.dvbs2_tx_fe_sample_rate[from];
+        dvbs2_tx_symbol_rate[to] = other.dvbs2_tx_symbol_rate[from];
+        dvbs2_tx_modulation[to] = other.dvbs2_tx_modulation[from];
+        dvbs2_tx_coding[to] = other.dvbs2_tx_coding[from];
+        dvbs2_tx_rolloff[to] = other.dvbs2_tx_rolloff[from];
+        dvbs2_tx_frame_length[to] = other.dvbs2_tx_frame_length[from];
+        dvbs2_tx_signal_scaling[to] = other.dvbs2_tx_signal_scaling[from];
+        gfsk_tx_force_on[to] = other.gfsk_tx_force_on[from];
+        gfsk_tx_idle_timeout_s[to] = other.gfsk_tx_idle_timeout_s[from];
+        gfsk_tx_fe_frequency[to] = other.gfsk_tx_fe_frequency[from];
+        gfsk_tx_fe_gain[to] = other.gfsk_tx_fe_gain[from];
+        gfsk_tx_fe_atten[to] = other.gfsk_tx_fe_atten[from];
+        gfsk_tx_fe_sample_rate[to] = other.gfsk_tx_fe_sample_rate[from];
+        gfsk_tx_symbol_rate[to] = other.gfsk_tx_symbol_rate[from];
+        gfsk_tx_mod_index[to] = other.gfsk_tx_mod_index[from];
+        gfsk_tx_max_payload_len[to] = other.gfsk_tx_max_payload_len[from];
+        gfsk_tx_bt[to] = other.gfsk_tx_bt[from];
+        anylink_active_tx_channel[to] = other.anylink_active_tx_channel[from];
+    }
+};
+
+// Unpack straight into row of already sized columns, false if length is not PACKED_SIZE
+static inline bool sharemap_unpack(const std::uint8_t *in, const std::size_t length, sharemap_config_columns_t &out, const std::size_t row)
+{
+    if (length != sharemap_config_t::PACKED_SIZE)
+    {
+        return false;
+    }
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, source_id), out.source_id[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, schema_hash), out.schema_hash[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, unix_timestamp_ns), out.unix_timestamp_ns[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_tx_force_on), out.psk_cc_tx_force_on[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_tx_idle_timeout_s), out.psk_cc_tx_idle_timeout_s[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_tx_fe_frequency), out.psk_cc_tx_fe_frequency[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_tx_fe_stx1_enable), out.psk_cc_tx_fe_stx1_enable[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_tx_fe_stx1_gain), out.psk_cc_tx_fe_stx1_gain[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_tx_fe_stx1_atten), out.psk_cc_tx_fe_stx1_atten[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_tx_fe_stx2_enable), out.psk_cc_tx_fe_stx2_enable[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_tx_fe_stx2_gain), out.psk_cc_tx_fe_stx2_gain[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_tx_fe_stx2_atten), out.psk_cc_tx_fe_stx2_atten[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_tx_fe_sample_rate), out.psk_cc_tx_fe_sample_rate[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_tx_symbol_rate), out.psk_cc_tx_symbol_rate[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_tx_modulation), out.psk_cc_tx_modulation[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_rx_force_on), out.psk_cc_rx_force_on[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_rx_idle_timeout_s), out.psk_cc_rx_idle_timeout_s[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_rx_low_power_timeout_s), out.psk_cc_rx_low_power_timeout_s[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_rx_gain_mode), out.psk_cc_rx_gain_mode[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_rx_auto_antenna_selection), out.psk_cc_rx_auto_antenna_selection[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_rx_fe_frequency), out.psk_cc_rx_fe_frequency[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_rx_fe_srx1_enable), out.psk_cc_rx_fe_srx1_enable[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_rx_fe_srx1_gain), out.psk_cc_rx_fe_srx1_gain[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_rx_fe_srx1_atten), out.psk_cc_rx_fe_srx1_atten[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_rx_fe_srx2_enable), out.psk_cc_rx_fe_srx2_enable[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_rx_fe_srx2_gain), out.psk_cc_rx_fe_srx2_gain[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_rx_fe_srx2_atten), out.psk_cc_rx_fe_srx2_atten[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_rx_fe_sample_rate), out.psk_cc_rx_fe_sample_rate[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_rx_symbol_rate), out.psk_cc_rx_symbol_rate[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, psk_cc_rx_modulation), out.psk_cc_rx_modulation[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, dvbs2_tx_force_on), out.dvbs2_tx_force_on[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, dvbs2_tx_idle_timeout_s), out.dvbs2_tx_idle_timeout_s[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, dvbs2_tx_fe_frequency), out.dvbs2_tx_fe_frequency[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, dvbs2_tx_fe_gain), out.dvbs2_tx_fe_gain[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, dvbs2_tx_fe_sample_rate), out.dvbs2_tx_fe_sample_rate[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, dvbs2_tx_symbol_rate), out.dvbs2_tx_symbol_rate[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, dvbs2_tx_modulation), out.dvbs2_tx_modulation[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, dvbs2_tx_coding), out.dvbs2_tx_coding[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, dvbs2_tx_rolloff), out.dvbs2_tx_rolloff[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, dvbs2_tx_frame_length), out.dvbs2_tx_frame_length[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, dvbs2_tx_signal_scaling), out.dvbs2_tx_signal_scaling[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, gfsk_tx_force_on), out.gfsk_tx_force_on[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, gfsk_tx_idle_timeout_s), out.gfsk_tx_idle_timeout_s[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, gfsk_tx_fe_frequency), out.gfsk_tx_fe_frequency[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, gfsk_tx_fe_gain), out.gfsk_tx_fe_gain[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, gfsk_tx_fe_atten), out.gfsk_tx_fe_atten[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, gfsk_tx_fe_sample_rate), out.gfsk_tx_fe_sample_rate[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, gfsk_tx_symbol_rate), out.gfsk_tx_symbol_rate[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, gfsk_tx_mod_index), out.gfsk_tx_mod_index[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, gfsk_tx_max_payload_len), out.gfsk_tx_max_payload_len[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, gfsk_tx_bt), out.gfsk_tx_bt[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_config_packed_t, anylink_active_tx_channel), out.anylink_active_tx_channel[row]);
+    return true;
+}
+
 // metrics sharemap binary over the wire format
 struct sharemap_metrics_packed_t
 {
@@ -729,12 +1655,261 @@ struct sharemap_metrics_packed_t
     std::uint8_t anylink_tap_endpoint_send_packets[8]{};
 } __attribute__((packed));
 
+struct sharemap_metrics_columns_t;
+
 struct sharemap_metrics_t
 {
     static constexpr std::string_view NAME{"metrics"};
     static constexpr std::uint64_t HASH{0x3ec97e7957b3a184};
     using packed_t = sharemap_metrics_packed_t;
+    using columns_t = sharemap_metrics_columns_t;
     static constexpr size_t PACKED_SIZE{sizeof(packed_t)};
+    static constexpr size_t SCHEMA_HASH_OFFSET{offsetof(packed_t, schema_hash)};
+    static constexpr bool HAS_SEQUENCE{false};
+    // false if a frame is too large for a bundle of SHAREMAP_BUNDLE_MTU_PAYLOAD bytes, needing jumbo frames
+    static constexpr bool FITS_MTU_BUNDLE{false};
+    static constexpr std::array<sharemap_field_t, 155> FIELDS{ {
+        {"source_id", sharemap_type_t::u16, offsetof(packed_t, source_id), 2, false},
+        {"schema_hash", sharemap_type_t::u64, offsetof(packed_t, schema_hash), 8, false},
+        {"unix_timestamp_ns", sharemap_type_t::i64, offsetof(packed_t, unix_timestamp_ns), 8, false},
+        {"controld_version", sharemap_type_t::string, offsetof(packed_t, controld_version), 64, false},
+        {"controld_timestamp", sharemap_type_t::string, offsetof(packed_t, controld_timestamp), 64, false},
+        {"powerd_version", sharemap_type_t::string, offsetof(packed_t, powerd_version), 64, false},
+        {"powerd_timestamp", sharemap_type_t::string, offsetof(packed_t, powerd_timestamp), 64, false},
+        {"radiod_version", sharemap_type_t::string, offsetof(packed_t, radiod_version), 64, false},
+        {"radiod_timestamp", sharemap_type_t::string, offsetof(packed_t, radiod_timestamp), 64, false},
+        {"fpga_version", sharemap_type_t::string, offsetof(packed_t, fpga_version), 64, false},
+        {"fpga_timestamp", sharemap_type_t::string, offsetof(packed_t, fpga_timestamp), 64, false},
+        {"fpga_project_name", sharemap_type_t::string, offsetof(packed_t, fpga_project_name), 64, false},
+        {"anylink_version", sharemap_type_t::string, offsetof(packed_t, anylink_version), 64, false},
+        {"psk_cc_tx_bytes_total", sharemap_type_t::u64, offsetof(packed_t, psk_cc_tx_bytes_total), 8, true},
+        {"psk_cc_tx_underflows", sharemap_type_t::u64, offsetof(packed_t, psk_cc_tx_underflows), 8, true},
+        {"psk_cc_tx_client_recv_errors", sharemap_type_t::u64, offsetof(packed_t, psk_cc_tx_client_recv_errors), 8, true},
+        {"psk_cc_tx_client_msgs", sharemap_type_t::u64, offsetof(packed_t, psk_cc_tx_client_msgs), 8, true},
+        {"psk_cc_tx_frames_transmitted", sharemap_type_t::u64, offsetof(packed_t, psk_cc_tx_frames_transmitted), 8, true},
+        {"psk_cc_tx_failed_transmissions", sharemap_type_t::u64, offsetof(packed_t, psk_cc_tx_failed_transmissions), 8, true},
+        {"psk_cc_tx_dropped_packets", sharemap_type_t::u64, offsetof(packed_t, psk_cc_tx_dropped_packets), 8, true},
+        {"psk_cc_tx_idle_frames_transmitted", sharemap_type_t::u64, offsetof(packed_t, psk_cc_tx_idle_frames_transmitted), 8, true},
+        {"psk_cc_tx_failed_idle_frames_transmitted", sharemap_type_t::u64, offsetof(packed_t, psk_cc_tx_failed_idle_frames_transmitted), 8, true},
+        {"psk_cc_tx_failed_bytes_in_flight_checks", sharemap_type_t::u64, offsetof(packed_t, psk_cc_tx_failed_bytes_in_flight_checks), 8, true},
+        {"psk_cc_tx_modem_underflows", sharemap_type_t::u64, offsetof(packed_t, psk_cc_tx_modem_underflows), 8, true},
+        {"psk_cc_tx_ad9361_tx_pll_lock", sharemap_type_t::boolean, offsetof(packed_t, psk_cc_tx_ad9361_tx_pll_lock), 1, false},
+        {"psk_cc_rx_bytes_total", sharemap_type_t::u64, offsetof(packed_t, psk_cc_rx_bytes_total), 8, true},
+        {"psk_cc_rx_client_send_errors", sharemap_type_t::u64, offsetof(packed_t, psk_cc_rx_client_send_errors), 8, true},
+        {"psk_cc_rx_client_msgs", sharemap_type_t::u64, offsetof(packed_t, psk_cc_rx_client_msgs), 8, true},
+        {"psk_cc_rx_frames_received", sharemap_type_t::u64, offsetof(packed_t, psk_cc_rx_frames_received), 8, true},
+        {"psk_cc_rx_failed_receptions", sharemap_type_t::u64, offsetof(packed_t, psk_cc_rx_failed_receptions), 8, true},
+        {"psk_cc_rx_dropped_good_packets", sharemap_type_t::u64, offsetof(packed_t, psk_cc_rx_dropped_good_packets), 8, true},
+        {"psk_cc_rx_failed_frames_available_checks", sharemap_type_t::u64, offsetof(packed_t, psk_cc_rx_failed_frames_available_checks), 8, true},
+        {"psk_cc_rx_encountered_frames_in_progress", sharemap_type_t::u64, offsetof(packed_t, psk_cc_rx_encountered_frames_in_progress), 8, true},
+        {"psk_cc_rx_modem_dma_overflows", sharemap_type_t::u64, offsetof(packed_t, psk_cc_rx_modem_dma_overflows), 8, true},
+        {"psk_cc_rx_modem_dma_packet_count", sharemap_type_t::u32, offsetof(packed_t, psk_cc_rx_modem_dma_packet_count), 4, false},
+        {"psk_cc_rx_signal_present", sharemap_type_t::boolean, offsetof(packed_t, psk_cc_rx_signal_present), 1, false},
+        {"psk_cc_rx_carrier_lock", sharemap_type_t::boolean, offsetof(packed_t, psk_cc_rx_carrier_lock), 1, false},
+        {"psk_cc_rx_frame_sync_lock", sharemap_type_t::boolean, offsetof(packed_t, psk_cc_rx_frame_sync_lock), 1, false},
+        {"psk_cc_rx_fec_confirmed_lock", sharemap_type_t::boolean, offsetof(packed_t, psk_cc_rx_fec_confirmed_lock), 1, false},
+        {"psk_cc_rx_fec_ber", sharemap_type_t::f32, offsetof(packed_t, psk_cc_rx_fec_ber), 4, false},
+        {"psk_cc_rx_ad9361_rx_pll_lock", sharemap_type_t::boolean, offsetof(packed_t, psk_cc_rx_ad9361_rx_pll_lock), 1, false},
+        {"psk_cc_rx_ad9361_bb_pll_lock", sharemap_type_t::boolean, offsetof(packed_t, psk_cc_rx_ad9361_bb_pll_lock), 1, false},
+        {"dvbs2_tx_bytes_total", sharemap_type_t::u64, offsetof(packed_t, dvbs2_tx_bytes_total), 8, true},
+        {"dvbs2_tx_underflows", sharemap_type_t::u64, offsetof(packed_t, dvbs2_tx_underflows), 8, true},
+        {"dvbs2_tx_client_recv_errors", sharemap_type_t::u64, offsetof(packed_t, dvbs2_tx_client_recv_errors), 8, true},
+        {"dvbs2_tx_client_msgs", sharemap_type_t::u64, offsetof(packed_t, dvbs2_tx_client_msgs), 8, true},
+        {"dvbs2_tx_frames_transmitted", sharemap_type_t::u64, offsetof(packed_t, dvbs2_tx_frames_transmitted), 8, true},
+        {"dvbs2_tx_failed_transmissions", sharemap_type_t::u64, offsetof(packed_t, dvbs2_tx_failed_transmissions), 8, true},
+        {"dvbs2_tx_dropped_packets", sharemap_type_t::u64, offsetof(packed_t, dvbs2_tx_dropped_packets), 8, true},
+        {"dvbs2_tx_idle_frames_transmitted", sharemap_type_t::u64, offsetof(packed_t, dvbs2_tx_idle_frames_transmitted), 8, true},
+        {"dvbs2_tx_failed_idle_frames_transmitted", sharemap_type_t::u64, offsetof(packed_t, dvbs2_tx_failed_idle_frames_transmitted), 8, true},
+        {"dvbs2_tx_failed_bytes_in_flight_checks", sharemap_type_t::u64, offsetof(packed_t, dvbs2_tx_failed_bytes_in_flight_checks), 8, true},
+        {"dvbs2_tx_dummy_pl_frames", sharemap_type_t::u64, offsetof(packed_t, dvbs2_tx_dummy_pl_frames), 8, true},
+        {"gfsk_tx_bytes_total", sharemap_type_t::u64, offsetof(packed_t, gfsk_tx_bytes_total), 8, true},
+        {"gfsk_tx_underflows", sharemap_type_t::u64, offsetof(packed_t, gfsk_tx_underflows), 8, true},
+        {"gfsk_tx_client_recv_errors", sharemap_type_t::u64, offsetof(packed_t, gfsk_tx_client_recv_errors), 8, true},
+        {"gfsk_tx_client_msgs", sharemap_type_t::u64, offsetof(packed_t, gfsk_tx_client_msgs), 8, true},
+        {"gfsk_tx_frames_transmitted", sharemap_type_t::u64, offsetof(packed_t, gfsk_tx_frames_transmitted), 8, true},
+        {"gfsk_tx_failed_transmissions", sharemap_type_t::u64, offsetof(packed_t, gfsk_tx_failed_transmissions), 8, true},
+        {"gfsk_tx_dropped_packets", sharemap_type_t::u64, offsetof(packed_t, gfsk_tx_dropped_packets), 8, true},
+        {"gfsk_tx_idle_frames_transmitted", sharemap_type_t::u64, offsetof(packed_t, gfsk_tx_idle_frames_transmitted), 8, true},
+        {"gfsk_tx_failed_idle_frames_transmitted", sharemap_type_t::u64, offsetof(packed_t, gfsk_tx_failed_idle_frames_transmitted), 8, true},
+        {"gfsk_tx_failed_bytes_in_flight_checks", sharemap_type_t::u64, offsetof(packed_t, gfsk_tx_failed_bytes_in_flight_checks), 8, true},
+        {"ad9122_pgood", sharemap_type_t::boolean, offsetof(packed_t, ad9122_pgood), 1, false},
+        {"ad9361_pgood", sharemap_type_t::boolean, offsetof(packed_t, ad9361_pgood), 1, false},
+        {"adrf6780_pgood", sharemap_type_t::boolean, offsetof(packed_t, adrf6780_pgood), 1, false},
+        {"at86_pgood", sharemap_type_t::boolean, offsetof(packed_t, at86_pgood), 1, false},
+        {"at86_is_pll_locked", sharemap_type_t::boolean, offsetof(packed_t, at86_is_pll_locked), 1, false},
+        {"aux_3v8_isense", sharemap_type_t::f64, offsetof(packed_t, aux_3v8_isense), 8, false},
+        {"aux_3v8_vsense", sharemap_type_t::f64, offsetof(packed_t, aux_3v8_vsense), 8, false},
+        {"carrier_28v0_isense", sharemap_type_t::f64, offsetof(packed_t, carrier_28v0_isense), 8, false},
+        {"carrier_28v0_vsense", sharemap_type_t::f64, offsetof(packed_t, carrier_28v0_vsense), 8, false},
+        {"carrier_2v1_isense", sharemap_type_t::f64, offsetof(packed_t, carrier_2v1_isense), 8, false},
+        {"carrier_2v1_vsense", sharemap_type_t::f64, offsetof(packed_t, carrier_2v1_vsense), 8, false},
+        {"carrier_2v6_isense", sharemap_type_t::f64, offsetof(packed_t, carrier_2v6_isense), 8, false},
+        {"carrier_2v6_vsense", sharemap_type_t::f64, offsetof(packed_t, carrier_2v6_vsense), 8, false},
+        {"carrier_3v8_isense", sharemap_type_t::f64, offsetof(packed_t, carrier_3v8_isense), 8, false},
+        {"carrier_3v8_vsense", sharemap_type_t::f64, offsetof(packed_t, carrier_3v8_vsense), 8, false},
+        {"carrier_5v5_isense", sharemap_type_t::f64, offsetof(packed_t, carrier_5v5_isense), 8, false},
+        {"carrier_5v5_vsense", sharemap_type_t::f64, offsetof(packed_t, carrier_5v5_vsense), 8, false},
+        {"carrier_temp", sharemap_type_t::f64, offsetof(packed_t, carrier_temp), 8, false},
+        {"lband_rx_pgood", sharemap_type_t::boolean, offsetof(packed_t, lband_rx_pgood), 1, false},
+        {"lband_temp", sharemap_type_t::f64, offsetof(packed_t, lband_temp), 8, false},
+        {"lband_tx_pgood", sharemap_type_t::boolean, offsetof(packed_t, lband_tx_pgood), 1, false},
+        {"lband_tx_rf_detect", sharemap_type_t::f64, offsetof(packed_t, lband_tx_rf_detect), 8, false},
+        {"lmk04832_pgood", sharemap_type_t::boolean, offsetof(packed_t, lmk04832_pgood), 1, false},
+        {"lmk04832_is_pll_locked", sharemap_type_t::boolean, offsetof(packed_t, lmk04832_is_pll_locked), 1, false},
+        {"lmx2594_pgood", sharemap_type_t::boolean, offsetof(packed_t, lmx2594_pgood), 1, false},
+        {"max2771_a_1_is_pll_locked", sharemap_type_t::boolean, offsetof(packed_t, max2771_a_1_is_pll_locked), 1, false},
+        {"max2771_a_2_is_pll_locked", sharemap_type_t::boolean, offsetof(packed_t, max2771_a_2_is_pll_locked), 1, false},
+        {"max2771_a_bias_pgood", sharemap_type_t::boolean, offsetof(packed_t, max2771_a_bias_pgood), 1, false},
+        {"max2771_a_pgood", sharemap_type_t::boolean, offsetof(packed_t, max2771_a_pgood), 1, false},
+        {"max2771_b_1_is_pll_locked", sharemap_type_t::boolean, offsetof(packed_t, max2771_b_1_is_pll_locked), 1, false},
+        {"max2771_b_2_is_pll_locked", sharemap_type_t::boolean, offsetof(packed_t, max2771_b_2_is_pll_locked), 1, false},
+        {"max2771_b_bias_pgood", sharemap_type_t::boolean, offsetof(packed_t, max2771_b_bias_pgood), 1, false},
+        {"max2771_b_pgood", sharemap_type_t::boolean, offsetof(packed_t, max2771_b_pgood), 1, false},
+        {"rf_fe_mux_pgood", sharemap_type_t::boolean, offsetof(packed_t, rf_fe_mux_pgood), 1, false},
+        {"sband_rx_pgood", sharemap_type_t::boolean, offsetof(packed_t, sband_rx_pgood), 1, false},
+        {"sband_temp", sharemap_type_t::f64, offsetof(packed_t, sband_temp), 8, false},
+        {"sband_tx_pgood", sharemap_type_t::boolean, offsetof(packed_t, sband_tx_pgood), 1, false},
+        {"sband_tx_rf_detect", sharemap_type_t::f64, offsetof(packed_t, sband_tx_rf_detect), 8, false},
+        {"si5345_pgood", sharemap_type_t::boolean, offsetof(packed_t, si5345_pgood), 1, false},
+        {"som_5v0_isense", sharemap_type_t::f64, offsetof(packed_t, som_5v0_isense), 8, false},
+        {"som_5v0_vsense", sharemap_type_t::f64, offsetof(packed_t, som_5v0_vsense), 8, false},
+        {"uhf_rx_pgood", sharemap_type_t::boolean, offsetof(packed_t, uhf_rx_pgood), 1, false},
+        {"uhf_temp", sharemap_type_t::f64, offsetof(packed_t, uhf_temp), 8, false},
+        {"uhf_tx_pgood", sharemap_type_t::boolean, offsetof(packed_t, uhf_tx_pgood), 1, false},
+        {"uhf_tx_rf_detect", sharemap_type_t::f64, offsetof(packed_t, uhf_tx_rf_detect), 8, false},
+        {"xband_24v0_isense", sharemap_type_t::f64, offsetof(packed_t, xband_24v0_isense), 8, false},
+        {"xband_24v0_vsense", sharemap_type_t::f64, offsetof(packed_t, xband_24v0_vsense), 8, false},
+        {"xband_drain_pgood", sharemap_type_t::boolean, offsetof(packed_t, xband_drain_pgood), 1, false},
+        {"xband_temp", sharemap_type_t::f64, offsetof(packed_t, xband_temp), 8, false},
+        {"xband_tx_rf_detect", sharemap_type_t::f64, offsetof(packed_t, xband_tx_rf_detect), 8, false},
+        {"anylink_uhf_tx_sent_bytes", sharemap_type_t::u64, offsetof(packed_t, anylink_uhf_tx_sent_bytes), 8, true},
+        {"anylink_uhf_tx_sent_packets", sharemap_type_t::u64, offsetof(packed_t, anylink_uhf_tx_sent_packets), 8, true},
+        {"anylink_uhf_tx_sent_frames", sharemap_type_t::u64, offsetof(packed_t, anylink_uhf_tx_sent_frames), 8, true},
+        {"anylink_uhf_tx_overflow_frames", sharemap_type_t::u64, offsetof(packed_t, anylink_uhf_tx_overflow_frames), 8, true},
+        {"anylink_sband_tx_sent_bytes", sharemap_type_t::u64, offsetof(packed_t, anylink_sband_tx_sent_bytes), 8, true},
+        {"anylink_sband_tx_sent_packets", sharemap_type_t::u64, offsetof(packed_t, anylink_sband_tx_sent_packets), 8, true},
+        {"anylink_sband_tx_sent_frames", sharemap_type_t::u64, offsetof(packed_t, anylink_sband_tx_sent_frames), 8, true},
+        {"anylink_sband_tx_overflow_frames", sharemap_type_t::u64, offsetof(packed_t, anylink_sband_tx_overflow_frames), 8, true},
+        {"anylink_xband_tx_sent_bytes", sharemap_type_t::u64, offsetof(packed_t, anylink_xband_tx_sent_bytes), 8, true},
+        {"anylink_xband_tx_sent_packets", sharemap_type_t::u64, offsetof(packed_t, anylink_xband_tx_sent_packets), 8, true},
+        {"anylink_xband_tx_sent_frames", sharemap_type_t::u64, offsetof(packed_t, anylink_xband_tx_sent_frames), 8, true},
+        {"anylink_xband_tx_overflow_frames", sharemap_type_t::u64, offsetof(packed_t, anylink_xband_tx_overflow_frames), 8, true},
+        {"anylink_sband_rx_received_bytes", sharemap_type_t::u64, offsetof(packed_t, anylink_sband_rx_received_bytes), 8, true},
+        {"anylink_sband_rx_received_packets", sharemap_type_t::u64, offsetof(packed_t, anylink_sband_rx_received_packets), 8, true},
+        {"anylink_sband_rx_received_frames", sharemap_type_t::u64, offsetof(packed_t, anylink_sband_rx_received_frames), 8, true},
+        {"anylink_sband_rx_dropped_packets", sharemap_type_t::u64, offsetof(packed_t, anylink_sband_rx_dropped_packets), 8, true},
+        {"anylink_sband_rx_dropped_frames", sharemap_type_t::u64, offsetof(packed_t, anylink_sband_rx_dropped_frames), 8, true},
+        {"anylink_sband_rx_socket_errors", sharemap_type_t::u64, offsetof(packed_t, anylink_sband_rx_socket_errors), 8, true},
+        {"anylink_sband_rx_idle_frames", sharemap_type_t::u64, offsetof(packed_t, anylink_sband_rx_idle_frames), 8, true},
+        {"anylink_heartbeats_sent", sharemap_type_t::u64, offsetof(packed_t, anylink_heartbeats_sent), 8, true},
+        {"anylink_heartbeats_received", sharemap_type_t::u64, offsetof(packed_t, anylink_heartbeats_received), 8, true},
+        {"anylink_rx_radio_bad_header", sharemap_type_t::u64, offsetof(packed_t, anylink_rx_radio_bad_header), 8, true},
+        {"anylink_rx_radio_packets_received", sharemap_type_t::u64, offsetof(packed_t, anylink_rx_radio_packets_received), 8, true},
+        {"anylink_tx_radio_packets_send_errors", sharemap_type_t::u64, offsetof(packed_t, anylink_tx_radio_packets_send_errors), 8, true},
+        {"anylink_tx_radio_packets_sent", sharemap_type_t::u64, offsetof(packed_t, anylink_tx_radio_packets_sent), 8, true},
+        {"anylink_tx_radio_packet_nodest", sharemap_type_t::u64, offsetof(packed_t, anylink_tx_radio_packet_nodest), 8, true},
+        {"anylink_tx_radio_packet_truncate", sharemap_type_t::u64, offsetof(packed_t, anylink_tx_radio_packet_truncate), 8, true},
+        {"anylink_tx_radio_packet_pad", sharemap_type_t::u64, offsetof(packed_t, anylink_tx_radio_packet_pad), 8, true},
+        {"anylink_rx_radio_no_endpoint", sharemap_type_t::u64, offsetof(packed_t, anylink_rx_radio_no_endpoint), 8, true},
+        {"anylink_rx_radio_reject_echo", sharemap_type_t::u64, offsetof(packed_t, anylink_rx_radio_reject_echo), 8, true},
+        {"anylink_total_endpoint_packets_received", sharemap_type_t::u64, offsetof(packed_t, anylink_total_endpoint_packets_received), 8, true},
+        {"anylink_total_endpoint_packets_sent", sharemap_type_t::u64, offsetof(packed_t, anylink_total_endpoint_packets_sent), 8, true},
+        {"anylink_encryption_failed", sharemap_type_t::u64, offsetof(packed_t, anylink_encryption_failed), 8, true},
+        {"anylink_decryption_failed", sharemap_type_t::u64, offsetof(packed_t, anylink_decryption_failed), 8, true},
+        {"anylink_tap_endpoint_active_tx_channel", sharemap_type_t::string, offsetof(packed_t, anylink_tap_endpoint_active_tx_channel), 64, false},
+        {"anylink_tap_endpoint_mtu", sharemap_type_t::u64, offsetof(packed_t, anylink_tap_endpoint_mtu), 8, false},
+        {"anylink_tap_endpoint_recv_bytes", sharemap_type_t::u64, offsetof(packed_t, anylink_tap_endpoint_recv_bytes), 8, true},
+        {"anylink_tap_endpoint_recv_errors", sharemap_type_t::u64, offsetof(packed_t, anylink_tap_endpoint_recv_errors), 8, true},
+        {"anylink_tap_endpoint_recv_packets", sharemap_type_t::u64, offsetof(packed_t, anylink_tap_endpoint_recv_packets), 8, true},
+        {"anylink_tap_endpoint_send_bytes", sharemap_type_t::u64, offsetof(packed_t, anylink_tap_endpoint_send_bytes), 8, true},
+        {"anylink_tap_endpoint_send_errors", sharemap_type_t::u64, offsetof(packed_t, anylink_tap_endpoint_send_errors), 8, true},
+        {"anylink_tap_endpoint_send_packets", sharemap_type_t::u64, offsetof(packed_t, anylink_tap_endpoint_send_packets), 8, true},
+    } };
+    static constexpr std::array<sharemap_alarm_t, 81> ALARMS{ {
+        {"carrier_temp_high", 80, sharemap_alarm_kind_t::above, 85.0, 80.0},
+        {"lband_temp_high", 82, sharemap_alarm_kind_t::above, 85.0, 80.0},
+        {"sband_temp_high", 98, sharemap_alarm_kind_t::above, 85.0, 80.0},
+        {"uhf_temp_high", 105, sharemap_alarm_kind_t::above, 85.0, 80.0},
+        {"xband_temp_high", 111, sharemap_alarm_kind_t::above, 85.0, 80.0},
+        {"aux_3v8_low", 69, sharemap_alarm_kind_t::below, 3.61, 3.648},
+        {"aux_3v8_high", 69, sharemap_alarm_kind_t::above, 3.99, 3.952},
+        {"carrier_28v0_low", 71, sharemap_alarm_kind_t::below, 26.6, 26.88},
+        {"carrier_28v0_high", 71, sharemap_alarm_kind_t::above, 29.4, 29.12},
+        {"carrier_2v1_low", 73, sharemap_alarm_kind_t::below, 1.995, 2.016},
+        {"carrier_2v1_high", 73, sharemap_alarm_kind_t::above, 2.205, 2.184},
+        {"carrier_2v6_low", 75, sharemap_alarm_kind_t::below, 2.47, 2.496},
+        {"carrier_2v6_high", 75, sharemap_alarm_kind_t::above, 2.73, 2.704},
+        {"carrier_3v8_low", 77, sharemap_alarm_kind_t::below, 3.61, 3.648},
+        {"carrier_3v8_high", 77, sharemap_alarm_kind_t::above, 3.99, 3.952},
+        {"carrier_5v5_low", 79, sharemap_alarm_kind_t::below, 5.225, 5.28},
+        {"carrier_5v5_high", 79, sharemap_alarm_kind_t::above, 5.775, 5.72},
+        {"som_5v0_low", 103, sharemap_alarm_kind_t::below, 4.75, 4.8},
+        {"som_5v0_high", 103, sharemap_alarm_kind_t::above, 5.25, 5.2},
+        {"xband_24v0_low", 109, sharemap_alarm_kind_t::below, 22.8, 23.04},
+        {"xband_24v0_high", 109, sharemap_alarm_kind_t::above, 25.2, 24.96},
+        {"ad9122_power_bad", 63, sharemap_alarm_kind_t::below, 0.5, 0.5},
+        {"ad9361_power_bad", 64, sharemap_alarm_kind_t::below, 0.5, 0.5},
+        {"adrf6780_power_bad", 65, sharemap_alarm_kind_t::below, 0.5, 0.5},
+        {"at86_power_bad", 66, sharemap_alarm_kind_t::below, 0.5, 0.5},
+        {"lband_rx_power_bad", 81, sharemap_alarm_kind_t::below, 0.5, 0.5},
+        {"lband_tx_power_bad", 83, sharemap_alarm_kind_t::below, 0.5, 0.5},
+        {"lmk04832_power_bad", 85, sharemap_alarm_kind_t::below, 0.5, 0.5},
+        {"lmx2594_power_bad", 87, sharemap_alarm_kind_t::below, 0.5, 0.5},
+        {"max2771_a_bias_power_bad", 90, sharemap_alarm_kind_t::below, 0.5, 0.5},
+        {"max2771_a_power_bad", 91, sharemap_alarm_kind_t::below, 0.5, 0.5},
+        {"max2771_b_bias_power_bad", 94, sharemap_alarm_kind_t::below, 0.5, 0.5},
+        {"max2771_b_power_bad", 95, sharemap_alarm_kind_t::below, 0.5, 0.5},
+        {"rf_fe_mux_power_bad", 96, sharemap_alarm_kind_t::below, 0.5, 0.5},
+        {"sband_rx_power_bad", 97, sharemap_alarm_kind_t::below, 0.5, 0.5},
+        {"sband_tx_power_bad", 99, sharemap_alarm_kind_t::below, 0.5, 0.5},
+        {"si5345_power_bad", 101, sharemap_alarm_kind_t::below, 0.5, 0.5},
+        {"uhf_rx_power_bad", 104, sharemap_alarm_kind_t::below, 0.5, 0.5},
+        {"uhf_tx_power_bad", 106, sharemap_alarm_kind_t::below, 0.5, 0.5},
+        {"xband_drain_power_bad", 110, sharemap_alarm_kind_t::below, 0.5, 0.5},
+        {"psk_cc_tx_ad9361_tx_pll_unlocked", 24, sharemap_alarm_kind_t::below, 0.5, 0.5},
+        {"psk_cc_rx_ad9361_rx_pll_unlocked", 40, sharemap_alarm_kind_t::below, 0.5, 0.5},
+        {"psk_cc_rx_ad9361_bb_pll_unlocked", 41, sharemap_alarm_kind_t::below, 0.5, 0.5},
+        {"at86_pll_unlocked", 67, sharemap_alarm_kind_t::below, 0.5, 0.5},
+        {"lmk04832_pll_unlocked", 86, sharemap_alarm_kind_t::below, 0.5, 0.5},
+        {"max2771_a_1_pll_unlocked", 88, sharemap_alarm_kind_t::below, 0.5, 0.5},
+        {"max2771_a_2_pll_unlocked", 89, sharemap_alarm_kind_t::below, 0.5, 0.5},
+        {"max2771_b_1_pll_unlocked", 92, sharemap_alarm_kind_t::below, 0.5, 0.5},
+        {"max2771_b_2_pll_unlocked", 93, sharemap_alarm_kind_t::below, 0.5, 0.5},
+        {"psk_cc_tx_underflows_increasing", 14, sharemap_alarm_kind_t::increases, 0.0, 0.0},
+        {"psk_cc_tx_client_recv_errors_increasing", 15, sharemap_alarm_kind_t::increases, 0.0, 0.0},
+        {"psk_cc_tx_failed_transmissions_increasing", 18, sharemap_alarm_kind_t::increases, 0.0, 0.0},
+        {"psk_cc_tx_dropped_packets_increasing", 19, sharemap_alarm_kind_t::increases, 0.0, 0.0},
+        {"psk_cc_tx_failed_idle_frames_transmitted_increasing", 21, sharemap_alarm_kind_t::increases, 0.0, 0.0},
+        {"psk_cc_tx_failed_bytes_in_flight_checks_increasing", 22, sharemap_alarm_kind_t::increases, 0.0, 0.0},
+        {"psk_cc_tx_modem_underflows_increasing", 23, sharemap_alarm_kind_t::increases, 0.0, 0.0},
+        {"psk_cc_rx_client_send_errors_increasing", 26, sharemap_alarm_kind_t::increases, 0.0, 0.0},
+        {"psk_cc_rx_failed_receptions_increasing", 29, sharemap_alarm_kind_t::increases, 0.0, 0.0},
+        {"psk_cc_rx_dropped_good_packets_increasing", 30, sharemap_alarm_kind_t::increases, 0.0, 0.0},
+        {"psk_cc_rx_failed_frames_available_checks_increasing", 31, sharemap_alarm_kind_t::increases, 0.0, 0.0},
+        {"psk_cc_rx_modem_dma_overflows_increasing", 33, sharemap_alarm_kind_t::increases, 0.0, 0.0},
+        {"dvbs2_tx_underflows_increasing", 43, sharemap_alarm_kind_t::increases, 0.0, 0.0},
+        {"dvbs2_tx_client_recv_errors_increasing", 44, sharemap_alarm_kind_t::increases, 0.0, 0.0},
+        {"dvbs2_tx_failed_transmissions_increasing", 47, sharemap_alarm_kind_t::increases, 0.0, 0.0},
+        {"dvbs2_tx_dropped_packets_increasing", 48, sharemap_alarm_kind_t::increases, 0.0, 0.0},
+        {"dvbs2_tx_failed_idle_frames_transmitted_increasing", 50, sharemap_alarm_kind_t::increases, 0.0, 0.0},
+        {"dvbs2_tx_failed_bytes_in_flight_checks_increasing", 51, sharemap_alarm_kind_t::increases, 0.0, 0.0},
+        {"gfsk_tx_underflows_increasing", 54, sharemap_alarm_kind_t::increases, 0.0, 0.0},
+        {"gfsk_tx_client_recv_errors_increasing", 55, sharemap_alarm_kind_t::increases, 0.0, 0.0},
+        {"gfsk_tx_failed_transmissions_increasing", 58, sharemap_alarm_kind_t::increases, 0.0, 0.0},
+        {"gfsk_tx_dropped_packets_increasing", 59, sharemap_alarm_kind_t::increases, 0.0, 0.0},
+        {"gfsk_tx_failed_idle_frames_transmitted_increasing", 61, sharemap_alarm_kind_t::increases, 0.0, 0.0},
+        {"gfsk_tx_failed_bytes_in_flight_checks_increasing", 62, sharemap_alarm_kind_t::increases, 0.0, 0.0},
+        {"anylink_sband_rx_dropped_packets_increasing", 128, sharemap_alarm_kind_t::increases, 0.0, 0.0},
+        {"anylink_sband_rx_dropped_frames_increasing", 129, sharemap_alarm_kind_t::increases, 0.0, 0.0},
+        {"anylink_sband_rx_socket_errors_increasing", 130, sharemap_alarm_kind_t::increases, 0.0, 0.0},
+        {"anylink_tx_radio_packets_send_errors_increasing", 136, sharemap_alarm_kind_t::increases, 0.0, 0.0},
+        {"anylink_encryption_failed_increasing", 145, sharemap_alarm_kind_t::increases, 0.0, 0.0},
+        {"anylink_decryption_failed_increasing", 146, sharemap_alarm_kind_t::increases, 0.0, 0.0},
+        {"anylink_tap_endpoint_recv_errors_increasing", 150, sharemap_alarm_kind_t::increases, 0.0, 0.0},
+        {"anylink_tap_endpoint_send_errors_increasing", 153, sharemap_alarm_kind_t::increases, 0.0, 0.0},
+    } };
+    static const std::array<std::string_view, 0> OPTIONS;
+    static const std::array<sharemap_rule_t, 0> RULES; // defined below, they take offsets in this struct
     
     // id of where the data comes from
     std::uint16_t source_id{};
@@ -1523,165 +2698,199 @@ struct sharemap_metrics_t
     }
 };
 
-static inline sharemap_metrics_packed_t sharemap_pack(sharemap_metrics_t &in)
+inline constexpr std::array<std::string_view, 0> sharemap_metrics_t::OPTIONS{ {
+} };
+
+inline constexpr std::array<sharemap_rule_t, 0> sharemap_metrics_t::RULES{ {
+} };
+
+// Broken rules of a metrics sharemap, bit i for RULES[i]
+using sharemap_metrics_errors_t = std::bitset<0>;
+
+// Check a metrics sharemap against the rules of its schema, none() when it is valid
+[[nodiscard]] static inline sharemap_metrics_errors_t sharemap_validate(const sharemap_metrics_t &in)
+{
+    return sharemap_validate_rules(reinterpret_cast<const std::uint8_t *>(&in), sharemap_metrics_t::RULES,
+                                   sharemap_metrics_t::OPTIONS);
+}
+
+// Pack straight into PACKED_SIZE bytes at out
+static inline void sharemap_pack_into(sharemap_metrics_t &in, std::uint8_t *out)
 {
     in.unix_timestamp_ns = time_ns_since_epoch();
+    anysignal::sharemap_pack_field(in.source_id, out + offsetof(sharemap_metrics_packed_t, source_id));
+    anysignal::sharemap_pack_field(in.schema_hash, out + offsetof(sharemap_metrics_packed_t, schema_hash));
+    anysignal::sharemap_pack_field(in.unix_timestamp_ns, out + offsetof(sharemap_metrics_packed_t, unix_timestamp_ns));
+    anysignal::sharemap_pack_field(in.controld_version, out + offsetof(sharemap_metrics_packed_t, controld_version));
+    anysignal::sharemap_pack_field(in.controld_timestamp, out + offsetof(sharemap_metrics_packed_t, controld_timestamp));
+    anysignal::sharemap_pack_field(in.powerd_version, out + offsetof(sharemap_metrics_packed_t, powerd_version));
+    anysignal::sharemap_pack_field(in.powerd_timestamp, out + offsetof(sharemap_metrics_packed_t, powerd_timestamp));
+    anysignal::sharemap_pack_field(in.radiod_version, out + offsetof(sharemap_metrics_packed_t, radiod_version));
+    anysignal::sharemap_pack_field(in.radiod_timestamp, out + offsetof(sharemap_metrics_packed_t, radiod_timestamp));
+    anysignal::sharemap_pack_field(in.fpga_version, out + offsetof(sharemap_metrics_packed_t, fpga_version));
+    anysignal::sharemap_pack_field(in.fpga_timestamp, out + offsetof(sharemap_metrics_packed_t, fpga_timestamp));
+    anysignal::sharemap_pack_field(in.fpga_project_name, out + offsetof(sharemap_metrics_packed_t, fpga_project_name));
+    anysignal::sharemap_pack_field(in.anylink_version, out + offsetof(sharemap_metrics_packed_t, anylink_version));
+    anysignal::sharemap_pack_field(in.psk_cc_tx_bytes_total, out + offsetof(sharemap_metrics_packed_t, psk_cc_tx_bytes_total));
+    anysignal::sharemap_pack_field(in.psk_cc_tx_underflows, out + offsetof(sharemap_metrics_packed_t, psk_cc_tx_underflows));
+    anysignal::sharemap_pack_field(in.psk_cc_tx_client_recv_errors, out + offsetof(sharemap_metrics_packed_t, psk_cc_tx_client_recv_errors));
+    anysignal::sharemap_pack_field(in.psk_cc_tx_client_msgs, out + offsetof(sharemap_metrics_packed_t, psk_cc_tx_client_msgs));
+    anysignal::sharemap_pack_field(in.psk_cc_tx_frames_transmitted, out + offsetof(sharemap_metrics_packed_t, psk_cc_tx_frames_transmitted));
+    anysignal::sharemap_pack_field(in.psk_cc_tx_failed_transmissions, out + offsetof(sharemap_metrics_packed_t, psk_cc_tx_failed_transmissions));
+    anysignal::sharemap_pack_field(in.psk_cc_tx_dropped_packets, out + offsetof(sharemap_metrics_packed_t, psk_cc_tx_dropped_packets));
+    anysignal::sharemap_pack_field(in.psk_cc_tx_idle_frames_transmitted, out + offsetof(sharemap_metrics_packed_t, psk_cc_tx_idle_frames_transmitted));
+    anysignal::sharemap_pack_field(in.psk_cc_tx_failed_idle_frames_transmitted, out + offsetof(sharemap_metrics_packed_t, psk_cc_tx_failed_idle_frames_transmitted));
+    anysignal::sharemap_pack_field(in.psk_cc_tx_failed_bytes_in_flight_checks, out + offsetof(sharemap_metrics_packed_t, psk_cc_tx_failed_bytes_in_flight_checks));
+    anysignal::sharemap_pack_field(in.psk_cc_tx_modem_underflows, out + offsetof(sharemap_metrics_packed_t, psk_cc_tx_modem_underflows));
+    anysignal::sharemap_pack_field(in.psk_cc_tx_ad9361_tx_pll_lock, out + offsetof(sharemap_metrics_packed_t, psk_cc_tx_ad9361_tx_pll_lock));
+    anysignal::sharemap_pack_field(in.psk_cc_rx_bytes_total, out + offsetof(sharemap_metrics_packed_t, psk_cc_rx_bytes_total));
+    anysignal::sharemap_pack_field(in.psk_cc_rx_client_send_errors, out + offsetof(sharemap_metrics_packed_t, psk_cc_rx_client_send_errors));
+    anysignal::sharemap_pack_field(in.psk_cc_rx_client_msgs, out + offsetof(sharemap_metrics_packed_t, psk_cc_rx_client_msgs));
+    anysignal::sharemap_pack_field(in.psk_cc_rx_frames_received, out + offsetof(sharemap_metrics_packed_t, psk_cc_rx_frames_received));
+    anysignal::sharemap_pack_field(in.psk_cc_rx_failed_receptions, out + offsetof(sharemap_metrics_packed_t, psk_cc_rx_failed_receptions));
+    anysignal::sharemap_pack_field(in.psk_cc_rx_dropped_good_packets, out + offsetof(sharemap_metrics_packed_t, psk_cc_rx_dropped_good_packets));
+    anysignal::sharemap_pack_field(in.psk_cc_rx_failed_frames_available_checks, out + offsetof(sharemap_metrics_packed_t, psk_cc_rx_failed_frames_available_checks));
+    anysignal::sharemap_pack_field(in.psk_cc_rx_encountered_frames_in_progress, out + offsetof(sharemap_metrics_packed_t, psk_cc_rx_encountered_frames_in_progress));
+    anysignal::sharemap_pack_field(in.psk_cc_rx_modem_dma_overflows, out + offsetof(sharemap_metrics_packed_t, psk_cc_rx_modem_dma_overflows));
+    anysignal::sharemap_pack_field(in.psk_cc_rx_modem_dma_packet_count, out + offsetof(sharemap_metrics_packed_t, psk_cc_rx_modem_dma_packet_count));
+    anysignal::sharemap_pack_field(in.psk_cc_rx_signal_present, out + offsetof(sharemap_metrics_packed_t, psk_cc_rx_signal_present));
+    anysignal::sharemap_pack_field(in.psk_cc_rx_carrier_lock, out + offsetof(sharemap_metrics_packed_t, psk_cc_rx_carrier_lock));
+    anysignal::sharemap_pack_field(in.psk_cc_rx_frame_sync_lock, out + offsetof(sharemap_metrics_packed_t, psk_cc_rx_frame_sync_lock));
+    anysignal::sharemap_pack_field(in.psk_cc_rx_fec_confirmed_lock, out + offsetof(sharemap_metrics_packed_t, psk_cc_rx_fec_confirmed_lock));
+    anysignal::sharemap_pack_field(in.psk_cc_rx_fec_ber, out + offsetof(sharemap_metrics_packed_t, psk_cc_rx_fec_ber));
+    anysignal::sharemap_pack_field(in.psk_cc_rx_ad9361_rx_pll_lock, out + offsetof(sharemap_metrics_packed_t, psk_cc_rx_ad9361_rx_pll_lock));
+    anysignal::sharemap_pack_field(in.psk_cc_rx_ad9361_bb_pll_lock, out + offsetof(sharemap_metrics_packed_t, psk_cc_rx_ad9361_bb_pll_lock));
+    anysignal::sharemap_pack_field(in.dvbs2_tx_bytes_total, out + offsetof(sharemap_metrics_packed_t, dvbs2_tx_bytes_total));
+    anysignal::sharemap_pack_field(in.dvbs2_tx_underflows, out + offsetof(sharemap_metrics_packed_t, dvbs2_tx_underflows));
+    anysignal::sharemap_pack_field(in.dvbs2_tx_client_recv_errors, out + offsetof(sharemap_metrics_packed_t, dvbs2_tx_client_recv_errors));
+    anysignal::sharemap_pack_field(in.dvbs2_tx_client_msgs, out + offsetof(sharemap_metrics_packed_t, dvbs2_tx_client_msgs));
+    anysignal::sharemap_pack_field(in.dvbs2_tx_frames_transmitted, out + offsetof(sharemap_metrics_packed_t, dvbs2_tx_frames_transmitted));
+    anysignal::sharemap_pack_field(in.dvbs2_tx_failed_transmissions, out + offsetof(sharemap_metrics_packed_t, dvbs2_tx_failed_transmissions));
+    anysignal::sharemap_pack_field(in.dvbs2_tx_dropped_packets, out + offsetof(sharemap_metrics_packed_t, dvbs2_tx_dropped_packets));
+    anysignal::sharemap_pack_field(in.dvbs2_tx_idle_frames_transmitted, out + offsetof(sharemap_metrics_packed_t, dvbs2_tx_idle_frames_transmitted));
+    anysignal::sharemap_pack_field(in.dvbs2_tx_failed_idle_frames_transmitted, out + offsetof(sharemap_metrics_packed_t, dvbs2_tx_failed_idle_frames_transmitted));
+    anysignal::sharemap_pack_field(in.dvbs2_tx_failed_bytes_in_flight_checks, out + offsetof(sharemap_metrics_packed_t, dvbs2_tx_failed_bytes_in_flight_checks));
+    anysignal::sharemap_pack_field(in.dvbs2_tx_dummy_pl_frames, out + offsetof(sharemap_metrics_packed_t, dvbs2_tx_dummy_pl_frames));
+    anysignal::sharemap_pack_field(in.gfsk_tx_bytes_total, out + offsetof(sharemap_metrics_packed_t, gfsk_tx_bytes_total));
+    anysignal::sharemap_pack_field(in.gfsk_tx_underflows, out + offsetof(sharemap_metrics_packed_t, gfsk_tx_underflows));
+    anysignal::sharemap_pack_field(in.gfsk_tx_client_recv_errors, out + offsetof(sharemap_metrics_packed_t, gfsk_tx_client_recv_errors));
+    anysignal::sharemap_pack_field(in.gfsk_tx_client_msgs, out + offsetof(sharemap_metrics_packed_t, gfsk_tx_client_msgs));
+    anysignal::sharemap_pack_field(in.gfsk_tx_frames_transmitted, out + offsetof(sharemap_metrics_packed_t, gfsk_tx_frames_transmitted));
+    anysignal::sharemap_pack_field(in.gfsk_tx_failed_transmissions, out + offsetof(sharemap_metrics_packed_t, gfsk_tx_failed_transmissions));
+    anysignal::sharemap_pack_field(in.gfsk_tx_dropped_packets, out + offsetof(sharemap_metrics_packed_t, gfsk_tx_dropped_packets));
+    anysignal::sharemap_pack_field(in.gfsk_tx_idle_frames_transmitted, out + offsetof(sharemap_metrics_packed_t, gfsk_tx_idle_frames_transmitted));
+    anysignal::sharemap_pack_field(in.gfsk_tx_failed_idle_frames_transmitted, out + offsetof(sharemap_metrics_packed_t, gfsk_tx_failed_idle_frames_transmitted));
+    anysignal::sharemap_pack_field(in.gfsk_tx_failed_bytes_in_flight_checks, out + offsetof(sharemap_metrics_packed_t, gfsk_tx_failed_bytes_in_flight_checks));
+    anysignal::sharemap_pack_field(in.ad9122_pgood, out + offsetof(sharemap_metrics_packed_t, ad9122_pgood));
+    anysignal::sharemap_pack_field(in.ad9361_pgood, out + offsetof(sharemap_metrics_packed_t, ad9361_pgood));
+    anysignal::sharemap_pack_field(in.adrf6780_pgood, out + offsetof(sharemap_metrics_packed_t, adrf6780_pgood));
+    anysignal::sharemap_pack_field(in.at86_pgood, out + offsetof(sharemap_metrics_packed_t, at86_pgood));
+    anysignal::sharemap_pack_field(in.at86_is_pll_locked, out + offsetof(sharemap_metrics_packed_t, at86_is_pll_locked));
+    anysignal::sharemap_pack_field(in.aux_3v8_isense, out + offsetof(sharemap_metrics_packed_t, aux_3v8_isense));
+    anysignal::sharemap_pack_field(in.aux_3v8_vsense, out + offsetof(sharemap_metrics_packed_t, aux_3v8_vsense));
+    anysignal::sharemap_pack_field(in.carrier_28v0_isense, out + offsetof(sharemap_metrics_packed_t, carrier_28v0_isense));
+    anysignal::sharemap_pack_field(in.carrier_28v0_vsense, out + offsetof(sharemap_metrics_packed_t, carrier_28v0_vsense));
+    anysignal::sharemap_pack_field(in.carrier_2v1_isense, out + offsetof(sharemap_metrics_packed_t, carrier_2v1_isense));
+    anysignal::sharemap_pack_field(in.carrier_2v1_vsense, out + offsetof(sharemap_metrics_packed_t, carrier_2v1_vsense));
+    anysignal::sharemap_pack_field(in.carrier_2v6_isense, out + offsetof(sharemap_metrics_packed_t, carrier_2v6_isense));
+    anysignal::sharemap_pack_field(in.carrier_2v6_vsense, out + offsetof(sharemap_metrics_packed_t, carrier_2v6_vsense));
+    anysignal::sharemap_pack_field(in.carrier_3v8_isense, out + offsetof(sharemap_metrics_packed_t, carrier_3v8_isense));
+    anysignal::sharemap_pack_field(in.carrier_3v8_vsense, out + offsetof(sharemap_metrics_packed_t, carrier_3v8_vsense));
+    anysignal::sharemap_pack_field(in.carrier_5v5_isense, out + offsetof(sharemap_metrics_packed_t, carrier_5v5_isense));
+    anysignal::sharemap_pack_field(in.carrier_5v5_vsense, out + offsetof(sharemap_metrics_packed_t, carrier_5v5_vsense));
+    anysignal::sharemap_pack_field(in.carrier_temp, out + offsetof(sharemap_metrics_packed_t, carrier_temp));
+    anysignal::sharemap_pack_field(in.lband_rx_pgood, out + offsetof(sharemap_metrics_packed_t, lband_rx_pgood));
+    anysignal::sharemap_pack_field(in.lband_temp, out + offsetof(sharemap_metrics_packed_t, lband_temp));
+    anysignal::sharemap_pack_field(in.lband_tx_pgood, out + offsetof(sharemap_metrics_packed_t, lband_tx_pgood));
+    anysignal::sharemap_pack_field(in.lband_tx_rf_detect, out + offsetof(sharemap_metrics_packed_t, lband_tx_rf_detect));
+    anysignal::sharemap_pack_field(in.lmk04832_pgood, out + offsetof(sharemap_metrics_packed_t, lmk04832_pgood));
+    anysignal::sharemap_pack_field(in.lmk04832_is_pll_locked, out + offsetof(sharemap_metrics_packed_t, lmk04832_is_pll_locked));
+    anysignal::sharemap_pack_field(in.lmx2594_pgood, out + offsetof(sharemap_metrics_packed_t, lmx2594_pgood));
+    anysignal::sharemap_pack_field(in.max2771_a_1_is_pll_locked, out + offsetof(sharemap_metrics_packed_t, max2771_a_1_is_pll_locked));
+    anysignal::sharemap_pack_field(in.max2771_a_2_is_pll_locked, out + offsetof(sharemap_metrics_packed_t, max2771_a_2_is_pll_locked));
+    anysignal::sharemap_pack_field(in.max2771_a_bias_pgood, out + offsetof(sharemap_metrics_packed_t, max2771_a_bias_pgood));
+    anysignal::sharemap_pack_field(in.max2771_a_pgood, out + offsetof(sharemap_metrics_packed_t, max2771_a_pgood));
+    anysignal::sharemap_pack_field(in.max2771_b_1_is_pll_locked, out + offsetof(sharemap_metrics_packed_t, max2771_b_1_is_pll_locked));
+    anysignal::sharemap_pack_field(in.max2771_b_2_is_pll_locked, out + offsetof(sharemap_metrics_packed_t, max2771_b_2_is_pll_locked));
+    anysignal::sharemap_pack_field(in.max2771_b_bias_pgood, out + offsetof(sharemap_metrics_packed_t, max2771_b_bias_pgood));
+    anysignal::sharemap_pack_field(in.max2771_b_pgood, out + offsetof(sharemap_metrics_packed_t, max2771_b_pgood));
+    anysignal::sharemap_pack_field(in.rf_fe_mux_pgood, out + offsetof(sharemap_metrics_packed_t, rf_fe_mux_pgood));
+    anysignal::sharemap_pack_field(in.sband_rx_pgood, out + offsetof(sharemap_metrics_packed_t, sband_rx_pgood));
+    anysignal::sharemap_pack_field(in.sband_temp, out + offsetof(sharemap_metrics_packed_t, sband_temp));
+    anysignal::sharemap_pack_field(in.sband_tx_pgood, out + offsetof(sharemap_metrics_packed_t, sband_tx_pgood));
+    anysignal::sharemap_pack_field(in.sband_tx_rf_detect, out + offsetof(sharemap_metrics_packed_t, sband_tx_rf_detect));
+    anysignal::sharemap_pack_field(in.si5345_pgood, out + offsetof(sharemap_metrics_packed_t, si5345_pgood));
+    anysignal::sharemap_pack_field(in.som_5v0_isense, out + offsetof(sharemap_metrics_packed_t, som_5v0_isense));
+    anysignal::sharemap_pack_field(in.som_5v0_vsense, out + offsetof(sharemap_metrics_packed_t, som_5v0_vsense));
+    anysignal::sharemap_pack_field(in.uhf_rx_pgood, out + offsetof(sharemap_metrics_packed_t, uhf_rx_pgood));
+    anysignal::sharemap_pack_field(in.uhf_temp, out + offsetof(sharemap_metrics_packed_t, uhf_temp));
+    anysignal::sharemap_pack_field(in.uhf_tx_pgood, out + offsetof(sharemap_metrics_packed_t, uhf_tx_pgood));
+    anysignal::sharemap_pack_field(in.uhf_tx_rf_detect, out + offsetof(sharemap_metrics_packed_t, uhf_tx_rf_detect));
+    anysignal::sharemap_pack_field(in.xband_24v0_isense, out + offsetof(sharemap_metrics_packed_t, xband_24v0_isense));
+    anysignal::sharemap_pack_field(in.xband_24v0_vsense, out + offsetof(sharemap_metrics_packed_t, xband_24v0_vsense));
+    anysignal::sharemap_pack_field(in.xband_drain_pgood, out + offsetof(sharemap_metrics_packed_t, xband_drain_pgood));
+    anysignal::sharemap_pack_field(in.xband_temp, out + offsetof(sharemap_metrics_packed_t, xband_temp));
+    anysignal::sharemap_pack_field(in.xband_tx_rf_detect, out + offsetof(sharemap_metrics_packed_t, xband_tx_rf_detect));
+    anysignal::sharemap_pack_field(in.anylink_uhf_tx_sent_bytes, out + offsetof(sharemap_metrics_packed_t, anylink_uhf_tx_sent_bytes));
+    anysignal::sharemap_pack_field(in.anylink_uhf_tx_sent_packets, out + offsetof(sharemap_metrics_packed_t, anylink_uhf_tx_sent_packets));
+    anysignal::sharemap_pack_field(in.anylink_uhf_tx_sent_frames, out + offsetof(sharemap_metrics_packed_t, anylink_uhf_tx_sent_frames));
+    anysignal::sharemap_pack_field(in.anylink_uhf_tx_overflow_frames, out + offsetof(sharemap_metrics_packed_t, anylink_uhf_tx_overflow_frames));
+    anysignal::sharemap_pack_field(in.anylink_sband_tx_sent_bytes, out + offsetof(sharemap_metrics_packed_t, anylink_sband_tx_sent_bytes));
+    anysignal::sharemap_pack_field(in.anylink_sband_tx_sent_packets, out + offsetof(sharemap_metrics_packed_t, anylink_sband_tx_sent_packets));
+    anysignal::sharemap_pack_field(in.anylink_sband_tx_sent_frames, out + offsetof(sharemap_metrics_packed_t, anylink_sband_tx_sent_frames));
+    anysignal::sharemap_pack_field(in.anylink_sband_tx_overflow_frames, out + offsetof(sharemap_metrics_packed_t, anylink_sband_tx_overflow_frames));
+    anysignal::sharemap_pack_field(in.anylink_xband_tx_sent_bytes, out + offsetof(sharemap_metrics_packed_t, anylink_xband_tx_sent_bytes));
+    anysignal::sharemap_pack_field(in.anylink_xband_tx_sent_packets, out + offsetof(sharemap_metrics_packed_t, anylink_xband_tx_sent_packets));
+    anysignal::sharemap_pack_field(in.anylink_xband_tx_sent_frames, out + offsetof(sharemap_metrics_packed_t, anylink_xband_tx_sent_frames));
+    anysignal::sharemap_pack_field(in.anylink_xband_tx_overflow_frames, out + offsetof(sharemap_metrics_packed_t, anylink_xband_tx_overflow_frames));
+    anysignal::sharemap_pack_field(in.anylink_sband_rx_received_bytes, out + offsetof(sharemap_metrics_packed_t, anylink_sband_rx_received_bytes));
+    anysignal::sharemap_pack_field(in.anylink_sband_rx_received_packets, out + offsetof(sharemap_metrics_packed_t, anylink_sband_rx_received_packets));
+    anysignal::sharemap_pack_field(in.anylink_sband_rx_received_frames, out + offsetof(sharemap_metrics_packed_t, anylink_sband_rx_received_frames));
+    anysignal::sharemap_pack_field(in.anylink_sband_rx_dropped_packets, out + offsetof(sharemap_metrics_packed_t, anylink_sband_rx_dropped_packets));
+    anysignal::sharemap_pack_field(in.anylink_sband_rx_dropped_frames, out + offsetof(sharemap_metrics_packed_t, anylink_sband_rx_dropped_frames));
+    anysignal::sharemap_pack_field(in.anylink_sband_rx_socket_errors, out + offsetof(sharemap_metrics_packed_t, anylink_sband_rx_socket_errors));
+    anysignal::sharemap_pack_field(in.anylink_sband_rx_idle_frames, out + offsetof(sharemap_metrics_packed_t, anylink_sband_rx_idle_frames));
+    anysignal::sharemap_pack_field(in.anylink_heartbeats_sent, out + offsetof(sharemap_metrics_packed_t, anylink_heartbeats_sent));
+    anysignal::sharemap_pack_field(in.anylink_heartbeats_received, out + offsetof(sharemap_metrics_packed_t, anylink_heartbeats_received));
+    anysignal::sharemap_pack_field(in.anylink_rx_radio_bad_header, out + offsetof(sharemap_metrics_packed_t, anylink_rx_radio_bad_header));
+    anysignal::sharemap_pack_field(in.anylink_rx_radio_packets_received, out + offsetof(sharemap_metrics_packed_t, anylink_rx_radio_packets_received));
+    anysignal::sharemap_pack_field(in.anylink_tx_radio_packets_send_errors, out + offsetof(sharemap_metrics_packed_t, anylink_tx_radio_packets_send_errors));
+    anysignal::sharemap_pack_field(in.anylink_tx_radio_packets_sent, out + offsetof(sharemap_metrics_packed_t, anylink_tx_radio_packets_sent));
+    anysignal::sharemap_pack_field(in.anylink_tx_radio_packet_nodest, out + offsetof(sharemap_metrics_packed_t, anylink_tx_radio_packet_nodest));
+    anysignal::sharemap_pack_field(in.anylink_tx_radio_packet_truncate, out + offsetof(sharemap_metrics_packed_t, anylink_tx_radio_packet_truncate));
+    anysignal::sharemap_pack_field(in.anylink_tx_radio_packet_pad, out + offsetof(sharemap_metrics_packed_t, anylink_tx_radio_packet_pad));
+    anysignal::sharemap_pack_field(in.anylink_rx_radio_no_endpoint, out + offsetof(sharemap_metrics_packed_t, anylink_rx_radio_no_endpoint));
+    anysignal::sharemap_pack_field(in.anylink_rx_radio_reject_echo, out + offsetof(sharemap_metrics_packed_t, anylink_rx_radio_reject_echo));
+    anysignal::sharemap_pack_field(in.anylink_total_endpoint_packets_received, out + offsetof(sharemap_metrics_packed_t, anylink_total_endpoint_packets_received));
+    anysignal::sharemap_pack_field(in.anylink_total_endpoint_packets_sent, out + offsetof(sharemap_metrics_packed_t, anylink_total_endpoint_packets_sent));
+    anysignal::sharemap_pack_field(in.anylink_encryption_failed, out + offsetof(sharemap_metrics_packed_t, anylink_encryption_failed));
+    anysignal::sharemap_pack_field(in.anylink_decryption_failed, out + offsetof(sharemap_metrics_packed_t, anylink_decryption_failed));
+    anysignal::sharemap_pack_field(in.anylink_tap_endpoint_active_tx_channel, out + offsetof(sharemap_metrics_packed_t, anylink_tap_endpoint_active_tx_channel));
+    anysignal::sharemap_pack_field(in.anylink_tap_endpoint_mtu, out + offsetof(sharemap_metrics_packed_t, anylink_tap_endpoint_mtu));
+    anysignal::sharemap_pack_field(in.anylink_tap_endpoint_recv_bytes, out + offsetof(sharemap_metrics_packed_t, anylink_tap_endpoint_recv_bytes));
+    anysignal::sharemap_pack_field(in.anylink_tap_endpoint_recv_errors, out + offsetof(sharemap_metrics_packed_t, anylink_tap_endpoint_recv_errors));
+    anysignal::sharemap_pack_field(in.anylink_tap_endpoint_recv_packets, out + offsetof(sharemap_metrics_packed_t, anylink_tap_endpoint_recv_packets));
+    anysignal::sharemap_pack_field(in.anylink_tap_endpoint_send_bytes, out + offsetof(sharemap_metrics_packed_t, anylink_tap_endpoint_send_bytes));
+    anysignal::sharemap_pack_field(in.anylink_tap_endpoint_send_errors, out + offsetof(sharemap_metrics_packed_t, anylink_tap_endpoint_send_errors));
+    anysignal::sharemap_pack_field(in.anylink_tap_endpoint_send_packets, out + offsetof(sharemap_metrics_packed_t, anylink_tap_endpoint_send_packets));
+}
+
+// Pack into caller storage, e.g. part of a send buffer or iovec.
+// Returns the bytes written, 0 if out is smaller than PACKED_SIZE.
+static inline std::size_t sharemap_pack(sharemap_metrics_t &in, std::span<std::uint8_t> out)
+{
+    if (out.size() < sharemap_metrics_t::PACKED_SIZE)
+    {
+        return 0;
+    }
+    sharemap_pack_into(in, out.data());
+    return sharemap_metrics_t::PACKED_SIZE;
+}
+
+static inline sharemap_metrics_packed_t sharemap_pack(sharemap_metrics_t &in)
+{
     sharemap_metrics_packed_t out{};
-    anysignal_sharemap_pack_field(in, out, source_id);
-    anysignal_sharemap_pack_field(in, out, schema_hash);
-    anysignal_sharemap_pack_field(in, out, unix_timestamp_ns);
-    anysignal_sharemap_pack_field(in, out, controld_version);
-    anysignal_sharemap_pack_field(in, out, controld_timestamp);
-    anysignal_sharemap_pack_field(in, out, powerd_version);
-    anysignal_sharemap_pack_field(in, out, powerd_timestamp);
-    anysignal_sharemap_pack_field(in, out, radiod_version);
-    anysignal_sharemap_pack_field(in, out, radiod_timestamp);
-    anysignal_sharemap_pack_field(in, out, fpga_version);
-    anysignal_sharemap_pack_field(in, out, fpga_timestamp);
-    anysignal_sharemap_pack_field(in, out, fpga_project_name);
-    anysignal_sharemap_pack_field(in, out, anylink_version);
-    anysignal_sharemap_pack_field(in, out, psk_cc_tx_bytes_total);
-    anysignal_sharemap_pack_field(in, out, psk_cc_tx_underflows);
-    anysignal_sharemap_pack_field(in, out, psk_cc_tx_client_recv_errors);
-    anysignal_sharemap_pack_field(in, out, psk_cc_tx_client_msgs);
-    anysignal_sharemap_pack_field(in, out, psk_cc_tx_frames_transmitted);
-    anysignal_sharemap_pack_field(in, out, psk_cc_tx_failed_transmissions);
-    anysignal_sharemap_pack_field(in, out, psk_cc_tx_dropped_packets);
-    anysignal_sharemap_pack_field(in, out, psk_cc_tx_idle_frames_transmitted);
-    anysignal_sharemap_pack_field(in, out, psk_cc_tx_failed_idle_frames_transmitted);
-    anysignal_sharemap_pack_field(in, out, psk_cc_tx_failed_bytes_in_flight_checks);
-    anysignal_sharemap_pack_field(in, out, psk_cc_tx_modem_underflows);
-    anysignal_sharemap_pack_field(in, out, psk_cc_tx_ad9361_tx_pll_lock);
-    anysignal_sharemap_pack_field(in, out, psk_cc_rx_bytes_total);
-    anysignal_sharemap_pack_field(in, out, psk_cc_rx_client_send_errors);
-    anysignal_sharemap_pack_field(in, out, psk_cc_rx_client_msgs);
-    anysignal_sharemap_pack_field(in, out, psk_cc_rx_frames_received);
-    anysignal_sharemap_pack_field(in, out, psk_cc_rx_failed_receptions);
-    anysignal_sharemap_pack_field(in, out, psk_cc_rx_dropped_good_packets);
-    anysignal_sharemap_pack_field(in, out, psk_cc_rx_failed_frames_available_checks);
-    anysignal_sharemap_pack_field(in, out, psk_cc_rx_encountered_frames_in_progress);
-    anysignal_sharemap_pack_field(in, out, psk_cc_rx_modem_dma_overflows);
-    anysignal_sharemap_pack_field(in, out, psk_cc_rx_modem_dma_packet_count);
-    anysignal_sharemap_pack_field(in, out, psk_cc_rx_signal_present);
-    anysignal_sharemap_pack_field(in, out, psk_cc_rx_carrier_lock);
-    anysignal_sharemap_pack_field(in, out, psk_cc_rx_frame_sync_lock);
-    anysignal_sharemap_pack_field(in, out, psk_cc_rx_fec_confirmed_lock);
-    anysignal_sharemap_pack_field(in, out, psk_cc_rx_fec_ber);
-    anysignal_sharemap_pack_field(in, out, psk_cc_rx_ad9361_rx_pll_lock);
-    anysignal_sharemap_pack_field(in, out, psk_cc_rx_ad9361_bb_pll_lock);
-    anysignal_sharemap_pack_field(in, out, dvbs2_tx_bytes_total);
-    anysignal_sharemap_pack_field(in, out, dvbs2_tx_underflows);
-    anysignal_sharemap_pack_field(in, out, dvbs2_tx_client_recv_errors);
-    anysignal_sharemap_pack_field(in, out, dvbs2_tx_client_msgs);
-    anysignal_sharemap_pack_field(in, out, dvbs2_tx_frames_transmitted);
-    anysignal_sharemap_pack_field(in, out, dvbs2_tx_failed_transmissions);
-    anysignal_sharemap_pack_field(in, out, dvbs2_tx_dropped_packets);
-    anysignal_sharemap_pack_field(in, out, dvbs2_tx_idle_frames_transmitted);
-    anysignal_sharemap_pack_field(in, out, dvbs2_tx_failed_idle_frames_transmitted);
-    anysignal_sharemap_pack_field(in, out, dvbs2_tx_failed_bytes_in_flight_checks);
-    anysignal_sharemap_pack_field(in, out, dvbs2_tx_dummy_pl_frames);
-    anysignal_sharemap_pack_field(in, out, gfsk_tx_bytes_total);
-    anysignal_sharemap_pack_field(in, out, gfsk_tx_underflows);
-    anysignal_sharemap_pack_field(in, out, gfsk_tx_client_recv_errors);
-    anysignal_sharemap_pack_field(in, out, gfsk_tx_client_msgs);
-    anysignal_sharemap_pack_field(in, out, gfsk_tx_frames_transmitted);
-    anysignal_sharemap_pack_field(in, out, gfsk_tx_failed_transmissions);
-    anysignal_sharemap_pack_field(in, out, gfsk_tx_dropped_packets);
-    anysignal_sharemap_pack_field(in, out, gfsk_tx_idle_frames_transmitted);
-    anysignal_sharemap_pack_field(in, out, gfsk_tx_failed_idle_frames_transmitted);
-    anysignal_sharemap_pack_field(in, out, gfsk_tx_failed_bytes_in_flight_checks);
-    anysignal_sharemap_pack_field(in, out, ad9122_pgood);
-    anysignal_sharemap_pack_field(in, out, ad9361_pgood);
-    anysignal_sharemap_pack_field(in, out, adrf6780_pgood);
-    anysignal_sharemap_pack_field(in, out, at86_pgood);
-    anysignal_sharemap_pack_field(in, out, at86_is_pll_locked);
-    anysignal_sharemap_pack_field(in, out, aux_3v8_isense);
-    anysignal_sharemap_pack_field(in, out, aux_3v8_vsense);
-    anysignal_sharemap_pack_field(in, out, carrier_28v0_isense);
-    anysignal_sharemap_pack_field(in, out, carrier_28v0_vsense);
-    anysignal_sharemap_pack_field(in, out, carrier_2v1_isense);
-    anysignal_sharemap_pack_field(in, out, carrier_2v1_vsense);
-    anysignal_sharemap_pack_field(in, out, carrier_2v6_isense);
-    anysignal_sharemap_pack_field(in, out, carrier_2v6_vsense);
-    anysignal_sharemap_pack_field(in, out, carrier_3v8_isense);
-    anysignal_sharemap_pack_field(in, out, carrier_3v8_vsense);
-    anysignal_sharemap_pack_field(in, out, carrier_5v5_isense);
-    anysignal_sharemap_pack_field(in, out, carrier_5v5_vsense);
-    anysignal_sharemap_pack_field(in, out, carrier_temp);
-    anysignal_sharemap_pack_field(in, out, lband_rx_pgood);
-    anysignal_sharemap_pack_field(in, out, lband_temp);
-    anysignal_sharemap_pack_field(in, out, lband_tx_pgood);
-    anysignal_sharemap_pack_field(in, out, lband_tx_rf_detect);
-    anysignal_sharemap_pack_field(in, out, lmk04832_pgood);
-    anysignal_sharemap_pack_field(in, out, lmk04832_is_pll_locked);
-    anysignal_sharemap_pack_field(in, out, lmx2594_pgood);
-    anysignal_sharemap_pack_field(in, out, max2771_a_1_is_pll_locked);
-    anysignal_sharemap_pack_field(in, out, max2771_a_2_is_pll_locked);
-    anysignal_sharemap_pack_field(in, out, max2771_a_bias_pgood);
-    anysignal_sharemap_pack_field(in, out, max2771_a_pgood);
-    anysignal_sharemap_pack_field(in, out, max2771_b_1_is_pll_locked);
-    anysignal_sharemap_pack_field(in, out, max2771_b_2_is_pll_locked);
-    anysignal_sharemap_pack_field(in, out, max2771_b_bias_pgood);
-    anysignal_sharemap_pack_field(in, out, max2771_b_pgood);
-    anysignal_sharemap_pack_field(in, out, rf_fe_mux_pgood);
-    anysignal_sharemap_pack_field(in, out, sband_rx_pgood);
-    anysignal_sharemap_pack_field(in, out, sband_temp);
-    anysignal_sharemap_pack_field(in, out, sband_tx_pgood);
-    anysignal_sharemap_pack_field(in, out, sband_tx_rf_detect);
-    anysignal_sharemap_pack_field(in, out, si5345_pgood);
-    anysignal_sharemap_pack_field(in, out, som_5v0_isense);
-    anysignal_sharemap_pack_field(in, out, som_5v0_vsense);
-    anysignal_sharemap_pack_field(in, out, uhf_rx_pgood);
-    anysignal_sharemap_pack_field(in, out, uhf_temp);
-    anysignal_sharemap_pack_field(in, out, uhf_tx_pgood);
-    anysignal_sharemap_pack_field(in, out, uhf_tx_rf_detect);
-    anysignal_sharemap_pack_field(in, out, xband_24v0_isense);
-    anysignal_sharemap_pack_field(in, out, xband_24v0_vsense);
-    anysignal_sharemap_pack_field(in, out, xband_drain_pgood);
-    anysignal_sharemap_pack_field(in, out, xband_temp);
-    anysignal_sharemap_pack_field(in, out, xband_tx_rf_detect);
-    anysignal_sharemap_pack_field(in, out, anylink_uhf_tx_sent_bytes);
-    anysignal_sharemap_pack_field(in, out, anylink_uhf_tx_sent_packets);
-    anysignal_sharemap_pack_field(in, out, anylink_uhf_tx_sent_frames);
-    anysignal_sharemap_pack_field(in, out, anylink_uhf_tx_overflow_frames);
-    anysignal_sharemap_pack_field(in, out, anylink_sband_tx_sent_bytes);
-    anysignal_sharemap_pack_field(in, out, anylink_sband_tx_sent_packets);
-    anysignal_sharemap_pack_field(in, out, anylink_sband_tx_sent_frames);
-    anysignal_sharemap_pack_field(in, out, anylink_sband_tx_overflow_frames);
-    anysignal_sharemap_pack_field(in, out, anylink_xband_tx_sent_bytes);
-    anysignal_sharemap_pack_field(in, out, anylink_xband_tx_sent_packets);
-    anysignal_sharemap_pack_field(in, out, anylink_xband_tx_sent_frames);
-    anysignal_sharemap_pack_field(in, out, anylink_xband_tx_overflow_frames);
-    anysignal_sharemap_pack_field(in, out, anylink_sband_rx_received_bytes);
-    anysignal_sharemap_pack_field(in, out, anylink_sband_rx_received_packets);
-    anysignal_sharemap_pack_field(in, out, anylink_sband_rx_received_frames);
-    anysignal_sharemap_pack_field(in, out, anylink_sband_rx_dropped_packets);
-    anysignal_sharemap_pack_field(in, out, anylink_sband_rx_dropped_frames);
-    anysignal_sharemap_pack_field(in, out, anylink_sband_rx_socket_errors);
-    anysignal_sharemap_pack_field(in, out, anylink_sband_rx_idle_frames);
-    anysignal_sharemap_pack_field(in, out, anylink_heartbeats_sent);
-    anysignal_sharemap_pack_field(in, out, anylink_heartbeats_received);
-    anysignal_sharemap_pack_field(in, out, anylink_rx_radio_bad_header);
-    anysignal_sharemap_pack_field(in, out, anylink_rx_radio_packets_received);
-    anysignal_sharemap_pack_field(in, out, anylink_tx_radio_packets_send_errors);
-    anysignal_sharemap_pack_field(in, out, anylink_tx_radio_packets_sent);
-    anysignal_sharemap_pack_field(in, out, anylink_tx_radio_packet_nodest);
-    anysignal_sharemap_pack_field(in, out, anylink_tx_radio_packet_truncate);
-    anysignal_sharemap_pack_field(in, out, anylink_tx_radio_packet_pad);
-    anysignal_sharemap_pack_field(in, out, anylink_rx_radio_no_endpoint);
-    anysignal_sharemap_pack_field(in, out, anylink_rx_radio_reject_echo);
-    anysignal_sharemap_pack_field(in, out, anylink_total_endpoint_packets_received);
-    anysignal_sharemap_pack_field(in, out, anylink_total_endpoint_packets_sent);
-    anysignal_sharemap_pack_field(in, out, anylink_encryption_failed);
-    anysignal_sharemap_pack_field(in, out, anylink_decryption_failed);
-    anysignal_sharemap_pack_field(in, out, anylink_tap_endpoint_active_tx_channel);
-    anysignal_sharemap_pack_field(in, out, anylink_tap_endpoint_mtu);
-    anysignal_sharemap_pack_field(in, out, anylink_tap_endpoint_recv_bytes);
-    anysignal_sharemap_pack_field(in, out, anylink_tap_endpoint_recv_errors);
-    anysignal_sharemap_pack_field(in, out, anylink_tap_endpoint_recv_packets);
-    anysignal_sharemap_pack_field(in, out, anylink_tap_endpoint_send_bytes);
-    anysignal_sharemap_pack_field(in, out, anylink_tap_endpoint_send_errors);
-    anysignal_sharemap_pack_field(in, out, anylink_tap_endpoint_send_packets);
+    sharemap_pack_into(in, reinterpret_cast<std::uint8_t *>(&out));
     return out;
 }
 
@@ -1846,6 +3055,1434 @@ static inline sharemap_metrics_t sharemap_unpack(const sharemap_metrics_packed_t
     return out;
 }
 
+// Unpack straight from a received buffer, false if length is not PACKED_SIZE
+static inline bool sharemap_unpack(const std::uint8_t *in, const std::size_t length, sharemap_metrics_t &out)
+{
+    if (length != sharemap_metrics_t::PACKED_SIZE)
+    {
+        return false;
+    }
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, source_id), out.source_id);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, schema_hash), out.schema_hash);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, unix_timestamp_ns), out.unix_timestamp_ns);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, controld_version), out.controld_version);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, controld_timestamp), out.controld_timestamp);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, powerd_version), out.powerd_version);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, powerd_timestamp), out.powerd_timestamp);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, radiod_version), out.radiod_version);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, radiod_timestamp), out.radiod_timestamp);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, fpga_version), out.fpga_version);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, fpga_timestamp), out.fpga_timestamp);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, fpga_project_name), out.fpga_project_name);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_version), out.anylink_version);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_tx_bytes_total), out.psk_cc_tx_bytes_total);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_tx_underflows), out.psk_cc_tx_underflows);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_tx_client_recv_errors), out.psk_cc_tx_client_recv_errors);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_tx_client_msgs), out.psk_cc_tx_client_msgs);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_tx_frames_transmitted), out.psk_cc_tx_frames_transmitted);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_tx_failed_transmissions), out.psk_cc_tx_failed_transmissions);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_tx_dropped_packets), out.psk_cc_tx_dropped_packets);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_tx_idle_frames_transmitted), out.psk_cc_tx_idle_frames_transmitted);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_tx_failed_idle_frames_transmitted), out.psk_cc_tx_failed_idle_frames_transmitted);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_tx_failed_bytes_in_flight_checks), out.psk_cc_tx_failed_bytes_in_flight_checks);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_tx_modem_underflows), out.psk_cc_tx_modem_underflows);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_tx_ad9361_tx_pll_lock), out.psk_cc_tx_ad9361_tx_pll_lock);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_rx_bytes_total), out.psk_cc_rx_bytes_total);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_rx_client_send_errors), out.psk_cc_rx_client_send_errors);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_rx_client_msgs), out.psk_cc_rx_client_msgs);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_rx_frames_received), out.psk_cc_rx_frames_received);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_rx_failed_receptions), out.psk_cc_rx_failed_receptions);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_rx_dropped_good_packets), out.psk_cc_rx_dropped_good_packets);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_rx_failed_frames_available_checks), out.psk_cc_rx_failed_frames_available_checks);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_rx_encountered_frames_in_progress), out.psk_cc_rx_encountered_frames_in_progress);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_rx_modem_dma_overflows), out.psk_cc_rx_modem_dma_overflows);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_rx_modem_dma_packet_count), out.psk_cc_rx_modem_dma_packet_count);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_rx_signal_present), out.psk_cc_rx_signal_present);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_rx_carrier_lock), out.psk_cc_rx_carrier_lock);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_rx_frame_sync_lock), out.psk_cc_rx_frame_sync_lock);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_rx_fec_confirmed_lock), out.psk_cc_rx_fec_confirmed_lock);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_rx_fec_ber), out.psk_cc_rx_fec_ber);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_rx_ad9361_rx_pll_lock), out.psk_cc_rx_ad9361_rx_pll_lock);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_rx_ad9361_bb_pll_lock), out.psk_cc_rx_ad9361_bb_pll_lock);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, dvbs2_tx_bytes_total), out.dvbs2_tx_bytes_total);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, dvbs2_tx_underflows), out.dvbs2_tx_underflows);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, dvbs2_tx_client_recv_errors), out.dvbs2_tx_client_recv_errors);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, dvbs2_tx_client_msgs), out.dvbs2_tx_client_msgs);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, dvbs2_tx_frames_transmitted), out.dvbs2_tx_frames_transmitted);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, dvbs2_tx_failed_transmissions), out.dvbs2_tx_failed_transmissions);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, dvbs2_tx_dropped_packets), out.dvbs2_tx_dropped_packets);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, dvbs2_tx_idle_frames_transmitted), out.dvbs2_tx_idle_frames_transmitted);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, dvbs2_tx_failed_idle_frames_transmitted), out.dvbs2_tx_failed_idle_frames_transmitted);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, dvbs2_tx_failed_bytes_in_flight_checks), out.dvbs2_tx_failed_bytes_in_flight_checks);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, dvbs2_tx_dummy_pl_frames), out.dvbs2_tx_dummy_pl_frames);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, gfsk_tx_bytes_total), out.gfsk_tx_bytes_total);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, gfsk_tx_underflows), out.gfsk_tx_underflows);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, gfsk_tx_client_recv_errors), out.gfsk_tx_client_recv_errors);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, gfsk_tx_client_msgs), out.gfsk_tx_client_msgs);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, gfsk_tx_frames_transmitted), out.gfsk_tx_frames_transmitted);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, gfsk_tx_failed_transmissions), out.gfsk_tx_failed_transmissions);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, gfsk_tx_dropped_packets), out.gfsk_tx_dropped_packets);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, gfsk_tx_idle_frames_transmitted), out.gfsk_tx_idle_frames_transmitted);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, gfsk_tx_failed_idle_frames_transmitted), out.gfsk_tx_failed_idle_frames_transmitted);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, gfsk_tx_failed_bytes_in_flight_checks), out.gfsk_tx_failed_bytes_in_flight_checks);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, ad9122_pgood), out.ad9122_pgood);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, ad9361_pgood), out.ad9361_pgood);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, adrf6780_pgood), out.adrf6780_pgood);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, at86_pgood), out.at86_pgood);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, at86_is_pll_locked), out.at86_is_pll_locked);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, aux_3v8_isense), out.aux_3v8_isense);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, aux_3v8_vsense), out.aux_3v8_vsense);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, carrier_28v0_isense), out.carrier_28v0_isense);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, carrier_28v0_vsense), out.carrier_28v0_vsense);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, carrier_2v1_isense), out.carrier_2v1_isense);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, carrier_2v1_vsense), out.carrier_2v1_vsense);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, carrier_2v6_isense), out.carrier_2v6_isense);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, carrier_2v6_vsense), out.carrier_2v6_vsense);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, carrier_3v8_isense), out.carrier_3v8_isense);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, carrier_3v8_vsense), out.carrier_3v8_vsense);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, carrier_5v5_isense), out.carrier_5v5_isense);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, carrier_5v5_vsense), out.carrier_5v5_vsense);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, carrier_temp), out.carrier_temp);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, lband_rx_pgood), out.lband_rx_pgood);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, lband_temp), out.lband_temp);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, lband_tx_pgood), out.lband_tx_pgood);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, lband_tx_rf_detect), out.lband_tx_rf_detect);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, lmk04832_pgood), out.lmk04832_pgood);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, lmk04832_is_pll_locked), out.lmk04832_is_pll_locked);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, lmx2594_pgood), out.lmx2594_pgood);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, max2771_a_1_is_pll_locked), out.max2771_a_1_is_pll_locked);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, max2771_a_2_is_pll_locked), out.max2771_a_2_is_pll_locked);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, max2771_a_bias_pgood), out.max2771_a_bias_pgood);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, max2771_a_pgood), out.max2771_a_pgood);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, max2771_b_1_is_pll_locked), out.max2771_b_1_is_pll_locked);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, max2771_b_2_is_pll_locked), out.max2771_b_2_is_pll_locked);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, max2771_b_bias_pgood), out.max2771_b_bias_pgood);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, max2771_b_pgood), out.max2771_b_pgood);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, rf_fe_mux_pgood), out.rf_fe_mux_pgood);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, sband_rx_pgood), out.sband_rx_pgood);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, sband_temp), out.sband_temp);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, sband_tx_pgood), out.sband_tx_pgood);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, sband_tx_rf_detect), out.sband_tx_rf_detect);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, si5345_pgood), out.si5345_pgood);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, som_5v0_isense), out.som_5v0_isense);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, som_5v0_vsense), out.som_5v0_vsense);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, uhf_rx_pgood), out.uhf_rx_pgood);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, uhf_temp), out.uhf_temp);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, uhf_tx_pgood), out.uhf_tx_pgood);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, uhf_tx_rf_detect), out.uhf_tx_rf_detect);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, xband_24v0_isense), out.xband_24v0_isense);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, xband_24v0_vsense), out.xband_24v0_vsense);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, xband_drain_pgood), out.xband_drain_pgood);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, xband_temp), out.xband_temp);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, xband_tx_rf_detect), out.xband_tx_rf_detect);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_uhf_tx_sent_bytes), out.anylink_uhf_tx_sent_bytes);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_uhf_tx_sent_packets), out.anylink_uhf_tx_sent_packets);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_uhf_tx_sent_frames), out.anylink_uhf_tx_sent_frames);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_uhf_tx_overflow_frames), out.anylink_uhf_tx_overflow_frames);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_sband_tx_sent_bytes), out.anylink_sband_tx_sent_bytes);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_sband_tx_sent_packets), out.anylink_sband_tx_sent_packets);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_sband_tx_sent_frames), out.anylink_sband_tx_sent_frames);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_sband_tx_overflow_frames), out.anylink_sband_tx_overflow_frames);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_xband_tx_sent_bytes), out.anylink_xband_tx_sent_bytes);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_xband_tx_sent_packets), out.anylink_xband_tx_sent_packets);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_xband_tx_sent_frames), out.anylink_xband_tx_sent_frames);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_xband_tx_overflow_frames), out.anylink_xband_tx_overflow_frames);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_sband_rx_received_bytes), out.anylink_sband_rx_received_bytes);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_sband_rx_received_packets), out.anylink_sband_rx_received_packets);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_sband_rx_received_frames), out.anylink_sband_rx_received_frames);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_sband_rx_dropped_packets), out.anylink_sband_rx_dropped_packets);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_sband_rx_dropped_frames), out.anylink_sband_rx_dropped_frames);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_sband_rx_socket_errors), out.anylink_sband_rx_socket_errors);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_sband_rx_idle_frames), out.anylink_sband_rx_idle_frames);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_heartbeats_sent), out.anylink_heartbeats_sent);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_heartbeats_received), out.anylink_heartbeats_received);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_rx_radio_bad_header), out.anylink_rx_radio_bad_header);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_rx_radio_packets_received), out.anylink_rx_radio_packets_received);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_tx_radio_packets_send_errors), out.anylink_tx_radio_packets_send_errors);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_tx_radio_packets_sent), out.anylink_tx_radio_packets_sent);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_tx_radio_packet_nodest), out.anylink_tx_radio_packet_nodest);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_tx_radio_packet_truncate), out.anylink_tx_radio_packet_truncate);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_tx_radio_packet_pad), out.anylink_tx_radio_packet_pad);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_rx_radio_no_endpoint), out.anylink_rx_radio_no_endpoint);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_rx_radio_reject_echo), out.anylink_rx_radio_reject_echo);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_total_endpoint_packets_received), out.anylink_total_endpoint_packets_received);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_total_endpoint_packets_sent), out.anylink_total_endpoint_packets_sent);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_encryption_failed), out.anylink_encryption_failed);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_decryption_failed), out.anylink_decryption_failed);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_tap_endpoint_active_tx_channel), out.anylink_tap_endpoint_active_tx_channel);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_tap_endpoint_mtu), out.anylink_tap_endpoint_mtu);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_tap_endpoint_recv_bytes), out.anylink_tap_endpoint_recv_bytes);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_tap_endpoint_recv_errors), out.anylink_tap_endpoint_recv_errors);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_tap_endpoint_recv_packets), out.anylink_tap_endpoint_recv_packets);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_tap_endpoint_send_bytes), out.anylink_tap_endpoint_send_bytes);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_tap_endpoint_send_errors), out.anylink_tap_endpoint_send_errors);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_tap_endpoint_send_packets), out.anylink_tap_endpoint_send_packets);
+    return true;
+}
+
+// metrics sharemap as one vector per field, for bulk analysis of many frames.
+// Booleans are kept as std::uint8_t, so rows can be written from several threads.
+struct sharemap_metrics_columns_t
+{
+    std::vector<std::uint16_t> source_id;
+    std::vector<std::uint64_t> schema_hash;
+    std::vector<std::int64_t> unix_timestamp_ns;
+    std::vector<std::array<char, STRING_BUFFER_SIZE>> controld_version;
+    std::vector<std::array<char, STRING_BUFFER_SIZE>> controld_timestamp;
+    std::vector<std::array<char, STRING_BUFFER_SIZE>> powerd_version;
+    std::vector<std::array<char, STRING_BUFFER_SIZE>> powerd_timestamp;
+    std::vector<std::array<char, STRING_BUFFER_SIZE>> radiod_version;
+    std::vector<std::array<char, STRING_BUFFER_SIZE>> radiod_timestamp;
+    std::vector<std::array<char, STRING_BUFFER_SIZE>> fpga_version;
+    std::vector<std::array<char, STRING_BUFFER_SIZE>> fpga_timestamp;
+    std::vector<std::array<char, STRING_BUFFER_SIZE>> fpga_project_name;
+    std::vector<std::array<char, STRING_BUFFER_SIZE>> anylink_version;
+    std::vector<std::uint64_t> psk_cc_tx_bytes_total;
+    std::vector<std::uint64_t> psk_cc_tx_underflows;
+    std::vector<std::uint64_t> psk_cc_tx_client_recv_errors;
+    std::vector<std::uint64_t> psk_cc_tx_client_msgs;
+    std::vector<std::uint64_t> psk_cc_tx_frames_transmitted;
+    std::vector<std::uint64_t> psk_cc_tx_failed_transmissions;
+    std::vector<std::uint64_t> psk_cc_tx_dropped_packets;
+    std::vector<std::uint64_t> psk_cc_tx_idle_frames_transmitted;
+    std::vector<std::uint64_t> psk_cc_tx_failed_idle_frames_transmitted;
+    std::vector<std::uint64_t> psk_cc_tx_failed_bytes_in_flight_checks;
+    std::vector<std::uint64_t> psk_cc_tx_modem_underflows;
+    std::vector<std::uint8_t> psk_cc_tx_ad9361_tx_pll_lock;
+    std::vector<std::uint64_t> psk_cc_rx_bytes_total;
+    std::vector<std::uint64_t> psk_cc_rx_client_send_errors;
+    std::vector<std::uint64_t> psk_cc_rx_client_msgs;
+    std::vector<std::uint64_t> psk_cc_rx_frames_received;
+    std::vector<std::uint64_t> psk_cc_rx_failed_receptions;
+    std::vector<std::uint64_t> psk_cc_rx_dropped_good_packets;
+    std::vector<std::uint64_t> psk_cc_rx_failed_frames_available_checks;
+    std::vector<std::uint64_t> psk_cc_rx_encountered_frames_in_progress;
+    std::vector<std::uint64_t> psk_cc_rx_modem_dma_overflows;
+    std::vector<std::uint32_t> psk_cc_rx_modem_dma_packet_count;
+    std::vector<std::uint8_t> psk_cc_rx_signal_present;
+    std::vector<std::uint8_t> psk_cc_rx_carrier_lock;
+    std::vector<std::uint8_t> psk_cc_rx_frame_sync_lock;
+    std::vector<std::uint8_t> psk_cc_rx_fec_confirmed_lock;
+    std::vector<float> psk_cc_rx_fec_ber;
+    std::vector<std::uint8_t> psk_cc_rx_ad9361_rx_pll_lock;
+    std::vector<std::uint8_t> psk_cc_rx_ad9361_bb_pll_lock;
+    std::vector<std::uint64_t> dvbs2_tx_bytes_total;
+    std::vector<std::uint64_t> dvbs2_tx_underflows;
+    std::vector<std::uint64_t> dvbs2_tx_client_recv_errors;
+    std::vector<std::uint64_t> dvbs2_tx_client_msgs;
+    std::vector<std::uint64_t> dvbs2_tx_frames_transmitted;
+    std::vector<std::uint64_t> dvbs2_tx_failed_transmissions;
+    std::vector<std::uint64_t> dvbs2_tx_dropped_packets;
+    std::vector<std::uint64_t> dvbs2_tx_idle_frames_transmitted;
+    std::vector<std::uint64_t> dvbs2_tx_failed_idle_frames_transmitted;
+    std::vector<std::uint64_t> dvbs2_tx_failed_bytes_in_flight_checks;
+    std::vector<std::uint64_t> dvbs2_tx_dummy_pl_frames;
+    std::vector<std::uint64_t> gfsk_tx_bytes_total;
+    std::vector<std::uint64_t> gfsk_tx_underflows;
+    std::vector<std::uint64_t> gfsk_tx_client_recv_errors;
+    std::vector<std::uint64_t> gfsk_tx_client_msgs;
+    std::vector<std::uint64_t> gfsk_tx_frames_transmitted;
+    std::vector<std::uint64_t> gfsk_tx_failed_transmissions;
+    std::vector<std::uint64_t> gfsk_tx_dropped_packets;
+    std::vector<std::uint64_t> gfsk_tx_idle_frames_transmitted;
+    std::vector<std::uint64_t> gfsk_tx_failed_idle_frames_transmitted;
+    std::vector<std::uint64_t> gfsk_tx_failed_bytes_in_flight_checks;
+    std::vector<std::uint8_t> ad9122_pgood;
+    std::vector<std::uint8_t> ad9361_pgood;
+    std::vector<std::uint8_t> adrf6780_pgood;
+    std::vector<std::uint8_t> at86_pgood;
+    std::vector<std::uint8_t> at86_is_pll_locked;
+    std::vector<double> aux_3v8_isense;
+    std::vector<double> aux_3v8_vsense;
+    std::vector<double> carrier_28v0_isense;
+    std::vector<double> carrier_28v0_vsense;
+    std::vector<double> carrier_2v1_isense;
+    std::vector<double> carrier_2v1_vsense;
+    std::vector<double> carrier_2v6_isense;
+    std::vector<double> carrier_2v6_vsense;
+    std::vector<double> carrier_3v8_isense;
+    std::vector<double> carrier_3v8_vsense;
+    std::vector<double> carrier_5v5_isense;
+    std::vector<double> carrier_5v5_vsense;
+    std::vector<double> carrier_temp;
+    std::vector<std::uint8_t> lband_rx_pgood;
+    std::vector<double> lband_temp;
+    std::vector<std::uint8_t> lband_tx_pgood;
+    std::vector<double> lband_tx_rf_detect;
+    std::vector<std::uint8_t> lmk04832_pgood;
+    std::vector<std::uint8_t> lmk04832_is_pll_locked;
+    std::vector<std::uint8_t> lmx2594_pgood;
+    std::vector<std::uint8_t> max2771_a_1_is_pll_locked;
+    std::vector<std::uint8_t> max2771_a_2_is_pll_locked;
+    std::vector<std::uint8_t> max2771_a_bias_pgood;
+    std::vector<std::uint8_t> max2771_a_pgood;
+    std::vector<std::uint8_t> max2771_b_1_is_pll_locked;
+    std::vector<std::uint8_t> max2771_b_2_is_pll_locked;
+    std::vector<std::uint8_t> max2771_b_bias_pgood;
+    std::vector<std::uint8_t> max2771_b_pgood;
+    std::vector<std::uint8_t> rf_fe_mux_pgood;
+    std::vector<std::uint8_t> sband_rx_pgood;
+    std::vector<double> sband_temp;
+    std::vector<std::uint8_t> sband_tx_pgood;
+    std::vector<double> sband_tx_rf_detect;
+    std::vector<std::uint8_t> si5345_pgood;
+    std::vector<double> som_5v0_isense;
+    std::vector<double> som_5v0_vsense;
+    std::vector<std::uint8_t> uhf_rx_pgood;
+    std::vector<double> uhf_temp;
+    std::vector<std::uint8_t> uhf_tx_pgood;
+    std::vector<double> uhf_tx_rf_detect;
+    std::vector<double> xband_24v0_isense;
+    std::vector<double> xband_24v0_vsense;
+    std::vector<std::uint8_t> xband_drain_pgood;
+    std::vector<double> xband_temp;
+    std::vector<double> xband_tx_rf_detect;
+    std::vector<std::uint64_t> anylink_uhf_tx_sent_bytes;
+    std::vector<std::uint64_t> anylink_uhf_tx_sent_packets;
+    std::vector<std::uint64_t> anylink_uhf_tx_sent_frames;
+    std::vector<std::uint64_t> anylink_uhf_tx_overflow_frames;
+    std::vector<std::uint64_t> anylink_sband_tx_sent_bytes;
+    std::vector<std::uint64_t> anylink_sband_tx_sent_packets;
+    std::vector<std::uint64_t> anylink_sband_tx_sent_frames;
+    std::vector<std::uint64_t> anylink_sband_tx_overflow_frames;
+    std::vector<std::uint64_t> anylink_xband_tx_sent_bytes;
+    std::vector<std::uint64_t> anylink_xband_tx_sent_packets;
+    std::vector<std::uint64_t> anylink_xband_tx_sent_frames;
+    std::vector<std::uint64_t> anylink_xband_tx_overflow_frames;
+    std::vector<std::uint64_t> anylink_sband_rx_received_bytes;
+    std::vector<std::uint64_t> anylink_sband_rx_received_packets;
+    std::vector<std::uint64_t> anylink_sband_rx_received_frames;
+    std::vector<std::uint64_t> anylink_sband_rx_dropped_packets;
+    std::vector<std::uint64_t> anylink_sband_rx_dropped_frames;
+    std::vector<std::uint64_t> anylink_sband_rx_socket_errors;
+    std::vector<std::uint64_t> anylink_sband_rx_idle_frames;
+    std::vector<std::uint64_t> anylink_heartbeats_sent;
+    std::vector<std::uint64_t> anylink_heartbeats_received;
+    std::vector<std::uint64_t> anylink_rx_radio_bad_header;
+    std::vector<std::uint64_t> anylink_rx_radio_packets_received;
+    std::vector<std::uint64_t> anylink_tx_radio_packets_send_errors;
+    std::vector<std::uint64_t> anylink_tx_radio_packets_sent;
+    std::vector<std::uint64_t> anylink_tx_radio_packet_nodest;
+    std::vector<std::uint64_t> anylink_tx_radio_packet_truncate;
+    std::vector<std::uint64_t> anylink_tx_radio_packet_pad;
+    std::vector<std::uint64_t> anylink_rx_radio_no_endpoint;
+    std::vector<std::uint64_t> anylink_rx_radio_reject_echo;
+    std::vector<std::uint64_t> anylink_total_endpoint_packets_received;
+    std::vector<std::uint64_t> anylink_total_endpoint_packets_sent;
+    std::vector<std::uint64_t> anylink_encryption_failed;
+    std::vector<std::uint64_t> anylink_decryption_failed;
+    std::vector<std::array<char, STRING_BUFFER_SIZE>> anylink_tap_endpoint_active_tx_channel;
+    std::vector<std::uint64_t> anylink_tap_endpoint_mtu;
+    std::vector<std::uint64_t> anylink_tap_endpoint_recv_bytes;
+    std::vector<std::uint64_t> anylink_tap_endpoint_recv_errors;
+    std::vector<std::uint64_t> anylink_tap_endpoint_recv_packets;
+    std::vector<std::uint64_t> anylink_tap_endpoint_send_bytes;
+    std::vector<std::uint64_t> anylink_tap_endpoint_send_errors;
+    std::vector<std::uint64_t> anylink_tap_endpoint_send_packets;
+
+    std::size_t size(void) const { return schema_hash.size(); }
+
+    void resize(const std::size_t n)
+    {
+        source_id.resize(n);
+        schema_hash.resize(n);
+        unix_timestamp_ns.resize(n);
+        controld_version.resize(n);
+        controld_timestamp.resize(n);
+        powerd_version.resize(n);
+        powerd_timestamp.resize(n);
+        radiod_version.resize(n);
+        radiod_timestamp.resize(n);
+        fpga_version.resize(n);
+        fpga_timestamp.resize(n);
+        fpga_project_name.resize(n);
+        anylink_version.resize(n);
+        psk_cc_tx_bytes_total.resize(n);
+        psk_cc_tx_underflows.resize(n);
+        psk_cc_tx_client_recv_errors.resize(n);
+        psk_cc_tx_client_msgs.resize(n);
+        psk_cc_tx_frames_transmitted.resize(n);
+        psk_cc_tx_failed_transmissions.resize(n);
+        psk_cc_tx_dropped_packets.resize(n);
+        psk_cc_tx_idle_frames_transmitted.resize(n);
+        psk_cc_tx_failed_idle_frames_transmitted.resize(n);
+        psk_cc_tx_failed_bytes_in_flight_checks.resize(n);
+        psk_cc_tx_modem_underflows.resize(n);
+        psk_cc_tx_ad9361_tx_pll_lock.resize(n);
+        psk_cc_rx_bytes_total.resize(n);
+        psk_cc_rx_client_send_errors.resize(n);
+        psk_cc_rx_client_msgs.resize(n);
+        psk_cc_rx_frames_received.resize(n);
+        psk_cc_rx_failed_receptions.resize(n);
+        psk_cc_rx_dropped_good_packets.resize(n);
+        psk_cc_rx_failed_frames_available_checks.resize(n);
+        psk_cc_rx_encountered_frames_in_progress.resize(n);
+        psk_cc_rx_modem_dma_overflows.resize(n);
+        psk_cc_rx_modem_dma_packet_count.resize(n);
+        psk_cc_rx_signal_present.resize(n);
+        psk_cc_rx_carrier_lock.resize(n);
+        psk_cc_rx_frame_sync_lock.resize(n);
+        psk_cc_rx_fec_confirmed_lock.resize(n);
+        psk_cc_rx_fec_ber.resize(n);
+        psk_cc_rx_ad9361_rx_pll_lock.resize(n);
+        psk_cc_rx_ad9361_bb_pll_lock.resize(n);
+        dvbs2_tx_bytes_total.resize(n);
+        dvbs2_tx_underflows.resize(n);
+        dvbs2_tx_client_recv_errors.resize(n);
+        dvbs2_tx_client_msgs.resize(n);
+        dvbs2_tx_frames_transmitted.resize(n);
+        dvbs2_tx_failed_transmissions.resize(n);
+        dvbs2_tx_dropped_packets.resize(n);
+        dvbs2_tx_idle_frames_transmitted.resize(n);
+        dvbs2_tx_failed_idle_frames_transmitted.resize(n);
+        dvbs2_tx_failed_bytes_in_flight_checks.resize(n);
+        dvbs2_tx_dummy_pl_frames.resize(n);
+        gfsk_tx_bytes_total.resize(n);
+        gfsk_tx_underflows.resize(n);
+        gfsk_tx_client_recv_errors.resize(n);
+        gfsk_tx_client_msgs.resize(n);
+        gfsk_tx_frames_transmitted.resize(n);
+        gfsk_tx_failed_transmissions.resize(n);
+        gfsk_tx_dropped_packets.resize(n);
+        gfsk_tx_idle_frames_transmitted.resize(n);
+        gfsk_tx_failed_idle_frames_transmitted.resize(n);
+        gfsk_tx_failed_bytes_in_flight_checks.resize(n);
+        ad9122_pgood.resize(n);
+        ad9361_pgood.resize(n);
+        adrf6780_pgood.resize(n);
+        at86_pgood.resize(n);
+        at86_is_pll_locked.resize(n);
+        aux_3v8_isense.resize(n);
+        aux_3v8_vsense.resize(n);
+        carrier_28v0_isense.resize(n);
+        carrier_28v0_vsense.resize(n);
+        carrier_2v1_isense.resize(n);
+        carrier_2v1_vsense.resize(n);
+        carrier_2v6_isense.resize(n);
+        carrier_2v6_vsense.resize(n);
+        carrier_3v8_isense.resize(n);
+        carrier_3v8_vsense.resize(n);
+        carrier_5v5_isense.resize(n);
+        carrier_5v5_vsense.resize(n);
+        carrier_temp.resize(n);
+        lband_rx_pgood.resize(n);
+        lband_temp.resize(n);
+        lband_tx_pgood.resize(n);
+        lband_tx_rf_detect.resize(n);
+        lmk04832_pgood.resize(n);
+        lmk04832_is_pll_locked.resize(n);
+        lmx2594_pgood.resize(n);
+        max2771_a_1_is_pll_locked.resize(n);
+        max2771_a_2_is_pll_locked.resize(n);
+        max2771_a_bias_pgood.resize(n);
+        max2771_a_pgood.resize(n);
+        max2771_b_1_is_pll_locked.resize(n);
+        max2771_b_2_is_pll_locked.resize(n);
+        max2771_b_bias_pgood.resize(n);
+        max2771_b_pgood.resize(n);
+        rf_fe_mux_pgood.resize(n);
+        sband_rx_pgood.resize(n);
+        sband_temp.resize(n);
+        sband_tx_pgood.resize(n);
+        sband_tx_rf_detect.resize(n);
+        si5345_pgood.resize(n);
+        som_5v0_isense.resize(n);
+        som_5v0_vsense.resize(n);
+        uhf_rx_pgood.resize(n);
+        uhf_temp.resize(n);
+        uhf_tx_pgood.resize(n);
+        uhf_tx_rf_detect.resize(n);
+        xband_24v0_isense.resize(n);
+        xband_24v0_vsense.resize(n);
+        xband_drain_pgood.resize(n);
+        xband_temp.resize(n);
+        xband_tx_rf_detect.resize(n);
+        anylink_uhf_tx_sent_bytes.resize(n);
+        anylink_uhf_tx_sent_packets.resize(n);
+        anylink_uhf_tx_sent_frames.resize(n);
+        anylink_uhf_tx_overflow_frames.resize(n);
+        anylink_sband_tx_sent_bytes.resize(n);
+        anylink_sband_tx_sent_packets.resize(n);
+        anylink_sband_tx_sent_frames.resize(n);
+        anylink_sband_tx_overflow_frames.resize(n);
+        anylink_xband_tx_sent_bytes.resize(n);
+        anylink_xband_tx_sent_packets.resize(n);
+        anylink_xband_tx_sent_frames.resize(n);
+        anylink_xband_tx_overflow_frames.resize(n);
+        anylink_sband_rx_received_bytes.resize(n);
+        anylink_sband_rx_received_packets.resize(n);
+        anylink_sband_rx_received_frames.resize(n);
+        anylink_sband_rx_dropped_packets.resize(n);
+        anylink_sband_rx_dropped_frames.resize(n);
+        anylink_sband_rx_socket_errors.resize(n);
+        anylink_sband_rx_idle_frames.resize(n);
+        anylink_heartbeats_sent.resize(n);
+        anylink_heartbeats_received.resize(n);
+        anylink_rx_radio_bad_header.resize(n);
+        anylink_rx_radio_packets_received.resize(n);
+        anylink_tx_radio_packets_send_errors.resize(n);
+        anylink_tx_radio_packets_sent.resize(n);
+        anylink_tx_radio_packet_nodest.resize(n);
+        anylink_tx_radio_packet_truncate.resize(n);
+        anylink_tx_radio_packet_pad.resize(n);
+        anylink_rx_radio_no_endpoint.resize(n);
+        anylink_rx_radio_reject_echo.resize(n);
+        anylink_total_endpoint_packets_received.resize(n);
+        anylink_total_endpoint_packets_sent.resize(n);
+        anylink_encryption_failed.resize(n);
+        anylink_decryption_failed.resize(n);
+        anylink_tap_endpoint_active_tx_channel.resize(n);
+        anylink_tap_endpoint_mtu.resize(n);
+        anylink_tap_endpoint_recv_bytes.resize(n);
+        anylink_tap_endpoint_recv_errors.resize(n);
+        anylink_tap_endpoint_recv_packets.resize(n);
+        anylink_tap_endpoint_send_bytes.resize(n);
+        anylink_tap_endpoint_send_errors.resize(n);
+        anylink_tap_endpoint_send_packets.resize(n);
+    }
+
+    void reserve(const std::size_t n)
+    {
+        source_id.reserve(n);
+        schema_hash.reserve(n);
+        unix_timestamp_ns.reserve(n);
+        controld_version.reserve(n);
+        controld_timestamp.reserve(n);
+        powerd_version.reserve(n);
+        powerd_timestamp.reserve(n);
+        radiod_version.reserve(n);
+        radiod_timestamp.reserve(n);
+        fpga_version.reserve(n);
+        fpga_timestamp.reserve(n);
+        fpga_project_name.reserve(n);
+        anylink_version.reserve(n);
+        psk_cc_tx_bytes_total.reserve(n);
+        psk_cc_tx_underflows.reserve(n);
+        psk_cc_tx_client_recv_errors.reserve(n);
+        psk_cc_tx_client_msgs.reserve(n);
+        psk_cc_tx_frames_transmitted.reserve(n);
+        psk_cc_tx_failed_transmissions.reserve(n);
+        psk_cc_tx_dropped_packets.reserve(n);
+        psk_cc_tx_idle_frames_transmitted.reserve(n);
+        psk_cc_tx_failed_idle_frames_transmitted.reserve(n);
+        psk_cc_tx_failed_bytes_in_flight_checks.reserve(n);
+        psk_cc_tx_modem_underflows.reserve(n);
+        psk_cc_tx_ad9361_tx_pll_lock.reserve(n);
+        psk_cc_rx_bytes_total.reserve(n);
+        psk_cc_rx_client_send_errors.reserve(n);
+        psk_cc_rx_client_msgs.reserve(n);
+        psk_cc_rx_frames_received.reserve(n);
+        psk_cc_rx_failed_receptions.reserve(n);
+        psk_cc_rx_dropped_good_packets.reserve(n);
+        psk_cc_rx_failed_frames_available_checks.reserve(n);
+        psk_cc_rx_encountered_frames_in_progress.reserve(n);
+        psk_cc_rx_modem_dma_overflows.reserve(n);
+        psk_cc_rx_modem_dma_packet_count.reserve(n);
+        psk_cc_rx_signal_present.reserve(n);
+        psk_cc_rx_carrier_lock.reserve(n);
+        psk_cc_rx_frame_sync_lock.reserve(n);
+        psk_cc_rx_fec_confirmed_lock.reserve(n);
+        psk_cc_rx_fec_ber.reserve(n);
+        psk_cc_rx_ad9361_rx_pll_lock.reserve(n);
+        psk_cc_rx_ad9361_bb_pll_lock.reserve(n);
+        dvbs2_tx_bytes_total.reserve(n);
+        dvbs2_tx_underflows.reserve(n);
+        dvbs2_tx_client_recv_errors.reserve(n);
+        dvbs2_tx_client_msgs.reserve(n);
+        dvbs2_tx_frames_transmitted.reserve(n);
+        dvbs2_tx_failed_transmissions.reserve(n);
+        dvbs2_tx_dropped_packets.reserve(n);
+        dvbs2_tx_idle_frames_transmitted.reserve(n);
+        dvbs2_tx_failed_idle_frames_transmitted.reserve(n);
+        dvbs2_tx_failed_bytes_in_flight_checks.reserve(n);
+        dvbs2_tx_dummy_pl_frames.reserve(n);
+        gfsk_tx_bytes_total.reserve(n);
+        gfsk_tx_underflows.reserve(n);
+        gfsk_tx_client_recv_errors.reserve(n);
+        gfsk_tx_client_msgs.reserve(n);
+        gfsk_tx_frames_transmitted.reserve(n);
+        gfsk_tx_failed_transmissions.reserve(n);
+        gfsk_tx_dropped_packets.reserve(n);
+        gfsk_tx_idle_frames_transmitted.reserve(n);
+        gfsk_tx_failed_idle_frames_transmitted.reserve(n);
+        gfsk_tx_failed_bytes_in_flight_checks.reserve(n);
+        ad9122_pgood.reserve(n);
+        ad9361_pgood.reserve(n);
+        adrf6780_pgood.reserve(n);
+        at86_pgood.reserve(n);
+        at86_is_pll_locked.reserve(n);
+        aux_3v8_isense.reserve(n);
+        aux_3v8_vsense.reserve(n);
+        carrier_28v0_isense.reserve(n);
+        carrier_28v0_vsense.reserve(n);
+        carrier_2v1_isense.reserve(n);
+        carrier_2v1_vsense.reserve(n);
+        carrier_2v6_isense.reserve(n);
+        carrier_2v6_vsense.reserve(n);
+        carrier_3v8_isense.reserve(n);
+        carrier_3v8_vsense.reserve(n);
+        carrier_5v5_isense.reserve(n);
+        carrier_5v5_vsense.reserve(n);
+        carrier_temp.reserve(n);
+        lband_rx_pgood.reserve(n);
+        lband_temp.reserve(n);
+        lband_tx_pgood.reserve(n);
+        lband_tx_rf_detect.reserve(n);
+        lmk04832_pgood.reserve(n);
+        lmk04832_is_pll_locked.reserve(n);
+        lmx2594_pgood.reserve(n);
+        max2771_a_1_is_pll_locked.reserve(n);
+        max2771_a_2_is_pll_locked.reserve(n);
+        max2771_a_bias_pgood.reserve(n);
+        max2771_a_pgood.reserve(n);
+        max2771_b_1_is_pll_locked.reserve(n);
+        max2771_b_2_is_pll_locked.reserve(n);
+        max2771_b_bias_pgood.reserve(n);
+        max2771_b_pgood.reserve(n);
+        rf_fe_mux_pgood.reserve(n);
+        sband_rx_pgood.reserve(n);
+        sband_temp.reserve(n);
+        sband_tx_pgood.reserve(n);
+        sband_tx_rf_detect.reserve(n);
+        si5345_pgood.reserve(n);
+        som_5v0_isense.reserve(n);
+        som_5v0_vsense.reserve(n);
+        uhf_rx_pgood.reserve(n);
+        uhf_temp.reserve(n);
+        uhf_tx_pgood.reserve(n);
+        uhf_tx_rf_detect.reserve(n);
+        xband_24v0_isense.reserve(n);
+        xband_24v0_vsense.reserve(n);
+        xband_drain_pgood.reserve(n);
+        xband_temp.reserve(n);
+        xband_tx_rf_detect.reserve(n);
+        anylink_uhf_tx_sent_bytes.reserve(n);
+        anylink_uhf_tx_sent_packets.reserve(n);
+        anylink_uhf_tx_sent_frames.reserve(n);
+        anylink_uhf_tx_overflow_frames.reserve(n);
+        anylink_sband_tx_sent_bytes.reserve(n);
+        anylink_sband_tx_sent_packets.reserve(n);
+        anylink_sband_tx_sent_frames.reserve(n);
+        anylink_sband_tx_overflow_frames.reserve(n);
+        anylink_xband_tx_sent_bytes.reserve(n);
+        anylink_xband_tx_sent_packets.reserve(n);
+        anylink_xband_tx_sent_frames.reserve(n);
+        anylink_xband_tx_overflow_frames.reserve(n);
+        anylink_sband_rx_received_bytes.reserve(n);
+        anylink_sband_rx_received_packets.reserve(n);
+        anylink_sband_rx_received_frames.reserve(n);
+        anylink_sband_rx_dropped_packets.reserve(n);
+        anylink_sband_rx_dropped_frames.reserve(n);
+        anylink_sband_rx_socket_errors.reserve(n);
+        anylink_sband_rx_idle_frames.reserve(n);
+        anylink_heartbeats_sent.reserve(n);
+        anylink_heartbeats_received.reserve(n);
+        anylink_rx_radio_bad_header.reserve(n);
+        anylink_rx_radio_packets_received.reserve(n);
+        anylink_tx_radio_packets_send_errors.reserve(n);
+        anylink_tx_radio_packets_sent.reserve(n);
+        anylink_tx_radio_packet_nodest.reserve(n);
+        anylink_tx_radio_packet_truncate.reserve(n);
+        anylink_tx_radio_packet_pad.reserve(n);
+        anylink_rx_radio_no_endpoint.reserve(n);
+        anylink_rx_radio_reject_echo.reserve(n);
+        anylink_total_endpoint_packets_received.reserve(n);
+        anylink_total_endpoint_packets_sent.reserve(n);
+        anylink_encryption_failed.reserve(n);
+        anylink_decryption_failed.reserve(n);
+        anylink_tap_endpoint_active_tx_channel.reserve(n);
+        anylink_tap_endpoint_mtu.reserve(n);
+        anylink_tap_endpoint_recv_bytes.reserve(n);
+        anylink_tap_endpoint_recv_errors.reserve(n);
+        anylink_tap_endpoint_recv_packets.reserve(n);
+        anylink_tap_endpoint_send_bytes.reserve(n);
+        anylink_tap_endpoint_send_errors.reserve(n);
+        anylink_tap_endpoint_send_packets.reserve(n);
+    }
+
+    void push_back(const sharemap_metrics_t &in)
+    {
+        source_id.push_back(in.source_id);
+        schema_hash.push_back(in.schema_hash);
+        unix_timestamp_ns.push_back(in.unix_timestamp_ns);
+        controld_version.push_back(in.controld_version);
+        controld_timestamp.push_back(in.controld_timestamp);
+        powerd_version.push_back(in.powerd_version);
+        powerd_timestamp.push_back(in.powerd_timestamp);
+        radiod_version.push_back(in.radiod_version);
+        radiod_timestamp.push_back(in.radiod_timestamp);
+        fpga_version.push_back(in.fpga_version);
+        fpga_timestamp.push_back(in.fpga_timestamp);
+        fpga_project_name.push_back(in.fpga_project_name);
+        anylink_version.push_back(in.anylink_version);
+        psk_cc_tx_bytes_total.push_back(in.psk_cc_tx_bytes_total);
+        psk_cc_tx_underflows.push_back(in.psk_cc_tx_underflows);
+        psk_cc_tx_client_recv_errors.push_back(in.psk_cc_tx_client_recv_errors);
+        psk_cc_tx_client_msgs.push_back(in.psk_cc_tx_client_msgs);
+        psk_cc_tx_frames_transmitted.push_back(in.psk_cc_tx_frames_transmitted);
+        psk_cc_tx_failed_transmissions.push_back(in.psk_cc_tx_failed_transmissions);
+        psk_cc_tx_dropped_packets.push_back(in.psk_cc_tx_dropped_packets);
+        psk_cc_tx_idle_frames_transmitted.push_back(in.psk_cc_tx_idle_frames_transmitted);
+        psk_cc_tx_failed_idle_frames_transmitted.push_back(in.psk_cc_tx_failed_idle_frames_transmitted);
+        psk_cc_tx_failed_bytes_in_flight_checks.push_back(in.psk_cc_tx_failed_bytes_in_flight_checks);
+        psk_cc_tx_modem_underflows.push_back(in.psk_cc_tx_modem_underflows);
+        psk_cc_tx_ad9361_tx_pll_lock.push_back(in.psk_cc_tx_ad9361_tx_pll_lock);
+        psk_cc_rx_bytes_total.push_back(in.psk_cc_rx_bytes_total);
+        psk_cc_rx_client_send_errors.push_back(in.psk_cc_rx_client_send_errors);
+        psk_cc_rx_client_msgs.push_back(in.psk_cc_rx_client_msgs);
+        psk_cc_rx_frames_received.push_back(in.psk_cc_rx_frames_received);
+        psk_cc_rx_failed_receptions.push_back(in.psk_cc_rx_failed_receptions);
+        psk_cc_rx_dropped_good_packets.push_back(in.psk_cc_rx_dropped_good_packets);
+        psk_cc_rx_failed_frames_available_checks.push_back(in.psk_cc_rx_failed_frames_available_checks);
+        psk_cc_rx_encountered_frames_in_progress.push_back(in.psk_cc_rx_encountered_frames_in_progress);
+        psk_cc_rx_modem_dma_overflows.push_back(in.psk_cc_rx_modem_dma_overflows);
+        psk_cc_rx_modem_dma_packet_count.push_back(in.psk_cc_rx_modem_dma_packet_count);
+        psk_cc_rx_signal_present.push_back(in.psk_cc_rx_signal_present);
+        psk_cc_rx_carrier_lock.push_back(in.psk_cc_rx_carrier_lock);
+        psk_cc_rx_frame_sync_lock.push_back(in.psk_cc_rx_frame_sync_lock);
+        psk_cc_rx_fec_confirmed_lock.push_back(in.psk_cc_rx_fec_confirmed_lock);
+        psk_cc_rx_fec_ber.push_back(in.psk_cc_rx_fec_ber);
+        psk_cc_rx_ad9361_rx_pll_lock.push_back(in.psk_cc_rx_ad9361_rx_pll_lock);
+        psk_cc_rx_ad9361_bb_pll_lock.push_back(in.psk_cc_rx_ad9361_bb_pll_lock);
+        dvbs2_tx_bytes_total.push_back(in.dvbs2_tx_bytes_total);
+        dvbs2_tx_underflows.push_back(in.dvbs2_tx_underflows);
+        dvbs2_tx_client_recv_errors.push_back(in.dvbs2_tx_client_recv_errors);
+        dvbs2_tx_client_msgs.push_back(in.dvbs2_tx_client_msgs);
+        dvbs2_tx_frames_transmitted.push_back(in.dvbs2_tx_frames_transmitted);
+        dvbs2_tx_failed_transmissions.push_back(in.dvbs2_tx_failed_transmissions);
+        dvbs2_tx_dropped_packets.push_back(in.dvbs2_tx_dropped_packets);
+        dvbs2_tx_idle_frames_transmitted.push_back(in.dvbs2_tx_idle_frames_transmitted);
+        dvbs2_tx_failed_idle_frames_transmitted.push_back(in.dvbs2_tx_failed_idle_frames_transmitted);
+        dvbs2_tx_failed_bytes_in_flight_checks.push_back(in.dvbs2_tx_failed_bytes_in_flight_checks);
+        dvbs2_tx_dummy_pl_frames.push_back(in.dvbs2_tx_dummy_pl_frames);
+        gfsk_tx_bytes_total.push_back(in.gfsk_tx_bytes_total);
+        gfsk_tx_underflows.push_back(in.gfsk_tx_underflows);
+        gfsk_tx_client_recv_errors.push_back(in.gfsk_tx_client_recv_errors);
+        gfsk_tx_client_msgs.push_back(in.gfsk_tx_client_msgs);
+        gfsk_tx_frames_transmitted.push_back(in.gfsk_tx_frames_transmitted);
+        gfsk_tx_failed_transmissions.push_back(in.gfsk_tx_failed_transmissions);
+        gfsk_tx_dropped_packets.push_back(in.gfsk_tx_dropped_packets);
+        gfsk_tx_idle_frames_transmitted.push_back(in.gfsk_tx_idle_frames_transmitted);
+        gfsk_tx_failed_idle_frames_transmitted.push_back(in.gfsk_tx_failed_idle_frames_transmitted);
+        gfsk_tx_failed_bytes_in_flight_checks.push_back(in.gfsk_tx_failed_bytes_in_flight_checks);
+        ad9122_pgood.push_back(in.ad9122_pgood);
+        ad9361_pgood.push_back(in.ad9361_pgood);
+        adrf6780_pgood.push_back(in.adrf6780_pgood);
+        at86_pgood.push_back(in.at86_pgood);
+        at86_is_pll_locked.push_back(in.at86_is_pll_locked);
+        aux_3v8_isense.push_back(in.aux_3v8_isense);
+        aux_3v8_vsense.push_back(in.aux_3v8_vsense);
+        carrier_28v0_isense.push_back(in.carrier_28v0_isense);
+        carrier_28v0_vsense.push_back(in.carrier_28v0_vsense);
+        carrier_2v1_isense.push_back(in.carrier_2v1_isense);
+        carrier_2v1_vsense.push_back(in.carrier_2v1_vsense);
+        carrier_2v6_isense.push_back(in.carrier_2v6_isense);
+        carrier_2v6_vsense.push_back(in.carrier_2v6_vsense);
+        carrier_3v8_isense.push_back(in.carrier_3v8_isense);
+        carrier_3v8_vsense.push_back(in.carrier_3v8_vsense);
+        carrier_5v5_isense.push_back(in.carrier_5v5_isense);
+        carrier_5v5_vsense.push_back(in.carrier_5v5_vsense);
+        carrier_temp.push_back(in.carrier_temp);
+        lband_rx_pgood.push_back(in.lband_rx_pgood);
+        lband_temp.push_back(in.lband_temp);
+        lband_tx_pgood.push_back(in.lband_tx_pgood);
+        lband_tx_rf_detect.push_back(in.lband_tx_rf_detect);
+        lmk04832_pgood.push_back(in.lmk04832_pgood);
+        lmk04832_is_pll_locked.push_back(in.lmk04832_is_pll_locked);
+        lmx2594_pgood.push_back(in.lmx2594_pgood);
+        max2771_a_1_is_pll_locked.push_back(in.max2771_a_1_is_pll_locked);
+        max2771_a_2_is_pll_locked.push_back(in.max2771_a_2_is_pll_locked);
+        max2771_a_bias_pgood.push_back(in.max2771_a_bias_pgood);
+        max2771_a_pgood.push_back(in.max2771_a_pgood);
+        max2771_b_1_is_pll_locked.push_back(in.max2771_b_1_is_pll_locked);
+        max2771_b_2_is_pll_locked.push_back(in.max2771_b_2_is_pll_locked);
+        max2771_b_bias_pgood.push_back(in.max2771_b_bias_pgood);
+        max2771_b_pgood.push_back(in.max2771_b_pgood);
+        rf_fe_mux_pgood.push_back(in.rf_fe_mux_pgood);
+        sband_rx_pgood.push_back(in.sband_rx_pgood);
+        sband_temp.push_back(in.sband_temp);
+        sband_tx_pgood.push_back(in.sband_tx_pgood);
+        sband_tx_rf_detect.push_back(in.sband_tx_rf_detect);
+        si5345_pgood.push_back(in.si5345_pgood);
+        som_5v0_isense.push_back(in.som_5v0_isense);
+        som_5v0_vsense.push_back(in.som_5v0_vsense);
+        uhf_rx_pgood.push_back(in.uhf_rx_pgood);
+        uhf_temp.push_back(in.uhf_temp);
+        uhf_tx_pgood.push_back(in.uhf_tx_pgood);
+        uhf_tx_rf_detect.push_back(in.uhf_tx_rf_detect);
+        xband_24v0_isense.push_back(in.xband_24v0_isense);
+        xband_24v0_vsense.push_back(in.xband_24v0_vsense);
+        xband_drain_pgood.push_back(in.xband_drain_pgood);
+        xband_temp.push_back(in.xband_temp);
+        xband_tx_rf_detect.push_back(in.xband_tx_rf_detect);
+        anylink_uhf_tx_sent_bytes.push_back(in.anylink_uhf_tx_sent_bytes);
+        anylink_uhf_tx_sent_packets.push_back(in.anylink_uhf_tx_sent_packets);
+        anylink_uhf_tx_sent_frames.push_back(in.anylink_uhf_tx_sent_frames);
+        anylink_uhf_tx_overflow_frames.push_back(in.anylink_uhf_tx_overflow_frames);
+        anylink_sband_tx_sent_bytes.push_back(in.anylink_sband_tx_sent_bytes);
+        anylink_sband_tx_sent_packets.push_back(in.anylink_sband_tx_sent_packets);
+        anylink_sband_tx_sent_frames.push_back(in.anylink_sband_tx_sent_frames);
+        anylink_sband_tx_overflow_frames.push_back(in.anylink_sband_tx_overflow_frames);
+        anylink_xband_tx_sent_bytes.push_back(in.anylink_xband_tx_sent_bytes);
+        anylink_xband_tx_sent_packets.push_back(in.anylink_xband_tx_sent_packets);
+        anylink_xband_tx_sent_frames.push_back(in.anylink_xband_tx_sent_frames);
+        anylink_xband_tx_overflow_frames.push_back(in.anylink_xband_tx_overflow_frames);
+        anylink_sband_rx_received_bytes.push_back(in.anylink_sband_rx_received_bytes);
+        anylink_sband_rx_received_packets.push_back(in.anylink_sband_rx_received_packets);
+        anylink_sband_rx_received_frames.push_back(in.anylink_sband_rx_received_frames);
+        anylink_sband_rx_dropped_packets.push_back(in.anylink_sband_rx_dropped_packets);
+        anylink_sband_rx_dropped_frames.push_back(in.anylink_sband_rx_dropped_frames);
+        anylink_sband_rx_socket_errors.push_back(in.anylink_sband_rx_socket_errors);
+        anylink_sband_rx_idle_frames.push_back(in.anylink_sband_rx_idle_frames);
+        anylink_heartbeats_sent.push_back(in.anylink_heartbeats_sent);
+        anylink_heartbeats_received.push_back(in.anylink_heartbeats_received);
+        anylink_rx_radio_bad_header.push_back(in.anylink_rx_radio_bad_header);
+        anylink_rx_radio_packets_received.push_back(in.anylink_rx_radio_packets_received);
+        anylink_tx_radio_packets_send_errors.push_back(in.anylink_tx_radio_packets_send_errors);
+        anylink_tx_radio_packets_sent.push_back(in.anylink_tx_radio_packets_sent);
+        anylink_tx_radio_packet_nodest.push_back(in.anylink_tx_radio_packet_nodest);
+        anylink_tx_radio_packet_truncate.push_back(in.anylink_tx_radio_packet_truncate);
+        anylink_tx_radio_packet_pad.push_back(in.anylink_tx_radio_packet_pad);
+        anylink_rx_radio_no_endpoint.push_back(in.anylink_rx_radio_no_endpoint);
+        anylink_rx_radio_reject_echo.push_back(in.anylink_rx_radio_reject_echo);
+        anylink_total_endpoint_packets_received.push_back(in.anylink_total_endpoint_packets_received);
+        anylink_total_endpoint_packets_sent.push_back(in.anylink_total_endpoint_packets_sent);
+        anylink_encryption_failed.push_back(in.anylink_encryption_failed);
+        anylink_decryption_failed.push_back(in.anylink_decryption_failed);
+        anylink_tap_endpoint_active_tx_channel.push_back(in.anylink_tap_endpoint_active_tx_channel);
+        anylink_tap_endpoint_mtu.push_back(in.anylink_tap_endpoint_mtu);
+        anylink_tap_endpoint_recv_bytes.push_back(in.anylink_tap_endpoint_recv_bytes);
+        anylink_tap_endpoint_recv_errors.push_back(in.anylink_tap_endpoint_recv_errors);
+        anylink_tap_endpoint_recv_packets.push_back(in.anylink_tap_endpoint_recv_packets);
+        anylink_tap_endpoint_send_bytes.push_back(in.anylink_tap_endpoint_send_bytes);
+        anylink_tap_endpoint_send_errors.push_back(in.anylink_tap_endpoint_send_errors);
+        anylink_tap_endpoint_send_packets.push_back(in.anylink_tap_endpoint_send_packets);
+    }
+
+    sharemap_metrics_t row(const std::size_t i) const
+    {
+        sharemap_metrics_t out{};
+        out.source_id = source_id[i];
+        out.schema_hash = schema_hash[i];
+        out.unix_timestamp_ns = unix_timestamp_ns[i];
+        out.controld_version = controld_version[i];
+        out.controld_timestamp = controld_timestamp[i];
+        out.powerd_version = powerd_version[i];
+        out.powerd_timestamp = powerd_timestamp[i];
+        out.radiod_version = radiod_version[i];
+        out.radiod_timestamp = radiod_timestamp[i];
+        out.fpga_version = fpga_version[i];
+        out.fpga_timestamp = fpga_timestamp[i];
+        out.fpga_project_name = fpga_project_name[i];
+        out.anylink_version = anylink_version[i];
+        out.psk_cc_tx_bytes_total = psk_cc_tx_bytes_total[i];
+        out.psk_cc_tx_underflows = psk_cc_tx_underflows[i];
+        out.psk_cc_tx_client_recv_errors = psk_cc_tx_client_recv_errors[i];
+        out.psk_cc_tx_client_msgs = psk_cc_tx_client_msgs[i];
+        out.psk_cc_tx_frames_transmitted = psk_cc_tx_frames_transmitted[i];
+        out.psk_cc_tx_failed_transmissions = psk_cc_tx_failed_transmissions[i];
+        out.psk_cc_tx_dropped_packets = psk_cc_tx_dropped_packets[i];
+        out.psk_cc_tx_idle_frames_transmitted = psk_cc_tx_idle_frames_transmitted[i];
+        out.psk_cc_tx_failed_idle_frames_transmitted = psk_cc_tx_failed_idle_frames_transmitted[i];
+        out.psk_cc_tx_failed_bytes_in_flight_checks = psk_cc_tx_failed_bytes_in_flight_checks[i];
+        out.psk_cc_tx_modem_underflows = psk_cc_tx_modem_underflows[i];
+        out.psk_cc_tx_ad9361_tx_pll_lock = psk_cc_tx_ad9361_tx_pll_lock[i];
+        out.psk_cc_rx_bytes_total = psk_cc_rx_bytes_total[i];
+        out.psk_cc_rx_client_send_errors = psk_cc_rx_client_send_errors[i];
+        out.psk_cc_rx_client_msgs = psk_cc_rx_client_msgs[i];
+        out.psk_cc_rx_frames_received = psk_cc_rx_frames_received[i];
+        out.psk_cc_rx_failed_receptions = psk_cc_rx_failed_receptions[i];
+        out.psk_cc_rx_dropped_good_packets = psk_cc_rx_dropped_good_packets[i];
+        out.psk_cc_rx_failed_frames_available_checks = psk_cc_rx_failed_frames_available_checks[i];
+        out.psk_cc_rx_encountered_frames_in_progress = psk_cc_rx_encountered_frames_in_progress[i];
+        out.psk_cc_rx_modem_dma_overflows = psk_cc_rx_modem_dma_overflows[i];
+        out.psk_cc_rx_modem_dma_packet_count = psk_cc_rx_modem_dma_packet_count[i];
+        out.psk_cc_rx_signal_present = psk_cc_rx_signal_present[i];
+        out.psk_cc_rx_carrier_lock = psk_cc_rx_carrier_lock[i];
+        out.psk_cc_rx_frame_sync_lock = psk_cc_rx_frame_sync_lock[i];
+        out.psk_cc_rx_fec_confirmed_lock = psk_cc_rx_fec_confirmed_lock[i];
+        out.psk_cc_rx_fec_ber = psk_cc_rx_fec_ber[i];
+        out.psk_cc_rx_ad9361_rx_pll_lock = psk_cc_rx_ad9361_rx_pll_lock[i];
+        out.psk_cc_rx_ad9361_bb_pll_lock = psk_cc_rx_ad9361_bb_pll_lock[i];
+        out.dvbs2_tx_bytes_total = dvbs2_tx_bytes_total[i];
+        out.dvbs2_tx_underflows = dvbs2_tx_underflows[i];
+        out.dvbs2_tx_client_recv_errors = dvbs2_tx_client_recv_errors[i];
+        out.dvbs2_tx_client_msgs = dvbs2_tx_client_msgs[i];
+        out.dvbs2_tx_frames_transmitted = dvbs2_tx_frames_transmitted[i];
+        out.dvbs2_tx_failed_transmissions = dvbs2_tx_failed_transmissions[i];
+        out.dvbs2_tx_dropped_packets = dvbs2_tx_dropped_packets[i];
+        out.dvbs2_tx_idle_frames_transmitted = dvbs2_tx_idle_frames_transmitted[i];
+        out.dvbs2_tx_failed_idle_frames_transmitted = dvbs2_tx_failed_idle_frames_transmitted[i];
+        out.dvbs2_tx_failed_bytes_in_flight_checks = dvbs2_tx_failed_bytes_in_flight_checks[i];
+        out.dvbs2_tx_dummy_pl_frames = dvbs2_tx_dummy_pl_frames[i];
+        out.gfsk_tx_bytes_total = gfsk_tx_bytes_total[i];
+        out.gfsk_tx_underflows = gfsk_tx_underflows[i];
+        out.gfsk_tx_client_recv_errors = gfsk_tx_client_recv_errors[i];
+        out.gfsk_tx_client_msgs = gfsk_tx_client_msgs[i];
+        out.gfsk_tx_frames_transmitted = gfsk_tx_frames_transmitted[i];
+        out.gfsk_tx_failed_transmissions = gfsk_tx_failed_transmissions[i];
+        out.gfsk_tx_dropped_packets = gfsk_tx_dropped_packets[i];
+        out.gfsk_tx_idle_frames_transmitted = gfsk_tx_idle_frames_transmitted[i];
+        out.gfsk_tx_failed_idle_frames_transmitted = gfsk_tx_failed_idle_frames_transmitted[i];
+        out.gfsk_tx_failed_bytes_in_flight_checks = gfsk_tx_failed_bytes_in_flight_checks[i];
+        out.ad9122_pgood = ad9122_pgood[i];
+        out.ad9361_pgood = ad9361_pgood[i];
+        out.adrf6780_pgood = adrf6780_pgood[i];
+        out.at86_pgood = at86_pgood[i];
+        out.at86_is_pll_locked = at86_is_pll_locked[i];
+        out.aux_3v8_isense = aux_3v8_isense[i];
+        out.aux_3v8_vsense = aux_3v8_vsense[i];
+        out.carrier_28v0_isense = carrier_28v0_isense[i];
+        out.carrier_28v0_vsense = carrier_28v0_vsense[i];
+        out.carrier_2v1_isense = carrier_2v1_isense[i];
+        out.carrier_2v1_vsense = carrier_2v1_vsense[i];
+        out.carrier_2v6_isense = carrier_2v6_isense[i];
+        out.carrier_2v6_vsense = carrier_2v6_vsense[i];
+        out.carrier_3v8_isense = carrier_3v8_isense[i];
+        out.carrier_3v8_vsense = carrier_3v8_vsense[i];
+        out.carrier_5v5_isense = carrier_5v5_isense[i];
+        out.carrier_5v5_vsense = carrier_5v5_vsense[i];
+        out.carrier_temp = carrier_temp[i];
+        out.lband_rx_pgood = lband_rx_pgood[i];
+        out.lband_temp = lband_temp[i];
+        out.lband_tx_pgood = lband_tx_pgood[i];
+        out.lband_tx_rf_detect = lband_tx_rf_detect[i];
+        out.lmk04832_pgood = lmk04832_pgood[i];
+        out.lmk04832_is_pll_locked = lmk04832_is_pll_locked[i];
+        out.lmx2594_pgood = lmx2594_pgood[i];
+        out.max2771_a_1_is_pll_locked = max2771_a_1_is_pll_locked[i];
+        out.max2771_a_2_is_pll_locked = max2771_a_2_is_pll_locked[i];
+        out.max2771_a_bias_pgood = max2771_a_bias_pgood[i];
+        out.max2771_a_pgood = max2771_a_pgood[i];
+        out.max2771_b_1_is_pll_locked = max2771_b_1_is_pll_locked[i];
+        out.max2771_b_2_is_pll_locked = max2771_b_2_is_pll_locked[i];
+        out.max2771_b_bias_pgood = max2771_b_bias_pgood[i];
+        out.max2771_b_pgood = max2771_b_pgood[i];
+        out.rf_fe_mux_pgood = rf_fe_mux_pgood[i];
+        out.sband_rx_pgood = sband_rx_pgood[i];
+        out.sband_temp = sband_temp[i];
+        out.sband_tx_pgood = sband_tx_pgood[i];
+        out.sband_tx_rf_detect = sband_tx_rf_detect[i];
+        out.si5345_pgood = si5345_pgood[i];
+        out.som_5v0_isense = som_5v0_isense[i];
+        out.som_5v0_vsense = som_5v0_vsense[i];
+        out.uhf_rx_pgood = uhf_rx_pgood[i];
+        out.uhf_temp = uhf_temp[i];
+        out.uhf_tx_pgood = uhf_tx_pgood[i];
+        out.uhf_tx_rf_detect = uhf_tx_rf_detect[i];
+        out.xband_24v0_isense = xband_24v0_isense[i];
+        out.xband_24v0_vsense = xband_24v0_vsense[i];
+        out.xband_drain_pgood = xband_drain_pgood[i];
+        out.xband_temp = xband_temp[i];
+        out.xband_tx_rf_detect = xband_tx_rf_detect[i];
+        out.anylink_uhf_tx_sent_bytes = anylink_uhf_tx_sent_bytes[i];
+        out.anylink_uhf_tx_sent_packets = anylink_uhf_tx_sent_packets[i];
+        out.anylink_uhf_tx_sent_frames = anylink_uhf_tx_sent_frames[i];
+        out.anylink_uhf_tx_overflow_frames = anylink_uhf_tx_overflow_frames[i];
+        out.anylink_sband_tx_sent_bytes = anylink_sband_tx_sent_bytes[i];
+        out.anylink_sband_tx_sent_packets = anylink_sband_tx_sent_packets[i];
+        out.anylink_sband_tx_sent_frames = anylink_sband_tx_sent_frames[i];
+        out.anylink_sband_tx_overflow_frames = anylink_sband_tx_overflow_frames[i];
+        out.anylink_xband_tx_sent_bytes = anylink_xband_tx_sent_bytes[i];
+        out.anylink_xband_tx_sent_packets = anylink_xband_tx_sent_packets[i];
+        out.anylink_xband_tx_sent_frames = anylink_xband_tx_sent_frames[i];
+        out.anylink_xband_tx_overflow_frames = anylink_xband_tx_overflow_frames[i];
+        out.anylink_sband_rx_received_bytes = anylink_sband_rx_received_bytes[i];
+        out.anylink_sband_rx_received_packets = anylink_sband_rx_received_packets[i];
+        out.anylink_sband_rx_received_frames = anylink_sband_rx_received_frames[i];
+        out.anylink_sband_rx_dropped_packets = anylink_sband_rx_dropped_packets[i];
+        out.anylink_sband_rx_dropped_frames = anylink_sband_rx_dropped_frames[i];
+        out.anylink_sband_rx_socket_errors = anylink_sband_rx_socket_errors[i];
+        out.anylink_sband_rx_idle_frames = anylink_sband_rx_idle_frames[i];
+        out.anylink_heartbeats_sent = anylink_heartbeats_sent[i];
+        out.anylink_heartbeats_received = anylink_heartbeats_received[i];
+        out.anylink_rx_radio_bad_header = anylink_rx_radio_bad_header[i];
+        out.anylink_rx_radio_packets_received = anylink_rx_radio_packets_received[i];
+        out.anylink_tx_radio_packets_send_errors = anylink_tx_radio_packets_send_errors[i];
+        out.anylink_tx_radio_packets_sent = anylink_tx_radio_packets_sent[i];
+        out.anylink_tx_radio_packet_nodest = anylink_tx_radio_packet_nodest[i];
+        out.anylink_tx_radio_packet_truncate = anylink_tx_radio_packet_truncate[i];
+        out.anylink_tx_radio_packet_pad = anylink_tx_radio_packet_pad[i];
+        out.anylink_rx_radio_no_endpoint = anylink_rx_radio_no_endpoint[i];
+        out.anylink_rx_radio_reject_echo = anylink_rx_radio_reject_echo[i];
+        out.anylink_total_endpoint_packets_received = anylink_total_endpoint_packets_received[i];
+        out.anylink_total_endpoint_packets_sent = anylink_total_endpoint_packets_sent[i];
+        out.anylink_encryption_failed = anylink_encryption_failed[i];
+        out.anylink_decryption_failed = anylink_decryption_failed[i];
+        out.anylink_tap_endpoint_active_tx_channel = anylink_tap_endpoint_active_tx_channel[i];
+        out.anylink_tap_endpoint_mtu = anylink_tap_endpoint_mtu[i];
+        out.anylink_tap_endpoint_recv_bytes = anylink_tap_endpoint_recv_bytes[i];
+        out.anylink_tap_endpoint_recv_errors = anylink_tap_endpoint_recv_errors[i];
+        out.anylink_tap_endpoint_recv_packets = anylink_tap_endpoint_recv_packets[i];
+        out.anylink_tap_endpoint_send_bytes = anylink_tap_endpoint_send_bytes[i];
+        out.anylink_tap_endpoint_send_errors = anylink_tap_endpoint_send_errors[i];
+        out.anylink_tap_endpoint_send_packets = anylink_tap_endpoint_send_packets[i];
+        return out;
+    }
+
+    // Copy row from of other into row to, both already sized
+    void copy_row(const std::size_t to, const sharemap_metrics_columns_t &other, const std::size_t from)
+    {
+        source_id[to] = other.source_id[from];
+        schema_hash[to] = other.schema_hash[from];
+        unix_timestamp_ns[to] = other.unix_timestamp_ns[from];
+        controld_version[to] = other.controld_version[from];
+        controld_timestamp[to] = other.controld_timestamp[from];
+        powerd_version[to] = other.powerd_version[from];
+        powerd_timestamp[to] = other.powerd_timestamp[from];
+        radiod_version[to] = other.radiod_version[from];
+        radiod_timestamp[to] = other.radiod_timestamp[from];
+        fpga_version[to] = other.fpga_version[from];
+        fpga_timestamp[to] = other.fpga_timestamp[from];
+        fpga_project_name[to] = other.fpga_project_name[from];
+        anylink_version[to] = other.anylink_version[from];
+        psk_cc_tx_bytes_total[to] = other.psk_cc_tx_bytes_total[from];
+        psk_cc_tx_underflows[to] = other.psk_cc_tx_underflows[from];
+        psk_cc_tx_client_recv_errors[to] = other.psk_cc_tx_client_recv_errors[from];
+        psk_cc_tx_client_msgs[to] = other.psk_cc_tx_client_msgs[from];
+        psk_cc_tx_frames_transmitted[to] = other.psk_cc_tx_frames_transmitted[from];
+        psk_cc_tx_failed_transmissions[to] = other.psk_cc_tx_failed_transmissions[from];
+        psk_cc_tx_dropped_packets[to] = other.psk_cc_tx_dropped_packets[from];
+        psk_cc_tx_idle_frames_transmitted[to] = other.psk_cc_tx_idle_frames_transmitted[from];
+        psk_cc_tx_failed_idle_frames_transmitted[to] = other.psk_cc_tx_failed_idle_frames_transmitted[from];
+        psk_cc_tx_failed_bytes_in_flight_checks[to] = other.psk_cc_tx_failed_bytes_in_flight_checks[from];
+        psk_cc_tx_modem_underflows[to] = other.psk_cc_tx_modem_underflows[from];
+        psk_cc_tx_ad9361_tx_pll_lock[to] = other.psk_cc_tx_ad9361_tx_pll_lock[from];
+        psk_cc_rx_bytes_total[to] = other.psk_cc_rx_bytes_total[from];
+        psk_cc_rx_client_send_errors[to] = other.psk_cc_rx_client_send_errors[from];
+        psk_cc_rx_client_msgs[to] = other.psk_cc_rx_client_msgs[from];
+        psk_cc_rx_frames_received[to] = other.psk_cc_rx_frames_received[from];
+        psk_cc_rx_failed_receptions[to] = other.psk_cc_rx_failed_receptions[from];
+        psk_cc_rx_dropped_good_packets[to] = other.psk_cc_rx_dropped_good_packets[from];
+        psk_cc_rx_failed_frames_available_checks[to] = other.psk_cc_rx_failed_frames_available_checks[from];
+        psk_cc_rx_encountered_frames_in_progress[to] = other.psk_cc_rx_encountered_frames_in_progress[from];
+        psk_cc_rx_modem_dma_overflows[to] = other.psk_cc_rx_modem_dma_overflows[from];
+        psk_cc_rx_modem_dma_packet_count[to] = other.psk_cc_rx_modem_dma_packet_count[from];
+        psk_cc_rx_signal_present[to] = other.psk_cc_rx_signal_present[from];
+        psk_cc_rx_carrier_lock[to] = other.psk_cc_rx_carrier_lock[from];
+        psk_cc_rx_frame_sync_lock[to] = other.psk_cc_rx_frame_sync_lock[from];
+        psk_cc_rx_fec_confirmed_lock[to] = other.psk_cc_rx_fec_confirmed_lock[from];
+        psk_cc_rx_fec_ber[to] = other.psk_cc_rx_fec_ber[from];
+        psk_cc_rx_ad9361_rx_pll_lock[to] = other.psk_cc_rx_ad9361_rx_pll_lock[from];
+        psk_cc_rx_ad9361_bb_pll_lock[to] = other.psk_cc_rx_ad9361_bb_pll_lock[from];
+        dvbs2_tx_bytes_total[to] = other.dvbs2_tx_bytes_total[from];
+        dvbs2_tx_underflows[to] = other.dvbs2_tx_underflows[from];
+        dvbs2_tx_client_recv_errors[to] = other.dvbs2_tx_client_recv_errors[from];
+        dvbs2_tx_client_msgs[to] = other.dvbs2_tx_client_msgs[from];
+        dvbs2_tx_frames_transmitted[to] = other.dvbs2_tx_frames_transmitted[from];
+        dvbs2_tx_failed_transmissions[to] = other.dvbs2_tx_failed_transmissions[from];
+        dvbs2_tx_dropped_packets[to] = other.dvbs2_tx_dropped_packets[from];
+        dvbs2_tx_idle_frames_transmitted[to] = other.dvbs2_tx_idle_frames_transmitted[from];
+        dvbs2_tx_failed_idle_frames_transmitted[to] = other.dvbs2_tx_failed_idle_frames_transmitted[from];
+        dvbs2_tx_failed_bytes_in_flight_checks[to] = other.dvbs2_tx_failed_bytes_in_flight_checks[from];
+        dvbs2_tx_dummy_pl_frames[to] = other.dvbs2_tx_dummy_pl_frames[from];
+        gfsk_tx_bytes_total[to] = other.gfsk_tx_bytes_total[from];
+        gfsk_tx_underflows[to] = other.gfsk_tx_underflows[from];
+        gfsk_tx_client_recv_errors[to] = other.gfsk_tx_client_recv_errors[from];
+        gfsk_tx_client_msgs[to] = other.gfsk_tx_client_msgs[from];
+        gfsk_tx_frames_transmitted[to] = other.gfsk_tx_frames_transmitted[from];
+        gfsk_tx_failed_transmissions[to] = other.gfsk_tx_failed_transmissions[from];
+        gfsk_tx_dropped_packets[to] = other.gfsk_tx_dropped_packets[from];
+        gfsk_tx_idle_frames_transmitted[to] = other.gfsk_tx_idle_frames_transmitted[from];
+        gfsk_tx_failed_idle_frames_transmitted[to] = other.gfsk_tx_failed_idle_frames_transmitted[from];
+        gfsk_tx_failed_bytes_in_flight_checks[to] = other.gfsk_tx_failed_bytes_in_flight_checks[from];
+        ad9122_pgood[to] = other.ad9122_pgood[from];
+        ad9361_pgood[to] = other.ad9361_pgood[from];
+        adrf6780_pgood[to] = other.adrf6780_pgood[from];
+        at86_pgood[to] = other.at86_pgood[from];
+        at86_is_pll_locked[to] = other.at86_is_pll_locked[from];
+        aux_3v8_isense[to] = other.aux_3v8_isense[from];
+        aux_3v8_vsense[to] = other.aux_3v8_vsense[from];
+        carrier_28v0_isense[to] = other.carrier_28v0_isense[from];
+        carrier_28v0_vsense[to] = other.carrier_28v0_vsense[from];
+        carrier_2v1_isense[to] = other.carrier_2v1_isense[from];
+        carrier_2v1_vsense[to] = other.carrier_2v1_vsense[from];
+        carrier_2v6_isense[to] = other.carrier_2v6_isense[from];
+        carrier_2v6_vsense[to] = other.carrier_2v6_vsense[from];
+        carrier_3v8_isense[to] = other.carrier_3v8_isense[from];
+        carrier_3v8_vsense[to] = other.carrier_3v8_vsense[from];
+        carrier_5v5_isense[to] = other.carrier_5v5_isense[from];
+        carrier_5v5_vsense[to] = other.carrier_5v5_vsense[from];
+        carrier_temp[to] = other.carrier_temp[from];
+        lband_rx_pgood[to] = other.lband_rx_pgood[from];
+        lband_temp[to] = other.lband_temp[from];
+        lband_tx_pgood[to] = other.lband_tx_pgood[from];
+        lband_tx_rf_detect[to] = other.lband_tx_rf_detect[from];
+        lmk04832_pgood[to] = other.lmk04832_pgood[from];
+        lmk04832_is_pll_locked[to] = other.lmk04832_is_pll_locked[from];
+        lmx2594_pgood[to] = other.lmx2594_pgood[from];
+        max2771_a_1_is_pll_locked[to] = other.max2771_a_1_is_pll_locked[from];
+        max2771_a_2_is_pll_locked[to] = other.max2771_a_2_is_pll_locked[from];
+        max2771_a_bias_pgood[to] = other.max2771_a_bias_pgood[from];
+        max2771_a_pgood[to] = other.max2771_a_pgood[from];
+        max2771_b_1_is_pll_locked[to] = other.max2771_b_1_is_pll_locked[from];
+        max2771_b_2_is_pll_locked[to] = other.max2771_b_2_is_pll_locked[from];
+        max2771_b_bias_pgood[to] = other.max2771_b_bias_pgood[from];
+        max2771_b_pgood[to] = other.max2771_b_pgood[from];
+        rf_fe_mux_pgood[to] = other.rf_fe_mux_pgood[from];
+        sband_rx_pgood[to] = other.sband_rx_pgood[from];
+        sband_temp[to] = other.sband_temp[from];
+        sband_tx_pgood[to] = other.sband_tx_pgood[from];
+        sband_tx_rf_detect[to] = other.sband_tx_rf_detect[from];
+        si5345_pgood[to] = other.si5345_pgood[from];
+        som_5v0_isense[to] = other.som_5v0_isense[from];
+        som_5v0_vsense[to] = other.som_5v0_vsense[from];
+        uhf_rx_pgood[to] = other.uhf_rx_pgood[from];
+        uhf_temp[to] = other.uhf_temp[from];
+        uhf_tx_pgood[to] = other.uhf_tx_pgood[from];
+        uhf_tx_rf_detect[to] = other.uhf_tx_rf_detect[from];
+        xband_24v0_isense[to] = other.xband_24v0_isense[from];
+        xband_24v0_vsense[to] = other.xband_24v0_vsense[from];
+        xband_drain_pgood[to] = other.xband_drain_pgood[from];
+        xband_temp[to] = other.xband_temp[from];
+        xband_tx_rf_detect[to] = other.xband_tx_rf_detect[from];
+        anylink_uhf_tx_sent_bytes[to] = other.anylink_uhf_tx_sent_bytes[from];
+        anylink_uhf_tx_sent_packets[to] = other.anylink_uhf_tx_sent_packets[from];
+        anylink_uhf_tx_sent_frames[to] = other.anylink_uhf_tx_sent_frames[from];
+        anylink_uhf_tx_overflow_frames[to] = other.anylink_uhf_tx_overflow_frames[from];
+        anylink_sband_tx_sent_bytes[to] = other.anylink_sband_tx_sent_bytes[from];
+        anylink_sband_tx_sent_packets[to] = other.anylink_sband_tx_sent_packets[from];
+        anylink_sband_tx_sent_frames[to] = other.anylink_sband_tx_sent_frames[from];
+        anylink_sband_tx_overflow_frames[to] = other.anylink_sband_tx_overflow_frames[from];
+        anylink_xband_tx_sent_bytes[to] = other.anylink_xband_tx_sent_bytes[from];
+        anylink_xband_tx_sent_packets[to] = other.anylink_xband_tx_sent_packets[from];
+        anylink_xband_tx_sent_frames[to] = other.anylink_xband_tx_sent_frames[from];
+        anylink_xband_tx_overflow_frames[to] = other.anylink_xband_tx_overflow_frames[from];
+        anylink_sband_rx_received_bytes[to] = other.anylink_sband_rx_received_bytes[from];
+        anylink_sband_rx_received_packets[to] = other.anylink_sband_rx_received_packets[from];
+        anylink_sband_rx_received_frames[to] = other.anylink_sband_rx_received_frames[from];
+        anylink_sband_rx_dropped_packets[to] = other.anylink_sband_rx_dropped_packets[from];
+        anylink_sband_rx_dropped_frames[to] = other.anylink_sband_rx_dropped_frames[from];
+        anylink_sband_rx_socket_errors[to] = other.anylink_sband_rx_socket_errors[from];
+        anylink_sband_rx_idle_frames[to] = other.anylink_sband_rx_idle_frames[from];
+        anylink_heartbeats_sent[to] = other.anylink_heartbeats_sent[from];
+        anylink_heartbeats_received[to] = other.anylink_heartbeats_received[from];
+        anylink_rx_radio_bad_header[to] = other.anylink_rx_radio_bad_header[from];
+        anylink_rx_radio_packets_received[to] = other.anylink_rx_radio_packets_received[from];
+        anylink_tx_radio_packets_send_errors[to] = other.anylink_tx_radio_packets_send_errors[from];
+        anylink_tx_radio_packets_sent[to] = other.anylink_tx_radio_packets_sent[from];
+        anylink_tx_radio_packet_nodest[to] = other.anylink_tx_radio_packet_nodest[from];
+        anylink_tx_radio_packet_truncate[to] = other.anylink_tx_radio_packet_truncate[from];
+        anylink_tx_radio_packet_pad[to] = other.anylink_tx_radio_packet_pad[from];
+        anylink_rx_radio_no_endpoint[to] = other.anylink_rx_radio_no_endpoint[from];
+        anylink_rx_radio_reject_echo[to] = other.anylink_rx_radio_reject_echo[from];
+        anylink_total_endpoint_packets_received[to] = other.anylink_total_endpoint_packets_received[from];
+        anylink_total_endpoint_packets_sent[to] = other.anylink_total_endpoint_packets_sent[from];
+        anylink_encryption_failed[to] = other.anylink_encryption_failed[from];
+        anylink_decryption_failed[to] = other.anylink_decryption_failed[from];
+        anylink_tap_endpoint_active_tx_channel[to] = other.anylink_tap_endpoint_active_tx_channel[from];
+        anylink_tap_endpoint_mtu[to] = other.anylink_tap_endpoint_mtu[from];
+        anylink_tap_endpoint_recv_bytes[to] = other.anylink_tap_endpoint_recv_bytes[from];
+        anylink_tap_endpoint_recv_errors[to] = other.anylink_tap_endpoint_recv_errors[from];
+        anylink_tap_endpoint_recv_packets[to] = other.anylink_tap_endpoint_recv_packets[from];
+        anylink_tap_endpoint_send_bytes[to] = other.anylink_tap_endpoint_send_bytes[from];
+        anylink_tap_endpoint_send_errors[to] = other.anylink_tap_endpoint_send_errors[from];
+        anylink_tap_endpoint_send_packets[to] = other.anylink_tap_endpoint_send_packets[from];
+    }
+};
+
+// Unpack straight into row of already sized columns, false if length is not PACKED_SIZE
+static inline bool sharemap_unpack(const std::uint8_t *in, const std::size_t length, sharemap_metrics_columns_t &out, const std::size_t row)
+{
+    if (length != sharemap_metrics_t::PACKED_SIZE)
+    {
+        return false;
+    }
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, source_id), out.source_id[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, schema_hash), out.schema_hash[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, unix_timestamp_ns), out.unix_timestamp_ns[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, controld_version), out.controld_version[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, controld_timestamp), out.controld_timestamp[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, powerd_version), out.powerd_version[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, powerd_timestamp), out.powerd_timestamp[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, radiod_version), out.radiod_version[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, radiod_timestamp), out.radiod_timestamp[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, fpga_version), out.fpga_version[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, fpga_timestamp), out.fpga_timestamp[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, fpga_project_name), out.fpga_project_name[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_version), out.anylink_version[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_tx_bytes_total), out.psk_cc_tx_bytes_total[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_tx_underflows), out.psk_cc_tx_underflows[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_tx_client_recv_errors), out.psk_cc_tx_client_recv_errors[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_tx_client_msgs), out.psk_cc_tx_client_msgs[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_tx_frames_transmitted), out.psk_cc_tx_frames_transmitted[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_tx_failed_transmissions), out.psk_cc_tx_failed_transmissions[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_tx_dropped_packets), out.psk_cc_tx_dropped_packets[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_tx_idle_frames_transmitted), out.psk_cc_tx_idle_frames_transmitted[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_tx_failed_idle_frames_transmitted), out.psk_cc_tx_failed_idle_frames_transmitted[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_tx_failed_bytes_in_flight_checks), out.psk_cc_tx_failed_bytes_in_flight_checks[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_tx_modem_underflows), out.psk_cc_tx_modem_underflows[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_tx_ad9361_tx_pll_lock), out.psk_cc_tx_ad9361_tx_pll_lock[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_rx_bytes_total), out.psk_cc_rx_bytes_total[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_rx_client_send_errors), out.psk_cc_rx_client_send_errors[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_rx_client_msgs), out.psk_cc_rx_client_msgs[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_rx_frames_received), out.psk_cc_rx_frames_received[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_rx_failed_receptions), out.psk_cc_rx_failed_receptions[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_rx_dropped_good_packets), out.psk_cc_rx_dropped_good_packets[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_rx_failed_frames_available_checks), out.psk_cc_rx_failed_frames_available_checks[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_rx_encountered_frames_in_progress), out.psk_cc_rx_encountered_frames_in_progress[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_rx_modem_dma_overflows), out.psk_cc_rx_modem_dma_overflows[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_rx_modem_dma_packet_count), out.psk_cc_rx_modem_dma_packet_count[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_rx_signal_present), out.psk_cc_rx_signal_present[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_rx_carrier_lock), out.psk_cc_rx_carrier_lock[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_rx_frame_sync_lock), out.psk_cc_rx_frame_sync_lock[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_rx_fec_confirmed_lock), out.psk_cc_rx_fec_confirmed_lock[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_rx_fec_ber), out.psk_cc_rx_fec_ber[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_rx_ad9361_rx_pll_lock), out.psk_cc_rx_ad9361_rx_pll_lock[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, psk_cc_rx_ad9361_bb_pll_lock), out.psk_cc_rx_ad9361_bb_pll_lock[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, dvbs2_tx_bytes_total), out.dvbs2_tx_bytes_total[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, dvbs2_tx_underflows), out.dvbs2_tx_underflows[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, dvbs2_tx_client_recv_errors), out.dvbs2_tx_client_recv_errors[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, dvbs2_tx_client_msgs), out.dvbs2_tx_client_msgs[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, dvbs2_tx_frames_transmitted), out.dvbs2_tx_frames_transmitted[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, dvbs2_tx_failed_transmissions), out.dvbs2_tx_failed_transmissions[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, dvbs2_tx_dropped_packets), out.dvbs2_tx_dropped_packets[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, dvbs2_tx_idle_frames_transmitted), out.dvbs2_tx_idle_frames_transmitted[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, dvbs2_tx_failed_idle_frames_transmitted), out.dvbs2_tx_failed_idle_frames_transmitted[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, dvbs2_tx_failed_bytes_in_flight_checks), out.dvbs2_tx_failed_bytes_in_flight_checks[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, dvbs2_tx_dummy_pl_frames), out.dvbs2_tx_dummy_pl_frames[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, gfsk_tx_bytes_total), out.gfsk_tx_bytes_total[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, gfsk_tx_underflows), out.gfsk_tx_underflows[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, gfsk_tx_client_recv_errors), out.gfsk_tx_client_recv_errors[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, gfsk_tx_client_msgs), out.gfsk_tx_client_msgs[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, gfsk_tx_frames_transmitted), out.gfsk_tx_frames_transmitted[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, gfsk_tx_failed_transmissions), out.gfsk_tx_failed_transmissions[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, gfsk_tx_dropped_packets), out.gfsk_tx_dropped_packets[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, gfsk_tx_idle_frames_transmitted), out.gfsk_tx_idle_frames_transmitted[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, gfsk_tx_failed_idle_frames_transmitted), out.gfsk_tx_failed_idle_frames_transmitted[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, gfsk_tx_failed_bytes_in_flight_checks), out.gfsk_tx_failed_bytes_in_flight_checks[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, ad9122_pgood), out.ad9122_pgood[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, ad9361_pgood), out.ad9361_pgood[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, adrf6780_pgood), out.adrf6780_pgood[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, at86_pgood), out.at86_pgood[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, at86_is_pll_locked), out.at86_is_pll_locked[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, aux_3v8_isense), out.aux_3v8_isense[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, aux_3v8_vsense), out.aux_3v8_vsense[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, carrier_28v0_isense), out.carrier_28v0_isense[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, carrier_28v0_vsense), out.carrier_28v0_vsense[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, carrier_2v1_isense), out.carrier_2v1_isense[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, carrier_2v1_vsense), out.carrier_2v1_vsense[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, carrier_2v6_isense), out.carrier_2v6_isense[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, carrier_2v6_vsense), out.carrier_2v6_vsense[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, carrier_3v8_isense), out.carrier_3v8_isense[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, carrier_3v8_vsense), out.carrier_3v8_vsense[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, carrier_5v5_isense), out.carrier_5v5_isense[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, carrier_5v5_vsense), out.carrier_5v5_vsense[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, carrier_temp), out.carrier_temp[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, lband_rx_pgood), out.lband_rx_pgood[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, lband_temp), out.lband_temp[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, lband_tx_pgood), out.lband_tx_pgood[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, lband_tx_rf_detect), out.lband_tx_rf_detect[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, lmk04832_pgood), out.lmk04832_pgood[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, lmk04832_is_pll_locked), out.lmk04832_is_pll_locked[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, lmx2594_pgood), out.lmx2594_pgood[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, max2771_a_1_is_pll_locked), out.max2771_a_1_is_pll_locked[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, max2771_a_2_is_pll_locked), out.max2771_a_2_is_pll_locked[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, max2771_a_bias_pgood), out.max2771_a_bias_pgood[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, max2771_a_pgood), out.max2771_a_pgood[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, max2771_b_1_is_pll_locked), out.max2771_b_1_is_pll_locked[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, max2771_b_2_is_pll_locked), out.max2771_b_2_is_pll_locked[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, max2771_b_bias_pgood), out.max2771_b_bias_pgood[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, max2771_b_pgood), out.max2771_b_pgood[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, rf_fe_mux_pgood), out.rf_fe_mux_pgood[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, sband_rx_pgood), out.sband_rx_pgood[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, sband_temp), out.sband_temp[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, sband_tx_pgood), out.sband_tx_pgood[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, sband_tx_rf_detect), out.sband_tx_rf_detect[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, si5345_pgood), out.si5345_pgood[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, som_5v0_isense), out.som_5v0_isense[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, som_5v0_vsense), out.som_5v0_vsense[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, uhf_rx_pgood), out.uhf_rx_pgood[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, uhf_temp), out.uhf_temp[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, uhf_tx_pgood), out.uhf_tx_pgood[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, uhf_tx_rf_detect), out.uhf_tx_rf_detect[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, xband_24v0_isense), out.xband_24v0_isense[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, xband_24v0_vsense), out.xband_24v0_vsense[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, xband_drain_pgood), out.xband_drain_pgood[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, xband_temp), out.xband_temp[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, xband_tx_rf_detect), out.xband_tx_rf_detect[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_uhf_tx_sent_bytes), out.anylink_uhf_tx_sent_bytes[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_uhf_tx_sent_packets), out.anylink_uhf_tx_sent_packets[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_uhf_tx_sent_frames), out.anylink_uhf_tx_sent_frames[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_uhf_tx_overflow_frames), out.anylink_uhf_tx_overflow_frames[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_sband_tx_sent_bytes), out.anylink_sband_tx_sent_bytes[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_sband_tx_sent_packets), out.anylink_sband_tx_sent_packets[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_sband_tx_sent_frames), out.anylink_sband_tx_sent_frames[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_sband_tx_overflow_frames), out.anylink_sband_tx_overflow_frames[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_xband_tx_sent_bytes), out.anylink_xband_tx_sent_bytes[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_xband_tx_sent_packets), out.anylink_xband_tx_sent_packets[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_xband_tx_sent_frames), out.anylink_xband_tx_sent_frames[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_xband_tx_overflow_frames), out.anylink_xband_tx_overflow_frames[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_sband_rx_received_bytes), out.anylink_sband_rx_received_bytes[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_sband_rx_received_packets), out.anylink_sband_rx_received_packets[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_sband_rx_received_frames), out.anylink_sband_rx_received_frames[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_sband_rx_dropped_packets), out.anylink_sband_rx_dropped_packets[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_sband_rx_dropped_frames), out.anylink_sband_rx_dropped_frames[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_sband_rx_socket_errors), out.anylink_sband_rx_socket_errors[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_sband_rx_idle_frames), out.anylink_sband_rx_idle_frames[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_heartbeats_sent), out.anylink_heartbeats_sent[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_heartbeats_received), out.anylink_heartbeats_received[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_rx_radio_bad_header), out.anylink_rx_radio_bad_header[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_rx_radio_packets_received), out.anylink_rx_radio_packets_received[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_tx_radio_packets_send_errors), out.anylink_tx_radio_packets_send_errors[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_tx_radio_packets_sent), out.anylink_tx_radio_packets_sent[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_tx_radio_packet_nodest), out.anylink_tx_radio_packet_nodest[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_tx_radio_packet_truncate), out.anylink_tx_radio_packet_truncate[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_tx_radio_packet_pad), out.anylink_tx_radio_packet_pad[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_rx_radio_no_endpoint), out.anylink_rx_radio_no_endpoint[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_rx_radio_reject_echo), out.anylink_rx_radio_reject_echo[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_total_endpoint_packets_received), out.anylink_total_endpoint_packets_received[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_total_endpoint_packets_sent), out.anylink_total_endpoint_packets_sent[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_encryption_failed), out.anylink_encryption_failed[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_decryption_failed), out.anylink_decryption_failed[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_tap_endpoint_active_tx_channel), out.anylink_tap_endpoint_active_tx_channel[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_tap_endpoint_mtu), out.anylink_tap_endpoint_mtu[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_tap_endpoint_recv_bytes), out.anylink_tap_endpoint_recv_bytes[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_tap_endpoint_recv_errors), out.anylink_tap_endpoint_recv_errors[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_tap_endpoint_recv_packets), out.anylink_tap_endpoint_recv_packets[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_tap_endpoint_send_bytes), out.anylink_tap_endpoint_send_bytes[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_tap_endpoint_send_errors), out.anylink_tap_endpoint_send_errors[row]);
+    anysignal::sharemap_unpack_field(in + offsetof(sharemap_metrics_packed_t, anylink_tap_endpoint_send_packets), out.anylink_tap_endpoint_send_packets[row]);
+    return true;
+}
+
+// Several sharemap frames in one datagram, see Sharemap.pack_bundle in sharemap_lib.py.
+// The header starts like every sharemap, so filters find SHAREMAP_BUNDLE_HASH at the usual offset.
+// Each entry is the frame's schema hash and length, followed by the packed frame.
+static constexpr std::uint64_t SHAREMAP_BUNDLE_HASH{0x6a75adcca70c830e};
+
+// Largest datagram payload that fits a 1500 byte MTU over IPv4
+static constexpr std::size_t SHAREMAP_BUNDLE_MTU_PAYLOAD{1472};
+
+struct sharemap_bundle_header_t
+{
+    std::uint8_t source_id[2]{};
+    std::uint8_t schema_hash[8]{};
+    std::uint8_t unix_timestamp_ns[8]{};
+    std::uint8_t count[2]{};
+} __attribute__((packed));
+
+struct sharemap_bundle_entry_t
+{
+    std::uint8_t schema_hash[8]{};
+    std::uint8_t length[2]{};
+} __attribute__((packed));
+
+static constexpr std::size_t SHAREMAP_BUNDLE_SCHEMA_HASH_OFFSET{offsetof(sharemap_bundle_header_t, schema_hash)};
+
+static_assert(sharemap_config_t::FITS_MTU_BUNDLE ==
+              (sizeof(sharemap_bundle_header_t) + sizeof(sharemap_bundle_entry_t) + sharemap_config_t::PACKED_SIZE <= SHAREMAP_BUNDLE_MTU_PAYLOAD));
+static_assert(sharemap_metrics_t::FITS_MTU_BUNDLE ==
+              (sizeof(sharemap_bundle_header_t) + sizeof(sharemap_bundle_entry_t) + sharemap_metrics_t::PACKED_SIZE <= SHAREMAP_BUNDLE_MTU_PAYLOAD));
+
+// Packs sharemaps one after another straight into a caller provided buffer
+class sharemap_bundle_writer
+{
+  public:
+    sharemap_bundle_writer(std::uint8_t *buff, const std::size_t capacity, const std::uint16_t source_id = 0)
+        : _buff(buff), _capacity(capacity), _source_id(source_id)
+    {
+        clear();
+    }
+
+    explicit sharemap_bundle_writer(std::span<std::uint8_t> buff, const std::uint16_t source_id = 0)
+        : sharemap_bundle_writer(buff.data(), buff.size(), source_id)
+    {
+    }
+
+    // Pack in as the next entry, false if it does not fit
+    template <typename Sharemap>
+    bool add(Sharemap &in)
+    {
+        const auto entry_size = sizeof(sharemap_bundle_entry_t) + Sharemap::PACKED_SIZE;
+        if (_size + entry_size > _capacity or _count == UINT16_MAX)
+        {
+            return false;
+        }
+        sharemap_pack_field(Sharemap::HASH, _buff + _size + offsetof(sharemap_bundle_entry_t, schema_hash));
+        sharemap_pack_field(std::uint16_t(Sharemap::PACKED_SIZE), _buff + _size + offsetof(sharemap_bundle_entry_t, length));
+        sharemap_pack_into(in, _buff + _size + sizeof(sharemap_bundle_entry_t));
+        _size += entry_size;
+        _count++;
+        sharemap_pack_field(_count, _buff + offsetof(sharemap_bundle_header_t, count));
+        sharemap_pack_field(time_ns_since_epoch(), _buff + offsetof(sharemap_bundle_header_t, unix_timestamp_ns));
+        return true;
+    }
+
+    // Start over with an empty bundle
+    void clear(void)
+    {
+        if (_capacity < sizeof(sharemap_bundle_header_t))
+        {
+            _size = _capacity; // nothing fits
+            return;
+        }
+        std::memset(_buff, 0, sizeof(sharemap_bundle_header_t));
+        sharemap_pack_field(_source_id, _buff + offsetof(sharemap_bundle_header_t, source_id));
+        sharemap_pack_field(SHAREMAP_BUNDLE_HASH, _buff + offsetof(sharemap_bundle_header_t, schema_hash));
+        _size = sizeof(sharemap_bundle_header_t);
+        _count = 0;
+    }
+
+    // Bytes of the bundle so far, ready to send once count() > 0
+    std::size_t size(void) const { return _size; }
+    std::span<const std::uint8_t> bytes(void) const { return {_buff, _size}; }
+    std::uint16_t count(void) const { return _count; }
+
+  private:
+    std::uint8_t *_buff;
+    std::size_t _capacity;
+    std::uint16_t _source_id;
+    std::size_t _size{0};
+    std::uint16_t _count{0};
+};
+
+// True if buff holds a bundle header
+static inline bool sharemap_is_bundle(const std::uint8_t *buff, const std::size_t length)
+{
+    std::uint64_t hash{};
+    if (length < sizeof(sharemap_bundle_header_t))
+    {
+        return false;
+    }
+    sharemap_unpack_field(buff + offsetof(sharemap_bundle_header_t, schema_hash), hash);
+    return hash == SHAREMAP_BUNDLE_HASH;
+}
+
+// Call fcn(std::uint64_t schema_hash, const std::uint8_t *frame, std::size_t length) for every entry.
+// Returns false, after calling fcn for the complete entries, if buff is not a well formed bundle.
+template <typename Fcn>
+bool sharemap_bundle_for_each(const std::uint8_t *buff, const std::size_t length, Fcn &&fcn)
+{
+    if (not sharemap_is_bundle(buff, length))
+    {
+        return false;
+    }
+    std::uint16_t count{};
+    sharemap_unpack_field(buff + offsetof(sharemap_bundle_header_t, count), count);
+
+    std::size_t offset = sizeof(sharemap_bundle_header_t);
+    for (std::uint16_t i = 0; i < count; i++)
+    {
+        std::uint64_t hash{};
+        std::uint16_t frame_length{};
+        if (offset + sizeof(sharemap_bundle_entry_t) > length)
+        {
+            return false;
+        }
+        sharemap_unpack_field(buff + offset + offsetof(sharemap_bundle_entry_t, schema_hash), hash);
+        sharemap_unpack_field(buff + offset + offsetof(sharemap_bundle_entry_t, length), frame_length);
+        offset += sizeof(sharemap_bundle_entry_t);
+        if (offset + frame_length > length)
+        {
+            return false;
+        }
+        fcn(hash, buff + offset, std::size_t(frame_length));
+        offset += frame_length;
+    }
+    return offset == length;
+}
+
 // Call a templated function on every sharemap
 #define anysignal_sharemap_for_each(fcn, ...) {\
         fcn<sharemap_config_t>(__VA_ARGS__); \
@@ -0,0 +1,208 @@
+#pragma once
+#include "sharemap.hpp"
+#include "source_slots.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace anysignal
+{
+
+// An alarm raised or cleared by a frame
+struct alarm_event_t
+{
+    std::uint16_t source_id{0};
+    std::int64_t unix_timestamp_ns{0}; // of the frame
+    size_t alarm{0};                   // index in the engine's alarms
+    bool raised{false};                // else cleared
+    double value{0.0};                 // of the field, or its increase for increases
+};
+
+// Evaluates a table of alarm rules (by default the ALARMS generated from alarms.yaml) on every
+// frame of every source. The rules are compiled into a flat program: the fields they read are
+// decoded once per frame into an array of operands, then every rule is a multiply and a compare
+// against its raise or clear threshold in one loop without branches, and only alarms that changed
+// state reach the callback. Each source keeps its own alarm states.
+// Not thread safe; one thread evaluates.
+template <typename Sharemap>
+class alarm_engine
+{
+  public:
+    using packed_t = typename Sharemap::packed_t;
+
+    // Throws std::runtime_error for an invalid source count or a rule naming a field not in the sharemap
+    explicit alarm_engine(const size_t max_sources, std::span<const sharemap_alarm_t> alarms = Sharemap::ALARMS);
+
+    // Evaluate every rule on a packed frame of its source_id and call fcn(const alarm_event_t &)
+    // for each alarm raised or cleared by it. False if the table is full of other sources.
+    template <typename Fcn>
+    bool evaluate(const std::uint8_t *packed, Fcn &&fcn);
+    template <typename Fcn>
+    bool evaluate(const packed_t &packed, Fcn &&fcn)
+    {
+        return evaluate(reinterpret_cast<const std::uint8_t *>(&packed), std::forward<Fcn>(fcn));
+    }
+
+    const sharemap_alarm_t &alarm(const size_t i) const { return _alarms[i]; }
+    size_t alarms(void) const { return _alarms.size(); }
+
+    // Is alarm i raised for source_id
+    bool active(const std::uint16_t source_id, const size_t i) const;
+
+  private:
+    // A field read by the rules, as is or as its increase since the previous frame
+    struct operand_t
+    {
+        const sharemap_field_t *field;
+        bool increase;
+    };
+
+    struct source_t
+    {
+        bool seen{false};
+        std::vector<std::uint64_t> previous; // counts of increase operands
+        std::vector<std::uint8_t> active;    // per rule
+    };
+
+    std::vector<sharemap_alarm_t> _alarms;
+    std::vector<operand_t> _operands;
+
+    // the program, one entry per rule: raised while sign * operand > (raised ? clear : set)
+    std::vector<std::uint32_t> _operand;
+    std::vector<double> _sign;
+    std::vector<double> _set;
+    std::vector<double> _clear;
+
+    std::vector<double> _values; // operands of the frame being evaluated
+    std::vector<std::uint8_t> _edges;
+    source_slots _slots;
+    std::vector<source_t> _sources; // by slot
+};
+
+} // namespace anysignal
+
+////////////////////////////////////////////////////////////////////////
+// implementation details
+////////////////////////////////////////////////////////////////////////
+
+#include <stdexcept>
+#include <string>
+#include <utility> //forward, move
+
+template <typename Sharemap>
+anysignal::alarm_engine<Sharemap>::alarm_engine(const size_t max_sources, std::span<const sharemap_alarm_t> alarms)
+    : _alarms(alarms.begin(), alarms.end()), _slots(max_sources)
+{
+    for (const auto &alarm : _alarms)
+    {
+        if (alarm.field >= Sharemap::FIELDS.size() or Sharemap::FIELDS[alarm.field].type == sharemap_type_t::string)
+        {
+            throw std::runtime_error("alarm " + std::string(alarm.name) + " reads no numeric field of sharemap " +
+                                     std::string(Sharemap::NAME));
+        }
+
+        // rules reading the same field share its operand
+        const operand_t operand{&Sharemap::FIELDS[alarm.field], alarm.kind == sharemap_alarm_kind_t::increases};
+        size_t index = 0;
+        while (index < _operands.size() and
+               (_operands[index].field != operand.field or _operands[index].increase != operand.increase))
+        {
+            index++;
+        }
+        if (index == _operands.size())
+        {
+            _operands.push_back(operand);
+        }
+
+        // below is above on the negated value
+        const double sign = alarm.kind == sharemap_alarm_kind_t::below ? -1.0 : 1.0;
+        _operand.push_back(std::uint32_t(index));
+        _sign.push_back(sign);
+        _set.push_back(sign * alarm.set);
+        _clear.push_back(sign * alarm.clear);
+    }
+    _values.resize(_operands.size());
+    _edges.resize(_alarms.size());
+    _sources.reserve(max_sources);
+}
+
+template <typename Sharemap>
+template <typename Fcn>
+bool anysignal::alarm_engine<Sharemap>::evaluate(const std::uint8_t *packed, Fcn &&fcn)
+{
+    std::uint16_t source_id;
+    sharemap_unpack_field(packed + offsetof(packed_t, source_id), source_id);
+
+    const auto slot = _slots.insert(source_id);
+    if (slot == source_slots::NO_SLOT)
+    {
+        return false;
+    }
+    if (slot == _sources.size())
+    {
+        source_t source;
+        source.previous.resize(_operands.size());
+        source.active.resize(_alarms.size());
+        _sources.push_back(std::move(source));
+    }
+    auto &source = _sources[slot];
+
+    // decode each field once; increases are taken on the raw count, 0 on the first frame
+    for (size_t o = 0; o < _operands.size(); o++)
+    {
+        const auto &operand = _operands[o];
+        const auto *in = packed + operand.field->offset;
+        if (not operand.increase)
+        {
+            _values[o] = sharemap_unpack_number(*operand.field, in);
+            continue;
+        }
+        const auto count = sharemap_unpack_integer(*operand.field, in);
+        _values[o] = source.seen ? double(std::int64_t(count - source.previous[o])) : 0.0;
+        source.previous[o] = count;
+    }
+    source.seen = true;
+
+    // every rule at once: the threshold is picked by the current state, an edge is a change of state
+    const auto *values = _values.data();
+    const auto *operands = _operand.data();
+    auto *active = source.active.data();
+    auto *edges = _edges.data();
+    std::uint8_t changed = 0;
+    for (size_t i = 0; i < _alarms.size(); i++)
+    {
+        const auto x = _sign[i] * values[operands[i]];
+        const auto was = active[i];
+        const std::uint8_t now = x > (was ? _clear[i] : _set[i]);
+        edges[i] = was ^ now;
+        active[i] = now;
+        changed |= edges[i];
+    }
+    if (not changed)
+    {
+        return true;
+    }
+
+    alarm_event_t event;
+    event.source_id = source_id;
+    sharemap_unpack_field(packed + offsetof(packed_t, unix_timestamp_ns), event.unix_timestamp_ns);
+    for (size_t i = 0; i < _alarms.size(); i++)
+    {
+        if (edges[i])
+        {
+            event.alarm = i;
+            event.raised = active[i];
+            event.value = values[operands[i]];
+            fcn(event);
+        }
+    }
+    return true;
+}
+
+template <typename Sharemap>
+bool anysignal::alarm_engine<Sharemap>::active(const std::uint16_t source_id, const size_t i) const
+{
+    const auto slot = _slots.find(source_id);
+    return slot != source_slots::NO_SLOT and i < _alarms.size() and _sources[slot].active[i] != 0;
+}
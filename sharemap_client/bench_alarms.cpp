@@ -0,0 +1,73 @@
+/***
+ * Rules evaluated per second by alarm_engine.hpp on metrics frames.
+ *
+ * Usage: bench_alarms [<rules>] [<sources>]
+ * The rules generated from alarms.yaml are repeated with shifted thresholds up to the rule count,
+ * and frames of drifting readings cycle through the sources so alarms now and then change state.
+ */
+#include "alarm_engine.hpp"
+#include "sharemap.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+using bench_clock = std::chrono::steady_clock;
+using metrics_t = anysignal::sharemap_metrics_t;
+
+int main(int argc, char *argv[])
+{
+    const size_t rule_count = argc > 1 ? std::stoul(argv[1]) : 1000;
+    const size_t sources = argc > 2 ? std::stoul(argv[2]) : 64;
+
+    std::vector<anysignal::sharemap_alarm_t> rules;
+    for (size_t i = 0; rules.size() < rule_count; i++)
+    {
+        auto rule = metrics_t::ALARMS[i % metrics_t::ALARMS.size()];
+        const auto shift = 0.001 * double(i / metrics_t::ALARMS.size());
+        if (rule.kind != anysignal::sharemap_alarm_kind_t::increases)
+        {
+            rule.set *= 1.0 + shift;
+            rule.clear *= 1.0 + shift;
+        }
+        rules.push_back(rule);
+    }
+
+    // readings of every source wander around the middle of the rail and temperature limits
+    std::mt19937_64 rng(1);
+    std::normal_distribution<double> noise(0.0, 0.02);
+    std::vector<metrics_t::packed_t> frames;
+    std::vector<metrics_t> state(sources);
+    for (size_t i = 0; i < 20000; i++)
+    {
+        auto &metrics = state[i % sources];
+        metrics.source_id = std::uint16_t(i % sources);
+        metrics.carrier_temp = 84.0 + 4.0 * noise(rng) * 50.0;
+        metrics.carrier_3v8_vsense = 3.8 * (1.0 + noise(rng));
+        metrics.som_5v0_vsense = 5.0 * (1.0 + noise(rng));
+        metrics.ad9361_pgood = rng() % 64 != 0;
+        metrics.psk_cc_tx_client_recv_errors += rng() % 16 == 0;
+        frames.push_back(anysignal::sharemap_pack(metrics));
+    }
+
+    anysignal::alarm_engine<metrics_t> engine(sources, rules);
+    size_t events = 0, evaluated = 0;
+    const auto count = [&](const anysignal::alarm_event_t &) { events++; };
+    const auto t0 = bench_clock::now();
+    while (bench_clock::now() - t0 < std::chrono::seconds(1))
+    {
+        for (const auto &frame : frames)
+        {
+            engine.evaluate(frame, count);
+        }
+        evaluated += frames.size();
+    }
+    const auto seconds = std::chrono::duration<double>(bench_clock::now() - t0).count();
+
+    printf("%zu rules, %zu sources\n", rules.size(), sources);
+    printf("%.2f M frames/s, %.1f M rules/s, %.2f events per frame\n", double(evaluated) / seconds / 1e6,
+           double(evaluated * rules.size()) / seconds / 1e6, double(events) / double(evaluated));
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,141 @@
+/***
+ * Compression ratio and speed of compressed_block.hpp on metrics frames.
+ *
+ * Usage: bench_compression [<recording directory>] [<frames per block>]
+ * Without a recording, a synthetic stream of steady counters and drifting floats is used.
+ * Frames of a recording are compressed per source, which is how the fields stay smooth.
+ */
+#include "compressed_block.hpp"
+#include "recorder_reader.hpp"
+#include "sharemap.hpp"
+#include "test_frames.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using bench_clock = std::chrono::steady_clock;
+using metrics_t = anysignal::sharemap_metrics_t;
+
+// Several radios reporting at a steady rate: counters, clocks, noisy floats, constant strings
+static std::vector<std::vector<metrics_t::packed_t>> synthetic(const size_t sources, const size_t frames)
+{
+    std::mt19937_64 rng(1);
+    std::normal_distribution<double> noise(0.0, 0.01);
+    std::vector<std::vector<metrics_t::packed_t>> out(sources);
+    for (size_t s = 0; s < sources; s++)
+    {
+        metrics_t metrics{};
+        metrics.source_id = std::uint16_t(s);
+        std::memcpy(metrics.controld_version.data(), "1.2.3", 5);
+        std::vector<double> level(metrics_t::FIELDS.size(), 20.0);
+        for (size_t i = 0; i < frames; i++)
+        {
+            // a 10 Hz clock with a little jitter
+            auto packed =
+                anysignal::packed_at(metrics, std::int64_t(1700000000000000000 + i * 100000000 + rng() % 50000));
+            auto *bytes = reinterpret_cast<std::uint8_t *>(&packed);
+            for (size_t f = 0; f < metrics_t::FIELDS.size(); f++)
+            {
+                const auto &field = metrics_t::FIELDS[f];
+                if (field.type == anysignal::sharemap_type_t::f32)
+                {
+                    level[f] += noise(rng);
+                    const auto value = float(level[f]);
+                    std::memcpy(bytes + field.offset, &value, sizeof(value));
+                }
+                else if (field.type == anysignal::sharemap_type_t::u64 and field.name.ends_with("_total"))
+                {
+                    anysignal::sharemap_pack_field(std::uint64_t(i * (1000 + f) + rng() % 100), bytes + field.offset);
+                }
+            }
+            out[s].push_back(packed);
+        }
+    }
+    return out;
+}
+
+static std::vector<std::vector<metrics_t::packed_t>> recorded(const std::string &directory)
+{
+    const anysignal::recorder_reader<metrics_t> reader(directory);
+    std::map<std::uint16_t, std::vector<metrics_t::packed_t>> by_source;
+    for (std::uint64_t i = 0; i < reader.size(); i++)
+    {
+        const auto view = reader[i];
+        auto &frames = by_source[view.source_id()];
+        frames.emplace_back();
+        std::memcpy(&frames.back(), view.frame(), sizeof(metrics_t::packed_t));
+    }
+    std::vector<std::vector<metrics_t::packed_t>> out;
+    for (auto &[source, frames] : by_source)
+    {
+        out.push_back(std::move(frames));
+    }
+    return out;
+}
+
+int main(int argc, char *argv[])
+{
+    const auto streams = argc > 1 ? recorded(argv[1]) : synthetic(16, 20000);
+    const size_t block_frames = argc > 2 ? std::stoul(argv[2]) : 1024;
+
+    size_t frames = 0;
+    for (const auto &stream : streams)
+    {
+        frames += stream.size();
+    }
+    if (frames == 0)
+    {
+        printf("no frames\n");
+        return EXIT_FAILURE;
+    }
+    const double raw_bytes = double(frames * metrics_t::PACKED_SIZE);
+
+    // encode every stream in blocks
+    std::vector<std::uint8_t> encoded;
+    anysignal::compressed_block_encoder<metrics_t> encoder;
+    const auto t0 = bench_clock::now();
+    for (const auto &stream : streams)
+    {
+        for (const auto &frame : stream)
+        {
+            encoder.add(frame);
+            if (encoder.size() == block_frames)
+            {
+                encoder.finish(encoded);
+            }
+        }
+        if (encoder.size() > 0)
+        {
+            encoder.finish(encoded);
+        }
+    }
+    const auto t1 = bench_clock::now();
+
+    // decode them all back
+    metrics_t::packed_t out;
+    size_t decoded = 0;
+    for (size_t offset = 0; offset < encoded.size();)
+    {
+        anysignal::compressed_block_decoder<metrics_t> decoder(encoded.data() + offset, encoded.size() - offset);
+        while (decoder.next(out))
+        {
+            decoded++;
+        }
+        offset += decoder.block_length();
+    }
+    const auto t2 = bench_clock::now();
+
+    const auto seconds = [](const auto d) { return std::chrono::duration<double>(d).count(); };
+    printf("%zu frames from %zu sources, %zu frames per block\n", frames, streams.size(), block_frames);
+    printf("raw %.1f MB, compressed %.2f MB, ratio %.1f, %.1f bytes per frame\n", raw_bytes / 1e6,
+           double(encoded.size()) / 1e6, raw_bytes / double(encoded.size()), double(encoded.size()) / double(frames));
+    printf("encode %.2f GB/s, decode %.2f GB/s (of raw frames)\n", raw_bytes / seconds(t1 - t0) / 1e9,
+           raw_bytes / seconds(t2 - t1) / 1e9);
+    return decoded == frames ? EXIT_SUCCESS : EXIT_FAILURE;
+}
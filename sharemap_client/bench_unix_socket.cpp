@@ -0,0 +1,136 @@
+/***
+ * Compare per-message latency and throughput of udp loopback and unix datagram sockets.
+ */
+#include "sharemap.hpp"
+#include "udp.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+using bench_clock = std::chrono::steady_clock;
+
+static constexpr size_t MESSAGE_SIZE = anysignal::sharemap_metrics_t::PACKED_SIZE;
+
+struct bench_result
+{
+    double rtt_p50_us{0};
+    double rtt_p99_us{0};
+    double msgs_per_sec{0};
+    double mbytes_per_sec{0};
+    size_t lost{0};
+};
+
+static void wait_send(anysignal::udp_sock &s, const void *buff, const size_t length)
+{
+    while (s.send(buff, length) < 0)
+    {
+        s.send_ready(std::chrono::milliseconds(10));
+    }
+}
+
+// Ping-pong a metrics sized message between two socket pairs, one way each
+static void bench_latency(const std::string &url_a, const std::string &url_b, const size_t iterations,
+                          bench_result &result)
+{
+    anysignal::udp_sock rx_a, tx_a, rx_b, tx_b;
+    rx_a.bind(url_a);
+    rx_b.bind(url_b);
+    tx_a.connect(url_b);
+    tx_b.connect(url_a);
+
+    std::atomic<bool> running{true};
+    std::thread echo([&] {
+        std::vector<std::uint8_t> buff(MESSAGE_SIZE);
+        while (running)
+        {
+            if (rx_b.recv_ready(std::chrono::milliseconds(10)))
+            {
+                auto r = rx_b.recv(buff.data(), buff.size());
+                if (r > 0)
+                    wait_send(tx_b, buff.data(), size_t(r));
+            }
+        }
+    });
+
+    std::vector<std::uint8_t> buff(MESSAGE_SIZE);
+    std::vector<double> rtts;
+    rtts.reserve(iterations);
+    for (size_t i = 0; i < iterations; i++)
+    {
+        const auto t0 = bench_clock::now();
+        wait_send(tx_a, buff.data(), buff.size());
+        while (not rx_a.recv_ready(std::chrono::milliseconds(1000)))
+        {
+        }
+        rx_a.recv(buff.data(), buff.size());
+        const auto t1 = bench_clock::now();
+        rtts.push_back(std::chrono::duration<double, std::micro>(t1 - t0).count());
+    }
+    running = false;
+    echo.join();
+
+    std::sort(rtts.begin(), rtts.end());
+    result.rtt_p50_us = rtts[rtts.size() / 2];
+    result.rtt_p99_us = rtts[rtts.size() * 99 / 100];
+}
+
+// Stream metrics sized messages as fast as the receiver takes them
+static void bench_throughput(const std::string &url, const size_t count, bench_result &result)
+{
+    anysignal::udp_sock rx, tx;
+    rx.bind(url);
+    tx.connect(url);
+
+    std::atomic<bool> sending{true};
+    size_t received = 0;
+    std::thread receiver([&] {
+        std::vector<std::uint8_t> buff(MESSAGE_SIZE);
+        while (rx.recv_ready(std::chrono::milliseconds(100)) or sending)
+        {
+            while (rx.recv(buff.data(), buff.size()) > 0)
+                received++;
+        }
+    });
+
+    std::vector<std::uint8_t> buff(MESSAGE_SIZE);
+    const auto t0 = bench_clock::now();
+    for (size_t i = 0; i < count; i++)
+    {
+        wait_send(tx, buff.data(), buff.size());
+    }
+    sending = false;
+    receiver.join();
+    const auto elapsed = std::chrono::duration<double>(bench_clock::now() - t0).count();
+
+    result.msgs_per_sec = double(received) / elapsed;
+    result.mbytes_per_sec = result.msgs_per_sec * MESSAGE_SIZE / 1e6;
+    result.lost = count - received;
+}
+
+int main(int argc, char *argv[])
+{
+    const size_t iterations = argc > 1 ? std::stoul(argv[1]) : 20000;
+    const size_t count = argc > 2 ? std::stoul(argv[2]) : 200000;
+
+    const std::vector<std::tuple<std::string, std::string, std::string>> transports{
+        {"udp://127.0.0.1", "udp://127.0.0.1:5631", "udp://127.0.0.1:5632"},
+        {"unix://@", "unix://@sharemap_bench_a", "unix://@sharemap_bench_b"},
+        {"unix:///tmp", "unix:///tmp/sharemap_bench_a.sock", "unix:///tmp/sharemap_bench_b.sock"},
+    };
+
+    printf("message size %zu bytes, %zu round trips, %zu streamed messages\n", MESSAGE_SIZE, iterations, count);
+    printf("%-14s %14s %14s %12s %10s %8s\n", "transport", "rtt p50 (us)", "rtt p99 (us)", "msgs/s", "MB/s", "lost");
+    for (const auto &[name, url_a, url_b] : transports)
+    {
+        bench_result result;
+        bench_latency(url_a, url_b, iterations, result);
+        bench_throughput(url_a, count, result);
+        printf("%-14s %14.2f %14.2f %12.0f %10.1f %8zu\n", name.c_str(), result.rtt_p50_us, result.rtt_p99_us,
+               result.msgs_per_sec, result.mbytes_per_sec, result.lost);
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,328 @@
+#pragma once
+#include "sharemap.hpp"
+#include "source_slots.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace anysignal
+{
+
+// Recent history of selected fields of a sharemap per source_id, as struct of arrays:
+// every source keeps a ring of the newest capacity samples with one contiguous, cache line
+// aligned column per stored field, so a scan over one field of one source reads only that
+// field. Columns hold host values (booleans as std::uint8_t, strings as their char arrays);
+// unix_timestamp_ns is always stored. A source's memory is allocated on its first frame and
+// is capacity times the size of the stored fields. Not thread safe; one thread appends and reads.
+template <typename Sharemap>
+class column_store
+{
+  public:
+    using packed_t = typename Sharemap::packed_t;
+    static constexpr size_t NO_COLUMN{~size_t(0)};
+
+    // Keep capacity samples of fields (every field if empty) for up to max_sources sources.
+    // Throws std::runtime_error for a field not in the sharemap.
+    column_store(const size_t max_sources, const size_t capacity, const std::vector<std::string_view> &fields = {});
+
+    // Append a packed frame to the history of its source_id, false if the store is full of other sources
+    bool append(const std::uint8_t *packed);
+    bool append(const packed_t &packed) { return append(reinterpret_cast<const std::uint8_t *>(&packed)); }
+
+    // Column of a stored field, NO_COLUMN if the field is not stored
+    size_t column(const std::string_view name) const;
+    const sharemap_field_t &field(const size_t column) const { return *_fields[column]; }
+    size_t columns(void) const { return _fields.size(); }
+
+    // Samples held for source_id, up to capacity
+    size_t size(const std::uint16_t source_id) const;
+
+    // Samples of a column, oldest first, as at most two contiguous runs (the ring wraps).
+    // T must have the size of the field's host type, std::runtime_error otherwise.
+    template <typename T>
+    std::array<std::span<const T>, 2> samples(const std::uint16_t source_id, const size_t column) const;
+
+    // Sender timestamps of the samples, oldest first
+    std::array<std::span<const std::int64_t>, 2> timestamps(const std::uint16_t source_id) const
+    {
+        return samples<std::int64_t>(source_id, _timestamp_column);
+    }
+
+    // Call fcn(std::uint16_t source_id) for every source in the store
+    template <typename Fcn>
+    void for_each_source(Fcn &&fcn) const;
+
+    // Bytes a source holds per sample
+    size_t sample_bytes(void) const { return _sample_bytes; }
+
+  private:
+    static constexpr size_t ALIGNMENT{64};
+
+    struct free_deleter
+    {
+        void operator()(std::uint8_t *p) const { std::free(p); }
+    };
+
+    struct source_t
+    {
+        std::uint16_t source_id{0};
+        std::uint64_t appended{0}; // samples ever appended
+        std::unique_ptr<std::uint8_t, free_deleter> data;
+    };
+
+    size_t _capacity{0};
+    size_t _timestamp_column{0};
+    size_t _sample_bytes{0};
+    std::vector<const sharemap_field_t *> _fields;
+    std::vector<size_t> _column_offsets; // bytes from the start of a source's data
+    size_t _source_bytes{0};
+    source_slots _slots;
+    std::vector<source_t> _sources; // by slot
+};
+
+// Count, minimum, maximum and mean of numeric samples, e.g. from column_store::samples
+template <typename T>
+struct column_summary_t
+{
+    size_t count{0};
+    T min{};
+    T max{};
+    double mean{0.0};
+};
+
+// Summary of runs of samples, in loops compilers turn into vector instructions
+template <typename T>
+column_summary_t<T> column_summary(const std::array<std::span<const T>, 2> &runs);
+
+} // namespace anysignal
+
+////////////////////////////////////////////////////////////////////////
+// implementation details
+////////////////////////////////////////////////////////////////////////
+
+#include <algorithm> //find, none_of, min
+#include <cstdlib>   //aligned_alloc
+#include <cstring>   //memcpy
+#include <stdexcept>
+#include <string>
+
+namespace anysignal
+{
+
+// Decode a packed field into its host representation
+static inline void column_store_unpack(const sharemap_field_t &field, const std::uint8_t *in, std::uint8_t *out)
+{
+    const auto unpack = [&]<typename T>(T *) {
+        T value;
+        sharemap_unpack_field(in, value);
+        std::memcpy(out, &value, sizeof(value));
+    };
+    switch (field.type)
+    {
+    case sharemap_type_t::u8:
+    case sharemap_type_t::boolean:
+        return unpack(static_cast<std::uint8_t *>(nullptr));
+    case sharemap_type_t::u16:
+        return unpack(static_cast<std::uint16_t *>(nullptr));
+    case sharemap_type_t::u32:
+        return unpack(static_cast<std::uint32_t *>(nullptr));
+    case sharemap_type_t::u64:
+        return unpack(static_cast<std::uint64_t *>(nullptr));
+    case sharemap_type_t::i8:
+        return unpack(static_cast<std::int8_t *>(nullptr));
+    case sharemap_type_t::i16:
+        return unpack(static_cast<std::int16_t *>(nullptr));
+    case sharemap_type_t::i32:
+        return unpack(static_cast<std::int32_t *>(nullptr));
+    case sharemap_type_t::i64:
+        return unpack(static_cast<std::int64_t *>(nullptr));
+    case sharemap_type_t::f32:
+        return unpack(static_cast<float *>(nullptr));
+    case sharemap_type_t::f64:
+        return unpack(static_cast<double *>(nullptr));
+    case sharemap_type_t::string:
+        return unpack(static_cast<std::array<char, STRING_BUFFER_SIZE> *>(nullptr));
+    }
+}
+
+} // namespace anysignal
+
+template <typename Sharemap>
+anysignal::column_store<Sharemap>::column_store(const size_t max_sources, const size_t capacity,
+                                                const std::vector<std::string_view> &fields)
+    : _capacity(capacity), _slots(max_sources)
+{
+    if (capacity == 0)
+    {
+        throw std::runtime_error("invalid column store configuration");
+    }
+
+    for (const auto &name : fields)
+    {
+        if (std::none_of(Sharemap::FIELDS.begin(), Sharemap::FIELDS.end(),
+                         [&](const sharemap_field_t &f) { return f.name == name; }))
+        {
+            throw std::runtime_error("no field " + std::string(name) + " in sharemap " + std::string(Sharemap::NAME));
+        }
+    }
+    for (const auto &field : Sharemap::FIELDS)
+    {
+        if (fields.empty() or field.name == "unix_timestamp_ns" or
+            std::find(fields.begin(), fields.end(), field.name) != fields.end())
+        {
+            _fields.push_back(&field);
+        }
+    }
+    _timestamp_column = column("unix_timestamp_ns");
+
+    // host values have the packed size, every column starts on a cache line
+    for (const auto *field : _fields)
+    {
+        _column_offsets.push_back(_source_bytes);
+        _sample_bytes += field->size;
+        _source_bytes += (capacity * field->size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    }
+    _sources.reserve(max_sources);
+}
+
+template <typename Sharemap>
+size_t anysignal::column_store<Sharemap>::column(const std::string_view name) const
+{
+    for (size_t c = 0; c < _fields.size(); c++)
+    {
+        if (_fields[c]->name == name)
+        {
+            return c;
+        }
+    }
+    return NO_COLUMN;
+}
+
+template <typename Sharemap>
+bool anysignal::column_store<Sharemap>::append(const std::uint8_t *packed)
+{
+    std::uint16_t source_id;
+    sharemap_unpack_field(packed + offsetof(packed_t, source_id), source_id);
+    auto slot = _slots.find(source_id);
+    if (slot == source_slots::NO_SLOT)
+    {
+        if (_slots.size() == _slots.max_sources())
+        {
+            return false;
+        }
+        auto *data = static_cast<std::uint8_t *>(std::aligned_alloc(ALIGNMENT, _source_bytes));
+        if (data == nullptr)
+        {
+            return false;
+        }
+        slot = _slots.insert(source_id);
+        _sources.push_back(source_t{source_id, 0, decltype(source_t::data)(data)});
+    }
+
+    auto &source = _sources[slot];
+    const auto position = size_t(source.appended % _capacity);
+    for (size_t c = 0; c < _fields.size(); c++)
+    {
+        const auto &field = *_fields[c];
+        column_store_unpack(field, packed + field.offset,
+                            source.data.get() + _column_offsets[c] + position * field.size);
+    }
+    source.appended++;
+    return true;
+}
+
+template <typename Sharemap>
+size_t anysignal::column_store<Sharemap>::size(const std::uint16_t source_id) const
+{
+    const auto slot = _slots.find(source_id);
+    return slot == source_slots::NO_SLOT ? 0 : size_t(std::min<std::uint64_t>(_sources[slot].appended, _capacity));
+}
+
+template <typename Sharemap>
+template <typename T>
+std::array<std::span<const T>, 2> anysignal::column_store<Sharemap>::samples(const std::uint16_t source_id,
+                                                                            const size_t column) const
+{
+    if (column >= _fields.size() or sizeof(T) != _fields[column]->size)
+    {
+        throw std::runtime_error("column type does not match the field");
+    }
+    const auto slot = _slots.find(source_id);
+    if (slot == source_slots::NO_SLOT)
+    {
+        return {};
+    }
+    const auto &source = _sources[slot];
+    const auto *data = reinterpret_cast<const T *>(source.data.get() + _column_offsets[column]);
+    if (source.appended <= _capacity)
+    {
+        return {std::span<const T>(data, size_t(source.appended)), std::span<const T>()};
+    }
+    // the oldest sample is where the next one goes
+    const auto next = size_t(source.appended % _capacity);
+    return {std::span<const T>(data + next, _capacity - next), std::span<const T>(data, next)};
+}
+
+template <typename Sharemap>
+template <typename Fcn>
+void anysignal::column_store<Sharemap>::for_each_source(Fcn &&fcn) const
+{
+    for (const auto &source : _sources)
+    {
+        fcn(source.source_id);
+    }
+}
+
+template <typename T>
+anysignal::column_summary_t<T> anysignal::column_summary(const std::array<std::span<const T>, 2> &runs)
+{
+    column_summary_t<T> out;
+    out.count = runs[0].size() + runs[1].size();
+    if (out.count == 0)
+    {
+        return out;
+    }
+    const auto first = runs[0].empty() ? runs[1][0] : runs[0][0];
+
+    // independent lanes, so the loop vectorizes without reordering floating point operations
+    constexpr size_t LANES{8};
+    std::array<double, LANES> sums{};
+    std::array<T, LANES> mins, maxs;
+    mins.fill(first);
+    maxs.fill(first);
+    for (const auto &run : runs)
+    {
+        size_t i = 0;
+        for (; i + LANES <= run.size(); i += LANES)
+        {
+            for (size_t j = 0; j < LANES; j++)
+            {
+                const auto v = run[i + j];
+                sums[j] += double(v);
+                mins[j] = v < mins[j] ? v : mins[j];
+                maxs[j] = v > maxs[j] ? v : maxs[j];
+            }
+        }
+        for (; i < run.size(); i++)
+        {
+            const auto v = run[i];
+            sums[0] += double(v);
+            mins[0] = v < mins[0] ? v : mins[0];
+            maxs[0] = v > maxs[0] ? v : maxs[0];
+        }
+    }
+    double sum = 0.0;
+    out.min = out.max = first;
+    for (size_t j = 0; j < LANES; j++)
+    {
+        sum += sums[j];
+        out.min = mins[j] < out.min ? mins[j] : out.min;
+        out.max = maxs[j] > out.max ? maxs[j] : out.max;
+    }
+    out.mean = sum / double(out.count);
+    return out;
+}
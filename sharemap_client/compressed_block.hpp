@@ -0,0 +1,589 @@
+#pragma once
+#include "sharemap.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace anysignal
+{
+
+// Compressed blocks of packed frames of one sharemap, one bit stream per field, driven by
+// the generated FIELDS table. Integers (timestamps, counters, ...) are delta-of-delta coded,
+// floats XOR coded against the previous value as in Facebook's Gorilla, booleans and strings
+// run-length coded. Decoding gives back the packed frames bit for bit.
+//
+// Block layout, host byte order: a compressed_block_header_t, the encoded byte length of
+// each field as std::uint32_t in FIELDS order, then the field streams back to back.
+
+static constexpr std::uint32_t COMPRESSED_BLOCK_MAGIC{0x62636d73}; //"smcb"
+
+struct compressed_block_header_t
+{
+    std::uint32_t magic;  // COMPRESSED_BLOCK_MAGIC
+    std::uint32_t frames; // frames in the block
+    std::uint64_t hash;   // schema hash
+    std::uint32_t fields; // number of field streams
+    std::uint32_t reserved;
+};
+
+// Most significant bit first bit stream
+class bit_writer
+{
+  public:
+    // Append the low bits of value (bits up to 64)
+    void write(const std::uint64_t value, const unsigned bits);
+
+    // Append the stream, padded to whole bytes, to out
+    void flush_into(std::vector<std::uint8_t> &out) const;
+
+    size_t bytes(void) const { return _bytes.size() + (_acc_bits + 7) / 8; }
+    void clear(void);
+
+  private:
+    std::vector<std::uint8_t> _bytes;
+    std::uint64_t _acc{0};
+    unsigned _acc_bits{0};
+};
+
+class bit_reader
+{
+  public:
+    bit_reader(void) = default;
+    bit_reader(const std::uint8_t *data, const size_t length) : _data(data), _length(length) {}
+
+    // Next bits (up to 64) of the stream, zeros past its end
+    std::uint64_t read(const unsigned bits);
+
+  private:
+    const std::uint8_t *_data{nullptr};
+    size_t _length{0};
+    size_t _position{0};
+    std::uint64_t _buffer{0};
+    unsigned _buffer_bits{0};
+};
+
+enum class compressed_block_coding
+{
+    delta_of_delta,
+    xor_float,
+    run_length,
+};
+
+static constexpr compressed_block_coding compressed_block_coding_of(const sharemap_type_t type)
+{
+    switch (type)
+    {
+    case sharemap_type_t::f32:
+    case sharemap_type_t::f64:
+        return compressed_block_coding::xor_float;
+    case sharemap_type_t::boolean:
+    case sharemap_type_t::string:
+        return compressed_block_coding::run_length;
+    default:
+        return compressed_block_coding::delta_of_delta;
+    }
+}
+
+// Coding of every field of a sharemap, worked out at compile time
+template <typename Sharemap>
+constexpr auto compressed_block_codings(void)
+{
+    std::array<compressed_block_coding, Sharemap::FIELDS.size()> codings{};
+    for (size_t f = 0; f < codings.size(); f++)
+    {
+        codings[f] = compressed_block_coding_of(Sharemap::FIELDS[f].type);
+    }
+    return codings;
+}
+
+// Adds packed frames one at a time; only the compressed streams are kept in memory
+template <typename Sharemap>
+class compressed_block_encoder
+{
+  public:
+    using packed_t = typename Sharemap::packed_t;
+
+    compressed_block_encoder(void);
+
+    void add(const std::uint8_t *packed);
+    void add(const packed_t &packed) { add(reinterpret_cast<const std::uint8_t *>(&packed)); }
+
+    // Frames added since the last finish
+    size_t size(void) const { return _frames; }
+
+    // Append the block to out and start a new one
+    void finish(std::vector<std::uint8_t> &out);
+
+  private:
+    struct field_state
+    {
+        bit_writer bits;
+        std::uint64_t previous{0};
+        std::uint64_t previous_delta{0};
+        unsigned leading{0};
+        unsigned trailing{0};
+        bool window{false};
+        std::uint32_t run{0};
+        std::array<std::uint8_t, 64> run_value{};
+    };
+
+    void flush_run(const sharemap_field_t &field, field_state &state);
+
+    static constexpr auto CODINGS{compressed_block_codings<Sharemap>()};
+
+    std::array<field_state, Sharemap::FIELDS.size()> _states;
+    size_t _frames{0};
+};
+
+// Gives back the packed frames of a block one at a time, in the order they were added
+template <typename Sharemap>
+class compressed_block_decoder
+{
+  public:
+    using packed_t = typename Sharemap::packed_t;
+
+    // Parse the block header, throws std::runtime_error if the block does not match the sharemap
+    compressed_block_decoder(const std::uint8_t *block, const size_t length);
+
+    // Frames in the block
+    size_t size(void) const { return _frames; }
+
+    // Bytes of the block, where the next block starts in a stream of blocks
+    size_t block_length(void) const { return _block_length; }
+
+    // Decode the next frame into PACKED_SIZE bytes at packed, false after the last one
+    bool next(std::uint8_t *packed);
+    bool next(packed_t &packed) { return next(reinterpret_cast<std::uint8_t *>(&packed)); }
+
+  private:
+    struct field_state
+    {
+        bit_reader bits;
+        std::uint64_t previous{0};
+        std::uint64_t previous_delta{0};
+        unsigned leading{0};
+        unsigned trailing{0};
+        std::uint32_t run{0};
+        std::array<std::uint8_t, 64> run_value{};
+    };
+
+    static constexpr auto CODINGS{compressed_block_codings<Sharemap>()};
+
+    std::array<field_state, Sharemap::FIELDS.size()> _states;
+    size_t _frames{0};
+    size_t _decoded{0};
+    size_t _block_length{0};
+};
+
+} // namespace anysignal
+
+////////////////////////////////////////////////////////////////////////
+// implementation details
+////////////////////////////////////////////////////////////////////////
+
+#include <bit> //countl_zero, countr_zero
+#include <cstring>
+#include <stdexcept>
+
+namespace anysignal
+{
+
+static inline std::uint64_t compressed_block_mask(const unsigned bits)
+{
+    return bits >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << bits) - 1;
+}
+
+static inline void compressed_block_store_int(const sharemap_field_t &field, std::uint64_t value, std::uint8_t *out)
+{
+    for (size_t i = field.size; i > 0; i--)
+    {
+        out[i - 1] = std::uint8_t(value);
+        value >>= 8;
+    }
+}
+
+// Float field bits as packed, the byte order does not matter as long as it is restored the same
+static inline std::uint64_t compressed_block_load_float(const sharemap_field_t &field, const std::uint8_t *in)
+{
+    if (field.size == sizeof(std::uint32_t))
+    {
+        std::uint32_t value;
+        std::memcpy(&value, in, sizeof(value));
+        return value;
+    }
+    std::uint64_t value;
+    std::memcpy(&value, in, sizeof(value));
+    return value;
+}
+
+static inline void compressed_block_store_float(const sharemap_field_t &field, const std::uint64_t value,
+                                                std::uint8_t *out)
+{
+    if (field.size == sizeof(std::uint32_t))
+    {
+        const auto narrow = std::uint32_t(value);
+        std::memcpy(out, &narrow, sizeof(narrow));
+        return;
+    }
+    std::memcpy(out, &value, sizeof(value));
+}
+
+} // namespace anysignal
+
+inline void anysignal::bit_writer::write(const std::uint64_t value, const unsigned bits)
+{
+    // at most 32 bits at a time, so the accumulator never holds more than 39
+    if (bits > 32)
+    {
+        write(value >> 32, bits - 32);
+        write(value, 32);
+        return;
+    }
+    _acc = (_acc << bits) | (value & compressed_block_mask(bits));
+    _acc_bits += bits;
+    while (_acc_bits >= 8)
+    {
+        _acc_bits -= 8;
+        _bytes.push_back(std::uint8_t(_acc >> _acc_bits));
+    }
+}
+
+inline void anysignal::bit_writer::flush_into(std::vector<std::uint8_t> &out) const
+{
+    out.insert(out.end(), _bytes.begin(), _bytes.end());
+    if (_acc_bits > 0)
+    {
+        out.push_back(std::uint8_t(_acc << (8 - _acc_bits)));
+    }
+}
+
+inline void anysignal::bit_writer::clear(void)
+{
+    _bytes.clear();
+    _acc = 0;
+    _acc_bits = 0;
+}
+
+inline std::uint64_t anysignal::bit_reader::read(const unsigned bits)
+{
+    if (bits > 32)
+    {
+        const auto high = read(bits - 32);
+        return (high << 32) | read(32);
+    }
+    while (_buffer_bits < bits)
+    {
+        _buffer = (_buffer << 8) | (_position < _length ? _data[_position] : 0);
+        _position++;
+        _buffer_bits += 8;
+    }
+    _buffer_bits -= bits;
+    return (_buffer >> _buffer_bits) & compressed_block_mask(bits);
+}
+
+template <typename Sharemap>
+anysignal::compressed_block_encoder<Sharemap>::compressed_block_encoder(void)
+{
+    for (const auto &field : Sharemap::FIELDS)
+    {
+        if (field.size > std::tuple_size_v<decltype(field_state::run_value)>)
+        {
+            throw std::runtime_error("field too large to compress: " + std::string(field.name));
+        }
+    }
+}
+
+template <typename Sharemap>
+void anysignal::compressed_block_encoder<Sharemap>::add(const std::uint8_t *packed)
+{
+    for (size_t f = 0; f < Sharemap::FIELDS.size(); f++)
+    {
+        const auto &field = Sharemap::FIELDS[f];
+        auto &state = _states[f];
+        const auto *in = packed + field.offset;
+        const auto width = unsigned(field.size * 8);
+
+        switch (CODINGS[f])
+        {
+        case compressed_block_coding::delta_of_delta: {
+            const auto value = sharemap_unpack_integer(field, in);
+            if (_frames == 0)
+            {
+                state.bits.write(value, width);
+            }
+            else
+            {
+                // a steady counter or clock has a delta of delta of 0, one bit per frame
+                const auto delta = value - state.previous;
+                const auto dod = std::int64_t(delta - state.previous_delta);
+                const auto zigzag = (std::uint64_t(dod) << 1) ^ std::uint64_t(dod >> 63);
+                if (zigzag == 0)
+                {
+                    state.bits.write(0b0, 1);
+                }
+                else if (zigzag < (1u << 7))
+                {
+                    state.bits.write(0b10, 2);
+                    state.bits.write(zigzag, 7);
+                }
+                else if (zigzag < (1u << 9))
+                {
+                    state.bits.write(0b110, 3);
+                    state.bits.write(zigzag, 9);
+                }
+                else if (zigzag < (1u << 12))
+                {
+                    state.bits.write(0b1110, 4);
+                    state.bits.write(zigzag, 12);
+                }
+                else
+                {
+                    state.bits.write(0b1111, 4);
+                    state.bits.write(zigzag, 64);
+                }
+                state.previous_delta = delta;
+            }
+            state.previous = value;
+            break;
+        }
+        case compressed_block_coding::xor_float: {
+            const auto value = compressed_block_load_float(field, in);
+            if (_frames == 0)
+            {
+                state.bits.write(value, width);
+            }
+            else
+            {
+                // a drifting value changes only its low mantissa bits
+                const auto x = value ^ state.previous;
+                if (x == 0)
+                {
+                    state.bits.write(0b0, 1);
+                }
+                else
+                {
+                    const auto leading = unsigned(std::countl_zero(x)) - (64 - width);
+                    const auto trailing = unsigned(std::countr_zero(x));
+                    if (state.window and leading >= state.leading and trailing >= state.trailing)
+                    {
+                        state.bits.write(0b10, 2);
+                        state.bits.write(x >> state.trailing, width - state.leading - state.trailing);
+                    }
+                    else
+                    {
+                        const auto length = width - leading - trailing;
+                        state.bits.write(0b11, 2);
+                        state.bits.write(leading, 6);
+                        state.bits.write(length - 1, 6);
+                        state.bits.write(x >> trailing, length);
+                        state.leading = leading;
+                        state.trailing = trailing;
+                        state.window = true;
+                    }
+                }
+            }
+            state.previous = value;
+            break;
+        }
+        case compressed_block_coding::run_length: {
+            if (state.run > 0 and std::memcmp(state.run_value.data(), in, field.size) != 0)
+            {
+                flush_run(field, state);
+            }
+            if (state.run == 0)
+            {
+                std::memcpy(state.run_value.data(), in, field.size);
+            }
+            state.run++;
+            break;
+        }
+        }
+    }
+    _frames++;
+}
+
+template <typename Sharemap>
+void anysignal::compressed_block_encoder<Sharemap>::flush_run(const sharemap_field_t &field, field_state &state)
+{
+    // run length as a varint, 7 bits per byte, then the value
+    for (auto run = state.run;; run >>= 7)
+    {
+        const bool more = run >= 0x80;
+        state.bits.write((run & 0x7F) | (more ? 0x80 : 0), 8);
+        if (not more)
+        {
+            break;
+        }
+    }
+    for (size_t i = 0; i < field.size; i++)
+    {
+        state.bits.write(state.run_value[i], 8);
+    }
+    state.run = 0;
+}
+
+template <typename Sharemap>
+void anysignal::compressed_block_encoder<Sharemap>::finish(std::vector<std::uint8_t> &out)
+{
+    constexpr auto FIELD_COUNT = Sharemap::FIELDS.size();
+    for (size_t f = 0; f < FIELD_COUNT; f++)
+    {
+        if (_states[f].run > 0)
+        {
+            flush_run(Sharemap::FIELDS[f], _states[f]);
+        }
+    }
+
+    compressed_block_header_t header{};
+    header.magic = COMPRESSED_BLOCK_MAGIC;
+    header.frames = std::uint32_t(_frames);
+    header.hash = Sharemap::HASH;
+    header.fields = std::uint32_t(FIELD_COUNT);
+    const auto start = out.size();
+    out.resize(start + sizeof(header) + FIELD_COUNT * sizeof(std::uint32_t));
+    std::memcpy(out.data() + start, &header, sizeof(header));
+    for (size_t f = 0; f < FIELD_COUNT; f++)
+    {
+        const auto length = std::uint32_t(_states[f].bits.bytes());
+        std::memcpy(out.data() + start + sizeof(header) + f * sizeof(length), &length, sizeof(length));
+    }
+    for (auto &state : _states)
+    {
+        state.bits.flush_into(out);
+        state = field_state{};
+    }
+    _frames = 0;
+}
+
+template <typename Sharemap>
+anysignal::compressed_block_decoder<Sharemap>::compressed_block_decoder(const std::uint8_t *block,
+                                                                        const size_t length)
+{
+    constexpr auto FIELD_COUNT = Sharemap::FIELDS.size();
+    compressed_block_header_t header{};
+    const auto streams = sizeof(header) + FIELD_COUNT * sizeof(std::uint32_t);
+    if (length >= sizeof(header))
+    {
+        std::memcpy(&header, block, sizeof(header));
+    }
+    if (length < streams or header.magic != COMPRESSED_BLOCK_MAGIC or header.hash != Sharemap::HASH or
+        header.fields != FIELD_COUNT)
+    {
+        throw std::runtime_error("not a compressed block of sharemap " + std::string(Sharemap::NAME));
+    }
+
+    size_t offset = streams;
+    for (size_t f = 0; f < FIELD_COUNT; f++)
+    {
+        std::uint32_t field_length;
+        std::memcpy(&field_length, block + sizeof(header) + f * sizeof(field_length), sizeof(field_length));
+        if (offset + field_length > length)
+        {
+            throw std::runtime_error("truncated compressed block of sharemap " + std::string(Sharemap::NAME));
+        }
+        _states[f].bits = bit_reader(block + offset, field_length);
+        offset += field_length;
+    }
+    _frames = header.frames;
+    _block_length = offset;
+}
+
+template <typename Sharemap>
+bool anysignal::compressed_block_decoder<Sharemap>::next(std::uint8_t *packed)
+{
+    if (_decoded == _frames)
+    {
+        return false;
+    }
+    for (size_t f = 0; f < Sharemap::FIELDS.size(); f++)
+    {
+        const auto &field = Sharemap::FIELDS[f];
+        auto &state = _states[f];
+        auto *out = packed + field.offset;
+        const auto width = unsigned(field.size * 8);
+
+        switch (CODINGS[f])
+        {
+        case compressed_block_coding::delta_of_delta: {
+            if (_decoded == 0)
+            {
+                state.previous = state.bits.read(width);
+                // sign extend like the encoder did
+                compressed_block_store_int(field, state.previous, out);
+                state.previous = sharemap_unpack_integer(field, out);
+                break;
+            }
+            std::uint64_t zigzag = 0;
+            if (state.bits.read(1) != 0)
+            {
+                if (state.bits.read(1) == 0)
+                {
+                    zigzag = state.bits.read(7);
+                }
+                else if (state.bits.read(1) == 0)
+                {
+                    zigzag = state.bits.read(9);
+                }
+                else if (state.bits.read(1) == 0)
+                {
+                    zigzag = state.bits.read(12);
+                }
+                else
+                {
+                    zigzag = state.bits.read(64);
+                }
+            }
+            const auto dod = (zigzag >> 1) ^ (~(zigzag & 1) + 1);
+            state.previous_delta += dod;
+            state.previous += state.previous_delta;
+            compressed_block_store_int(field, state.previous, out);
+            break;
+        }
+        case compressed_block_coding::xor_float: {
+            if (_decoded == 0)
+            {
+                state.previous = state.bits.read(width);
+            }
+            else if (state.bits.read(1) != 0)
+            {
+                if (state.bits.read(1) != 0)
+                {
+                    state.leading = unsigned(state.bits.read(6));
+                    const auto length = unsigned(state.bits.read(6)) + 1;
+                    state.trailing = width - state.leading - length;
+                }
+                const auto length = width - state.leading - state.trailing;
+                state.previous ^= state.bits.read(length) << state.trailing;
+            }
+            compressed_block_store_float(field, state.previous, out);
+            break;
+        }
+        case compressed_block_coding::run_length: {
+            if (state.run == 0)
+            {
+                std::uint32_t run = 0;
+                for (unsigned shift = 0; shift < 32; shift += 7)
+                {
+                    const auto byte = state.bits.read(8);
+                    run |= std::uint32_t(byte & 0x7F) << shift;
+                    if ((byte & 0x80) == 0)
+                    {
+                        break;
+                    }
+                }
+                for (size_t i = 0; i < field.size; i++)
+                {
+                    state.run_value[i] = std::uint8_t(state.bits.read(8));
+                }
+                state.run = run;
+            }
+            std::memcpy(out, state.run_value.data(), field.size);
+            state.run -= (state.run > 0);
+            break;
+        }
+        }
+    }
+    _decoded++;
+    return true;
+}
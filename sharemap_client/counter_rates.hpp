@@ -0,0 +1,161 @@
+#pragma once
+#include "sharemap.hpp"
+#include "source_slots.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace anysignal
+{
+
+// Number of fields marked counter in a sharemap's schema
+template <typename Sharemap>
+constexpr size_t counter_rates_count(void)
+{
+    size_t count = 0;
+    for (const auto &field : Sharemap::FIELDS)
+    {
+        count += field.counter ? 1 : 0;
+    }
+    return count;
+}
+
+// Per-second rates of every counter of a sharemap per source_id. Each source keeps its previous
+// counts, and a frame's rates are worked out for all counters at once in one branch-free loop over
+// arrays, using the frames' unix_timestamp_ns as the time base. A count below the previous one
+// wrapped around its field's width when the previous count was in the upper half of the range,
+// otherwise the counter restarted from zero and the new count is the increase.
+// Not thread safe; one thread updates.
+template <typename Sharemap>
+class counter_rates
+{
+  public:
+    using packed_t = typename Sharemap::packed_t;
+    static constexpr size_t COUNTERS{counter_rates_count<Sharemap>()};
+
+    // Track counts of up to max_sources sources, throws std::runtime_error for an invalid count
+    explicit counter_rates(const size_t max_sources);
+
+    // The field of counter k, in the order of the schema
+    static constexpr const sharemap_field_t &field(const size_t k) { return Sharemap::FIELDS[FIELD_INDEXES[k]]; }
+
+    // Rates per second of the counters since the previous frame of its source_id into rates,
+    // COUNTERS long. False when there are no rates: the first frame of a source, a frame not newer
+    // than the previous one (which is otherwise ignored) or a table full of other sources.
+    bool update(const std::uint8_t *packed, std::span<double, COUNTERS> rates);
+    bool update(const packed_t &packed, std::span<double, COUNTERS> rates)
+    {
+        return update(reinterpret_cast<const std::uint8_t *>(&packed), rates);
+    }
+
+    // Same for a source already given a slot (below max_sources) by the caller's own source_slots,
+    // so containers that map sources themselves do not need a second map in here
+    bool update(const std::uint32_t slot, const std::uint8_t *packed, std::span<double, COUNTERS> rates);
+
+  private:
+    static constexpr auto FIELD_INDEXES{[] {
+        std::array<size_t, COUNTERS> indexes{};
+        for (size_t f = 0, k = 0; f < Sharemap::FIELDS.size(); f++)
+        {
+            if (Sharemap::FIELDS[f].counter)
+            {
+                indexes[k++] = f;
+            }
+        }
+        return indexes;
+    }()};
+
+    // all ones in the width of each counter
+    static constexpr auto MASKS{[] {
+        std::array<std::uint64_t, COUNTERS> masks{};
+        for (size_t k = 0; k < COUNTERS; k++)
+        {
+            const auto bits = 8 * Sharemap::FIELDS[FIELD_INDEXES[k]].size;
+            masks[k] = bits >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << bits) - 1;
+        }
+        return masks;
+    }()};
+
+    struct source_t
+    {
+        bool seen{false};
+        std::int64_t previous_ns{0};
+        std::array<std::uint64_t, COUNTERS> previous{};
+    };
+
+    source_slots _slots; // only used by update without a slot, allocated on first use
+    std::vector<source_t> _sources; // by slot
+};
+
+} // namespace anysignal
+
+////////////////////////////////////////////////////////////////////////
+// implementation details
+////////////////////////////////////////////////////////////////////////
+
+template <typename Sharemap>
+anysignal::counter_rates<Sharemap>::counter_rates(const size_t max_sources)
+    : _slots(max_sources)
+{
+    _sources.reserve(max_sources);
+}
+
+template <typename Sharemap>
+bool anysignal::counter_rates<Sharemap>::update(const std::uint8_t *packed, std::span<double, COUNTERS> rates)
+{
+    std::uint16_t source_id;
+    sharemap_unpack_field(packed + offsetof(packed_t, source_id), source_id);
+    const auto slot = _slots.insert(source_id);
+    return slot != source_slots::NO_SLOT and update(slot, packed, rates);
+}
+
+template <typename Sharemap>
+bool anysignal::counter_rates<Sharemap>::update(const std::uint32_t slot, const std::uint8_t *packed,
+                                                std::span<double, COUNTERS> rates)
+{
+    if (slot >= _slots.max_sources())
+    {
+        return false;
+    }
+    if (slot >= _sources.size())
+    {
+        _sources.resize(slot + 1);
+    }
+    auto &source = _sources[slot];
+
+    std::int64_t timestamp;
+    sharemap_unpack_field(packed + offsetof(packed_t, unix_timestamp_ns), timestamp);
+
+    // gather the counts into one array
+    std::array<std::uint64_t, COUNTERS> counts;
+    for (size_t k = 0; k < COUNTERS; k++)
+    {
+        counts[k] = sharemap_unpack_integer(field(k), packed + field(k).offset);
+    }
+
+    if (not source.seen)
+    {
+        source = source_t{true, timestamp, counts};
+        return false;
+    }
+    if (timestamp <= source.previous_ns)
+    {
+        return false;
+    }
+
+    const double per_second = 1e9 / double(timestamp - source.previous_ns);
+    for (size_t k = 0; k < COUNTERS; k++)
+    {
+        const auto previous = source.previous[k];
+        const auto count = counts[k];
+        const auto wrapped = (count - previous) & MASKS[k];
+        // selected with masks rather than branches, so the loop vectorizes
+        const auto restarted = -std::uint64_t((count < previous) & (previous <= (MASKS[k] >> 1)));
+        rates[k] = double((count & restarted) | (wrapped & ~restarted)) * per_second;
+    }
+    source.previous = counts;
+    source.previous_ns = timestamp;
+    return true;
+}
@@ -0,0 +1,236 @@
+#pragma once
+#include "sharemap.hpp"
+#include "source_slots.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace anysignal
+{
+
+// Time constants of the moving averages: 1 s, 10 s and 1 min
+static inline const std::vector<std::int64_t> FIELD_STATS_DEFAULT_TAUS{1'000'000'000, 10'000'000'000,
+                                                                       60'000'000'000};
+
+// Running statistics of one field of one source
+struct field_stats_t
+{
+    std::uint64_t count{0};
+    double mean{0.0};
+    double variance{0.0}; // sample variance
+    double min{0.0};
+    double max{0.0};
+};
+
+// Streaming statistics of the numeric gauges of a sharemap per source_id: the count, mean and
+// variance (Welford), min and max since the first frame, and exponentially weighted moving
+// averages at several time constants, weighted by the time between frames' unix_timestamp_ns.
+// Every statistic is an array over the fields, so a frame updates them all in a few loops that
+// vectorize. Counters are left out; see counter_rates for their rates.
+// Not thread safe; one thread updates and reads.
+template <typename Sharemap>
+class field_stats
+{
+  public:
+    using packed_t = typename Sharemap::packed_t;
+    static constexpr size_t NO_COLUMN{~size_t(0)};
+
+    // Throws std::runtime_error for an invalid source count or a time constant that is not positive
+    field_stats(const size_t max_sources, const std::vector<std::int64_t> &taus_ns = FIELD_STATS_DEFAULT_TAUS);
+
+    // Add a packed frame to the statistics of its source_id, false if the table is full of other sources
+    bool update(const std::uint8_t *packed);
+    bool update(const packed_t &packed) { return update(reinterpret_cast<const std::uint8_t *>(&packed)); }
+
+    // Column of a gauge, NO_COLUMN for counters, strings, the common header and unknown names
+    size_t column(const std::string_view name) const;
+    const sharemap_field_t &field(const size_t column) const { return *_fields[column]; }
+    size_t columns(void) const { return _fields.size(); }
+
+    const std::vector<std::int64_t> &taus(void) const { return _taus_ns; }
+
+    // Statistics of a column, a count of 0 for a source without frames
+    field_stats_t stats(const std::uint16_t source_id, const size_t column) const;
+
+    // Moving average of a column with time constant taus()[tau]
+    double ewma(const std::uint16_t source_id, const size_t column, const size_t tau) const;
+
+    // Bytes of statistics held per source
+    size_t source_bytes(void) const
+    {
+        return sizeof(source_t) + _fields.size() * (STATS + _taus_ns.size()) * sizeof(double);
+    }
+
+  private:
+    static constexpr size_t STATS{4}; // mean, m2, min, max, then one moving average per time constant
+
+    struct source_t
+    {
+        std::uint64_t count{0};
+        std::int64_t previous_ns{0};
+        std::vector<double> stats; // STATS + taus arrays of columns() values
+    };
+
+    std::vector<std::int64_t> _taus_ns;
+    std::vector<const sharemap_field_t *> _fields;
+    std::vector<double> _values; // of the frame being added
+    source_slots _slots;
+    std::vector<source_t> _sources; // by slot
+};
+
+} // namespace anysignal
+
+////////////////////////////////////////////////////////////////////////
+// implementation details
+////////////////////////////////////////////////////////////////////////
+
+#include <algorithm> //copy, max
+#include <cmath>     //expm1
+#include <limits>
+#include <stdexcept>
+
+template <typename Sharemap>
+anysignal::field_stats<Sharemap>::field_stats(const size_t max_sources, const std::vector<std::int64_t> &taus_ns)
+    : _taus_ns(taus_ns), _slots(max_sources)
+{
+    for (const auto tau : taus_ns)
+    {
+        if (tau <= 0)
+        {
+            throw std::runtime_error("invalid field stats time constant");
+        }
+    }
+
+    for (const auto &field : Sharemap::FIELDS)
+    {
+        if (field.type == sharemap_type_t::string or field.counter or field.name == "source_id" or
+            field.name == "schema_hash" or field.name == "unix_timestamp_ns" or field.name == "sequence")
+        {
+            continue;
+        }
+        _fields.push_back(&field);
+    }
+    _values.resize(_fields.size());
+    _sources.reserve(max_sources);
+}
+
+template <typename Sharemap>
+size_t anysignal::field_stats<Sharemap>::column(const std::string_view name) const
+{
+    for (size_t c = 0; c < _fields.size(); c++)
+    {
+        if (_fields[c]->name == name)
+        {
+            return c;
+        }
+    }
+    return NO_COLUMN;
+}
+
+template <typename Sharemap>
+bool anysignal::field_stats<Sharemap>::update(const std::uint8_t *packed)
+{
+    std::uint16_t source_id;
+    sharemap_unpack_field(packed + offsetof(packed_t, source_id), source_id);
+    std::int64_t timestamp;
+    sharemap_unpack_field(packed + offsetof(packed_t, unix_timestamp_ns), timestamp);
+
+    const auto slot = _slots.insert(source_id);
+    if (slot == source_slots::NO_SLOT)
+    {
+        return false;
+    }
+    if (slot == _sources.size())
+    {
+        source_t source;
+        source.stats.resize(_fields.size() * (STATS + _taus_ns.size()));
+        _sources.push_back(std::move(source));
+    }
+    auto &source = _sources[slot];
+
+    const auto columns = _fields.size();
+    for (size_t c = 0; c < columns; c++)
+    {
+        _values[c] = sharemap_unpack_number(*_fields[c], packed + _fields[c]->offset);
+    }
+
+    // the first frame starts every statistic at its value
+    const auto n = ++source.count;
+    const auto *values = _values.data();
+    auto *mean = source.stats.data();
+    auto *m2 = mean + columns;
+    auto *min = m2 + columns;
+    auto *max = min + columns;
+    if (n == 1)
+    {
+        for (size_t c = 0; c < columns; c++)
+        {
+            mean[c] = min[c] = max[c] = values[c];
+            m2[c] = 0.0;
+        }
+        for (size_t t = 0; t < _taus_ns.size(); t++)
+        {
+            std::copy(values, values + columns, max + (t + 1) * columns);
+        }
+        source.previous_ns = timestamp;
+        return true;
+    }
+
+    const double weight = 1.0 / double(n);
+    for (size_t c = 0; c < columns; c++)
+    {
+        const auto v = values[c];
+        const auto delta = v - mean[c];
+        mean[c] += delta * weight;
+        m2[c] += delta * (v - mean[c]);
+        min[c] = v < min[c] ? v : min[c];
+        max[c] = v > max[c] ? v : max[c];
+    }
+
+    // a frame moves each average by 1 - e^(-dt / tau); frames out of order leave them alone
+    const auto dt = timestamp > source.previous_ns ? double(timestamp - source.previous_ns) : 0.0;
+    for (size_t t = 0; t < _taus_ns.size(); t++)
+    {
+        const auto alpha = -std::expm1(-dt / double(_taus_ns[t]));
+        auto *ewma = max + (t + 1) * columns;
+        for (size_t c = 0; c < columns; c++)
+        {
+            ewma[c] += alpha * (values[c] - ewma[c]);
+        }
+    }
+    source.previous_ns = std::max(source.previous_ns, timestamp);
+    return true;
+}
+
+template <typename Sharemap>
+anysignal::field_stats_t anysignal::field_stats<Sharemap>::stats(const std::uint16_t source_id,
+                                                                 const size_t column) const
+{
+    const auto slot = _slots.find(source_id);
+    if (slot == source_slots::NO_SLOT or column >= _fields.size())
+    {
+        return {};
+    }
+    const auto &source = _sources[slot];
+    const auto columns = _fields.size();
+    field_stats_t out;
+    out.count = source.count;
+    out.mean = source.stats[column];
+    out.variance = source.count > 1 ? source.stats[columns + column] / double(source.count - 1) : 0.0;
+    out.min = source.stats[2 * columns + column];
+    out.max = source.stats[3 * columns + column];
+    return out;
+}
+
+template <typename Sharemap>
+double anysignal::field_stats<Sharemap>::ewma(const std::uint16_t source_id, const size_t column,
+                                              const size_t tau) const
+{
+    const auto slot = _slots.find(source_id);
+    if (slot == source_slots::NO_SLOT or column >= _fields.size() or tau >= _taus_ns.size())
+    {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    return _sources[slot].stats[(STATS + tau) * _fields.size() + column];
+}
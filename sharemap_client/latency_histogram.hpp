@@ -0,0 +1,153 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace anysignal
+{
+
+// Log bucketed histogram of latencies in nanoseconds, in the style of HdrHistogram.
+// Values below 16 ns get a bucket each; every power of two above is split in 8 buckets,
+// so a bucket is at most 12.5% wide. Values from 2^36 ns (about 69 s) share the last bucket.
+// One thread records without locks or read-modify-write instructions; other threads take snapshots.
+class latency_histogram
+{
+  public:
+    static constexpr size_t LINEAR_BUCKETS{16};
+    static constexpr size_t SUB_BUCKET_BITS{3};
+    static constexpr size_t SUB_BUCKETS{size_t(1) << SUB_BUCKET_BITS};
+    static constexpr size_t MAX_EXPONENT{36};
+    static constexpr size_t BUCKETS{LINEAR_BUCKETS + (MAX_EXPONENT - 4) * SUB_BUCKETS};
+
+    struct snapshot_t
+    {
+        std::array<std::uint32_t, BUCKETS> counts{};
+        std::uint64_t count{0};
+        std::uint64_t negative{0}; // values below zero, recorded as 0 (e.g. clock offset between hosts)
+        std::uint64_t sum{0};
+        std::uint64_t max{0};
+
+        // Value at percentile (0 to 100), the midpoint of the bucket it falls in
+        std::uint64_t percentile(const double p) const;
+
+        double mean(void) const { return count == 0 ? 0.0 : double(sum) / double(count); }
+    };
+
+    // Record a value (single writer only)
+    void record(const std::int64_t value_ns);
+
+    // Copy of the counters, consistent per counter but not across them
+    snapshot_t snapshot(void) const;
+
+    static size_t bucket(const std::uint64_t value);
+    static std::uint64_t bucket_lower(const size_t index);
+    static std::uint64_t bucket_upper(const size_t index); // exclusive
+
+  private:
+    std::array<std::atomic<std::uint32_t>, BUCKETS> _counts{};
+    std::atomic<std::uint64_t> _count{0};
+    std::atomic<std::uint64_t> _negative{0};
+    std::atomic<std::uint64_t> _sum{0};
+    std::atomic<std::uint64_t> _max{0};
+};
+
+} // namespace anysignal
+
+////////////////////////////////////////////////////////////////////////
+// implementation details
+////////////////////////////////////////////////////////////////////////
+
+#include <bit> //bit_width
+
+inline size_t anysignal::latency_histogram::bucket(const std::uint64_t value)
+{
+    if (value < LINEAR_BUCKETS)
+    {
+        return size_t(value);
+    }
+    const auto exponent = size_t(std::bit_width(value)) - 1;
+    if (exponent >= MAX_EXPONENT)
+    {
+        return BUCKETS - 1;
+    }
+    const auto sub = size_t(value >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+    return LINEAR_BUCKETS + (exponent - 4) * SUB_BUCKETS + sub;
+}
+
+inline std::uint64_t anysignal::latency_histogram::bucket_lower(const size_t index)
+{
+    if (index < LINEAR_BUCKETS)
+    {
+        return index;
+    }
+    const auto exponent = (index - LINEAR_BUCKETS) / SUB_BUCKETS + 4;
+    const auto sub = (index - LINEAR_BUCKETS) % SUB_BUCKETS;
+    return (std::uint64_t(SUB_BUCKETS + sub)) << (exponent - SUB_BUCKET_BITS);
+}
+
+inline std::uint64_t anysignal::latency_histogram::bucket_upper(const size_t index)
+{
+    return index + 1 < BUCKETS ? bucket_lower(index + 1) : std::uint64_t(1) << MAX_EXPONENT;
+}
+
+inline void anysignal::latency_histogram::record(const std::int64_t value_ns)
+{
+    // the only writer, plain load and store instead of locked read-modify-write
+    const auto increment = [](auto &counter, const auto delta) {
+        counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    };
+    if (value_ns < 0)
+    {
+        increment(_negative, 1u);
+    }
+    const auto value = value_ns < 0 ? std::uint64_t(0) : std::uint64_t(value_ns);
+    increment(_counts[bucket(value)], 1u);
+    increment(_sum, value);
+    if (value > _max.load(std::memory_order_relaxed))
+    {
+        _max.store(value, std::memory_order_relaxed);
+    }
+    _count.store(_count.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+inline anysignal::latency_histogram::snapshot_t anysignal::latency_histogram::snapshot(void) const
+{
+    snapshot_t s;
+    s.count = _count.load(std::memory_order_acquire);
+    s.negative = _negative.load(std::memory_order_relaxed);
+    s.sum = _sum.load(std::memory_order_relaxed);
+    s.max = _max.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < BUCKETS; i++)
+    {
+        s.counts[i] = _counts[i].load(std::memory_order_relaxed);
+    }
+    return s;
+}
+
+inline std::uint64_t anysignal::latency_histogram::snapshot_t::percentile(const double p) const
+{
+    // total from the buckets, count may be a few records ahead of them
+    std::uint64_t total = 0;
+    for (const auto c : counts)
+    {
+        total += c;
+    }
+    if (total == 0)
+    {
+        return 0;
+    }
+
+    const auto rank = std::uint64_t(p / 100.0 * double(total - 1)) + 1;
+    std::uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKETS; i++)
+    {
+        seen += counts[i];
+        if (seen >= rank)
+        {
+            const auto mid = bucket_lower(i) + (bucket_upper(i) - 1 - bucket_lower(i)) / 2;
+            return mid < max ? mid : max;
+        }
+    }
+    return max;
+}
@@ -0,0 +1,420 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace anysignal
+{
+
+// Append-only log of received frames of one sharemap, split in segment files.
+// Each segment is a RECORDER_HEADER_SIZE header block followed by fixed size records:
+// a recorder_record_t then the packed frame as received. Files use host byte order.
+// Records are never written partially apart from a crash, and unused preallocated
+// space reads back as zeros, so a record with recv_ns 0 marks the end of a segment.
+
+static constexpr std::uint64_t RECORDER_MAGIC{0x736d7265636f7631}; //"smrecov1"
+static constexpr size_t RECORDER_HEADER_SIZE{4096};
+static constexpr size_t RECORDER_BLOCK_SIZE{4096}; // alignment of O_DIRECT buffers, offsets and lengths
+
+struct recorder_file_header_t
+{
+    std::uint64_t magic;       // RECORDER_MAGIC
+    std::uint64_t hash;        // schema hash of the frames
+    std::uint32_t header_size; // offset of the first record
+    std::uint32_t record_size; // sizeof(recorder_record_t) + frame_size
+    std::uint32_t frame_size;  // PACKED_SIZE of the sharemap
+    std::uint32_t segment;     // index of this file in the recording, from 0
+    std::int64_t created_ns;   // CLOCK_REALTIME when the recording started
+    char name[32];             // sharemap name, nul terminated
+};
+
+struct recorder_record_t
+{
+    std::int64_t recv_ns;     // receive time, CLOCK_REALTIME
+    std::uint16_t source_id;  // sender of the frame
+    std::uint8_t reserved[6]; // zero
+};
+
+struct recorder_options
+{
+    std::string directory{"."};
+    size_t segment_bytes{size_t(1) << 30}; // record bytes per segment, rounded down to whole blocks of records
+    size_t buffer_bytes{size_t(4) << 20};  // size of each of the two write buffers, rounded up to whole blocks
+    bool direct_io{false};                 // bypass the page cache (O_DIRECT), not every filesystem allows it
+    bool preallocate{false};               // reserve each segment on disk when it is opened (fallocate)
+};
+
+// Segment file name: <directory>/<name>-<start unix seconds>-<segment>.smrec,
+// so the files of a recording sort in order.
+std::string recorder_segment_path(const std::string &directory, const std::string_view name,
+                                  const std::int64_t created_ns, const std::uint32_t segment);
+
+// Records frames from one thread, e.g. the receive loop, and writes them from its own thread.
+// append copies into one of two large buffers and never waits: a full buffer is handed to
+// the writer thread, and when the writer still holds the other one the frame is dropped
+// and counted rather than stalling the receiver.
+template <typename Sharemap>
+class recorder
+{
+  public:
+    using packed_t = typename Sharemap::packed_t;
+    static constexpr size_t RECORD_SIZE{sizeof(recorder_record_t) + Sharemap::PACKED_SIZE};
+
+    // Open the first segment and start the writer thread, throws std::runtime_error on failure
+    explicit recorder(const recorder_options &options);
+    recorder(const recorder &) = delete;
+    recorder &operator=(const recorder &) = delete;
+    ~recorder(void);
+
+    // Append a PACKED_SIZE frame, false if it was dropped because the writer fell behind
+    bool append(const std::uint8_t *frame, const std::int64_t recv_ns, const std::uint16_t source_id);
+    bool append(const packed_t &frame, const std::int64_t recv_ns, const std::uint16_t source_id)
+    {
+        return append(reinterpret_cast<const std::uint8_t *>(&frame), recv_ns, source_id);
+    }
+
+    // Hand the records buffered so far to the writer, e.g. once a second when traffic is light.
+    // With direct_io only whole blocks go out, the rest stays for the next buffer.
+    // Returns false, without waiting, if the writer is busy with the other buffer.
+    bool flush(void);
+
+    // Write everything out, close the segment and stop the writer thread (same thread as append)
+    void close(void);
+
+    struct stats_t
+    {
+        std::uint64_t records{0};       // frames appended
+        std::uint64_t dropped{0};       // frames dropped, both buffers were full
+        std::uint64_t bytes_written{0}; // record bytes written to disk
+        std::uint64_t segments{0};      // segment files opened
+        std::uint64_t write_errors{0};  // failed writes or segment opens, the data is lost
+    };
+
+    // Snapshot of the counters, safe to call from any thread
+    stats_t stats(void) const;
+
+  private:
+    // value of _pending for the last buffer, the writer exits after it
+    static constexpr size_t FINAL{size_t(1) << (sizeof(size_t) * 8 - 1)};
+
+    struct free_deleter
+    {
+        void operator()(std::uint8_t *p) const { std::free(p); }
+    };
+    using block_ptr = std::unique_ptr<std::uint8_t, free_deleter>;
+
+    bool hand_off(const size_t length, const size_t final);
+    void writer_loop(void);
+    void write_buffer(const std::uint8_t *data, size_t length);
+    void write_all(const std::uint8_t *data, const size_t length);
+    void open_segment(void);
+    void close_segment(void);
+
+    recorder_options _options;
+    std::int64_t _created_ns{0};
+    size_t _segment_bytes{0};
+
+    // appending thread
+    std::array<block_ptr, 2> _buffers;
+    size_t _active{0};
+    size_t _fill{0};
+    std::atomic<std::uint64_t> _records{0};
+    std::atomic<std::uint64_t> _dropped{0};
+
+    // bytes handed to the writer per buffer, 0 while the buffer belongs to the appending thread
+    std::array<std::atomic<size_t>, 2> _pending{};
+
+    // writer thread
+    block_ptr _header_block;
+    int _fd{-1};
+    std::uint32_t _segment{0};
+    size_t _segment_written{0};
+    std::atomic<std::uint64_t> _bytes_written{0};
+    std::atomic<std::uint64_t> _segments{0};
+    std::atomic<std::uint64_t> _write_errors{0};
+    std::thread _writer;
+};
+
+} // namespace anysignal
+
+////////////////////////////////////////////////////////////////////////
+// implementation details
+////////////////////////////////////////////////////////////////////////
+
+#include <algorithm> //min, max
+#include <cerrno>
+#include <chrono>
+#include <cstdio>  //snprintf
+#include <cstring> //memcpy, strerror
+#include <fcntl.h>
+#include <numeric> //lcm
+#include <stdexcept>
+#include <unistd.h>
+
+inline std::string anysignal::recorder_segment_path(const std::string &directory, const std::string_view name,
+                                                    const std::int64_t created_ns, const std::uint32_t segment)
+{
+    char suffix[64];
+    std::snprintf(suffix, sizeof(suffix), "-%lld-%06u.smrec", static_cast<long long>(created_ns / 1000000000),
+                  segment);
+    return directory + "/" + std::string(name) + suffix;
+}
+
+template <typename Sharemap>
+anysignal::recorder<Sharemap>::recorder(const recorder_options &options) : _options(options)
+{
+    // segments hold whole records and end on a block boundary, so O_DIRECT writes stay aligned across them
+    const auto unit = std::lcm(RECORD_SIZE, RECORDER_BLOCK_SIZE);
+    _segment_bytes = std::max(unit, options.segment_bytes / unit * unit);
+    const auto buffer_bytes =
+        (std::max(RECORD_SIZE, options.buffer_bytes) + RECORDER_BLOCK_SIZE - 1) & ~(RECORDER_BLOCK_SIZE - 1);
+    _options.buffer_bytes = buffer_bytes;
+
+    for (auto &buffer : _buffers)
+    {
+        buffer.reset(static_cast<std::uint8_t *>(std::aligned_alloc(RECORDER_BLOCK_SIZE, buffer_bytes)));
+    }
+    _header_block.reset(static_cast<std::uint8_t *>(std::aligned_alloc(RECORDER_BLOCK_SIZE, RECORDER_HEADER_SIZE)));
+    if (not _buffers[0] or not _buffers[1] or not _header_block)
+    {
+        throw std::runtime_error("failed to allocate recorder buffers");
+    }
+
+    _created_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::system_clock::now().time_since_epoch())
+                      .count();
+    open_segment();
+    _writer = std::thread(&recorder::writer_loop, this);
+}
+
+template <typename Sharemap>
+anysignal::recorder<Sharemap>::~recorder(void)
+{
+    close();
+}
+
+template <typename Sharemap>
+bool anysignal::recorder<Sharemap>::append(const std::uint8_t *frame, const std::int64_t recv_ns,
+                                           const std::uint16_t source_id)
+{
+    // a record may straddle the two buffers, the file is one stream of records
+    const auto room = _options.buffer_bytes - _fill;
+    if (room <= RECORD_SIZE and _pending[_active ^ 1].load(std::memory_order_acquire) != 0)
+    {
+        _dropped.store(_dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return false;
+    }
+
+    std::uint8_t record[RECORD_SIZE];
+    recorder_record_t header{};
+    header.recv_ns = recv_ns;
+    header.source_id = source_id;
+    std::memcpy(record, &header, sizeof(header));
+    std::memcpy(record + sizeof(header), frame, Sharemap::PACKED_SIZE);
+
+    const auto first = std::min(room, RECORD_SIZE);
+    std::memcpy(_buffers[_active].get() + _fill, record, first);
+    _fill += first;
+    if (_fill == _options.buffer_bytes)
+    {
+        hand_off(_fill, 0);
+        std::memcpy(_buffers[_active].get(), record + first, RECORD_SIZE - first);
+        _fill = RECORD_SIZE - first;
+    }
+    _records.store(_records.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    return true;
+}
+
+template <typename Sharemap>
+bool anysignal::recorder<Sharemap>::hand_off(const size_t length, const size_t final)
+{
+    if (_pending[_active ^ 1].load(std::memory_order_acquire) != 0)
+    {
+        return false;
+    }
+    _pending[_active].store(length | final, std::memory_order_release);
+    _pending[_active].notify_one();
+    _active ^= 1;
+    _fill = 0;
+    return true;
+}
+
+template <typename Sharemap>
+bool anysignal::recorder<Sharemap>::flush(void)
+{
+    const auto length = _options.direct_io ? _fill & ~(RECORDER_BLOCK_SIZE - 1) : _fill;
+    if (length == 0 or not _writer.joinable())
+    {
+        return true;
+    }
+    const auto tail = _fill - length;
+    const auto *buffer = _buffers[_active].get();
+    if (not hand_off(length, 0))
+    {
+        return false;
+    }
+    std::memcpy(_buffers[_active].get(), buffer + length, tail);
+    _fill = tail;
+    return true;
+}
+
+template <typename Sharemap>
+void anysignal::recorder<Sharemap>::close(void)
+{
+    if (not _writer.joinable())
+    {
+        return;
+    }
+    // the writer takes buffers in order, so the last one can go out while it still writes the other
+    _pending[_active].store(_fill | FINAL, std::memory_order_release);
+    _pending[_active].notify_one();
+    _writer.join();
+}
+
+template <typename Sharemap>
+typename anysignal::recorder<Sharemap>::stats_t anysignal::recorder<Sharemap>::stats(void) const
+{
+    stats_t s;
+    s.records = _records.load(std::memory_order_relaxed);
+    s.dropped = _dropped.load(std::memory_order_relaxed);
+    s.bytes_written = _bytes_written.load(std::memory_order_relaxed);
+    s.segments = _segments.load(std::memory_order_relaxed);
+    s.write_errors = _write_errors.load(std::memory_order_relaxed);
+    return s;
+}
+
+template <typename Sharemap>
+void anysignal::recorder<Sharemap>::writer_loop(void)
+{
+    for (size_t i = 0;; i ^= 1)
+    {
+        _pending[i].wait(0, std::memory_order_acquire);
+        const auto pending = _pending[i].load(std::memory_order_acquire);
+        write_buffer(_buffers[i].get(), pending & ~FINAL);
+        if ((pending & FINAL) != 0)
+        {
+            break;
+        }
+        _pending[i].store(0, std::memory_order_release);
+    }
+    close_segment();
+}
+
+template <typename Sharemap>
+void anysignal::recorder<Sharemap>::write_buffer(const std::uint8_t *data, size_t length)
+{
+    while (length > 0)
+    {
+        // a new segment is only opened once there is something to put in it
+        if (_segment_written == _segment_bytes)
+        {
+            close_segment();
+            _segment++;
+            try
+            {
+                open_segment();
+            }
+            catch (const std::exception &)
+            {
+                _write_errors.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        const auto n = std::min(length, _segment_bytes - _segment_written);
+        write_all(data, n);
+        _segment_written += n;
+        data += n;
+        length -= n;
+    }
+}
+
+template <typename Sharemap>
+void anysignal::recorder<Sharemap>::write_all(const std::uint8_t *data, const size_t length)
+{
+    if (_fd < 0)
+    {
+        _write_errors.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    // O_DIRECT needs whole blocks, the tail written on close goes through the page cache
+    if (_options.direct_io and length % RECORDER_BLOCK_SIZE != 0)
+    {
+        ::fcntl(_fd, F_SETFL, ::fcntl(_fd, F_GETFL) & ~O_DIRECT);
+    }
+    size_t done = 0;
+    while (done < length)
+    {
+        const auto r = ::write(_fd, data + done, length - done);
+        if (r < 0 and errno == EINTR)
+        {
+            continue;
+        }
+        if (r <= 0)
+        {
+            _write_errors.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        done += size_t(r);
+        _bytes_written.fetch_add(size_t(r), std::memory_order_relaxed);
+    }
+}
+
+template <typename Sharemap>
+void anysignal::recorder<Sharemap>::open_segment(void)
+{
+    const auto path = recorder_segment_path(_options.directory, Sharemap::NAME, _created_ns, _segment);
+    _segment_written = 0;
+    _fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC | (_options.direct_io ? O_DIRECT : 0), 0644);
+    if (_fd < 0)
+    {
+        throw std::runtime_error("failed to create " + path + ": " + std::strerror(errno));
+    }
+    _segments.fetch_add(1, std::memory_order_relaxed);
+
+    // best effort, a filesystem without fallocate still records
+    if (_options.preallocate)
+    {
+        ::fallocate(_fd, 0, 0, ::off_t(RECORDER_HEADER_SIZE + _segment_bytes));
+    }
+
+    std::memset(_header_block.get(), 0, RECORDER_HEADER_SIZE);
+    recorder_file_header_t header{};
+    header.magic = RECORDER_MAGIC;
+    header.hash = Sharemap::HASH;
+    header.header_size = RECORDER_HEADER_SIZE;
+    header.record_size = RECORD_SIZE;
+    header.frame_size = Sharemap::PACKED_SIZE;
+    header.segment = _segment;
+    header.created_ns = _created_ns;
+    Sharemap::NAME.copy(header.name, sizeof(header.name) - 1);
+    std::memcpy(_header_block.get(), &header, sizeof(header));
+    const auto r = ::write(_fd, _header_block.get(), RECORDER_HEADER_SIZE);
+    if (r != ::ssize_t(RECORDER_HEADER_SIZE))
+    {
+        const auto error = errno;
+        ::close(_fd);
+        _fd = -1;
+        throw std::runtime_error("failed to write the header of " + path + ": " + std::strerror(error));
+    }
+}
+
+template <typename Sharemap>
+void anysignal::recorder<Sharemap>::close_segment(void)
+{
+    if (_fd < 0)
+    {
+        return;
+    }
+    // give back what a short segment did not use of its preallocation
+    if (_options.preallocate and _segment_written < _segment_bytes)
+    {
+        (void)::ftruncate(_fd, ::off_t(RECORDER_HEADER_SIZE + _segment_written));
+    }
+    ::close(_fd);
+    _fd = -1;
+}
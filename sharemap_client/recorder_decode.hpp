@@ -0,0 +1,161 @@
+#pragma once
+#include "recorder_reader.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace anysignal
+{
+
+// Decoded frames of a recording, one vector per field plus the receive times
+template <typename Sharemap>
+struct recorder_columns
+{
+    typename Sharemap::columns_t fields;
+    std::vector<std::int64_t> recv_ns;
+
+    size_t size(void) const { return recv_ns.size(); }
+};
+
+// Decode frames begin to end (exclusive) of a recording on threads threads, 0 for one per core.
+// The range is cut into chunks that the threads take in turn and unpack into columns of their
+// own; the chunks are then merged by unix_timestamp_ns, ties kept in receive order, and
+// gathered into the result in parallel. Frames are independent and fixed size, so the
+// decode scales with the cores until the disk or memory bandwidth runs out.
+template <typename Sharemap>
+recorder_columns<Sharemap> recorder_decode(const recorder_reader<Sharemap> &reader, size_t threads = 0,
+                                           std::uint64_t begin = 0, std::uint64_t end = UINT64_MAX);
+
+} // namespace anysignal
+
+////////////////////////////////////////////////////////////////////////
+// implementation details
+////////////////////////////////////////////////////////////////////////
+
+#include <algorithm> //min, stable_sort
+#include <atomic>
+#include <numeric> //iota
+#include <queue>
+#include <thread>
+
+namespace anysignal
+{
+
+// Run fcn(size_t task) for tasks 0 to count - 1 on threads threads, each taking the next task when done
+template <typename Fcn>
+void recorder_parallel_for(const size_t count, const size_t threads, Fcn &&fcn)
+{
+    std::atomic<size_t> next{0};
+    const auto work = [&] {
+        for (auto task = next.fetch_add(1, std::memory_order_relaxed); task < count;
+             task = next.fetch_add(1, std::memory_order_relaxed))
+        {
+            fcn(task);
+        }
+    };
+    std::vector<std::thread> pool;
+    for (size_t i = 1; i < std::min(threads, count); i++)
+    {
+        pool.emplace_back(work);
+    }
+    work();
+    for (auto &thread : pool)
+    {
+        thread.join();
+    }
+}
+
+} // namespace anysignal
+
+template <typename Sharemap>
+anysignal::recorder_columns<Sharemap> anysignal::recorder_decode(const recorder_reader<Sharemap> &reader,
+                                                                 size_t threads, std::uint64_t begin,
+                                                                 std::uint64_t end)
+{
+    end = std::min(end, reader.size());
+    begin = std::min(begin, end);
+    const auto count = size_t(end - begin);
+    if (threads == 0)
+    {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // a few chunks per thread even out slow ones, each chunk sorted in its own order
+    struct chunk_t
+    {
+        std::uint64_t first{0};
+        typename Sharemap::columns_t columns;
+        std::vector<std::int64_t> recv_ns;
+        std::vector<std::uint32_t> order;
+    };
+    constexpr size_t MIN_CHUNK{4096};
+    const auto chunk_size = std::max(MIN_CHUNK, (count + 4 * threads - 1) / (4 * threads));
+    std::vector<chunk_t> chunks((count + chunk_size - 1) / chunk_size);
+
+    recorder_parallel_for(chunks.size(), threads, [&](const size_t c) {
+        auto &chunk = chunks[c];
+        chunk.first = begin + c * chunk_size;
+        const auto n = std::min(chunk_size, size_t(end - chunk.first));
+        chunk.columns.resize(n);
+        chunk.recv_ns.resize(n);
+        for (size_t i = 0; i < n; i++)
+        {
+            const auto view = reader[chunk.first + i];
+            sharemap_unpack(view.frame(), Sharemap::PACKED_SIZE, chunk.columns, i);
+            chunk.recv_ns[i] = view.recv_ns();
+        }
+        // frames arrive nearly in timestamp order, which the sort is quick on
+        chunk.order.resize(n);
+        std::iota(chunk.order.begin(), chunk.order.end(), 0u);
+        const auto &ts = chunk.columns.unix_timestamp_ns;
+        std::stable_sort(chunk.order.begin(), chunk.order.end(),
+                         [&](const std::uint32_t a, const std::uint32_t b) { return ts[a] < ts[b]; });
+    });
+
+    // k-way merge into a list of (chunk, row), the earlier chunk first on equal timestamps
+    struct head_t
+    {
+        std::int64_t ns;
+        std::uint32_t chunk;
+        std::uint32_t position;
+        bool operator>(const head_t &other) const
+        {
+            return ns != other.ns ? ns > other.ns : chunk > other.chunk;
+        }
+    };
+    std::priority_queue<head_t, std::vector<head_t>, std::greater<head_t>> heads;
+    const auto head = [&](const std::uint32_t c, const std::uint32_t position) {
+        return head_t{chunks[c].columns.unix_timestamp_ns[chunks[c].order[position]], c, position};
+    };
+    for (std::uint32_t c = 0; c < chunks.size(); c++)
+    {
+        heads.push(head(c, 0));
+    }
+    std::vector<std::pair<std::uint32_t, std::uint32_t>> merged;
+    merged.reserve(count);
+    while (not heads.empty())
+    {
+        const auto h = heads.top();
+        heads.pop();
+        merged.emplace_back(h.chunk, chunks[h.chunk].order[h.position]);
+        if (h.position + 1 < chunks[h.chunk].order.size())
+        {
+            heads.push(head(h.chunk, h.position + 1));
+        }
+    }
+
+    // gather the rows in merged order, every thread filling its own slice of the result
+    recorder_columns<Sharemap> out;
+    out.fields.resize(count);
+    out.recv_ns.resize(count);
+    const auto slices = std::min(count, threads * 4);
+    recorder_parallel_for(slices, threads, [&](const size_t s) {
+        for (size_t i = s * count / slices; i < (s + 1) * count / slices; i++)
+        {
+            const auto &chunk = chunks[merged[i].first];
+            out.fields.copy_row(i, chunk.columns, merged[i].second);
+            out.recv_ns[i] = chunk.recv_ns[merged[i].second];
+        }
+    });
+    return out;
+}
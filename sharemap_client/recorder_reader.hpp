@@ -0,0 +1,328 @@
+#pragma once
+#include "recorder.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace anysignal
+{
+
+// One recorded segment file mapped read-only
+class recorder_segment
+{
+  public:
+    explicit recorder_segment(const std::string &path);
+    ~recorder_segment(void);
+    recorder_segment(const recorder_segment &) = delete;
+    recorder_segment &operator=(const recorder_segment &) = delete;
+
+    const recorder_file_header_t &header(void) const { return _header; }
+    const std::string &path(void) const { return _path; }
+
+    // Complete records, without the zeroed tail of a preallocated or interrupted segment
+    size_t records(void) const { return _records; }
+
+    // Start of record i, a recorder_record_t then the frame
+    const std::uint8_t *record(const size_t i) const { return _data + _header.header_size + i * _header.record_size; }
+
+    // Access pattern hint for the mapping (MADV_RANDOM, MADV_SEQUENTIAL, ...)
+    void advise(const int advice) const;
+
+  private:
+    std::string _path;
+    recorder_file_header_t _header{};
+    const std::uint8_t *_data{nullptr};
+    size_t _size{0};
+    size_t _records{0};
+};
+
+// Zero-copy view of one recorded frame, valid while its reader lives.
+// Records are packed back to back, so the fields are copied out rather than referenced.
+template <typename Sharemap>
+class recorder_view
+{
+  public:
+    explicit recorder_view(const std::uint8_t *record) : _record(record) {}
+
+    std::int64_t recv_ns(void) const;
+    std::uint16_t source_id(void) const;
+
+    // The packed frame as received, PACKED_SIZE bytes
+    const std::uint8_t *frame(void) const { return _record + sizeof(recorder_record_t); }
+
+    // Sender timestamp, decoded without unpacking the rest of the frame
+    std::int64_t unix_timestamp_ns(void) const;
+
+    // Decode the whole frame with sharemap_unpack
+    bool unpack(Sharemap &out) const { return sharemap_unpack(frame(), Sharemap::PACKED_SIZE, out); }
+
+  private:
+    const std::uint8_t *_record;
+};
+
+// Random access to the recorded frames of one sharemap in a directory, see recorder.hpp.
+// Every segment file of the sharemap is mapped, all recordings in name (so time) order.
+// A sparse index samples the sender timestamp of every index_stride-th record; a time
+// range query binary searches it and scans sequentially from there. Sender clocks and
+// network delay put frames somewhat out of timestamp order, so the search is widened by
+// slack_ns on both ends: frames more out of order than that may be missed.
+template <typename Sharemap>
+class recorder_reader
+{
+  public:
+    using view_t = recorder_view<Sharemap>;
+
+    // Map the segments and build the index, throws std::runtime_error on failure
+    explicit recorder_reader(const std::string &directory, const std::int64_t slack_ns = 10000000000,
+                             const size_t index_stride = 256);
+
+    size_t segments(void) const { return _segments.size(); }
+
+    // Number of frames in all segments
+    std::uint64_t size(void) const { return _offsets.empty() ? 0 : _offsets.back(); }
+
+    // Frame i of the whole recording, in receive order (0 <= i < size())
+    view_t operator[](const std::uint64_t i) const;
+
+    // Call fcn(const view_t &) for every frame with t0 <= unix_timestamp_ns <= t1, in receive order
+    template <typename Fcn>
+    void query(const std::int64_t t0, const std::int64_t t1, Fcn &&fcn) const;
+
+    // Same, only for frames of source_id, filtered without decoding the frames
+    template <typename Fcn>
+    void query(const std::uint16_t source_id, const std::int64_t t0, const std::int64_t t1, Fcn &&fcn) const;
+
+  private:
+    struct index_t
+    {
+        std::vector<std::int64_t> max_ns; // running maximum of the sampled timestamps
+    };
+
+    template <typename Match, typename Fcn>
+    void scan(const std::int64_t t0, const std::int64_t t1, Match &&match, Fcn &&fcn) const;
+
+    std::vector<std::unique_ptr<recorder_segment>> _segments;
+    std::vector<index_t> _indexes;
+    std::vector<std::uint64_t> _offsets; // frames before each segment, then the total
+    std::int64_t _slack_ns{0};
+    size_t _stride{0};
+};
+
+} // namespace anysignal
+
+////////////////////////////////////////////////////////////////////////
+// implementation details
+////////////////////////////////////////////////////////////////////////
+
+#include <algorithm> //sort, upper_bound, partition_point
+#include <cstring>   //memcpy
+#include <fcntl.h>   //open
+#include <filesystem>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h> //close
+
+inline anysignal::recorder_segment::recorder_segment(const std::string &path) : _path(path)
+{
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1)
+    {
+        throw std::runtime_error("failed to open " + path);
+    }
+    struct ::stat st{};
+    if (::fstat(fd, &st) != 0 or size_t(st.st_size) < RECORDER_HEADER_SIZE)
+    {
+        ::close(fd);
+        throw std::runtime_error("not a recorder segment: " + path);
+    }
+    _size = size_t(st.st_size);
+    void *data = ::mmap(nullptr, _size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED)
+    {
+        throw std::runtime_error("failed to map " + path);
+    }
+    _data = static_cast<const std::uint8_t *>(data);
+
+    std::memcpy(&_header, _data, sizeof(_header));
+    if (_header.magic != RECORDER_MAGIC or _header.header_size < sizeof(_header) or _header.header_size > _size or
+        _header.record_size <= sizeof(recorder_record_t))
+    {
+        ::munmap(data, _size);
+        throw std::runtime_error("not a recorder segment: " + path);
+    }
+
+    // zeros only ever follow the last record, so the first zero receive time is found by bisection
+    size_t lo = 0, hi = (_size - _header.header_size) / _header.record_size;
+    while (lo < hi)
+    {
+        const auto mid = lo + (hi - lo) / 2;
+        std::int64_t recv_ns;
+        std::memcpy(&recv_ns, record(mid), sizeof(recv_ns));
+        if (recv_ns != 0)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    _records = lo;
+}
+
+inline void anysignal::recorder_segment::advise(const int advice) const
+{
+    ::madvise(const_cast<std::uint8_t *>(_data), _size, advice);
+}
+
+inline anysignal::recorder_segment::~recorder_segment(void)
+{
+    ::munmap(const_cast<std::uint8_t *>(_data), _size);
+}
+
+template <typename Sharemap>
+std::int64_t anysignal::recorder_view<Sharemap>::recv_ns(void) const
+{
+    std::int64_t value;
+    std::memcpy(&value, _record + offsetof(recorder_record_t, recv_ns), sizeof(value));
+    return value;
+}
+
+template <typename Sharemap>
+std::uint16_t anysignal::recorder_view<Sharemap>::source_id(void) const
+{
+    std::uint16_t value;
+    std::memcpy(&value, _record + offsetof(recorder_record_t, source_id), sizeof(value));
+    return value;
+}
+
+template <typename Sharemap>
+std::int64_t anysignal::recorder_view<Sharemap>::unix_timestamp_ns(void) const
+{
+    // big endian on the wire
+    const auto *in = frame() + offsetof(typename Sharemap::packed_t, unix_timestamp_ns);
+    std::uint64_t value = 0;
+    for (size_t i = 0; i < sizeof(value); i++)
+    {
+        value = (value << 8) | in[i];
+    }
+    return std::int64_t(value);
+}
+
+template <typename Sharemap>
+anysignal::recorder_reader<Sharemap>::recorder_reader(const std::string &directory, const std::int64_t slack_ns,
+                                                      const size_t index_stride)
+    : _slack_ns(slack_ns), _stride(index_stride)
+{
+    if (index_stride == 0 or slack_ns < 0)
+    {
+        throw std::runtime_error("invalid recorder reader configuration");
+    }
+
+    // file names sort by recording start time, then segment
+    std::vector<std::string> paths;
+    const auto prefix = std::string(Sharemap::NAME) + "-";
+    for (const auto &entry : std::filesystem::directory_iterator(directory))
+    {
+        const auto name = entry.path().filename().string();
+        if (name.starts_with(prefix) and name.ends_with(".smrec"))
+        {
+            paths.push_back(entry.path().string());
+        }
+    }
+    std::sort(paths.begin(), paths.end());
+
+    _offsets.push_back(0);
+    for (const auto &path : paths)
+    {
+        auto segment = std::make_unique<recorder_segment>(path);
+        if (segment->header().hash != Sharemap::HASH or segment->header().frame_size != Sharemap::PACKED_SIZE or
+            segment->header().record_size != sizeof(recorder_record_t) + Sharemap::PACKED_SIZE)
+        {
+            throw std::runtime_error("recorded schema mismatch: " + path);
+        }
+
+        // one sample per stride touches one page in many, not the whole file, without readahead
+        segment->advise(MADV_RANDOM);
+        index_t index;
+        std::int64_t max_ns = INT64_MIN;
+        for (size_t i = 0; i < segment->records(); i += _stride)
+        {
+            max_ns = std::max(max_ns, view_t(segment->record(i)).unix_timestamp_ns());
+            index.max_ns.push_back(max_ns);
+        }
+        segment->advise(MADV_SEQUENTIAL);
+        _offsets.push_back(_offsets.back() + segment->records());
+        _indexes.push_back(std::move(index));
+        _segments.push_back(std::move(segment));
+    }
+}
+
+template <typename Sharemap>
+typename anysignal::recorder_reader<Sharemap>::view_t anysignal::recorder_reader<Sharemap>::operator[](
+    const std::uint64_t i) const
+{
+    const auto s = size_t(std::upper_bound(_offsets.begin(), _offsets.end(), i) - _offsets.begin()) - 1;
+    return view_t(_segments[s]->record(size_t(i - _offsets[s])));
+}
+
+template <typename Sharemap>
+template <typename Match, typename Fcn>
+void anysignal::recorder_reader<Sharemap>::scan(const std::int64_t t0, const std::int64_t t1, Match &&match,
+                                                Fcn &&fcn) const
+{
+    // saturated, so open ended windows such as [0, INT64_MAX] work
+    const auto lower = t0 < INT64_MIN + _slack_ns ? INT64_MIN : t0 - _slack_ns;
+    const auto upper = t1 > INT64_MAX - _slack_ns ? INT64_MAX : t1 + _slack_ns;
+    for (size_t s = 0; s < _segments.size(); s++)
+    {
+        const auto &segment = *_segments[s];
+        const auto &samples = _indexes[s].max_ns;
+        if (samples.empty())
+        {
+            continue;
+        }
+
+        // frames before the last sample below the window cannot be in it, up to the slack
+        const auto first = size_t(std::partition_point(samples.begin(), samples.end(),
+                                                       [&](const std::int64_t v) { return v < lower; }) -
+                                  samples.begin());
+        const auto begin = (first == 0 ? 0 : first - 1) * _stride;
+        for (size_t i = begin; i < segment.records(); i++)
+        {
+            const view_t view(segment.record(i));
+            // stop at a sampled frame past the window, the frames after it are later still
+            if (i % _stride == 0 and view.unix_timestamp_ns() > upper)
+            {
+                return;
+            }
+            if (match(view))
+            {
+                const auto ns = view.unix_timestamp_ns();
+                if (ns >= t0 and ns <= t1)
+                {
+                    fcn(view);
+                }
+            }
+        }
+    }
+}
+
+template <typename Sharemap>
+template <typename Fcn>
+void anysignal::recorder_reader<Sharemap>::query(const std::int64_t t0, const std::int64_t t1, Fcn &&fcn) const
+{
+    scan(t0, t1, [](const view_t &) { return true; }, fcn);
+}
+
+template <typename Sharemap>
+template <typename Fcn>
+void anysignal::recorder_reader<Sharemap>::query(const std::uint16_t source_id, const std::int64_t t0,
+                                                 const std::int64_t t1, Fcn &&fcn) const
+{
+    scan(t0, t1, [&](const view_t &view) { return view.source_id() == source_id; }, fcn);
+}
@@ -0,0 +1,303 @@
+#pragma once
+#include "counter_rates.hpp"
+#include "sharemap.hpp"
+#include "source_slots.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace anysignal
+{
+
+// One resolution of a rollup: the newest `buckets` buckets of bucket_ns each
+struct rollup_level_t
+{
+    std::int64_t bucket_ns;
+    size_t buckets;
+};
+
+// 1 s buckets for an hour, 1 min buckets for a day, 1 h buckets for a week
+static inline const std::vector<rollup_level_t> ROLLUP_DEFAULT_LEVELS{
+    {1'000'000'000, 3600},
+    {60'000'000'000, 1440},
+    {3'600'000'000'000, 168},
+};
+
+// Summary of one field over one bucket
+struct rollup_bucket_t
+{
+    std::int64_t start_ns{0};
+    std::uint32_t count{0}; // samples summarized
+    float min{0};
+    float max{0};
+    float mean{0};
+    float last{0};
+};
+
+// Multi-resolution summaries of the numeric fields of a sharemap per source_id.
+// Every frame updates the bucket containing its unix_timestamp_ns at each level, in rings of
+// fixed size, so a source's memory is a constant (source_bytes) and a query over a week reads
+// at most a few hundred buckets. Fields marked counter in the schema are summarized as rates
+// per second between consecutive frames of a source (counter_rates), a first frame giving no
+// sample. Frames older than a level's ring are ignored at that level.
+// Not thread safe; one thread appends and queries.
+template <typename Sharemap>
+class rollup
+{
+  public:
+    using packed_t = typename Sharemap::packed_t;
+    static constexpr size_t NO_COLUMN{~size_t(0)};
+
+    // Throws std::runtime_error for an invalid source count, no levels or a level without buckets
+    rollup(const size_t max_sources, const std::vector<rollup_level_t> &levels = ROLLUP_DEFAULT_LEVELS);
+
+    // Add a packed frame to the summaries of its source_id, false if the store is full of other sources
+    bool append(const std::uint8_t *packed);
+    bool append(const packed_t &packed) { return append(reinterpret_cast<const std::uint8_t *>(&packed)); }
+
+    // Column of a numeric field, NO_COLUMN for strings, the common header and unknown names
+    size_t column(const std::string_view name) const;
+    const sharemap_field_t &field(const size_t column) const { return *_fields[column]; }
+    size_t columns(void) const { return _fields.size(); }
+
+    const std::vector<rollup_level_t> &levels(void) const { return _levels; }
+
+    // Call fcn(const rollup_bucket_t &) for the non-empty buckets of a column at a level
+    // that overlap [t0, t1], oldest first
+    template <typename Fcn>
+    void query(const std::uint16_t source_id, const size_t level, const size_t column, const std::int64_t t0,
+               const std::int64_t t1, Fcn &&fcn) const;
+
+    // Bytes of summaries held per source
+    size_t source_bytes(void) const { return _total_buckets * (sizeof(std::int64_t) + _fields.size() * STAT_BYTES); }
+
+  private:
+    static constexpr std::int64_t NO_BUCKET{INT64_MIN};
+    static constexpr size_t STATS{4}; // min, max, mean, last
+    static constexpr size_t STAT_BYTES{STATS * sizeof(float) + sizeof(std::uint32_t)};
+
+    struct source_t
+    {
+        std::uint16_t source_id{0};
+        std::vector<std::int64_t> newest;  // newest bucket number per level
+        std::vector<std::int64_t> bucket;  // bucket number held per slot
+        std::vector<float> stats;          // per slot: min, max, mean, last of every column
+        std::vector<std::uint32_t> counts; // per slot: samples of every column
+    };
+
+    // Add _values to the summaries in a slot, for the columns with _has set
+    void _update(source_t &source, const size_t slot);
+
+    std::vector<rollup_level_t> _levels;
+    std::vector<size_t> _level_slots; // first slot of each level
+    size_t _total_buckets{0};
+    std::vector<const sharemap_field_t *> _fields;
+    std::vector<size_t> _counter_columns; // column of each counter of _rates
+    counter_rates<Sharemap> _rates; // fed with the slots of _slots
+    std::array<double, counter_rates<Sharemap>::COUNTERS> _counter_rates;
+    std::vector<float> _values; // sample of each column of the frame being appended
+    std::vector<std::uint8_t> _has;
+    source_slots _slots;
+    std::vector<source_t> _sources; // by slot
+};
+
+} // namespace anysignal
+
+////////////////////////////////////////////////////////////////////////
+// implementation details
+////////////////////////////////////////////////////////////////////////
+
+#include <algorithm> //max, min, fill
+#include <stdexcept>
+
+namespace anysignal
+{
+
+// Bucket number of a timestamp, rounding down for negative times too
+static inline std::int64_t rollup_bucket_number(const std::int64_t t, const std::int64_t bucket_ns)
+{
+    return t / bucket_ns - (t % bucket_ns < 0 ? 1 : 0);
+}
+
+} // namespace anysignal
+
+template <typename Sharemap>
+anysignal::rollup<Sharemap>::rollup(const size_t max_sources, const std::vector<rollup_level_t> &levels)
+    : _levels(levels), _rates(max_sources), _slots(max_sources)
+{
+    if (levels.empty())
+    {
+        throw std::runtime_error("invalid rollup configuration");
+    }
+    for (const auto &level : levels)
+    {
+        if (level.buckets == 0 or level.bucket_ns <= 0)
+        {
+            throw std::runtime_error("invalid rollup level");
+        }
+        _level_slots.push_back(_total_buckets);
+        _total_buckets += level.buckets;
+    }
+
+    for (const auto &field : Sharemap::FIELDS)
+    {
+        if (field.type == sharemap_type_t::string or field.name == "source_id" or field.name == "schema_hash" or
+            field.name == "unix_timestamp_ns" or field.name == "sequence")
+        {
+            continue;
+        }
+        if (field.counter)
+        {
+            _counter_columns.push_back(_fields.size());
+        }
+        _fields.push_back(&field);
+    }
+    _values.resize(_fields.size());
+    _has.resize(_fields.size());
+    _sources.reserve(max_sources);
+}
+
+template <typename Sharemap>
+size_t anysignal::rollup<Sharemap>::column(const std::string_view name) const
+{
+    for (size_t c = 0; c < _fields.size(); c++)
+    {
+        if (_fields[c]->name == name)
+        {
+            return c;
+        }
+    }
+    return NO_COLUMN;
+}
+
+template <typename Sharemap>
+bool anysignal::rollup<Sharemap>::append(const std::uint8_t *packed)
+{
+    std::uint16_t source_id;
+    sharemap_unpack_field(packed + offsetof(packed_t, source_id), source_id);
+    std::int64_t timestamp;
+    sharemap_unpack_field(packed + offsetof(packed_t, unix_timestamp_ns), timestamp);
+
+    const auto slot = _slots.insert(source_id);
+    if (slot == source_slots::NO_SLOT)
+    {
+        return false;
+    }
+    if (slot == _sources.size())
+    {
+        source_t source;
+        source.source_id = source_id;
+        source.newest.resize(_levels.size(), NO_BUCKET);
+        source.bucket.resize(_total_buckets, NO_BUCKET);
+        source.stats.resize(_total_buckets * STATS * _fields.size());
+        source.counts.resize(_total_buckets * _fields.size());
+        _sources.push_back(std::move(source));
+    }
+    auto &source = _sources[slot];
+
+    // gauges are summarized as they are
+    for (size_t c = 0; c < _fields.size(); c++)
+    {
+        _values[c] = float(sharemap_unpack_number(*_fields[c], packed + _fields[c]->offset));
+        _has[c] = 1;
+    }
+
+    // counters as the rate since the previous frame, when there is one
+    const bool has_rates = _rates.update(slot, packed, _counter_rates);
+    for (size_t k = 0; k < _counter_columns.size(); k++)
+    {
+        _values[_counter_columns[k]] = float(_counter_rates[k]);
+        _has[_counter_columns[k]] = has_rates;
+    }
+
+    for (size_t l = 0; l < _levels.size(); l++)
+    {
+        const auto &level = _levels[l];
+        const auto number = rollup_bucket_number(timestamp, level.bucket_ns);
+        if (source.newest[l] != NO_BUCKET and number <= source.newest[l] - std::int64_t(level.buckets))
+        {
+            continue; // older than the ring
+        }
+        source.newest[l] = std::max(source.newest[l], number);
+
+        const auto s = _level_slots[l] + size_t(number % std::int64_t(level.buckets) + std::int64_t(level.buckets)) %
+                                             level.buckets;
+        if (source.bucket[s] != number)
+        {
+            // the slot held an older bucket, start it over
+            source.bucket[s] = number;
+            std::fill_n(source.counts.begin() + std::ptrdiff_t(s * _fields.size()), _fields.size(), 0);
+        }
+        _update(source, s);
+    }
+    return true;
+}
+
+template <typename Sharemap>
+void anysignal::rollup<Sharemap>::_update(source_t &source, const size_t slot)
+{
+    const auto columns = _fields.size();
+    auto *counts = source.counts.data() + slot * columns;
+    auto *min = source.stats.data() + slot * STATS * columns;
+    auto *max = min + columns;
+    auto *mean = max + columns;
+    auto *last = mean + columns;
+    for (size_t c = 0; c < columns; c++)
+    {
+        if (not _has[c])
+        {
+            continue;
+        }
+        const auto v = _values[c];
+        const auto n = ++counts[c];
+        min[c] = n == 1 or v < min[c] ? v : min[c];
+        max[c] = n == 1 or v > max[c] ? v : max[c];
+        mean[c] = n == 1 ? v : mean[c] + (v - mean[c]) / float(n);
+        last[c] = v;
+    }
+}
+
+template <typename Sharemap>
+template <typename Fcn>
+void anysignal::rollup<Sharemap>::query(const std::uint16_t source_id, const size_t level, const size_t column,
+                                        const std::int64_t t0, const std::int64_t t1, Fcn &&fcn) const
+{
+    const auto slot = _slots.find(source_id);
+    if (slot == source_slots::NO_SLOT or level >= _levels.size() or column >= _fields.size() or t1 < t0)
+    {
+        return;
+    }
+    const auto &source = _sources[slot];
+    const auto &l = _levels[level];
+    if (source.newest[level] == NO_BUCKET)
+    {
+        return;
+    }
+
+    // only the buckets still in the ring can be there
+    const auto first =
+        std::max(rollup_bucket_number(t0, l.bucket_ns), source.newest[level] - std::int64_t(l.buckets) + 1);
+    const auto last = std::min(rollup_bucket_number(t1, l.bucket_ns), source.newest[level]);
+    const auto columns = _fields.size();
+    for (auto number = first; number <= last; number++)
+    {
+        const auto s =
+            _level_slots[level] + size_t(number % std::int64_t(l.buckets) + std::int64_t(l.buckets)) % l.buckets;
+        const auto count = source.counts[s * columns + column];
+        if (source.bucket[s] != number or count == 0)
+        {
+            continue;
+        }
+        const auto *stats = source.stats.data() + s * STATS * columns + column;
+        rollup_bucket_t bucket;
+        bucket.start_ns = number * l.bucket_ns;
+        bucket.count = count;
+        bucket.min = stats[0];
+        bucket.max = stats[columns];
+        bucket.mean = stats[2 * columns];
+        bucket.last = stats[3 * columns];
+        fcn(bucket);
+    }
+}
@@ -0,0 +1,124 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace anysignal
+{
+
+// Sequence lock around a trivially copyable value, for one writer and any number of readers.
+// The writer never waits on readers; a reader that overlaps a store retries its copy.
+// The object holds no pointers, so it can be placed in memory shared between processes.
+template <typename T>
+class seqlock
+{
+    static_assert(std::is_trivially_copyable_v<T>, "seqlock values are copied bytewise");
+
+  public:
+    seqlock(void) = default;
+    seqlock(const seqlock &) = delete;
+    seqlock &operator=(const seqlock &) = delete;
+
+    // Publish a new value (single writer only)
+    void store(const T &value);
+
+    // Copy a consistent value into out, retrying while a store is in progress.
+    // Returns false if nothing was stored yet.
+    bool load(T &out) const;
+
+    // Single attempt of load, also false when it overlapped a store
+    bool try_load(T &out) const;
+
+    // Number of completed stores
+    std::uint64_t version(void) const;
+
+    // Finish a store that was interrupted, e.g. by a crashed writer process
+    void repair(void);
+
+  private:
+    static constexpr size_t WORDS{(sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t)};
+    alignas(64) std::atomic<std::uint64_t> _seq{0};
+    std::uint64_t _data[WORDS]{};
+};
+
+} // namespace anysignal
+
+////////////////////////////////////////////////////////////////////////
+// implementation details
+////////////////////////////////////////////////////////////////////////
+
+#include <cstring> //memcpy
+
+// The value is copied in 64-bit words through relaxed atomics, so overlapping
+// reads and writes are well defined; the sequence number tells if they tore.
+
+template <typename T>
+void anysignal::seqlock<T>::store(const T &value)
+{
+    std::uint64_t words[WORDS]{};
+    std::memcpy(words, &value, sizeof(T));
+
+    const auto seq = _seq.load(std::memory_order_relaxed);
+    _seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < WORDS; i++)
+    {
+        std::atomic_ref<std::uint64_t>(_data[i]).store(words[i], std::memory_order_relaxed);
+    }
+    _seq.store(seq + 2, std::memory_order_release);
+}
+
+template <typename T>
+bool anysignal::seqlock<T>::try_load(T &out) const
+{
+    const auto seq0 = _seq.load(std::memory_order_acquire);
+    if (seq0 == 0 or (seq0 & 1) != 0)
+    {
+        return false;
+    }
+
+    std::uint64_t words[WORDS];
+    auto *data = const_cast<std::uint64_t *>(_data);
+    for (size_t i = 0; i < WORDS; i++)
+    {
+        words[i] = std::atomic_ref<std::uint64_t>(data[i]).load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (_seq.load(std::memory_order_relaxed) != seq0)
+    {
+        return false;
+    }
+
+    std::memcpy(&out, words, sizeof(T));
+    return true;
+}
+
+template <typename T>
+bool anysignal::seqlock<T>::load(T &out) const
+{
+    while (not try_load(out))
+    {
+        if (_seq.load(std::memory_order_relaxed) == 0)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+std::uint64_t anysignal::seqlock<T>::version(void) const
+{
+    return _seq.load(std::memory_order_acquire) / 2;
+}
+
+template <typename T>
+void anysignal::seqlock<T>::repair(void)
+{
+    const auto seq = _seq.load(std::memory_order_relaxed);
+    if ((seq & 1) != 0)
+    {
+        _seq.store(seq + 1, std::memory_order_release);
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include <cstdint>
+
+namespace anysignal
+{
+
+// Loss, duplicate and reorder accounting for the sequence numbers of one source.
+// The last 64 sequence numbers are remembered, so a frame that arrives late
+// within that window is told apart from a duplicate and taken off the lost count.
+class sequence_tracker
+{
+  public:
+    // A jump back by more than this many frames is taken as a restarted sender
+    static constexpr std::int64_t RESET_BACKWARD{1024};
+
+    // A jump forward by more than this many frames is taken as a restarted sender
+    static constexpr std::int64_t RESET_FORWARD{std::int64_t(1) << 20};
+
+    // Account for a received sequence number
+    void update(const std::uint32_t sequence);
+
+    std::uint64_t received{0};   // frames seen
+    std::uint64_t lost{0};       // sequence numbers skipped and not received since
+    std::uint64_t duplicates{0}; // frames seen twice
+    std::uint64_t reordered{0};  // frames that arrived after a later one, within the window
+    std::uint64_t late{0};       // frames too old for the window or older than the first one, neither
+                                 // lost nor duplicate can be told
+    std::uint64_t resets{0};     // sender restarts
+
+  private:
+    std::uint32_t _last{0};   // highest sequence number seen
+    std::uint64_t _window{0}; // bit n set if _last - n was seen
+    std::int64_t _span{0};    // bits of _window since the first frame (or reset), up to 64
+};
+
+} // namespace anysignal
+
+////////////////////////////////////////////////////////////////////////
+// implementation details
+////////////////////////////////////////////////////////////////////////
+
+inline void anysignal::sequence_tracker::update(const std::uint32_t sequence)
+{
+    received++;
+
+    // distance in modular arithmetic, so the wrap at 2^32 is just another step forward
+    const auto distance = std::int64_t(std::int32_t(sequence - _last));
+    if (_window == 0 or distance > RESET_FORWARD or distance < -RESET_BACKWARD)
+    {
+        resets += (_window != 0);
+        _last = sequence;
+        _window = 1;
+        _span = 1;
+    }
+    else if (distance > 0)
+    {
+        lost += std::uint64_t(distance - 1);
+        _window = distance < 64 ? (_window << distance) | 1 : 1;
+        _span = distance < 64 - _span ? _span + distance : 64;
+        _last = sequence;
+    }
+    else if (-distance < _span)
+    {
+        const auto bit = std::uint64_t(1) << -distance;
+        if ((_window & bit) != 0)
+        {
+            duplicates++;
+        }
+        else
+        {
+            _window |= bit;
+            reordered++;
+            lost--; // counted when the gap opened
+        }
+    }
+    else
+    {
+        late++;
+    }
+}
@@ -1,14 +1,23 @@
 /***
  * Simple CLI program to test the sharemap interface.
  */
+#include "latency_histogram.hpp"
+#include "seqlock.hpp"
 #include "sharemap.hpp"
+#include "shm_latest.hpp"
+#include "shm_ring.hpp"
+#include "source_table.hpp"
+#include "thread_tuning.hpp"
+#include "timer_wheel.hpp"
 #include "udp.hpp"
+#include <atomic>
 #include <chrono>
 #include <csignal>
 #include <cstdio>
 #include <iostream>
 #include <string>
 #include <thread>
+#include <vector>
 
 // Sharemap proxy settings
 std::string sharemap_control_url = "udp://0.0.0.0:3333";
@@ -16,16 +25,67 @@ std::string sharemap_metrics_url = "udp://127.0.0.1:4444";
 
 anysignal::udp_sock *control_socket = nullptr;
 anysignal::udp_sock *metrics_socket = nullptr;
+
+// Publish the latest config and metrics of each source_id to shared memory
+bool sharemap_shm = false;
+anysignal::shm_latest_writer<anysignal::sharemap_config_t> *config_shm = nullptr;
+anysignal::shm_latest_writer<anysignal::sharemap_metrics_t> *metrics_shm = nullptr;
+
+// Forward every received metrics frame to a shared memory ring of this many slots (0 to disable)
+std::uint32_t sharemap_ring_slots = 0;
+anysignal::shm_ring_writer<anysignal::sharemap_metrics_t> *metrics_ring = nullptr;
+
+// Latest metrics and receive stats of up to this many source_ids
+std::uint32_t sharemap_max_sources = 1024;
+using metrics_source_state_t = anysignal::source_state<anysignal::sharemap_metrics_t>;
+anysignal::source_table<metrics_source_state_t> *metrics_sources = nullptr;
+
+// Receive path latency of each metrics source, indexed like metrics_sources
+struct metrics_latency_t
+{
+    anysignal::latency_histogram sender_to_kernel; // unix_timestamp_ns to the kernel receive timestamp
+    anysignal::latency_histogram kernel_to_user;   // kernel receive timestamp to recv returning
+    anysignal::latency_histogram decode;           // unpacking and bookkeeping of one frame
+};
+metrics_latency_t *metrics_latency = nullptr;
+
+// Time from the kernel receive timestamp to recv returning, by how recv_spin got the data
+struct wakeup_latency_t
+{
+    anysignal::latency_histogram spin;    // found while spinning
+    anysignal::latency_histogram blocked; // woken up from a blocking wait
+};
+wakeup_latency_t *wakeup_latency = nullptr;
+
+// Datagrams of the metrics socket by what they held, counted by the receive thread
+struct metrics_datagrams_t
+{
+    std::atomic<std::uint64_t> frames{0};  // one metrics frame
+    std::atomic<std::uint64_t> bundles{0}; // a well formed bundle
+    std::atomic<std::uint64_t> invalid{0}; // neither, such as a malformed bundle
+};
+metrics_datagrams_t *metrics_datagrams = nullptr;
+
+// Receive thread tuning: spin on the socket before waiting (0 to always wait), kernel busy
+// polling (0 to disable), the cpu to pin it to (-1 for any) and its SCHED_FIFO priority (0 for none)
+std::uint32_t sharemap_recv_spin_us = 0;
+std::uint32_t sharemap_busy_poll_us = 0;
+std::int32_t sharemap_recv_cpu = -1;
+std::uint32_t sharemap_recv_fifo_priority = 0;
+
+// Mark a source stale when it sends no metrics for this long (0 to disable)
+std::uint32_t sharemap_stale_timeout_ms = 3000;
 anysignal::sharemap_config_t config;
-anysignal::sharemap_metrics_t metrics;
+// Latest received metrics, stored by the receive thread and copied out by the CLI
+anysignal::seqlock<anysignal::sharemap_metrics_t> latest_metrics;
 
 std::thread recv_thread;
 
-static volatile bool metrics_initialized = false;
+static std::atomic<bool> metrics_initialized{false};
 
 // Signal handler
-static volatile bool running = true;
-static volatile bool receiving = false;
+static std::atomic<bool> running{true};
+static std::atomic<bool> receiving{false};
 static void signal_callback_handler(int signum)
 {
     printf("Caught signal %d\n", signum);
@@ -35,33 +95,143 @@ static void signal_callback_handler(int signum)
     fclose(stdin);
 }
 
+static std::int64_t steady_ns(void)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
 void recv_metrics()
 {
     anysignal::sharemap_metrics_t::packed_t packed_metrics;
+    std::vector<std::uint8_t> buff(anysignal::udp_sock::GSO_MAX_BYTES);
+
+    // one staleness deadline per source_id, re-armed by every frame
+    const std::int64_t stale_timeout_ns = std::int64_t(sharemap_stale_timeout_ms) * 1000000;
+    anysignal::timer_wheel stale_timers(std::size_t(1) << 16, 1000000, steady_ns());
+    const auto on_stale = [&](const std::uint32_t source_id) {
+        metrics_sources->update(std::uint16_t(source_id), [](metrics_source_state_t &state) {
+            state.stale = true;
+            state.stale_events++;
+        });
+        printf("Source %u sent no metrics for %u ms\n", source_id, sharemap_stale_timeout_ms);
+    };
+
+    try
+    {
+        if (sharemap_recv_cpu >= 0)
+        {
+            anysignal::set_thread_affinity(sharemap_recv_cpu);
+        }
+        if (sharemap_recv_fifo_priority > 0)
+        {
+            anysignal::set_thread_realtime(int(sharemap_recv_fifo_priority));
+        }
+    }
+    catch (const std::exception &ex)
+    {
+        printf("Warning: %s\n", ex.what());
+    }
+    const std::chrono::microseconds spin(sharemap_recv_spin_us);
+
     while (receiving)
     {
+        if (stale_timeout_ns > 0)
+        {
+            stale_timers.advance(steady_ns(), on_stale);
+        }
 
-        // Wait for metrics
-        if (metrics_socket->recv_ready(std::chrono::milliseconds(500)))
+        // Wait for metrics, spinning first in low latency mode
+        anysignal::udp_sock::recv_info info;
+        int recvd = -1;
+        if (spin.count() > 0)
         {
-            // Receive packed data
-            size_t recvd = metrics_socket->recv(reinterpret_cast<uint8_t *>(&packed_metrics),
-                                                anysignal::sharemap_metrics_t::PACKED_SIZE);
-            if (recvd != anysignal::sharemap_metrics_t::PACKED_SIZE)
+            recvd = metrics_socket->recv_spin(buff.data(), buff.size(), info, spin, std::chrono::milliseconds(100));
+        }
+        else if (metrics_socket->recv_ready(std::chrono::milliseconds(100)))
+        {
+            recvd = metrics_socket->recv(buff.data(), buff.size(), info);
+        }
+        if (recvd >= 0)
+        {
+            // Received packed data, possibly several GRO-coalesced frames
+            const auto arrival_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+            if (info.kernel_timestamp_ns != 0)
             {
-                continue;
+                (info.spun ? wakeup_latency->spin : wakeup_latency->blocked).record(arrival_ns - info.kernel_timestamp_ns);
             }
 
-            // Unpack
-            metrics = anysignal::sharemap_unpack(packed_metrics);
+            // Decode one packed metrics frame
+            const auto handle_metrics = [&](const std::uint8_t *frame) {
+                const auto decode_start_ns = steady_ns();
 
-            // Check the hash
-            if (metrics.schema_hash != anysignal::sharemap_metrics_t::HASH)
-            {
-                printf("Unexpected schema hash (0x%lX)\n", metrics.schema_hash);
-            }
+                if (metrics_ring)
+                {
+                    std::memcpy(&packed_metrics, frame, sizeof(packed_metrics));
+                    metrics_ring->push(packed_metrics);
+                }
+
+                // Unpack
+                anysignal::sharemap_metrics_t metrics;
+                anysignal::sharemap_unpack(frame, anysignal::sharemap_metrics_t::PACKED_SIZE, metrics);
 
-            metrics_initialized = true;
+                // Check the hash
+                if (metrics.schema_hash != anysignal::sharemap_metrics_t::HASH)
+                {
+                    printf("Unexpected schema hash (0x%lX)\n", metrics.schema_hash);
+                }
+
+                latest_metrics.store(metrics);
+                const bool tracked = metrics_sources->update(metrics.source_id, [&](metrics_source_state_t &state) {
+                    anysignal::source_state_update(state, metrics, arrival_ns);
+                });
+                const auto decode_end_ns = steady_ns();
+                if (tracked and stale_timeout_ns > 0)
+                {
+                    stale_timers.arm(metrics.source_id, decode_end_ns + stale_timeout_ns);
+                }
+                if (const auto index = metrics_sources->index(metrics.source_id); index != metrics_sources->NO_INDEX)
+                {
+                    auto &latency = metrics_latency[index];
+                    if (info.kernel_timestamp_ns != 0)
+                    {
+                        latency.sender_to_kernel.record(info.kernel_timestamp_ns - metrics.unix_timestamp_ns);
+                        latency.kernel_to_user.record(arrival_ns - info.kernel_timestamp_ns);
+                    }
+                    latency.decode.record(decode_end_ns - decode_start_ns);
+                }
+                if (metrics_shm)
+                {
+                    metrics_shm->publish(metrics);
+                }
+
+                metrics_initialized = true;
+            };
+
+            anysignal::udp_sock::for_each_segment(buff.data(), recvd, info, [&](const std::uint8_t *frame, size_t length) {
+                // a bundle carries several frames, possibly of other sharemaps
+                if (anysignal::sharemap_is_bundle(frame, length))
+                {
+                    // the complete entries of a malformed bundle are still used, but it counts as invalid
+                    const bool ok = anysignal::sharemap_bundle_for_each(frame, length, [&](const std::uint64_t hash, const std::uint8_t *entry, size_t entry_length) {
+                        if (hash == anysignal::sharemap_metrics_t::HASH and entry_length == anysignal::sharemap_metrics_t::PACKED_SIZE)
+                        {
+                            handle_metrics(entry);
+                        }
+                    });
+                    (ok ? metrics_datagrams->bundles : metrics_datagrams->invalid).fetch_add(1, std::memory_order_relaxed);
+                }
+                else if (length == anysignal::sharemap_metrics_t::PACKED_SIZE)
+                {
+                    metrics_datagrams->frames.fetch_add(1, std::memory_order_relaxed);
+                    handle_metrics(frame);
+                }
+                else
+                {
+                    metrics_datagrams->invalid.fetch_add(1, std::memory_order_relaxed);
+                }
+            });
         }
     }
 }
@@ -75,7 +245,7 @@ void help()
     std::cout << "    send config         Send the configuration" << std::endl;
     std::cout << "    connect             Connect to sharemap server" << std::endl;
     std::cout << "    disconnect          Disconnect from sharemap server" << std::endl;
-    std::cout << "    display <what>      Display info.  <what> can be \"config\" or \"metrics\"" << std::endl;
+    std::cout << "    display <what>      Display info.  <what> can be \"config\", \"metrics\", \"sources\", \"latency\" or \"stats\"" << std::endl;
     std::cout << "    quit                Quit this application" << std::endl;
 }
 
@@ -243,6 +413,38 @@ void set(std::string args)
     {
         sharemap_metrics_url = val;
     }
+    else if (key == "sharemap_shm")
+    {
+        set(sharemap_shm, val);
+    }
+    else if (key == "sharemap_ring_slots")
+    {
+        set(sharemap_ring_slots, val);
+    }
+    else if (key == "sharemap_max_sources")
+    {
+        set(sharemap_max_sources, val);
+    }
+    else if (key == "sharemap_stale_timeout_ms")
+    {
+        set(sharemap_stale_timeout_ms, val);
+    }
+    else if (key == "sharemap_recv_spin_us")
+    {
+        set(sharemap_recv_spin_us, val);
+    }
+    else if (key == "sharemap_busy_poll_us")
+    {
+        set(sharemap_busy_poll_us, val);
+    }
+    else if (key == "sharemap_recv_cpu")
+    {
+        set(sharemap_recv_cpu, val);
+    }
+    else if (key == "sharemap_recv_fifo_priority")
+    {
+        set(sharemap_recv_fifo_priority, val);
+    }
     else if (key == "source_id")
     {
         set(config.source_id, val);
@@ -470,6 +672,14 @@ void display(std::string what)
     {
         std::cout << "sharemap_control_url = " << sharemap_control_url << std::endl;
         std::cout << "sharemap_metrics_url = " << sharemap_metrics_url << std::endl;
+        std::cout << "sharemap_shm = " << to_string(sharemap_shm) << std::endl;
+        std::cout << "sharemap_ring_slots = " << to_string(sharemap_ring_slots) << std::endl;
+        std::cout << "sharemap_max_sources = " << to_string(sharemap_max_sources) << std::endl;
+        std::cout << "sharemap_stale_timeout_ms = " << to_string(sharemap_stale_timeout_ms) << std::endl;
+        std::cout << "sharemap_recv_spin_us = " << to_string(sharemap_recv_spin_us) << std::endl;
+        std::cout << "sharemap_busy_poll_us = " << to_string(sharemap_busy_poll_us) << std::endl;
+        std::cout << "sharemap_recv_cpu = " << to_string(sharemap_recv_cpu) << std::endl;
+        std::cout << "sharemap_recv_fifo_priority = " << to_string(sharemap_recv_fifo_priority) << std::endl;
         std::cout << "source_id = " << to_string(config.source_id) << std::endl;
         std::cout << "schema_hash = " << to_string(config.schema_hash) << std::endl;
         std::cout << "unix_timestamp_ns = " << to_string(config.unix_timestamp_ns) << std::endl;
@@ -525,11 +735,17 @@ void display(std::string what)
     }
     else if (what == "metrics")
     {
-        if (!metrics_initialized)
+        anysignal::sharemap_metrics_t metrics;
+        if (!metrics_initialized or !latest_metrics.load(metrics))
         {
             std::cout << "No metrics received" << std::endl;
             return;
         }
+        metrics_source_state_t source;
+        if (metrics_sources and metrics_sources->load(metrics.source_id, source) and source.stale)
+        {
+            std::cout << "Warning: source " << metrics.source_id << " is stale" << std::endl;
+        }
         std::cout << "source_id = " << to_string(metrics.source_id) << std::endl;
         std::cout << "schema_hash = " << to_string(metrics.schema_hash) << std::endl;
         std::cout << "unix_timestamp_ns = " << to_string(metrics.unix_timestamp_ns) << std::endl;
@@ -686,12 +902,100 @@ void display(std::string what)
         std::cout << "anylink_tap_endpoint_send_errors = " << to_string(metrics.anylink_tap_endpoint_send_errors) << std::endl;
         std::cout << "anylink_tap_endpoint_send_packets = " << to_string(metrics.anylink_tap_endpoint_send_packets) << std::endl;
     }
+    else if (what == "sources")
+    {
+        if (!metrics_sources or metrics_sources->size() == 0)
+        {
+            std::cout << "No metrics received" << std::endl;
+            return;
+        }
+        const auto now_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        printf("%9s %12s %12s %15s %10s %10s %10s %10s %8s %6s\n", "source_id", "frames", "age_ms",
+               "max_interval_ms", "bad_hash", "lost", "duplicate", "reordered", "resets", "stale");
+        metrics_sources->for_each([&](const std::uint16_t source_id, const metrics_source_state_t &state) {
+            printf("%9u %12lu %12.1f %15.1f %10lu %10lu %10lu %10lu %8lu %6s\n", source_id, state.frames,
+                   double(now_ns - state.last_arrival_ns) / 1e6, double(state.max_interval_ns) / 1e6,
+                   state.hash_mismatches, state.sequence.lost, state.sequence.duplicates,
+                   state.sequence.reordered + state.sequence.late, state.sequence.resets,
+                   state.stale ? "yes" : "no");
+        });
+    }
+    else if (what == "latency")
+    {
+        if (!metrics_sources or metrics_sources->size() == 0)
+        {
+            std::cout << "No metrics received" << std::endl;
+            return;
+        }
+        printf("%9s %-16s %10s %10s %10s %10s %10s %10s\n", "source_id", "latency_us", "count", "p50", "p90", "p99",
+               "p99.9", "max");
+        const auto print = [](const char *source_id, const char *name, const anysignal::latency_histogram &h) {
+            const auto s = h.snapshot();
+            printf("%9s %-16s %10lu %10.1f %10.1f %10.1f %10.1f %10.1f\n", source_id, name, s.count,
+                   double(s.percentile(50)) / 1e3, double(s.percentile(90)) / 1e3, double(s.percentile(99)) / 1e3,
+                   double(s.percentile(99.9)) / 1e3, double(s.max) / 1e3);
+        };
+        print("all", "wakeup_spin", wakeup_latency->spin);
+        print("all", "wakeup_blocked", wakeup_latency->blocked);
+        metrics_sources->for_each([&](const std::uint16_t source_id, const metrics_source_state_t &) {
+            const auto &latency = metrics_latency[metrics_sources->index(source_id)];
+            const auto id = std::to_string(source_id);
+            print(id.c_str(), "sender_to_kernel", latency.sender_to_kernel);
+            print(id.c_str(), "kernel_to_user", latency.kernel_to_user);
+            print(id.c_str(), "decode", latency.decode);
+        });
+    }
+    else if (what == "stats")
+    {
+        if (!metrics_socket)
+        {
+            std::cout << "No connection detected" << std::endl;
+            return;
+        }
+        const auto stats = metrics_socket->stats();
+        std::cout << "datagrams = " << stats.datagrams << std::endl;
+        std::cout << "bytes = " << stats.bytes << std::endl;
+        std::cout << "frames = " << metrics_datagrams->frames.load(std::memory_order_relaxed) << std::endl;
+        std::cout << "bundles = " << metrics_datagrams->bundles.load(std::memory_order_relaxed) << std::endl;
+        std::cout << "invalid = " << metrics_datagrams->invalid.load(std::memory_order_relaxed) << std::endl;
+        std::cout << "truncated = " << stats.truncated << std::endl;
+        std::cout << "eagain = " << stats.eagain << std::endl;
+        std::cout << "spurious_wakeups = " << stats.spurious_wakeups << std::endl;
+        std::cout << "socket_drops = " << stats.socket_drops << std::endl;
+        std::cout << "spin_hits = " << stats.spin_hits << std::endl;
+        std::cout << "spin_misses = " << stats.spin_misses << std::endl;
+    }
     else
     {
         std::cout << "Invalid argument to display command: " << what << std::endl;
     }
 }
 
+// Free everything connect set up, also after a connect that failed half way
+void release_connection()
+{
+    delete control_socket;
+    control_socket = nullptr;
+    delete metrics_socket;
+    metrics_socket = nullptr;
+    delete config_shm;
+    config_shm = nullptr;
+    delete metrics_shm;
+    metrics_shm = nullptr;
+    delete metrics_ring;
+    metrics_ring = nullptr;
+    delete metrics_sources;
+    metrics_sources = nullptr;
+    delete[] metrics_latency;
+    metrics_latency = nullptr;
+    delete wakeup_latency;
+    wakeup_latency = nullptr;
+    delete metrics_datagrams;
+    metrics_datagrams = nullptr;
+    metrics_initialized = false;
+}
+
 void connect()
 {
     std::cout << "Connecting sharemap client" << std::endl;
@@ -700,10 +1004,54 @@ void connect()
         std::cout << "Already connected" << std::endl;
         return;
     }
-    control_socket = new anysignal::udp_sock();
-    control_socket->connect(sharemap_control_url);
-    metrics_socket = new anysignal::udp_sock();
-    metrics_socket->bind(sharemap_metrics_url);
+    if ((sharemap_ring_slots & (sharemap_ring_slots - 1)) != 0)
+    {
+        std::cout << "sharemap_ring_slots must be 0 or a power of two" << std::endl;
+        return;
+    }
+    try
+    {
+        control_socket = new anysignal::udp_sock();
+        control_socket->connect(sharemap_control_url);
+        metrics_socket = new anysignal::udp_sock();
+        metrics_socket->bind(sharemap_metrics_url);
+        metrics_socket->set_gro(true);
+        metrics_socket->set_timestamps(true);
+        if (sharemap_busy_poll_us > 0)
+        {
+            try
+            {
+                metrics_socket->set_busy_poll(std::chrono::microseconds(sharemap_busy_poll_us));
+            }
+            catch (const std::exception &ex)
+            {
+                std::cout << "Warning: " << ex.what() << std::endl;
+            }
+        }
+        // drop foreign, mis-sized and stale-schema datagrams in the kernel, bundles are checked when split
+        metrics_socket->attach_filter(
+            {anysignal::udp_sock::sharemap_filter_rule<anysignal::sharemap_metrics_t>(),
+             {0, anysignal::SHAREMAP_BUNDLE_SCHEMA_HASH_OFFSET, anysignal::SHAREMAP_BUNDLE_HASH}});
+        metrics_sources = new anysignal::source_table<metrics_source_state_t>(sharemap_max_sources);
+        metrics_latency = new metrics_latency_t[metrics_sources->capacity()];
+        wakeup_latency = new wakeup_latency_t();
+        metrics_datagrams = new metrics_datagrams_t();
+        if (sharemap_shm)
+        {
+            config_shm = new anysignal::shm_latest_writer<anysignal::sharemap_config_t>();
+            metrics_shm = new anysignal::shm_latest_writer<anysignal::sharemap_metrics_t>();
+        }
+        if (sharemap_ring_slots > 0)
+        {
+            metrics_ring = new anysignal::shm_ring_writer<anysignal::sharemap_metrics_t>(sharemap_ring_slots);
+        }
+    }
+    catch (const std::exception &ex)
+    {
+        std::cout << "Failed to connect: " << ex.what() << std::endl;
+        release_connection();
+        return;
+    }
 
     std::cout << "Starting metrics monitor" << std::endl;
     receiving = true;
@@ -723,11 +1071,7 @@ void disconnect()
     {
         recv_thread.join();
     }
-    delete control_socket;
-    control_socket = nullptr;
-    delete metrics_socket;
-    metrics_socket = nullptr;
-    metrics_initialized = false;
+    release_connection();
 }
 
 void send_cmd(std::string arg)
@@ -740,8 +1084,26 @@ void send_cmd(std::string arg)
             std::cout << "No control socket connected" << std::endl;
             return;
         }
-        auto packed_config = anysignal::sharemap_pack(config);
-        control_socket->send(reinterpret_cast<uint8_t *>(&packed_config), anysignal::sharemap_config_t::PACKED_SIZE);
+        const auto errors = anysignal::sharemap_validate(config);
+        if (errors.any())
+        {
+            for (size_t i = 0; i < errors.size(); i++)
+            {
+                if (errors[i])
+                {
+                    std::cout << "Invalid config: " << anysignal::sharemap_config_t::RULES[i].name << std::endl;
+                }
+            }
+            std::cout << "Config not sent" << std::endl;
+            return;
+        }
+        std::array<std::uint8_t, anysignal::sharemap_config_t::PACKED_SIZE> packed_config;
+        anysignal::sharemap_pack(config, packed_config);
+        control_socket->send(packed_config.data(), packed_config.size());
+        if (config_shm)
+        {
+            config_shm->publish(config);
+        }
         std::cout << "Config sent" << std::endl;
     }
     else
@@ -769,6 +1131,8 @@ int main(int /*argc*/, char * /*argv*/[])
     config.psk_cc_tx_fe_stx2_gain = 55;
     config.psk_cc_tx_fe_stx2_atten = 0;
     config.psk_cc_tx_symbol_rate = 960e3;
+    val = "QPSK";
+    std::copy(val.begin(), val.end(), config.psk_cc_tx_modulation.data());
     config.psk_cc_rx_force_on = true;
     config.psk_cc_rx_idle_timeout_s = 4;
     config.psk_cc_rx_low_power_timeout_s = 1;
@@ -785,6 +1149,8 @@ int main(int /*argc*/, char * /*argv*/[])
     config.psk_cc_rx_fe_srx2_atten = 0;
     config.psk_cc_rx_fe_sample_rate = 30.72e6;
     config.psk_cc_rx_symbol_rate = 960e3;
+    val = "QPSK";
+    std::copy(val.begin(), val.end(), config.psk_cc_rx_modulation.data());
     config.dvbs2_tx_force_on = false;
     config.dvbs2_tx_idle_timeout_s = 4;
     config.dvbs2_tx_fe_frequency = 8.488e9;
@@ -806,7 +1172,7 @@ int main(int /*argc*/, char * /*argv*/[])
     config.gfsk_tx_fe_gain = 10;
     config.gfsk_tx_fe_atten = 0;
     config.gfsk_tx_fe_sample_rate = 400e3;
-    config.gfsk_tx_symbol_rate = 9.6e3;
+    config.gfsk_tx_symbol_rate = 10e3;
     config.gfsk_tx_mod_index = 0.5;
     config.gfsk_tx_max_payload_len = 128;
     config.gfsk_tx_bt = 1.0;
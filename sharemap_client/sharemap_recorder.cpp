@@ -0,0 +1,189 @@
+/***
+ * Record every received metrics frame to segmented log files, see recorder.hpp,
+ * or list the recorded frames of a time window, see recorder_reader.hpp.
+ *
+ * Usage: sharemap_recorder <bind url> <directory> [--segment-mb <n>] [--buffer-mb <n>] [--direct] [--preallocate]
+ *        sharemap_recorder --query <directory> <source_id|all> <t0 ns> <t1 ns>
+ */
+#include "recorder.hpp"
+#include "recorder_reader.hpp"
+#include "sharemap.hpp"
+#include "udp.hpp"
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+static std::atomic<bool> running{true};
+static void signal_callback_handler(int)
+{
+    running = false;
+}
+
+static void usage(const char *name)
+{
+    printf("Usage: %s <bind url> <directory> [--segment-mb <n>] [--buffer-mb <n>] [--direct] [--preallocate]\n", name);
+    printf("       %s --query <directory> <source_id|all> <t0 ns> <t1 ns>\n", name);
+}
+
+template <typename Sharemap>
+static void print_frame(const anysignal::recorder_view<Sharemap> &view)
+{
+    Sharemap frame;
+    view.unpack(frame);
+    printf("source %u unix_timestamp_ns %ld recv_ns %ld", view.source_id(), frame.unix_timestamp_ns, view.recv_ns());
+    if constexpr (Sharemap::HAS_SEQUENCE)
+    {
+        printf(" sequence %u", frame.sequence);
+    }
+    printf("\n");
+}
+
+// Print the recorded metrics frames with a sender timestamp in [t0, t1]
+static int query(const std::string &directory, const std::string &source, const std::int64_t t0, const std::int64_t t1)
+{
+    using metrics_t = anysignal::sharemap_metrics_t;
+    std::uint64_t frames = 0;
+    const auto print = [&](const anysignal::recorder_view<metrics_t> &view) {
+        print_frame(view);
+        frames++;
+    };
+
+    try
+    {
+        const anysignal::recorder_reader<metrics_t> reader(directory);
+        if (source == "all")
+        {
+            reader.query(t0, t1, print);
+        }
+        else
+        {
+            reader.query(std::uint16_t(std::stoul(source)), t0, t1, print);
+        }
+        printf("%lu of %lu frames in %zu segments\n", frames, reader.size(), reader.segments());
+    }
+    catch (const std::exception &ex)
+    {
+        printf("Error: %s\n", ex.what());
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc == 6 and std::string(argv[1]) == "--query")
+    {
+        return query(argv[2], argv[3], std::stoll(argv[4]), std::stoll(argv[5]));
+    }
+    if (argc < 3)
+    {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    const std::string url = argv[1];
+    anysignal::recorder_options options;
+    options.directory = argv[2];
+    for (int i = 3; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+        if (arg == "--segment-mb" and i + 1 < argc)
+        {
+            options.segment_bytes = std::stoul(argv[++i]) << 20;
+        }
+        else if (arg == "--buffer-mb" and i + 1 < argc)
+        {
+            options.buffer_bytes = std::stoul(argv[++i]) << 20;
+        }
+        else if (arg == "--direct")
+        {
+            options.direct_io = true;
+        }
+        else if (arg == "--preallocate")
+        {
+            options.preallocate = true;
+        }
+        else
+        {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    using metrics_t = anysignal::sharemap_metrics_t;
+    anysignal::udp_sock sock;
+    std::unique_ptr<anysignal::recorder<metrics_t>> recorder;
+    try
+    {
+        sock.bind(url);
+        sock.set_gro(true);
+        sock.set_timestamps(true);
+        sock.attach_filter({anysignal::udp_sock::sharemap_filter_rule<metrics_t>(),
+                            {0, anysignal::SHAREMAP_BUNDLE_SCHEMA_HASH_OFFSET, anysignal::SHAREMAP_BUNDLE_HASH}});
+        recorder = std::make_unique<anysignal::recorder<metrics_t>>(options);
+    }
+    catch (const std::exception &ex)
+    {
+        printf("Error: %s\n", ex.what());
+        return EXIT_FAILURE;
+    }
+    signal(SIGINT, signal_callback_handler);
+    signal(SIGTERM, signal_callback_handler);
+    printf("Recording metrics from %s to %s\n", url.c_str(), options.directory.c_str());
+
+    const auto record = [&](const std::uint8_t *frame, const std::int64_t recv_ns) {
+        std::uint16_t source_id{};
+        anysignal::sharemap_unpack_field(frame + offsetof(metrics_t::packed_t, source_id), source_id);
+        recorder->append(frame, recv_ns, source_id);
+    };
+
+    // keep at most about a second of frames in memory when traffic is light
+    std::vector<std::uint8_t> buff(anysignal::udp_sock::GSO_MAX_BYTES);
+    auto last_flush = std::chrono::steady_clock::now();
+    while (running)
+    {
+        if (sock.recv_ready(std::chrono::milliseconds(100)))
+        {
+            anysignal::udp_sock::recv_info info;
+            const int recvd = sock.recv(buff.data(), buff.size(), info);
+            if (recvd >= 0)
+            {
+                const auto recv_ns = info.kernel_timestamp_ns != 0 ? info.kernel_timestamp_ns
+                                                                   : anysignal::time_ns_since_epoch();
+                anysignal::udp_sock::for_each_segment(buff.data(), recvd, info, [&](const std::uint8_t *frame, size_t length) {
+                    if (anysignal::sharemap_is_bundle(frame, length))
+                    {
+                        anysignal::sharemap_bundle_for_each(frame, length, [&](const std::uint64_t hash, const std::uint8_t *entry, size_t entry_length) {
+                            if (hash == metrics_t::HASH and entry_length == metrics_t::PACKED_SIZE)
+                            {
+                                record(entry, recv_ns);
+                            }
+                        });
+                    }
+                    else if (length == metrics_t::PACKED_SIZE)
+                    {
+                        record(frame, recv_ns);
+                    }
+                });
+            }
+        }
+
+        const auto now = std::chrono::steady_clock::now();
+        if (now - last_flush >= std::chrono::seconds(1))
+        {
+            recorder->flush();
+            last_flush = now;
+        }
+    }
+
+    recorder->close();
+    const auto stats = recorder->stats();
+    const auto sock_stats = sock.stats();
+    printf("Recorded %lu frames (%lu dropped, %lu write errors) in %lu segments, %lu bytes\n", stats.records,
+           stats.dropped, stats.write_errors, stats.segments, stats.bytes_written);
+    printf("Kernel dropped %lu datagrams (full queue or filtered out)\n", sock_stats.socket_drops);
+    return EXIT_SUCCESS;
+}
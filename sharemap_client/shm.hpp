@@ -0,0 +1,112 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+namespace anysignal
+{
+
+// Named POSIX shared memory segment mapped into this process
+class shm_segment
+{
+  public:
+    shm_segment(void) = default;
+    ~shm_segment(void);
+    shm_segment(const shm_segment &) = delete;
+    shm_segment &operator=(const shm_segment &) = delete;
+
+    // Map the segment read-write, creating it or resizing it to size bytes.
+    // Pages are allocated on first touch, so sparse layouts only cost what is used.
+    void create(const std::string &name, const size_t size);
+
+    // Map an existing segment read-only
+    void open(const std::string &name);
+
+    // Remove the name; mappings stay valid until they are unmapped
+    static void remove(const std::string &name);
+
+    void *data(void) { return _data; }
+    const void *data(void) const { return _data; }
+    size_t size(void) const { return _size; }
+
+  private:
+    void *_data{nullptr};
+    size_t _size{0};
+    void map(const std::string &name, const int fd, const bool writable);
+};
+
+} // namespace anysignal
+
+////////////////////////////////////////////////////////////////////////
+// implementation details
+////////////////////////////////////////////////////////////////////////
+
+#include <fcntl.h> //O_*
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h> //close, ftruncate
+
+inline anysignal::shm_segment::~shm_segment(void)
+{
+    if (_data != nullptr)
+    {
+        ::munmap(_data, _size);
+    }
+}
+
+inline void anysignal::shm_segment::create(const std::string &name, const size_t size)
+{
+    const int fd = ::shm_open(name.c_str(), O_CREAT | O_RDWR, 0644);
+    if (fd == -1)
+    {
+        throw std::runtime_error("failed to create shared memory " + name);
+    }
+
+    struct ::stat st{};
+    if (::fstat(fd, &st) != 0 or (size_t(st.st_size) != size and ::ftruncate(fd, off_t(size)) != 0))
+    {
+        ::close(fd);
+        throw std::runtime_error("failed to size shared memory " + name);
+    }
+    map(name, fd, true);
+}
+
+inline void anysignal::shm_segment::open(const std::string &name)
+{
+    const int fd = ::shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd == -1)
+    {
+        throw std::runtime_error("failed to open shared memory " + name);
+    }
+    map(name, fd, false);
+}
+
+inline void anysignal::shm_segment::remove(const std::string &name)
+{
+    ::shm_unlink(name.c_str());
+}
+
+inline void anysignal::shm_segment::map(const std::string &name, const int fd, const bool writable)
+{
+    struct ::stat st{};
+    if (::fstat(fd, &st) != 0 or st.st_size == 0)
+    {
+        ::close(fd);
+        throw std::runtime_error("failed to stat shared memory " + name);
+    }
+
+    const int prot = writable ? PROT_READ | PROT_WRITE : PROT_READ;
+    void *data = ::mmap(nullptr, size_t(st.st_size), prot, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED)
+    {
+        throw std::runtime_error("failed to map shared memory " + name);
+    }
+
+    if (_data != nullptr)
+    {
+        ::munmap(_data, _size);
+    }
+    _data = data;
+    _size = size_t(st.st_size);
+}
@@ -0,0 +1,197 @@
+#pragma once
+#include "seqlock.hpp"
+#include "shm.hpp"
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace anysignal
+{
+
+// Latest value of a sharemap for every source_id, kept in a named shared memory segment.
+// One process publishes with shm_latest_writer; any number of local processes take
+// consistent snapshots with shm_latest_reader, without syscalls or locks.
+
+static constexpr size_t SHM_LATEST_NUM_SOURCES{size_t(1) << 16};
+static constexpr std::uint64_t SHM_LATEST_MAGIC{0x736d6c6174657374}; //"smlatest"
+
+template <typename Sharemap>
+std::string shm_latest_name(void)
+{
+    return "/sharemap_" + std::string(Sharemap::NAME);
+}
+
+// Segment layout, indexed directly by source_id.
+// A new segment is zero filled, which is the empty state of every member.
+template <typename Sharemap>
+struct shm_latest_segment_t
+{
+    std::atomic<std::uint64_t> magic;
+    std::uint64_t hash;
+    std::uint64_t slot_size;
+    std::uint64_t num_slots;
+    std::atomic<std::uint64_t> active[SHM_LATEST_NUM_SOURCES / 64]; // sources published so far
+    seqlock<Sharemap> slots[SHM_LATEST_NUM_SOURCES];
+};
+
+template <typename Sharemap>
+class shm_latest_writer
+{
+  public:
+    // Create the segment, or reuse it if a previous writer left one with the same schema
+    explicit shm_latest_writer(const std::string &name = shm_latest_name<Sharemap>());
+
+    // Replace the latest value for value.source_id
+    void publish(const Sharemap &value);
+
+  private:
+    shm_segment _shm;
+    shm_latest_segment_t<Sharemap> *_segment{nullptr};
+};
+
+template <typename Sharemap>
+class shm_latest_reader
+{
+  public:
+    explicit shm_latest_reader(const std::string &name = shm_latest_name<Sharemap>());
+
+    // Snapshot of the latest value for source_id, false if there is none
+    bool load(const std::uint16_t source_id, Sharemap &out) const;
+
+    // Number of values published for source_id, to poll for changes without copying
+    std::uint64_t version(const std::uint16_t source_id) const;
+
+    // Call fcn(const Sharemap &) with a snapshot of every published source
+    template <typename Fcn>
+    void for_each(Fcn &&fcn) const;
+
+  private:
+    shm_segment _shm;
+    const shm_latest_segment_t<Sharemap> *_segment{nullptr};
+};
+
+} // namespace anysignal
+
+////////////////////////////////////////////////////////////////////////
+// implementation details
+////////////////////////////////////////////////////////////////////////
+
+#include <bit> //countr_zero
+#include <new> //launder
+#include <stdexcept>
+
+template <typename Sharemap>
+anysignal::shm_latest_writer<Sharemap>::shm_latest_writer(const std::string &name)
+{
+    using segment_t = shm_latest_segment_t<Sharemap>;
+    _shm.create(name, sizeof(segment_t));
+    _segment = std::launder(reinterpret_cast<segment_t *>(_shm.data()));
+
+    const bool compatible = _segment->magic.load(std::memory_order_acquire) == SHM_LATEST_MAGIC and
+                            _segment->hash == Sharemap::HASH and _segment->slot_size == sizeof(seqlock<Sharemap>);
+    if (compatible)
+    {
+        // readers keep their mapping; only stores cut short by a dead writer need fixing.
+        // untouched slots are skipped, reading them would allocate their pages
+        for (size_t word = 0; word < SHM_LATEST_NUM_SOURCES / 64; word++)
+        {
+            auto bits = _segment->active[word].load(std::memory_order_relaxed);
+            for (; bits != 0; bits &= bits - 1)
+            {
+                _segment->slots[word * 64 + size_t(std::countr_zero(bits))].repair();
+            }
+        }
+        return;
+    }
+
+    // start over with a fresh zero filled segment, readers of the old one must reopen
+    if (_segment->magic.load(std::memory_order_relaxed) != 0)
+    {
+        shm_segment::remove(name);
+        _shm.create(name, sizeof(segment_t));
+        _segment = std::launder(reinterpret_cast<segment_t *>(_shm.data()));
+    }
+    _segment->hash = Sharemap::HASH;
+    _segment->slot_size = sizeof(seqlock<Sharemap>);
+    _segment->num_slots = SHM_LATEST_NUM_SOURCES;
+    _segment->magic.store(SHM_LATEST_MAGIC, std::memory_order_release);
+}
+
+template <typename Sharemap>
+void anysignal::shm_latest_writer<Sharemap>::publish(const Sharemap &value)
+{
+    const auto source_id = size_t(value.source_id);
+    _segment->slots[source_id].store(value);
+
+    auto &active = _segment->active[source_id / 64];
+    const auto bit = std::uint64_t(1) << (source_id % 64);
+    if ((active.load(std::memory_order_relaxed) & bit) == 0)
+    {
+        active.fetch_or(bit, std::memory_order_release);
+    }
+}
+
+template <typename Sharemap>
+anysignal::shm_latest_reader<Sharemap>::shm_latest_reader(const std::string &name)
+{
+    using segment_t = shm_latest_segment_t<Sharemap>;
+    _shm.open(name);
+    if (_shm.size() < sizeof(segment_t))
+    {
+        throw std::runtime_error("unexpected shared memory size for " + name);
+    }
+    _segment = std::launder(reinterpret_cast<const segment_t *>(_shm.data()));
+    if (_segment->magic.load(std::memory_order_acquire) != SHM_LATEST_MAGIC)
+    {
+        throw std::runtime_error("shared memory is not initialized: " + name);
+    }
+    if (_segment->hash != Sharemap::HASH or _segment->slot_size != sizeof(seqlock<Sharemap>))
+    {
+        throw std::runtime_error("shared memory schema mismatch: " + name);
+    }
+}
+
+template <typename Sharemap>
+bool anysignal::shm_latest_reader<Sharemap>::load(const std::uint16_t source_id, Sharemap &out) const
+{
+    // a writer that died mid-store leaves the slot busy until it restarts, so give up eventually
+    const auto &slot = _segment->slots[source_id];
+    for (int attempt = 0; attempt < 1000; attempt++)
+    {
+        if (slot.try_load(out))
+        {
+            return true;
+        }
+        if (slot.version() == 0)
+        {
+            return false;
+        }
+    }
+    return false;
+}
+
+template <typename Sharemap>
+std::uint64_t anysignal::shm_latest_reader<Sharemap>::version(const std::uint16_t source_id) const
+{
+    return _segment->slots[source_id].version();
+}
+
+template <typename Sharemap>
+template <typename Fcn>
+void anysignal::shm_latest_reader<Sharemap>::for_each(Fcn &&fcn) const
+{
+    Sharemap value;
+    for (size_t word = 0; word < SHM_LATEST_NUM_SOURCES / 64; word++)
+    {
+        auto bits = _segment->active[word].load(std::memory_order_acquire);
+        while (bits != 0)
+        {
+            const auto source_id = std::uint16_t(word * 64 + size_t(std::countr_zero(bits)));
+            bits &= bits - 1;
+            if (load(source_id, value))
+            {
+                fcn(value);
+            }
+        }
+    }
+}
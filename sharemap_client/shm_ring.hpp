@@ -0,0 +1,228 @@
+#pragma once
+#include "shm.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace anysignal
+{
+
+// Every received frame of a sharemap, in a ring of fixed size packed_t slots in shared memory.
+// One producer writes with shm_ring_writer and never waits. Each shm_ring_reader keeps its own
+// cursor; a reader that falls more than a ring behind skips ahead and counts the lost frames.
+
+static constexpr std::uint64_t SHM_RING_MAGIC{0x736d72696e677631}; //"smringv1"
+
+template <typename Sharemap>
+std::string shm_ring_name(void)
+{
+    return "/sharemap_" + std::string(Sharemap::NAME) + "_ring";
+}
+
+template <typename Sharemap>
+struct shm_ring_slot_t
+{
+    static constexpr size_t WORDS{(Sharemap::PACKED_SIZE + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t)};
+
+    // 2 * position + 1 while position is written, 2 * position + 2 once it is complete
+    alignas(64) std::atomic<std::uint64_t> seq;
+    std::uint64_t data[WORDS];
+};
+
+// Segment header, followed by capacity slots.
+// A new segment is zero filled, which is the empty state of every member.
+struct shm_ring_header_t
+{
+    std::atomic<std::uint64_t> magic;
+    std::uint64_t hash;
+    std::uint64_t slot_size;
+    std::uint64_t capacity;
+    alignas(64) std::atomic<std::uint64_t> head; // number of frames written
+};
+
+template <typename Sharemap>
+class shm_ring_writer
+{
+  public:
+    using packed_t = typename Sharemap::packed_t;
+
+    // Create the ring with capacity slots (a power of two), or reuse a compatible one
+    explicit shm_ring_writer(const size_t capacity, const std::string &name = shm_ring_name<Sharemap>());
+
+    void push(const packed_t &frame);
+
+  private:
+    shm_segment _shm;
+    shm_ring_header_t *_header{nullptr};
+    shm_ring_slot_t<Sharemap> *_slots{nullptr};
+    std::uint64_t _mask{0};
+};
+
+template <typename Sharemap>
+class shm_ring_reader
+{
+  public:
+    using packed_t = typename Sharemap::packed_t;
+
+    // Start with the next frame written, or with the oldest frame still in the ring
+    explicit shm_ring_reader(const std::string &name = shm_ring_name<Sharemap>(), const bool from_oldest = false);
+
+    // Copy the next frame into out, false when the reader caught up with the writer
+    bool pop(packed_t &out);
+
+    // Frames written but not read yet, including any that will be lost to an overrun
+    std::uint64_t available(void) const;
+
+    // Frames skipped because the writer lapped this reader
+    std::uint64_t overruns(void) const { return _overruns; }
+
+  private:
+    shm_segment _shm;
+    const shm_ring_header_t *_header{nullptr};
+    const shm_ring_slot_t<Sharemap> *_slots{nullptr};
+    std::uint64_t _capacity{0};
+    std::uint64_t _cursor{0};
+    std::uint64_t _overruns{0};
+};
+
+} // namespace anysignal
+
+////////////////////////////////////////////////////////////////////////
+// implementation details
+////////////////////////////////////////////////////////////////////////
+
+#include <cstring> //memcpy
+#include <new>     //launder
+#include <stdexcept>
+
+template <typename Sharemap>
+anysignal::shm_ring_writer<Sharemap>::shm_ring_writer(const size_t capacity, const std::string &name)
+{
+    using slot_t = shm_ring_slot_t<Sharemap>;
+    if (capacity == 0 or (capacity & (capacity - 1)) != 0)
+    {
+        throw std::runtime_error("shm ring capacity must be a power of two");
+    }
+
+    const size_t size = sizeof(shm_ring_header_t) + capacity * sizeof(slot_t);
+    _shm.create(name, size);
+    _header = std::launder(reinterpret_cast<shm_ring_header_t *>(_shm.data()));
+
+    // a restarted writer continues the sequence, a half written slot is simply written again
+    const bool compatible = _header->magic.load(std::memory_order_acquire) == SHM_RING_MAGIC and
+                            _header->hash == Sharemap::HASH and _header->slot_size == sizeof(slot_t) and
+                            _header->capacity == capacity;
+    if (not compatible)
+    {
+        if (_header->magic.load(std::memory_order_relaxed) != 0)
+        {
+            shm_segment::remove(name);
+            _shm.create(name, size);
+            _header = std::launder(reinterpret_cast<shm_ring_header_t *>(_shm.data()));
+        }
+        _header->hash = Sharemap::HASH;
+        _header->slot_size = sizeof(slot_t);
+        _header->capacity = capacity;
+        _header->magic.store(SHM_RING_MAGIC, std::memory_order_release);
+    }
+
+    _slots = std::launder(reinterpret_cast<slot_t *>(static_cast<std::uint8_t *>(_shm.data()) +
+                                                     sizeof(shm_ring_header_t)));
+    _mask = capacity - 1;
+}
+
+template <typename Sharemap>
+void anysignal::shm_ring_writer<Sharemap>::push(const packed_t &frame)
+{
+    using slot_t = shm_ring_slot_t<Sharemap>;
+    std::uint64_t words[slot_t::WORDS]{};
+    std::memcpy(words, &frame, sizeof(frame));
+
+    const auto position = _header->head.load(std::memory_order_relaxed);
+    auto &slot = _slots[position & _mask];
+    slot.seq.store(2 * position + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < slot_t::WORDS; i++)
+    {
+        std::atomic_ref<std::uint64_t>(slot.data[i]).store(words[i], std::memory_order_relaxed);
+    }
+    slot.seq.store(2 * position + 2, std::memory_order_release);
+    _header->head.store(position + 1, std::memory_order_release);
+}
+
+template <typename Sharemap>
+anysignal::shm_ring_reader<Sharemap>::shm_ring_reader(const std::string &name, const bool from_oldest)
+{
+    using slot_t = shm_ring_slot_t<Sharemap>;
+    _shm.open(name);
+    if (_shm.size() < sizeof(shm_ring_header_t))
+    {
+        throw std::runtime_error("unexpected shared memory size for " + name);
+    }
+    _header = std::launder(reinterpret_cast<const shm_ring_header_t *>(_shm.data()));
+    if (_header->magic.load(std::memory_order_acquire) != SHM_RING_MAGIC)
+    {
+        throw std::runtime_error("shared memory is not initialized: " + name);
+    }
+    if (_header->hash != Sharemap::HASH or _header->slot_size != sizeof(slot_t) or
+        _shm.size() < sizeof(shm_ring_header_t) + _header->capacity * sizeof(slot_t))
+    {
+        throw std::runtime_error("shared memory schema mismatch: " + name);
+    }
+
+    _slots = std::launder(reinterpret_cast<const slot_t *>(static_cast<const std::uint8_t *>(_shm.data()) +
+                                                           sizeof(shm_ring_header_t)));
+    _capacity = _header->capacity;
+    const auto head = _header->head.load(std::memory_order_acquire);
+    _cursor = (from_oldest and head > _capacity) ? head - _capacity : (from_oldest ? 0 : head);
+}
+
+template <typename Sharemap>
+bool anysignal::shm_ring_reader<Sharemap>::pop(packed_t &out)
+{
+    using slot_t = shm_ring_slot_t<Sharemap>;
+    std::uint64_t words[slot_t::WORDS];
+    while (true)
+    {
+        const auto head = _header->head.load(std::memory_order_acquire);
+        if (_cursor >= head)
+        {
+            return false;
+        }
+        if (head - _cursor > _capacity)
+        {
+            _overruns += head - _capacity - _cursor;
+            _cursor = head - _capacity;
+        }
+
+        const auto &slot = _slots[_cursor & (_capacity - 1)];
+        const auto expected = 2 * _cursor + 2;
+        if (slot.seq.load(std::memory_order_acquire) == expected)
+        {
+            auto *data = const_cast<std::uint64_t *>(slot.data);
+            for (size_t i = 0; i < slot_t::WORDS; i++)
+            {
+                words[i] = std::atomic_ref<std::uint64_t>(data[i]).load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.seq.load(std::memory_order_relaxed) == expected)
+            {
+                std::memcpy(&out, words, sizeof(out));
+                _cursor++;
+                return true;
+            }
+        }
+
+        // the writer lapped us while we looked at the slot, the frame is gone
+        _overruns++;
+        _cursor++;
+    }
+}
+
+template <typename Sharemap>
+std::uint64_t anysignal::shm_ring_reader<Sharemap>::available(void) const
+{
+    const auto head = _header->head.load(std::memory_order_acquire);
+    return head > _cursor ? head - _cursor : 0;
+}
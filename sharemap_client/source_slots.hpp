@@ -0,0 +1,70 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace anysignal
+{
+
+// Dense slot numbers for up to max_sources source_ids, given out in order of first use, so
+// single threaded consumers can keep per-source data in plain arrays indexed by slot.
+// A lookup is one load from a table of every source_id, allocated on the first insert.
+// See source_table for per-source state shared between threads.
+class source_slots
+{
+  public:
+    static constexpr std::uint32_t NO_SLOT{0xFFFFFFFF};
+
+    // Throws std::runtime_error for a count of 0 or more than there are source_ids
+    explicit source_slots(const size_t max_sources);
+
+    // Slot of source_id, NO_SLOT if it has none
+    std::uint32_t find(const std::uint16_t source_id) const
+    {
+        return _slots.empty() ? NO_SLOT : _slots[source_id];
+    }
+
+    // Slot of source_id, the next one (size() - 1 after the call) on first use,
+    // NO_SLOT if source_id is new and every slot is taken
+    std::uint32_t insert(const std::uint16_t source_id);
+
+    // Number of slots given out
+    size_t size(void) const { return _size; }
+
+    size_t max_sources(void) const { return _max_sources; }
+
+  private:
+    size_t _max_sources{0};
+    size_t _size{0};
+    std::vector<std::uint32_t> _slots; // source_id to slot
+};
+
+} // namespace anysignal
+
+////////////////////////////////////////////////////////////////////////
+// implementation details
+////////////////////////////////////////////////////////////////////////
+
+#include <stdexcept>
+
+inline anysignal::source_slots::source_slots(const size_t max_sources) : _max_sources(max_sources)
+{
+    if (max_sources == 0 or max_sources > (size_t(1) << 16))
+    {
+        throw std::runtime_error("invalid source count");
+    }
+}
+
+inline std::uint32_t anysignal::source_slots::insert(const std::uint16_t source_id)
+{
+    if (_slots.empty())
+    {
+        _slots.resize(size_t(1) << 16, NO_SLOT);
+    }
+    auto &slot = _slots[source_id];
+    if (slot == NO_SLOT and _size < _max_sources)
+    {
+        slot = std::uint32_t(_size++);
+    }
+    return slot;
+}
@@ -0,0 +1,220 @@
+#pragma once
+#include "seqlock.hpp"
+#include "sequence_tracker.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace anysignal
+{
+
+// Receiver side state of one source_id
+template <typename Sharemap>
+struct source_state
+{
+    Sharemap latest{};                  // last frame received
+    std::int64_t first_arrival_ns{0};   // local receive time of the first frame
+    std::int64_t last_arrival_ns{0};    // local receive time of the last frame
+    std::uint64_t frames{0};            // frames received
+    std::uint64_t hash_mismatches{0};   // frames received with another schema hash
+    std::int64_t max_interval_ns{0};    // longest time between two frames
+    sequence_tracker sequence;          // loss and reorder counters, for sharemaps with a sequence field
+    bool stale{false};                  // no frame within the staleness deadline, cleared by the next frame
+    std::uint64_t stale_events{0};      // times the source went stale
+};
+
+// Fold a received frame into its source state
+template <typename Sharemap>
+void source_state_update(source_state<Sharemap> &state, const Sharemap &frame, const std::int64_t arrival_ns);
+
+// Fixed capacity open addressing table of per-source states, keyed by source_id.
+// One thread inserts and updates without locks; any thread takes consistent
+// snapshots of single sources or iterates all of them. Memory is allocated
+// once up front, sources are never removed.
+template <typename State>
+class source_table
+{
+  public:
+    // Room for max_sources sources, the table keeps its load factor at or below one half
+    explicit source_table(const size_t max_sources);
+    source_table(const source_table &) = delete;
+    source_table &operator=(const source_table &) = delete;
+
+    // Call fcn(State &) on the state of source_id, a default constructed State on first use.
+    // Returns false without calling fcn if source_id is new and the table is full (single writer only).
+    template <typename Fcn>
+    bool update(const std::uint16_t source_id, Fcn &&fcn);
+
+    // Snapshot of the state of source_id, false if it was never updated
+    bool load(const std::uint16_t source_id, State &out) const;
+
+    // Call fcn(std::uint16_t source_id, const State &) with a snapshot of every source
+    template <typename Fcn>
+    void for_each(Fcn &&fcn) const;
+
+    // Number of sources in the table
+    size_t size(void) const { return _size.load(std::memory_order_acquire); }
+
+    // Maximum number of sources
+    size_t max_sources(void) const { return _max_sources; }
+
+    // Position of source_id in the table, NO_INDEX if it was never updated.
+    // Positions never change, so callers can keep more per-source data, such as
+    // atomic counters that cannot live in a seqlock, in arrays of capacity() entries.
+    static constexpr size_t NO_INDEX{~size_t(0)};
+    size_t index(const std::uint16_t source_id) const;
+    size_t capacity(void) const { return _mask + 1; }
+
+  private:
+    struct entry
+    {
+        std::atomic<std::uint32_t> key{0}; // source_id + 1, 0 when empty
+        seqlock<State> state;
+    };
+
+    size_t slot(const std::uint16_t source_id) const;
+    const entry *find(const std::uint16_t source_id) const;
+
+    std::unique_ptr<entry[]> _entries;
+    size_t _mask{0};
+    size_t _max_sources{0};
+    std::atomic<size_t> _size{0};
+};
+
+} // namespace anysignal
+
+////////////////////////////////////////////////////////////////////////
+// implementation details
+////////////////////////////////////////////////////////////////////////
+
+#include <algorithm> //max
+#include <bit>       //bit_ceil
+#include <stdexcept>
+
+template <typename Sharemap>
+void anysignal::source_state_update(source_state<Sharemap> &state, const Sharemap &frame, const std::int64_t arrival_ns)
+{
+    if (state.frames == 0)
+    {
+        state.first_arrival_ns = arrival_ns;
+    }
+    else
+    {
+        state.max_interval_ns = std::max(state.max_interval_ns, arrival_ns - state.last_arrival_ns);
+    }
+    if (frame.schema_hash != Sharemap::HASH)
+    {
+        state.hash_mismatches++;
+    }
+    if constexpr (requires { frame.sequence; })
+    {
+        state.sequence.update(frame.sequence);
+    }
+    state.latest = frame;
+    state.stale = false;
+    state.last_arrival_ns = arrival_ns;
+    state.frames++;
+}
+
+template <typename State>
+anysignal::source_table<State>::source_table(const size_t max_sources)
+{
+    if (max_sources == 0 or max_sources > (size_t(1) << 16))
+    {
+        throw std::runtime_error("source table size must be between 1 and 65536");
+    }
+    const auto capacity = std::bit_ceil(2 * max_sources);
+    _entries = std::make_unique<entry[]>(capacity);
+    _mask = capacity - 1;
+    _max_sources = max_sources;
+}
+
+template <typename State>
+size_t anysignal::source_table<State>::slot(const std::uint16_t source_id) const
+{
+    // fibonacci hashing spreads consecutive ids, which radios tend to get
+    return size_t((std::uint64_t(source_id) * 0x9E3779B97F4A7C15u) >> 32) & _mask;
+}
+
+template <typename State>
+const typename anysignal::source_table<State>::entry *anysignal::source_table<State>::find(
+    const std::uint16_t source_id) const
+{
+    const auto key = std::uint32_t(source_id) + 1;
+    for (auto i = slot(source_id);; i = (i + 1) & _mask)
+    {
+        const auto k = _entries[i].key.load(std::memory_order_acquire);
+        if (k == key)
+        {
+            return &_entries[i];
+        }
+        if (k == 0)
+        {
+            return nullptr;
+        }
+    }
+}
+
+template <typename State>
+template <typename Fcn>
+bool anysignal::source_table<State>::update(const std::uint16_t source_id, Fcn &&fcn)
+{
+    State state;
+    auto *e = const_cast<entry *>(find(source_id));
+    if (e != nullptr)
+    {
+        // the only writer, so the snapshot is never contended
+        e->state.load(state);
+        fcn(state);
+        e->state.store(state);
+        return true;
+    }
+
+    const auto size = _size.load(std::memory_order_relaxed);
+    if (size == _max_sources)
+    {
+        return false;
+    }
+    auto i = slot(source_id);
+    while (_entries[i].key.load(std::memory_order_relaxed) != 0)
+    {
+        i = (i + 1) & _mask;
+    }
+
+    // fill the state before the key makes it visible to readers
+    fcn(state);
+    _entries[i].state.store(state);
+    _entries[i].key.store(std::uint32_t(source_id) + 1, std::memory_order_release);
+    _size.store(size + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename State>
+bool anysignal::source_table<State>::load(const std::uint16_t source_id, State &out) const
+{
+    const auto *e = find(source_id);
+    return e != nullptr and e->state.load(out);
+}
+
+template <typename State>
+size_t anysignal::source_table<State>::index(const std::uint16_t source_id) const
+{
+    const auto *e = find(source_id);
+    return e == nullptr ? NO_INDEX : size_t(e - _entries.get());
+}
+
+template <typename State>
+template <typename Fcn>
+void anysignal::source_table<State>::for_each(Fcn &&fcn) const
+{
+    State state;
+    for (size_t i = 0; i <= _mask; i++)
+    {
+        const auto key = _entries[i].key.load(std::memory_order_acquire);
+        if (key != 0 and _entries[i].state.load(state))
+        {
+            fcn(std::uint16_t(key - 1), static_cast<const State &>(state));
+        }
+    }
+}
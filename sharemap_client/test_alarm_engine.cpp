@@ -0,0 +1,141 @@
+#include "alarm_engine.hpp"
+#include "sharemap.hpp"
+#include "test_frames.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+using metrics_t = anysignal::sharemap_metrics_t;
+
+static size_t field_index(const std::string_view name) { return anysignal::find_by_name(metrics_t::FIELDS, name); }
+
+// Set a field of a packed frame from a double, for the field types the rules read
+static void set_field(metrics_t::packed_t &packed, const std::string_view name, const double value)
+{
+    const auto &field = metrics_t::FIELDS[field_index(name)];
+    auto *out = reinterpret_cast<std::uint8_t *>(&packed) + field.offset;
+    switch (field.type)
+    {
+    case anysignal::sharemap_type_t::f64:
+        return anysignal::sharemap_pack_field(value, out);
+    case anysignal::sharemap_type_t::boolean:
+        return anysignal::sharemap_pack_field(value != 0.0, out);
+    default:
+        return anysignal::sharemap_pack_field(std::uint64_t(value), out);
+    }
+}
+
+static bool test_rules(void)
+{
+    std::cout << "testing alarm rules..." << std::endl;
+    const std::vector<anysignal::sharemap_alarm_t> rules{
+        {"hot", field_index("carrier_temp"), anysignal::sharemap_alarm_kind_t::above, 85.0, 80.0},
+        {"low", field_index("carrier_3v8_vsense"), anysignal::sharemap_alarm_kind_t::below, 3.6, 3.65},
+        {"unlocked", field_index("at86_is_pll_locked"), anysignal::sharemap_alarm_kind_t::below, 0.5, 0.5},
+        {"errors", field_index("psk_cc_tx_client_recv_errors"), anysignal::sharemap_alarm_kind_t::increases, 0.0,
+         0.0},
+        {"very hot", field_index("carrier_temp"), anysignal::sharemap_alarm_kind_t::above, 90.0, 90.0},
+    };
+    anysignal::alarm_engine<metrics_t> engine(2, rules);
+
+    std::string events;
+    const auto step = [&](const double temp, const double volts, const bool locked, const double errors) {
+        metrics_t metrics{};
+        metrics.source_id = 5;
+        auto packed = anysignal::sharemap_pack(metrics);
+        set_field(packed, "carrier_temp", temp);
+        set_field(packed, "carrier_3v8_vsense", volts);
+        set_field(packed, "at86_is_pll_locked", locked);
+        set_field(packed, "psk_cc_tx_client_recv_errors", errors);
+        engine.evaluate(packed, [&](const anysignal::alarm_event_t &event) {
+            events += (event.raised ? "+" : "-") + std::string(engine.alarm(event.alarm).name) + " ";
+        });
+        events += "| ";
+    };
+    step(70.0, 3.8, true, 10.0);  // a first frame raises nothing, not even for the errors so far
+    step(86.0, 3.8, true, 10.0);  // hot
+    step(82.0, 3.62, true, 10.0); // still hot until below 80, not low yet
+    step(79.0, 3.5, false, 12.0); // cooled, low, unlocked and errors
+    step(95.0, 3.64, true, 12.0); // hot and very hot, still low until 3.65, locked, no new errors
+    step(60.0, 3.7, true, 12.0);
+    // events come in the order of the rules
+    const std::string expected = "| +hot | | -hot +low +unlocked +errors | +hot -unlocked -errors +very hot | -hot -low "
+                                 "-very hot | ";
+    if (events != expected)
+    {
+        std::cerr << "unexpected events: " << events << std::endl;
+        return false;
+    }
+    if (engine.active(5, 0) or engine.active(6, 0))
+    {
+        std::cerr << "unexpected alarm state" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+static bool test_generated(void)
+{
+    std::cout << "testing generated alarm rules..." << std::endl;
+    anysignal::alarm_engine<metrics_t> engine(1);
+    if (engine.alarms() != metrics_t::ALARMS.size() or engine.alarms() == 0)
+    {
+        std::cerr << "unexpected rule count" << std::endl;
+        return false;
+    }
+
+    // a healthy frame: between the limits of every rule
+    std::map<size_t, std::pair<double, double>> limits; // field to lowest high and highest low
+    for (const auto &alarm : metrics_t::ALARMS)
+    {
+        auto &limit = limits.try_emplace(alarm.field, -1e9, 1e9).first->second;
+        if (alarm.kind == anysignal::sharemap_alarm_kind_t::below)
+        {
+            limit.first = std::max(limit.first, alarm.clear);
+        }
+        else if (alarm.kind == anysignal::sharemap_alarm_kind_t::above)
+        {
+            limit.second = std::min(limit.second, alarm.clear);
+        }
+    }
+    metrics_t metrics{};
+    auto packed = anysignal::sharemap_pack(metrics);
+    for (const auto &[field, limit] : limits)
+    {
+        const auto value = limit.first > -1e9 and limit.second < 1e9 ? (limit.first + limit.second) / 2
+                           : limit.first > -1e9                      ? limit.first + 1.0
+                                                                     : limit.second - 1.0;
+        set_field(packed, metrics_t::FIELDS[field].name, value);
+    }
+
+    std::vector<std::string> raised;
+    const auto collect = [&](const anysignal::alarm_event_t &event) {
+        raised.emplace_back(engine.alarm(event.alarm).name);
+    };
+    engine.evaluate(packed, collect);
+    set_field(packed, "ad9361_pgood", 0.0);
+    engine.evaluate(packed, collect);
+    if (raised != std::vector<std::string>{"ad9361_power_bad"})
+    {
+        std::cerr << raised.size() << " unexpected alarms, first " << (raised.empty() ? "" : raised[0]) << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(void)
+{
+    if (not test_rules())
+    {
+        return EXIT_FAILURE;
+    }
+    if (not test_generated())
+    {
+        return EXIT_FAILURE;
+    }
+    std::cout << "done" << std::endl;
+    return EXIT_SUCCESS;
+}
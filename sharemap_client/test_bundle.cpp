@@ -0,0 +1,122 @@
+#include "sharemap.hpp"
+#include <array>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+static bool test_roundtrip(void)
+{
+    std::cout << "testing sharemap bundles..." << std::endl;
+
+    anysignal::sharemap_config_t config{};
+    config.psk_cc_tx_symbol_rate = 960e3;
+    anysignal::sharemap_metrics_t metrics{};
+    metrics.source_id = 7;
+    metrics.psk_cc_tx_bytes_total = 1234;
+
+    // two configs and a metrics frame in one buffer, a third config does not fit
+    std::vector<std::uint8_t> buff(sizeof(anysignal::sharemap_bundle_header_t) +
+                                   3 * sizeof(anysignal::sharemap_bundle_entry_t) +
+                                   2 * anysignal::sharemap_config_t::PACKED_SIZE +
+                                   anysignal::sharemap_metrics_t::PACKED_SIZE);
+    anysignal::sharemap_bundle_writer writer(buff.data(), buff.size(), 3);
+    const bool added = writer.add(config) and writer.add(metrics) and writer.add(config);
+    if (not added or writer.add(config) or writer.count() != 3 or writer.size() != buff.size())
+    {
+        std::cerr << "unexpected bundle writer state" << std::endl;
+        return false;
+    }
+
+    // every frame matches a plain sharemap_pack of the same values
+    size_t configs = 0, others = 0;
+    const bool complete = anysignal::sharemap_bundle_for_each(
+        buff.data(), writer.size(), [&](const std::uint64_t hash, const std::uint8_t *frame, const size_t length) {
+            if (hash == anysignal::sharemap_config_t::HASH)
+            {
+                anysignal::sharemap_config_t out;
+                configs += anysignal::sharemap_unpack(frame, length, out) and out.psk_cc_tx_symbol_rate == 960e3;
+            }
+            else if (hash == anysignal::sharemap_metrics_t::HASH)
+            {
+                anysignal::sharemap_metrics_t out;
+                others += anysignal::sharemap_unpack(frame, length, out) and out.source_id == 7 and
+                          out.psk_cc_tx_bytes_total == 1234 and out.schema_hash == anysignal::sharemap_metrics_t::HASH;
+            }
+        });
+    if (not complete or configs != 2 or others != 1)
+    {
+        std::cerr << "unexpected bundle entries" << std::endl;
+        return false;
+    }
+
+    // truncated bundles and plain frames are rejected
+    size_t entries = 0;
+    const auto count = [&](std::uint64_t, const std::uint8_t *, size_t) { entries++; };
+    const auto packed = anysignal::sharemap_pack(config);
+    if (anysignal::sharemap_bundle_for_each(buff.data(), writer.size() - 1, count) or entries != 2 or
+        anysignal::sharemap_is_bundle(reinterpret_cast<const std::uint8_t *>(&packed), sizeof(packed)))
+    {
+        std::cerr << "malformed bundle accepted" << std::endl;
+        return false;
+    }
+
+    std::cout << "sharemap bundles work!" << std::endl;
+    return true;
+}
+
+static bool test_pack_span(void)
+{
+    std::cout << "testing packing into caller storage..." << std::endl;
+
+    anysignal::sharemap_config_t config{};
+    config.psk_cc_rx_symbol_rate = 1.5e6;
+
+    // the frame lands at an offset of a larger buffer, a short span is refused
+    std::vector<std::uint8_t> buff(anysignal::sharemap_config_t::PACKED_SIZE + 10, 0xAA);
+    const auto written = anysignal::sharemap_pack(config, std::span<std::uint8_t>(buff).subspan(10));
+    const auto refused = anysignal::sharemap_pack(config, std::span<std::uint8_t>(buff).subspan(11));
+    anysignal::sharemap_config_t out;
+    if (written != anysignal::sharemap_config_t::PACKED_SIZE or refused != 0 or buff[9] != 0xAA or
+        not anysignal::sharemap_unpack(buff.data() + 10, written, out) or out.psk_cc_rx_symbol_rate != 1.5e6 or
+        out.schema_hash != anysignal::sharemap_config_t::HASH)
+    {
+        std::cerr << "unexpected span pack result" << std::endl;
+        return false;
+    }
+
+    std::cout << "packing into caller storage works!" << std::endl;
+    return true;
+}
+
+static bool test_mtu(void)
+{
+    std::cout << "testing bundles within the MTU..." << std::endl;
+
+    // metrics frames only go into bundles over links with jumbo frames
+    static_assert(anysignal::sharemap_config_t::FITS_MTU_BUNDLE);
+    static_assert(not anysignal::sharemap_metrics_t::FITS_MTU_BUNDLE);
+
+    std::array<std::uint8_t, anysignal::SHAREMAP_BUNDLE_MTU_PAYLOAD> buff{};
+    anysignal::sharemap_bundle_writer writer(buff);
+    anysignal::sharemap_config_t config{};
+    anysignal::sharemap_metrics_t metrics{};
+    if (writer.add(metrics) or not writer.add(config) or writer.count() != 1)
+    {
+        std::cerr << "unexpected MTU bundle contents" << std::endl;
+        return false;
+    }
+
+    std::cout << "bundles within the MTU work!" << std::endl;
+    return true;
+}
+
+int main(void)
+{
+    if (not test_roundtrip())
+        return EXIT_FAILURE;
+    if (not test_pack_span())
+        return EXIT_FAILURE;
+    if (not test_mtu())
+        return EXIT_FAILURE;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,162 @@
+#include "column_store.hpp"
+#include "sharemap.hpp"
+#include "test_frames.hpp"
+#include <array>
+#include <cstdlib>
+#include <limits>
+#include <iostream>
+#include <vector>
+
+using metrics_t = anysignal::sharemap_metrics_t;
+
+static metrics_t::packed_t frame(const std::uint16_t source_id, const size_t i)
+{
+    return anysignal::packed_metrics(source_id, std::int64_t(1000 + i), [&](metrics_t &metrics) {
+        metrics.carrier_temp = 20.0 + double(i);
+        metrics.psk_cc_tx_bytes_total = i * 10;
+    });
+}
+
+// Flatten the two runs of a column
+template <typename T>
+static std::vector<T> flatten(const std::array<std::span<const T>, 2> &runs)
+{
+    std::vector<T> out(runs[0].begin(), runs[0].end());
+    out.insert(out.end(), runs[1].begin(), runs[1].end());
+    return out;
+}
+
+static bool test_selected_fields(void)
+{
+    std::cout << "testing column store of selected fields..." << std::endl;
+    anysignal::column_store<metrics_t> store(4, 100, {"carrier_temp", "psk_cc_tx_bytes_total"});
+    if (store.columns() != 3 or store.sample_bytes() != 24 or store.column("uhf_temp") != store.NO_COLUMN)
+    {
+        std::cerr << "unexpected columns" << std::endl;
+        return false;
+    }
+
+    // source 7 wraps its ring, source 9 does not
+    for (size_t i = 0; i < 250; i++)
+    {
+        store.append(frame(7, i));
+        if (i < 30)
+        {
+            store.append(frame(9, i));
+        }
+    }
+
+    const auto temp = store.column("carrier_temp");
+    const auto temps = flatten(store.samples<double>(7, temp));
+    const auto times = flatten(store.timestamps(7));
+    const auto totals = flatten(store.samples<std::uint64_t>(7, store.column("psk_cc_tx_bytes_total")));
+    if (store.size(7) != 100 or temps.size() != 100 or temps.front() != 170.0 or temps.back() != 269.0 or
+        times.front() != 1150 or totals.back() != 2490)
+    {
+        std::cerr << "unexpected samples of a wrapped source" << std::endl;
+        return false;
+    }
+    if (store.size(9) != 30 or flatten(store.samples<double>(9, temp)).back() != 49.0 or store.size(8) != 0 or
+        not store.samples<double>(8, temp)[0].empty())
+    {
+        std::cerr << "unexpected samples of a short source" << std::endl;
+        return false;
+    }
+
+    const auto summary = anysignal::column_summary(store.samples<double>(7, temp));
+    if (summary.count != 100 or summary.min != 170.0 or summary.max != 269.0 or summary.mean != 219.5)
+    {
+        std::cerr << "unexpected summary" << std::endl;
+        return false;
+    }
+
+    size_t sources = 0;
+    store.for_each_source([&](const std::uint16_t) { sources++; });
+    if (sources != 2)
+    {
+        std::cerr << "unexpected sources" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Pack and unpack one integer in its big-endian wire format
+template <typename T>
+static bool round_trips(const T value)
+{
+    std::array<std::uint8_t, sizeof(T)> wire{};
+    anysignal::sharemap_pack_field(value, wire.data());
+    T out{};
+    anysignal::sharemap_unpack_field(wire.data(), out);
+    return out == value;
+}
+
+static bool test_integers(void)
+{
+    std::cout << "testing signed and unsigned integer fields..." << std::endl;
+    if (not round_trips(std::int8_t(-1)) or not round_trips(std::int8_t(-128)) or not round_trips(std::int8_t(127)) or
+        not round_trips(std::int16_t(-2)) or not round_trips(std::numeric_limits<std::int32_t>::min()) or
+        not round_trips(std::int64_t(-3)) or not round_trips(std::uint8_t(0xFF)) or
+        not round_trips(std::numeric_limits<std::uint32_t>::max()) or
+        not round_trips(std::numeric_limits<std::uint64_t>::max()))
+    {
+        std::cerr << "an integer did not survive packing" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+static bool test_limits(void)
+{
+    std::cout << "testing column store limits..." << std::endl;
+    anysignal::column_store<metrics_t> store(2, 8);
+    if (store.sample_bytes() <= metrics_t::PACKED_SIZE - 1 or not store.append(frame(1, 0)) or
+        not store.append(frame(2, 0)) or store.append(frame(3, 0)) or not store.append(frame(1, 1)))
+    {
+        std::cerr << "unexpected source limit" << std::endl;
+        return false;
+    }
+
+    // wrong types and unknown fields are refused
+    bool refused = false;
+    try
+    {
+        store.samples<float>(1, store.column("carrier_temp"));
+    }
+    catch (const std::runtime_error &)
+    {
+        refused = true;
+    }
+    try
+    {
+        anysignal::column_store<metrics_t> bad(2, 8, {"no_such_field"});
+        refused = false;
+    }
+    catch (const std::runtime_error &)
+    {
+    }
+    if (not refused)
+    {
+        std::cerr << "a bad column was accepted" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(void)
+{
+    if (not test_selected_fields())
+    {
+        return EXIT_FAILURE;
+    }
+    if (not test_limits())
+    {
+        return EXIT_FAILURE;
+    }
+    if (not test_integers())
+    {
+        return EXIT_FAILURE;
+    }
+    std::cout << "done" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,187 @@
+#include "compressed_block.hpp"
+#include "sharemap.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using metrics_t = anysignal::sharemap_metrics_t;
+
+// Frame i of a telemetry-like stream: steady clocks and counters, drifting floats,
+// a flag that flips now and then and strings that never change
+static metrics_t::packed_t smooth_frame(const size_t i)
+{
+    metrics_t::packed_t packed{};
+    auto *out = reinterpret_cast<std::uint8_t *>(&packed);
+    for (size_t f = 0; f < metrics_t::FIELDS.size(); f++)
+    {
+        const auto &field = metrics_t::FIELDS[f];
+        switch (field.type)
+        {
+        case anysignal::sharemap_type_t::f32: {
+            const auto value = float(20.0 + f + 0.5 * std::sin(double(i) / 50.0));
+            std::memcpy(out + field.offset, &value, sizeof(value));
+            break;
+        }
+        case anysignal::sharemap_type_t::f64: {
+            const auto value = 1e3 * double(f) + 0.001 * double(i);
+            std::memcpy(out + field.offset, &value, sizeof(value));
+            break;
+        }
+        case anysignal::sharemap_type_t::boolean:
+            out[field.offset] = (i / 100) % 2;
+            break;
+        case anysignal::sharemap_type_t::string:
+            std::memcpy(out + field.offset, "1.2.3", 5);
+            break;
+        default: {
+            // big endian counter growing by f per frame, with a hiccup every 64 frames
+            auto value = std::uint64_t(1700000000000000000 * (field.size == 8)) + i * f + (i % 64 == 0 ? 3 : 0);
+            for (size_t b = field.size; b > 0; b--, value >>= 8)
+            {
+                out[field.offset + b - 1] = std::uint8_t(value);
+            }
+        }
+        }
+    }
+    return packed;
+}
+
+static bool roundtrip(const std::vector<metrics_t::packed_t> &frames, size_t &encoded_bytes)
+{
+    anysignal::compressed_block_encoder<metrics_t> encoder;
+    for (const auto &frame : frames)
+    {
+        encoder.add(frame);
+    }
+    std::vector<std::uint8_t> block;
+    encoder.finish(block);
+    encoded_bytes = block.size();
+
+    anysignal::compressed_block_decoder<metrics_t> decoder(block.data(), block.size());
+    if (decoder.size() != frames.size() or decoder.block_length() != block.size())
+    {
+        std::cerr << "unexpected block size" << std::endl;
+        return false;
+    }
+    metrics_t::packed_t out;
+    for (size_t i = 0; i < frames.size(); i++)
+    {
+        if (not decoder.next(out) or std::memcmp(&out, &frames[i], sizeof(out)) != 0)
+        {
+            std::cerr << "frame " << i << " differs after decoding" << std::endl;
+            return false;
+        }
+    }
+    return not decoder.next(out);
+}
+
+static bool test_smooth(void)
+{
+    std::cout << "testing compression of a smooth stream..." << std::endl;
+    std::vector<metrics_t::packed_t> frames;
+    for (size_t i = 0; i < 1000; i++)
+    {
+        frames.push_back(smooth_frame(i));
+    }
+    size_t encoded = 0;
+    if (not roundtrip(frames, encoded))
+    {
+        return false;
+    }
+    const auto ratio = double(frames.size() * metrics_t::PACKED_SIZE) / double(encoded);
+    if (ratio < 8.0)
+    {
+        std::cerr << "compression ratio only " << ratio << std::endl;
+        return false;
+    }
+    return true;
+}
+
+static bool test_random(void)
+{
+    std::cout << "testing compression of random frames..." << std::endl;
+    std::mt19937_64 rng(7);
+    std::vector<metrics_t::packed_t> frames(300);
+    for (size_t i = 0; i < frames.size(); i++)
+    {
+        auto *bytes = reinterpret_cast<std::uint8_t *>(&frames[i]);
+        for (size_t b = 0; b < sizeof(frames[i]); b++)
+        {
+            // runs of equal frames and mostly small changes, then anything at all
+            bytes[b] = i < 100 ? std::uint8_t(i / 10) : i < 200 ? std::uint8_t(rng() % 3) : std::uint8_t(rng());
+        }
+    }
+    size_t encoded = 0;
+    return roundtrip(frames, encoded) and roundtrip({frames.front()}, encoded) and roundtrip({}, encoded);
+}
+
+static bool test_stream(void)
+{
+    std::cout << "testing a stream of compressed blocks..." << std::endl;
+    anysignal::compressed_block_encoder<metrics_t> encoder;
+    std::vector<std::uint8_t> stream;
+    for (size_t i = 0; i < 250; i++)
+    {
+        encoder.add(smooth_frame(i));
+        if (encoder.size() == 100)
+        {
+            encoder.finish(stream);
+        }
+    }
+    encoder.finish(stream);
+
+    size_t offset = 0, frames = 0;
+    metrics_t::packed_t out;
+    while (offset < stream.size())
+    {
+        anysignal::compressed_block_decoder<metrics_t> decoder(stream.data() + offset, stream.size() - offset);
+        while (decoder.next(out))
+        {
+            const auto expected = smooth_frame(frames++);
+            if (std::memcmp(&out, &expected, sizeof(out)) != 0)
+            {
+                std::cerr << "frame " << frames - 1 << " differs in the stream" << std::endl;
+                return false;
+            }
+        }
+        offset += decoder.block_length();
+    }
+    if (frames != 250)
+    {
+        std::cerr << "decoded " << frames << " frames from the stream" << std::endl;
+        return false;
+    }
+
+    // a block of another sharemap is refused
+    try
+    {
+        anysignal::compressed_block_decoder<anysignal::sharemap_config_t> decoder(stream.data(), stream.size());
+        std::cerr << "decoded a metrics block as config" << std::endl;
+        return false;
+    }
+    catch (const std::runtime_error &)
+    {
+    }
+    return true;
+}
+
+int main(void)
+{
+    if (not test_smooth())
+    {
+        return EXIT_FAILURE;
+    }
+    if (not test_random())
+    {
+        return EXIT_FAILURE;
+    }
+    if (not test_stream())
+    {
+        return EXIT_FAILURE;
+    }
+    std::cout << "done" << std::endl;
+    return EXIT_SUCCESS;
+}
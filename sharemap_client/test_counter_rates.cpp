@@ -0,0 +1,116 @@
+#include "counter_rates.hpp"
+#include "sharemap.hpp"
+#include "test_frames.hpp"
+#include <cstdlib>
+#include <iostream>
+
+using metrics_t = anysignal::sharemap_metrics_t;
+using rates_t = anysignal::counter_rates<metrics_t>;
+
+static metrics_t::packed_t frame(const std::uint16_t source_id, const std::int64_t timestamp,
+                                 const std::uint64_t bytes)
+{
+    return anysignal::packed_metrics(source_id, timestamp, [&](metrics_t &metrics) {
+        metrics.psk_cc_tx_bytes_total = bytes;
+        metrics.psk_cc_rx_bytes_total = 2 * bytes;
+    });
+}
+
+// The fields of the counters, by counter index
+static constexpr auto COUNTER_FIELDS{[] {
+    std::array<anysignal::sharemap_field_t, rates_t::COUNTERS> fields{};
+    for (size_t k = 0; k < rates_t::COUNTERS; k++)
+    {
+        fields[k] = rates_t::field(k);
+    }
+    return fields;
+}()};
+
+static size_t counter(const std::string_view name) { return anysignal::find_by_name(COUNTER_FIELDS, name); }
+
+static bool test_rates(void)
+{
+    std::cout << "testing counter rates..." << std::endl;
+    static_assert(anysignal::counter_rates<anysignal::sharemap_config_t>::COUNTERS == 0);
+    const auto tx = counter("psk_cc_tx_bytes_total");
+    const auto rx = counter("psk_cc_rx_bytes_total");
+    if (tx == rates_t::COUNTERS or rx == rates_t::COUNTERS or counter("anylink_tap_endpoint_mtu") != rates_t::COUNTERS)
+    {
+        std::cerr << "unexpected counters" << std::endl;
+        return false;
+    }
+
+    rates_t rates(2);
+    std::array<double, rates_t::COUNTERS> out{};
+    const std::int64_t second = 1'000'000'000;
+    if (rates.update(frame(1, 10 * second, 1000), out))
+    {
+        std::cerr << "rates from a first frame" << std::endl;
+        return false;
+    }
+
+    // 500 bytes in half a second
+    if (not rates.update(frame(1, 10 * second + second / 2, 1500), out) or out[tx] != 1000.0 or out[rx] != 2000.0 or
+        out[counter("psk_cc_tx_underflows")] != 0.0)
+    {
+        std::cerr << "unexpected rate " << out[tx] << std::endl;
+        return false;
+    }
+
+    // a frame not newer than the previous one is ignored
+    if (rates.update(frame(1, 10 * second, 0), out) or not rates.update(frame(1, 11 * second, 2000), out) or
+        out[tx] != 1000.0)
+    {
+        std::cerr << "unexpected rate after an old frame " << out[tx] << std::endl;
+        return false;
+    }
+
+    // a restart counts from zero
+    if (not rates.update(frame(1, 12 * second, 300), out) or out[tx] != 300.0 or out[rx] != 600.0)
+    {
+        std::cerr << "unexpected rate after a restart " << out[tx] << std::endl;
+        return false;
+    }
+
+    // a count near the top of its range wraps around
+    const auto top = ~std::uint64_t(0) - 99;
+    if (not rates.update(frame(1, 13 * second, top), out) or
+        not rates.update(frame(1, 14 * second, 100), out) or out[tx] != 200.0)
+    {
+        std::cerr << "unexpected rate after a wrap " << out[tx] << std::endl;
+        return false;
+    }
+
+    // sources are independent, up to the limit
+    rates.update(frame(2, 14 * second, 0), out);
+    if (not rates.update(frame(2, 15 * second, 50), out) or out[tx] != 50.0 or
+        rates.update(frame(3, 15 * second, 0), out) or rates.update(frame(3, 16 * second, 0), out))
+    {
+        std::cerr << "unexpected rates of other sources" << std::endl;
+        return false;
+    }
+
+    // slots given by the caller, regardless of source_id, up to the limit
+    rates_t slotted(2);
+    const auto f0 = frame(9, 20 * second, 0);
+    const auto f1 = frame(9, 21 * second, 10);
+    const auto *p0 = reinterpret_cast<const std::uint8_t *>(&f0);
+    const auto *p1 = reinterpret_cast<const std::uint8_t *>(&f1);
+    if (slotted.update(1, p0, out) or not slotted.update(1, p1, out) or out[tx] != 10.0 or slotted.update(0, p1, out) or
+        slotted.update(2, p0, out) or slotted.update(2, p1, out))
+    {
+        std::cerr << "unexpected rates by slot" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(void)
+{
+    if (not test_rates())
+    {
+        return EXIT_FAILURE;
+    }
+    std::cout << "done" << std::endl;
+    return EXIT_SUCCESS;
+}
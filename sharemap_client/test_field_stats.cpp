@@ -0,0 +1,145 @@
+#include "field_stats.hpp"
+#include "sharemap.hpp"
+#include "test_frames.hpp"
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+using metrics_t = anysignal::sharemap_metrics_t;
+
+static constexpr std::int64_t SECOND{1'000'000'000};
+
+static metrics_t::packed_t frame(const std::uint16_t source_id, const std::int64_t timestamp, const double temp)
+{
+    return anysignal::packed_metrics(source_id, timestamp, [&](metrics_t &metrics) {
+        metrics.carrier_temp = temp;
+        metrics.sband_temp = 30.0;
+    });
+}
+
+static bool near(const double a, const double b) { return std::abs(a - b) < 1e-9 * std::max(1.0, std::abs(b)); }
+
+static bool test_running(void)
+{
+    std::cout << "testing running statistics..." << std::endl;
+    anysignal::field_stats<metrics_t> stats(4);
+    for (int i = 1; i <= 100; i++)
+    {
+        stats.update(frame(2, i * SECOND / 10, double(i)));
+    }
+    const auto temp = stats.stats(2, stats.column("carrier_temp"));
+    if (temp.count != 100 or not near(temp.mean, 50.5) or not near(temp.variance, 100.0 * 101.0 / 12.0) or
+        temp.min != 1.0 or temp.max != 100.0)
+    {
+        std::cerr << "unexpected statistics, mean " << temp.mean << " variance " << temp.variance << std::endl;
+        return false;
+    }
+    const auto sband = stats.column("sband_temp");
+    if (stats.stats(2, sband).variance != 0.0 or stats.ewma(2, sband, 2) != 30.0 or stats.stats(3, sband).count != 0)
+    {
+        std::cerr << "unexpected statistics of a constant" << std::endl;
+        return false;
+    }
+    if (stats.column("psk_cc_tx_bytes_total") != stats.NO_COLUMN or stats.column("controld_version") != stats.NO_COLUMN)
+    {
+        std::cerr << "unexpected columns" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+static bool test_ewma(void)
+{
+    std::cout << "testing moving averages..." << std::endl;
+    anysignal::field_stats<metrics_t> stats(1, {SECOND, 10 * SECOND});
+    const auto temp = stats.column("carrier_temp");
+
+    // a step from 0 to 10, one frame a second
+    stats.update(frame(1, 100 * SECOND, 0.0));
+    stats.update(frame(1, 101 * SECOND, 10.0));
+    if (not near(stats.ewma(1, temp, 0), 10.0 * (1.0 - std::exp(-1.0))) or
+        not near(stats.ewma(1, temp, 1), 10.0 * (1.0 - std::exp(-0.1))))
+    {
+        std::cerr << "unexpected step response " << stats.ewma(1, temp, 0) << std::endl;
+        return false;
+    }
+
+    // a frame from the past moves the statistics but not the averages
+    const auto before = stats.ewma(1, temp, 0);
+    stats.update(frame(1, 99 * SECOND, 50.0));
+    if (stats.ewma(1, temp, 0) != before or stats.stats(1, temp).max != 50.0)
+    {
+        std::cerr << "an old frame moved an average" << std::endl;
+        return false;
+    }
+    for (int i = 2; i < 60; i++)
+    {
+        stats.update(frame(1, (100 + i) * SECOND, 10.0));
+    }
+    if (std::abs(stats.ewma(1, temp, 0) - 10.0) > 1e-6 or std::abs(stats.ewma(1, temp, 1) - 10.0) > 0.1)
+    {
+        std::cerr << "averages did not settle" << std::endl;
+        return false;
+    }
+
+    // sources beyond the limit and bad time constants are refused
+    if (stats.update(frame(2, 0, 0.0)))
+    {
+        std::cerr << "unexpected source limit" << std::endl;
+        return false;
+    }
+    try
+    {
+        anysignal::field_stats<metrics_t> bad(1, {0});
+        std::cerr << "a time constant of 0 was accepted" << std::endl;
+        return false;
+    }
+    catch (const std::runtime_error &)
+    {
+    }
+    return true;
+}
+
+// Value of one packed field decoded through the FIELDS table helper
+template <typename T>
+static double unpack_number(const anysignal::sharemap_type_t type, const T value)
+{
+    std::array<std::uint8_t, sizeof(T)> wire{};
+    anysignal::sharemap_pack_field(value, wire.data());
+    return anysignal::sharemap_unpack_number({"field", type, 0, sizeof(T), false}, wire.data());
+}
+
+static bool test_unpack_number(void)
+{
+    std::cout << "testing numeric field decoding..." << std::endl;
+    using type_t = anysignal::sharemap_type_t;
+    if (unpack_number(type_t::i8, std::int8_t(-5)) != -5.0 or unpack_number(type_t::i16, std::int16_t(-300)) != -300.0 or
+        unpack_number(type_t::i32, std::int32_t(-70000)) != -70000.0 or
+        unpack_number(type_t::i64, std::int64_t(-1) << 40) != -1099511627776.0 or
+        unpack_number(type_t::u8, std::uint8_t(250)) != 250.0 or unpack_number(type_t::f32, 1.5f) != 1.5 or
+        unpack_number(type_t::boolean, true) != 1.0)
+    {
+        std::cerr << "unexpected decoded number" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(void)
+{
+    if (not test_running())
+    {
+        return EXIT_FAILURE;
+    }
+    if (not test_ewma())
+    {
+        return EXIT_FAILURE;
+    }
+    if (not test_unpack_number())
+    {
+        return EXIT_FAILURE;
+    }
+    std::cout << "done" << std::endl;
+    return EXIT_SUCCESS;
+}
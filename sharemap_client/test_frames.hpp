@@ -0,0 +1,61 @@
+#pragma once
+#include "sharemap.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+
+// Packed frames for the tests and benchmarks, with the timestamps they choose, and lookups by name
+namespace anysignal
+{
+
+// Pack in with unix_timestamp_ns set to timestamp_ns rather than the time of packing
+template <typename Sharemap>
+typename Sharemap::packed_t packed_at(Sharemap &in, const std::int64_t timestamp_ns);
+
+// Packed metrics frame of source_id at timestamp_ns, the other fields zero but for the ones
+// set by setter(sharemap_metrics_t &)
+template <typename Setter>
+sharemap_metrics_t::packed_t packed_metrics(const std::uint16_t source_id, const std::int64_t timestamp_ns,
+                                            Setter &&setter);
+
+// Index of the entry named name in a table such as FIELDS or RULES, its size if there is none
+template <typename Table>
+size_t find_by_name(const Table &table, const std::string_view name);
+
+} // namespace anysignal
+
+////////////////////////////////////////////////////////////////////////
+// implementation details
+////////////////////////////////////////////////////////////////////////
+
+template <typename Sharemap>
+typename Sharemap::packed_t anysignal::packed_at(Sharemap &in, const std::int64_t timestamp_ns)
+{
+    auto packed = sharemap_pack(in);
+    in.unix_timestamp_ns = timestamp_ns;
+    sharemap_pack_field(timestamp_ns, reinterpret_cast<std::uint8_t *>(&packed) +
+                                          offsetof(typename Sharemap::packed_t, unix_timestamp_ns));
+    return packed;
+}
+
+template <typename Setter>
+anysignal::sharemap_metrics_t::packed_t anysignal::packed_metrics(const std::uint16_t source_id,
+                                                                  const std::int64_t timestamp_ns, Setter &&setter)
+{
+    sharemap_metrics_t metrics{};
+    metrics.source_id = source_id;
+    setter(metrics);
+    return packed_at(metrics, timestamp_ns);
+}
+
+template <typename Table>
+size_t anysignal::find_by_name(const Table &table, const std::string_view name)
+{
+    size_t i = 0;
+    while (i < std::size(table) and table[i].name != name)
+    {
+        i++;
+    }
+    return i;
+}
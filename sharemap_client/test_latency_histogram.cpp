@@ -0,0 +1,103 @@
+#include "latency_histogram.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+
+static bool test_buckets(void)
+{
+    std::cout << "testing latency histogram buckets..." << std::endl;
+    using hist = anysignal::latency_histogram;
+
+    // buckets tile the value range without gaps, each at most 12.5% wide
+    for (size_t i = 0; i < hist::BUCKETS; i++)
+    {
+        const auto lower = hist::bucket_lower(i);
+        const auto upper = hist::bucket_upper(i);
+        if (hist::bucket(lower) != i or hist::bucket(upper - 1) != i or (i > 0 and hist::bucket_upper(i - 1) != lower))
+        {
+            std::cerr << "bucket " << i << " does not tile [" << lower << ", " << upper << ")" << std::endl;
+            return false;
+        }
+        if (lower >= hist::LINEAR_BUCKETS and double(upper - lower) > 0.125 * double(lower))
+        {
+            std::cerr << "bucket " << i << " is too wide" << std::endl;
+            return false;
+        }
+    }
+    if (hist::bucket(~std::uint64_t(0)) != hist::BUCKETS - 1)
+    {
+        std::cerr << "large values must land in the last bucket" << std::endl;
+        return false;
+    }
+
+    std::cout << "latency histogram buckets work!" << std::endl;
+    return true;
+}
+
+static bool test_percentiles(void)
+{
+    std::cout << "testing latency histogram percentiles..." << std::endl;
+    anysignal::latency_histogram h;
+
+    // uniform 0..1ms: percentiles within a bucket width of the exact value
+    std::mt19937_64 rng(42);
+    constexpr std::int64_t range = 1000000;
+    for (int i = 0; i < 1000000; i++)
+        h.record(std::int64_t(rng() % std::uint64_t(range)));
+    h.record(-5);
+
+    const auto s = h.snapshot();
+    for (const double p : {10.0, 50.0, 90.0, 99.0, 99.9})
+    {
+        const auto exact = p / 100.0 * double(range);
+        const auto value = double(s.percentile(p));
+        if (value < exact * 0.93 or value > exact * 1.07)
+        {
+            std::cerr << "p" << p << " = " << value << ", expected about " << exact << std::endl;
+            return false;
+        }
+    }
+    if (s.count != 1000001 or s.negative != 1 or s.max >= std::uint64_t(range) or s.percentile(0) != 0 or
+        s.mean() < 0.49 * double(range) or s.mean() > 0.51 * double(range))
+    {
+        std::cerr << "unexpected snapshot totals" << std::endl;
+        return false;
+    }
+
+    // snapshots taken while recording never count more than was recorded
+    anysignal::latency_histogram live;
+    std::thread writer([&] {
+        for (int i = 0; i < 2000000; i++)
+            live.record(i % 5000);
+    });
+    std::uint64_t last = 0;
+    bool ok = true;
+    while (last < 2000000 and ok)
+    {
+        const auto snap = live.snapshot();
+        std::uint64_t total = 0;
+        for (const auto c : snap.counts)
+            total += c;
+        ok = snap.count >= last and total >= snap.count and total <= 2000000;
+        last = snap.count;
+    }
+    writer.join();
+    if (not ok)
+    {
+        std::cerr << "inconsistent live snapshot" << std::endl;
+        return false;
+    }
+
+    std::cout << "latency histogram percentiles work!" << std::endl;
+    return true;
+}
+
+int main(void)
+{
+    if (not test_buckets())
+        return EXIT_FAILURE;
+    if (not test_percentiles())
+        return EXIT_FAILURE;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,327 @@
+#include "recorder.hpp"
+#include "recorder_decode.hpp"
+#include "recorder_reader.hpp"
+#include "sharemap.hpp"
+#include "test_frames.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <string_view>
+#include <vector>
+
+// Small stand-in for a generated sharemap
+struct test_sharemap_t
+{
+    static constexpr std::string_view NAME{"recorder_test"};
+    static constexpr std::uint64_t HASH{0x5678};
+    using packed_t = std::array<std::uint8_t, 100>;
+    static constexpr size_t PACKED_SIZE{sizeof(packed_t)};
+};
+
+using test_recorder = anysignal::recorder<test_sharemap_t>;
+
+static std::string make_directory(void)
+{
+    char path[] = "/tmp/test_recorder_XXXXXX";
+    if (::mkdtemp(path) == nullptr)
+    {
+        throw std::runtime_error("mkdtemp failed");
+    }
+    return path;
+}
+
+// Append count frames, frame i filled with i and received at 1000 + i.
+// Frames the recorder refuses are retried, refused counts the attempts.
+static test_recorder::stats_t record(const anysignal::recorder_options &options, const size_t count,
+                                     size_t &refused)
+{
+    test_recorder recorder(options);
+    test_sharemap_t::packed_t frame;
+    for (size_t i = 0; i < count; i++)
+    {
+        frame.fill(std::uint8_t(i));
+        while (not recorder.append(frame, std::int64_t(1000 + i), std::uint16_t(i % 7)))
+        {
+            // the test wants every frame, a receive loop would move on
+            refused++;
+        }
+        if (i % 100 == 0)
+        {
+            recorder.flush();
+        }
+    }
+    recorder.close();
+    return recorder.stats();
+}
+
+// Read back every segment in name order and check the records are consecutive
+static bool verify(const std::string &directory, const size_t count, const size_t expected_segments,
+                   const bool exact_size)
+{
+    std::vector<std::filesystem::path> paths;
+    for (const auto &entry : std::filesystem::directory_iterator(directory))
+    {
+        paths.push_back(entry.path());
+    }
+    std::sort(paths.begin(), paths.end());
+    if (paths.size() != expected_segments)
+    {
+        std::cerr << "expected " << expected_segments << " segments, found " << paths.size() << std::endl;
+        return false;
+    }
+
+    size_t next = 0;
+    for (size_t segment = 0; segment < paths.size(); segment++)
+    {
+        std::ifstream file(paths[segment], std::ios::binary);
+        std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        anysignal::recorder_file_header_t header;
+        std::memcpy(&header, data.data(), sizeof(header));
+        if (header.magic != anysignal::RECORDER_MAGIC or header.hash != test_sharemap_t::HASH or
+            header.record_size != test_recorder::RECORD_SIZE or header.segment != segment or
+            std::string_view(header.name) != test_sharemap_t::NAME)
+        {
+            std::cerr << "unexpected header in " << paths[segment] << std::endl;
+            return false;
+        }
+        if (exact_size and (data.size() - header.header_size) % header.record_size != 0)
+        {
+            std::cerr << "partial record at the end of " << paths[segment] << std::endl;
+            return false;
+        }
+
+        for (size_t offset = header.header_size; offset + header.record_size <= data.size();
+             offset += header.record_size)
+        {
+            anysignal::recorder_record_t r;
+            std::memcpy(&r, data.data() + offset, sizeof(r));
+            if (r.recv_ns == 0)
+            {
+                break;
+            }
+            const auto *frame = reinterpret_cast<const std::uint8_t *>(data.data() + offset + sizeof(r));
+            if (r.recv_ns != std::int64_t(1000 + next) or r.source_id != next % 7 or frame[0] != std::uint8_t(next) or
+                frame[test_sharemap_t::PACKED_SIZE - 1] != std::uint8_t(next))
+            {
+                std::cerr << "unexpected record " << next << " in " << paths[segment] << std::endl;
+                return false;
+            }
+            next++;
+        }
+    }
+    if (next != count)
+    {
+        std::cerr << "read back " << next << " of " << count << " records" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+static bool test_segments(void)
+{
+    std::cout << "testing recorder segments..." << std::endl;
+    anysignal::recorder_options options;
+    options.directory = make_directory();
+    options.buffer_bytes = 8192;
+    // lcm(116, 4096) = 118784, 1024 records per segment
+    options.segment_bytes = 118784;
+
+    const size_t count = 2500;
+    size_t refused = 0;
+    const auto stats = record(options, count, refused);
+    const bool ok = verify(options.directory, count, 3, true);
+    std::filesystem::remove_all(options.directory);
+    if (stats.records != count or stats.dropped != refused or stats.segments != 3 or stats.write_errors != 0 or
+        stats.bytes_written != count * test_recorder::RECORD_SIZE)
+    {
+        std::cerr << "unexpected recorder stats: " << stats.records << " records, " << stats.dropped << " dropped, "
+                  << stats.segments << " segments, " << stats.write_errors << " write errors, "
+                  << stats.bytes_written << " bytes" << std::endl;
+        return false;
+    }
+    return ok;
+}
+
+static bool test_direct_preallocate(void)
+{
+    std::cout << "testing recorder with O_DIRECT and preallocation..." << std::endl;
+    anysignal::recorder_options options;
+    options.directory = make_directory();
+    options.buffer_bytes = 3 * 4096;
+    options.segment_bytes = 118784;
+    options.direct_io = true;
+    options.preallocate = true;
+
+    bool ok = true;
+    try
+    {
+        const size_t count = 1500;
+        size_t refused = 0;
+        const auto stats = record(options, count, refused);
+        ok = verify(options.directory, count, 2, true) and stats.write_errors == 0;
+    }
+    catch (const std::exception &ex)
+    {
+        // tmpfs and some others refuse O_DIRECT
+        std::cout << "skipped: " << ex.what() << std::endl;
+    }
+    std::filesystem::remove_all(options.directory);
+    return ok;
+}
+
+using metrics_t = anysignal::sharemap_metrics_t;
+
+// Sender timestamps 1 ms apart but up to 4 ms out of order
+static std::int64_t metrics_timestamp(const size_t i)
+{
+    return std::int64_t(1000000000 + i * 1000000 + (i % 5) * 1000000);
+}
+
+// Record count metrics frames from three sources in segments of 2048 frames,
+// frame i with psk_cc_tx_bytes_total i, received at 1 + i
+static void record_metrics(const std::string &directory, const size_t count)
+{
+    anysignal::recorder_options options;
+    options.directory = directory;
+    options.segment_bytes = 1; // the smallest whole number of blocks and records
+    anysignal::recorder<metrics_t> recorder(options);
+    metrics_t metrics{};
+    for (size_t i = 0; i < count; i++)
+    {
+        metrics.source_id = std::uint16_t(i % 3);
+        metrics.psk_cc_tx_bytes_total = i;
+        const auto packed = anysignal::packed_at(metrics, metrics_timestamp(i));
+        while (not recorder.append(packed, std::int64_t(1 + i), metrics.source_id))
+        {
+        }
+    }
+}
+
+static bool test_reader(void)
+{
+    std::cout << "testing recorder reader..." << std::endl;
+    anysignal::recorder_options options;
+    options.directory = make_directory();
+    const size_t count = 5000;
+    record_metrics(options.directory, count);
+
+    bool ok = true;
+    {
+        anysignal::recorder_reader<metrics_t> reader(options.directory, 5000000, 64);
+        if (reader.segments() != 3 or reader.size() != count or reader[4321].recv_ns() != 4322)
+        {
+            std::cerr << "unexpected recording size" << std::endl;
+            ok = false;
+        }
+
+        metrics_t out;
+        if (not reader[2500].unpack(out) or out.psk_cc_tx_bytes_total != 2500 or out.source_id != 2500 % 3 or
+            out.unix_timestamp_ns != metrics_timestamp(2500))
+        {
+            std::cerr << "unexpected unpacked frame" << std::endl;
+            ok = false;
+        }
+
+        // every query matches a full scan, including windows across segment boundaries
+        const std::int64_t windows[][2] = {{0, 999999999}, {1000000000, 1000000000}, {1100000000, 1200000000},
+                                           {3000000000, 3100000000}, {5000000000, 6000000000}, {0, INT64_MAX}};
+        for (const auto &w : windows)
+        {
+            std::vector<std::uint64_t> expected, all, source;
+            for (std::uint64_t i = 0; i < reader.size(); i++)
+            {
+                const auto ns = reader[i].unix_timestamp_ns();
+                if (ns >= w[0] and ns <= w[1])
+                {
+                    expected.push_back(i);
+                }
+            }
+            reader.query(w[0], w[1], [&](const auto &view) { all.push_back(std::uint64_t(view.recv_ns() - 1)); });
+            reader.query(1, w[0], w[1], [&](const auto &view) { source.push_back(std::uint64_t(view.recv_ns() - 1)); });
+            const auto expected_source = std::count_if(expected.begin(), expected.end(), [](auto i) { return i % 3 == 1; });
+            if (all != expected or std::int64_t(source.size()) != expected_source)
+            {
+                std::cerr << "query [" << w[0] << ", " << w[1] << "] returned " << all.size() << " and "
+                          << source.size() << " frames, expected " << expected.size() << " and " << expected_source
+                          << std::endl;
+                ok = false;
+            }
+        }
+    }
+    std::filesystem::remove_all(options.directory);
+    return ok;
+}
+
+static bool test_decode(void)
+{
+    std::cout << "testing parallel decode..." << std::endl;
+    const auto directory = make_directory();
+    const size_t count = 30000;
+    record_metrics(directory, count);
+
+    bool ok = true;
+    {
+        const anysignal::recorder_reader<metrics_t> reader(directory);
+
+        // the merge must match a stable sort of the frames by sender timestamp
+        std::vector<size_t> expected(count);
+        std::iota(expected.begin(), expected.end(), 0);
+        std::stable_sort(expected.begin(), expected.end(),
+                         [](const size_t a, const size_t b) { return metrics_timestamp(a) < metrics_timestamp(b); });
+
+        for (const size_t threads : {1, 3, 8})
+        {
+            const auto decoded = anysignal::recorder_decode(reader, threads);
+            bool same = decoded.size() == count and decoded.fields.size() == count;
+            for (size_t i = 0; same and i < count; i++)
+            {
+                const auto j = expected[i];
+                same = decoded.fields.psk_cc_tx_bytes_total[i] == j and decoded.recv_ns[i] == std::int64_t(1 + j) and
+                       decoded.fields.source_id[i] == j % 3 and
+                       decoded.fields.unix_timestamp_ns[i] == metrics_timestamp(j) and
+                       decoded.fields.row(i).schema_hash == metrics_t::HASH;
+            }
+            if (not same)
+            {
+                std::cerr << "unexpected decode on " << threads << " threads" << std::endl;
+                ok = false;
+            }
+        }
+
+        const auto part = anysignal::recorder_decode(reader, 2, 100, 110);
+        if (part.size() != 10 or part.recv_ns.front() != 101)
+        {
+            std::cerr << "unexpected decode of a range" << std::endl;
+            ok = false;
+        }
+    }
+    std::filesystem::remove_all(directory);
+    return ok;
+}
+
+int main(void)
+{
+    if (not test_segments())
+    {
+        return EXIT_FAILURE;
+    }
+    if (not test_direct_preallocate())
+    {
+        return EXIT_FAILURE;
+    }
+    if (not test_reader())
+    {
+        return EXIT_FAILURE;
+    }
+    if (not test_decode())
+    {
+        return EXIT_FAILURE;
+    }
+    std::cout << "done" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,160 @@
+#include "rollup.hpp"
+#include "sharemap.hpp"
+#include "test_frames.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+using metrics_t = anysignal::sharemap_metrics_t;
+
+static constexpr std::int64_t SECOND{1'000'000'000};
+
+// Frame i of a source reporting at 10 Hz from t = 1000 s: a temperature of i and
+// a byte counter growing by 1000 a frame, or 10000 a second
+static metrics_t::packed_t frame(const std::uint16_t source_id, const size_t i, const std::uint64_t bytes)
+{
+    return anysignal::packed_metrics(source_id, 1000 * SECOND + std::int64_t(i) * SECOND / 10, [&](metrics_t &metrics) {
+        metrics.carrier_temp = double(i);
+        metrics.psk_cc_tx_bytes_total = bytes;
+    });
+}
+
+static std::vector<anysignal::rollup_bucket_t> buckets(const anysignal::rollup<metrics_t> &rollup,
+                                                       const std::uint16_t source_id, const size_t level,
+                                                       const std::string_view name)
+{
+    std::vector<anysignal::rollup_bucket_t> out;
+    rollup.query(source_id, level, rollup.column(name), 0, INT64_MAX,
+                 [&](const anysignal::rollup_bucket_t &bucket) { out.push_back(bucket); });
+    return out;
+}
+
+static bool near(const float a, const double b) { return std::abs(double(a) - b) < 1e-3 * std::max(1.0, b); }
+
+static bool test_levels(void)
+{
+    std::cout << "testing rollup levels..." << std::endl;
+    anysignal::rollup<metrics_t> rollup(4, {{SECOND, 10}, {10 * SECOND, 6}});
+    for (size_t i = 0; i < 1000; i++)
+    {
+        rollup.append(frame(3, i, 1000 * i));
+    }
+
+    // the newest 10 seconds, of 10 frames each
+    const auto seconds = buckets(rollup, 3, 0, "carrier_temp");
+    if (seconds.size() != 10 or seconds.front().start_ns != 1090 * SECOND or seconds.back().count != 10 or
+        seconds.back().min != 990.0f or seconds.back().max != 999.0f or seconds.back().last != 999.0f or
+        not near(seconds.back().mean, 994.5))
+    {
+        std::cerr << "unexpected 1 s buckets" << std::endl;
+        return false;
+    }
+
+    // the newest minute, of 100 frames every 10 seconds
+    const auto tens = buckets(rollup, 3, 1, "carrier_temp");
+    if (tens.size() != 6 or tens.front().start_ns != 1040 * SECOND or tens.back().count != 100 or
+        not near(tens.back().mean, 949.5))
+    {
+        std::cerr << "unexpected 10 s buckets" << std::endl;
+        return false;
+    }
+
+    // counters are rates
+    for (const auto &bucket : buckets(rollup, 3, 1, "psk_cc_tx_bytes_total"))
+    {
+        if (not near(bucket.min, 10000.0) or not near(bucket.max, 10000.0) or bucket.count != 100)
+        {
+            std::cerr << "unexpected counter rate " << bucket.min << std::endl;
+            return false;
+        }
+    }
+
+    // a window selects the overlapping buckets
+    size_t selected = 0;
+    rollup.query(3, 0, rollup.column("carrier_temp"), 1095 * SECOND + 1, 1097 * SECOND,
+                 [&](const anysignal::rollup_bucket_t &) { selected++; });
+    if (selected != 3)
+    {
+        std::cerr << "selected " << selected << " buckets" << std::endl;
+        return false;
+    }
+
+    // frames older than the ring change nothing
+    rollup.append(frame(3, 0, 0));
+    if (buckets(rollup, 3, 0, "carrier_temp").front().count != 10)
+    {
+        std::cerr << "an old frame was summarized" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+static bool test_counter_reset(void)
+{
+    std::cout << "testing rollup of a reset counter..." << std::endl;
+    anysignal::rollup<metrics_t> rollup(1, {{SECOND, 4}});
+    for (size_t i = 0; i < 20; i++)
+    {
+        // the count restarts from 0 just before frame 15, so the rate holds
+        rollup.append(frame(1, i, i < 15 ? 5000 + 1000 * i : 1000 * (i - 14)));
+    }
+    const auto rates = buckets(rollup, 1, 0, "psk_cc_tx_bytes_total");
+    if (rates.size() != 2 or rates[0].count != 9 or rates[1].count != 10 or not near(rates[1].min, 10000.0) or
+        not near(rates[1].max, 10000.0))
+    {
+        std::cerr << "unexpected rates around a reset" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+static bool test_limits(void)
+{
+    std::cout << "testing rollup limits..." << std::endl;
+    anysignal::rollup<metrics_t> rollup(2, {{SECOND, 4}, {60 * SECOND, 2}});
+    if (rollup.column("controld_version") != rollup.NO_COLUMN or rollup.column("unix_timestamp_ns") !=
+        rollup.NO_COLUMN or rollup.column("carrier_temp") == rollup.NO_COLUMN)
+    {
+        std::cerr << "unexpected columns" << std::endl;
+        return false;
+    }
+    if (rollup.source_bytes() != 6 * (8 + rollup.columns() * 20))
+    {
+        std::cerr << "unexpected size " << rollup.source_bytes() << std::endl;
+        return false;
+    }
+    if (not rollup.append(frame(1, 0, 0)) or not rollup.append(frame(2, 0, 0)) or rollup.append(frame(3, 0, 0)))
+    {
+        std::cerr << "unexpected source limit" << std::endl;
+        return false;
+    }
+    try
+    {
+        anysignal::rollup<metrics_t> bad(2, {{SECOND, 0}});
+        std::cerr << "a level without buckets was accepted" << std::endl;
+        return false;
+    }
+    catch (const std::runtime_error &)
+    {
+    }
+    return true;
+}
+
+int main(void)
+{
+    if (not test_levels())
+    {
+        return EXIT_FAILURE;
+    }
+    if (not test_counter_reset())
+    {
+        return EXIT_FAILURE;
+    }
+    if (not test_limits())
+    {
+        return EXIT_FAILURE;
+    }
+    std::cout << "done" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,248 @@
+#include "shm_latest.hpp"
+#include "shm_ring.hpp"
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string_view>
+#include <thread>
+
+// Small stand-in for a generated sharemap
+struct test_sharemap_t
+{
+    static constexpr std::string_view NAME{"shm_test"};
+    static constexpr std::uint64_t HASH{0x1234};
+    std::uint16_t source_id{};
+    std::uint64_t schema_hash{HASH};
+    std::array<std::uint64_t, 32> values{};
+};
+
+static bool test_latest(void)
+{
+    std::cout << "testing shared memory latest values..." << std::endl;
+    const std::string name = "/sharemap_test_shm_latest";
+    anysignal::shm_segment::remove(name);
+
+    {
+        anysignal::shm_latest_writer<test_sharemap_t> writer(name);
+        anysignal::shm_latest_reader<test_sharemap_t> reader(name);
+
+        test_sharemap_t value;
+        if (reader.load(3, value))
+        {
+            std::cerr << "unexpected value before publish" << std::endl;
+            return false;
+        }
+
+        value.source_id = 3;
+        value.values[0] = 33;
+        writer.publish(value);
+        value.source_id = 700;
+        value.values[0] = 77;
+        writer.publish(value);
+        value.values[0] = 78;
+        writer.publish(value);
+
+        test_sharemap_t out;
+        if (not reader.load(3, out) or out.values[0] != 33 or not reader.load(700, out) or out.values[0] != 78 or
+            reader.version(700) != 2)
+        {
+            std::cerr << "unexpected published values" << std::endl;
+            return false;
+        }
+
+        size_t count = 0;
+        reader.for_each([&](const test_sharemap_t &v) { count += (v.source_id == 3 or v.source_id == 700); });
+        if (count != 2)
+        {
+            std::cerr << "for_each visited " << count << " sources" << std::endl;
+            return false;
+        }
+    }
+
+    // a restarted writer keeps the values readers already see
+    {
+        anysignal::shm_latest_writer<test_sharemap_t> writer(name);
+        anysignal::shm_latest_reader<test_sharemap_t> reader(name);
+        test_sharemap_t out;
+        if (not reader.load(700, out) or out.values[0] != 78)
+        {
+            std::cerr << "values lost across writer restart" << std::endl;
+            return false;
+        }
+    }
+
+    // concurrent stores never show a torn value
+    {
+        anysignal::shm_latest_writer<test_sharemap_t> writer(name);
+        anysignal::shm_latest_reader<test_sharemap_t> reader(name);
+        std::atomic<bool> running{true};
+        std::thread publisher([&] {
+            test_sharemap_t value;
+            value.source_id = 9;
+            for (std::uint64_t i = 1; running; i++)
+            {
+                value.values.fill(i);
+                writer.publish(value);
+            }
+        });
+
+        size_t snapshots = 0;
+        const auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(200);
+        while (std::chrono::steady_clock::now() < end)
+        {
+            test_sharemap_t out;
+            if (not reader.load(9, out))
+                continue;
+            snapshots++;
+            for (const auto v : out.values)
+            {
+                if (v != out.values[0])
+                {
+                    running = false;
+                    publisher.join();
+                    std::cerr << "torn snapshot" << std::endl;
+                    return false;
+                }
+            }
+        }
+        running = false;
+        publisher.join();
+        std::cout << "took " << snapshots << " consistent snapshots" << std::endl;
+    }
+
+    anysignal::shm_segment::remove(name);
+    std::cout << "shared memory latest values work!" << std::endl;
+    return true;
+}
+
+// Stand-in packed frame: a position stamp followed by filler derived from it
+struct test_packed_t
+{
+    std::uint8_t stamp[8];
+    std::uint8_t fill[195];
+} __attribute__((packed));
+
+struct test_ring_sharemap_t
+{
+    static constexpr std::string_view NAME{"ring_test"};
+    static constexpr std::uint64_t HASH{0x5678};
+    using packed_t = test_packed_t;
+    static constexpr size_t PACKED_SIZE{sizeof(packed_t)};
+};
+
+static test_packed_t make_frame(const std::uint64_t stamp)
+{
+    test_packed_t frame;
+    std::memcpy(frame.stamp, &stamp, sizeof(stamp));
+    std::memset(frame.fill, int(stamp & 0xff), sizeof(frame.fill));
+    return frame;
+}
+
+static std::uint64_t frame_stamp(const test_packed_t &frame)
+{
+    std::uint64_t stamp;
+    std::memcpy(&stamp, frame.stamp, sizeof(stamp));
+    return stamp;
+}
+
+static bool consistent(const test_packed_t &frame)
+{
+    for (const auto f : frame.fill)
+        if (f != std::uint8_t(frame_stamp(frame)))
+            return false;
+    return true;
+}
+
+static bool test_ring(void)
+{
+    std::cout << "testing shared memory ring..." << std::endl;
+    const std::string name = "/sharemap_test_shm_ring";
+    anysignal::shm_segment::remove(name);
+
+    {
+        anysignal::shm_ring_writer<test_ring_sharemap_t> writer(8, name);
+        anysignal::shm_ring_reader<test_ring_sharemap_t> reader(name);
+        anysignal::shm_ring_reader<test_ring_sharemap_t> other(name);
+
+        // every reader sees every frame in order
+        for (std::uint64_t i = 0; i < 5; i++)
+            writer.push(make_frame(i));
+        test_packed_t frame;
+        for (std::uint64_t i = 0; i < 5; i++)
+        {
+            if (not reader.pop(frame) or frame_stamp(frame) != i or not consistent(frame))
+            {
+                std::cerr << "unexpected ring frame " << i << std::endl;
+                return false;
+            }
+        }
+        if (reader.pop(frame) or other.available() != 5)
+        {
+            std::cerr << "unexpected ring state" << std::endl;
+            return false;
+        }
+
+        // a reader that falls behind loses the oldest frames and is told so
+        for (std::uint64_t i = 5; i < 25; i++)
+            writer.push(make_frame(i));
+        std::uint64_t expected = 17;
+        while (reader.pop(frame))
+        {
+            if (frame_stamp(frame) != expected++)
+            {
+                std::cerr << "unexpected frame after overrun" << std::endl;
+                return false;
+            }
+        }
+        if (expected != 25 or reader.overruns() != 12)
+        {
+            std::cerr << "unexpected overrun count " << reader.overruns() << std::endl;
+            return false;
+        }
+    }
+
+    // a reader racing the writer sees every frame either complete or counted as lost
+    {
+        anysignal::shm_ring_writer<test_ring_sharemap_t> writer(64, name);
+        anysignal::shm_ring_reader<test_ring_sharemap_t> reader(name);
+        constexpr std::uint64_t num_frames = 200000;
+        std::thread producer([&] {
+            for (std::uint64_t i = 0; i < num_frames; i++)
+                writer.push(make_frame(i));
+        });
+
+        std::uint64_t received = 0;
+        std::uint64_t last = 0;
+        test_packed_t frame;
+        while (received + reader.overruns() < num_frames)
+        {
+            if (not reader.pop(frame))
+                continue;
+            if (not consistent(frame) or (received > 0 and frame_stamp(frame) <= last))
+            {
+                producer.join();
+                std::cerr << "torn or out of order ring frame" << std::endl;
+                return false;
+            }
+            last = frame_stamp(frame);
+            received++;
+        }
+        producer.join();
+        std::cout << "read " << received << " frames, " << reader.overruns() << " lost to overruns" << std::endl;
+    }
+
+    anysignal::shm_segment::remove(name);
+    std::cout << "shared memory ring works!" << std::endl;
+    return true;
+}
+
+int main(void)
+{
+    if (not test_latest())
+        return EXIT_FAILURE;
+    if (not test_ring())
+        return EXIT_FAILURE;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,224 @@
+#include "sequence_tracker.hpp"
+#include "source_slots.hpp"
+#include "source_table.hpp"
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+// Small stand-in for a generated sharemap
+struct test_sharemap_t
+{
+    static constexpr std::uint64_t HASH{0x1234};
+    std::uint16_t source_id{};
+    std::uint64_t schema_hash{HASH};
+    std::array<std::uint64_t, 16> values{};
+};
+
+using test_state_t = anysignal::source_state<test_sharemap_t>;
+
+static bool test_updates(void)
+{
+    std::cout << "testing source table updates..." << std::endl;
+    anysignal::source_table<test_state_t> table(10000);
+
+    // every source_id keeps its own state
+    test_sharemap_t frame;
+    for (std::int64_t round = 0; round < 3; round++)
+    {
+        for (std::uint32_t id = 0; id < 10000; id++)
+        {
+            frame.source_id = std::uint16_t(id * 7);
+            frame.values[0] = id + 100 * std::uint64_t(round);
+            frame.schema_hash = (id == 5 and round == 1) ? 0 : test_sharemap_t::HASH;
+            const auto ok = table.update(frame.source_id, [&](test_state_t &state) {
+                anysignal::source_state_update(state, frame, 1000 * round + id);
+            });
+            if (not ok)
+            {
+                std::cerr << "update failed for source " << frame.source_id << std::endl;
+                return false;
+            }
+        }
+    }
+
+    test_state_t state;
+    if (table.size() != 10000 or table.load(1, state) or not table.load(5 * 7, state) or state.frames != 3 or
+        state.latest.values[0] != 205 or state.first_arrival_ns != 5 or state.last_arrival_ns != 2005 or
+        state.max_interval_ns != 1000 or state.hash_mismatches != 1)
+    {
+        std::cerr << "unexpected source state" << std::endl;
+        return false;
+    }
+
+    if (table.index(1) != table.NO_INDEX or table.index(5 * 7) >= table.capacity() or
+        table.index(5 * 7) == table.index(6 * 7))
+    {
+        std::cerr << "unexpected source index" << std::endl;
+        return false;
+    }
+
+    size_t count = 0;
+    table.for_each([&](const std::uint16_t source_id, const test_state_t &s) {
+        count += (s.latest.source_id == source_id and s.frames == 3);
+    });
+    if (count != 10000)
+    {
+        std::cerr << "for_each visited " << count << " sources" << std::endl;
+        return false;
+    }
+
+    // a full table refuses new sources but keeps updating known ones
+    if (table.update(1, [](test_state_t &) {}) or not table.update(0, [](test_state_t &) {}))
+    {
+        std::cerr << "unexpected update result on a full table" << std::endl;
+        return false;
+    }
+
+    std::cout << "source table updates work!" << std::endl;
+    return true;
+}
+
+static bool test_concurrent(void)
+{
+    std::cout << "testing concurrent source table snapshots..." << std::endl;
+    anysignal::source_table<test_state_t> table(256);
+    std::atomic<bool> running{true};
+    std::thread writer([&] {
+        test_sharemap_t frame;
+        for (std::uint64_t i = 1; running; i++)
+        {
+            frame.source_id = std::uint16_t(i % 200);
+            frame.values.fill(i);
+            table.update(frame.source_id,
+                         [&](test_state_t &state) { anysignal::source_state_update(state, frame, std::int64_t(i)); });
+        }
+    });
+
+    size_t snapshots = 0;
+    bool torn = false;
+    const auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(200);
+    while (std::chrono::steady_clock::now() < end and not torn)
+    {
+        table.for_each([&](const std::uint16_t source_id, const test_state_t &state) {
+            snapshots++;
+            for (const auto v : state.latest.values)
+                torn |= (v != state.latest.values[0]);
+            torn |= (state.latest.source_id != source_id or std::int64_t(state.latest.values[0]) != state.last_arrival_ns);
+        });
+    }
+    running = false;
+    writer.join();
+    if (torn)
+    {
+        std::cerr << "torn snapshot" << std::endl;
+        return false;
+    }
+
+    std::cout << "took " << snapshots << " consistent snapshots" << std::endl;
+    std::cout << "concurrent source table snapshots work!" << std::endl;
+    return true;
+}
+
+static bool test_sequence(void)
+{
+    std::cout << "testing sequence tracking..." << std::endl;
+    anysignal::sequence_tracker tracker;
+
+    // 1 2 [3 lost] 4 6 5 5, then a late frame outside the window
+    for (const std::uint32_t sequence : {1u, 2u, 4u, 6u, 5u, 5u})
+        tracker.update(sequence);
+    for (std::uint32_t sequence = 7; sequence < 107; sequence++)
+        tracker.update(sequence);
+    tracker.update(3);
+    if (tracker.received != 107 or tracker.lost != 1 or tracker.duplicates != 1 or tracker.reordered != 1 or
+        tracker.late != 1 or tracker.resets != 0)
+    {
+        std::cerr << "unexpected counters: lost " << tracker.lost << ", duplicates " << tracker.duplicates
+                  << ", reordered " << tracker.reordered << ", late " << tracker.late << std::endl;
+        return false;
+    }
+
+    // wrapping around 2^32 is not a gap, a sender restart is not a loss
+    anysignal::sequence_tracker wrap;
+    for (std::uint32_t sequence = 0xFFFFFFFE; sequence != 3; sequence++)
+        wrap.update(sequence);
+    wrap.update(1);
+    wrap.update(2);
+    if (wrap.lost != 0 or wrap.resets != 0 or wrap.duplicates != 2)
+    {
+        std::cerr << "unexpected counters across the wrap" << std::endl;
+        return false;
+    }
+    for (std::uint32_t sequence = 3; sequence < 5000; sequence++)
+        wrap.update(sequence);
+    wrap.update(1);
+    wrap.update(2);
+    if (wrap.lost != 0 or wrap.resets != 1 or wrap.duplicates != 2)
+    {
+        std::cerr << "unexpected counters across a restart" << std::endl;
+        return false;
+    }
+
+    // a frame older than the first one is late, not a loss filled in: 11 is still missing
+    anysignal::sequence_tracker first;
+    for (const std::uint32_t sequence : {10u, 12u, 9u})
+        first.update(sequence);
+    if (first.lost != 1 or first.reordered != 0 or first.late != 1)
+    {
+        std::cerr << "unexpected counters before the first frame: lost " << first.lost << std::endl;
+        return false;
+    }
+    first.update(11);
+    if (first.lost != 0 or first.reordered != 1 or first.late != 1 or first.duplicates != 0)
+    {
+        std::cerr << "unexpected counters after the gap filled in" << std::endl;
+        return false;
+    }
+
+    std::cout << "sequence tracking works!" << std::endl;
+    return true;
+}
+
+static bool test_slots(void)
+{
+    std::cout << "testing source slots..." << std::endl;
+    anysignal::source_slots slots(2);
+    constexpr auto none = anysignal::source_slots::NO_SLOT;
+    if (slots.find(7) != none or slots.insert(7) != 0 or slots.insert(65535) != 1 or slots.insert(7) != 0 or
+        slots.insert(3) != none or slots.find(65535) != 1 or slots.find(3) != none or slots.size() != 2)
+    {
+        std::cerr << "unexpected source slots" << std::endl;
+        return false;
+    }
+    for (const size_t max_sources : {size_t(0), (size_t(1) << 16) + 1})
+    {
+        try
+        {
+            anysignal::source_slots bad(max_sources);
+            std::cerr << "accepted " << max_sources << " sources" << std::endl;
+            return false;
+        }
+        catch (const std::runtime_error &)
+        {
+        }
+    }
+    std::cout << "source slots work!" << std::endl;
+    return true;
+}
+
+int main(void)
+{
+    if (not test_updates())
+        return EXIT_FAILURE;
+    if (not test_concurrent())
+        return EXIT_FAILURE;
+    if (not test_sequence())
+        return EXIT_FAILURE;
+    if (not test_slots())
+        return EXIT_FAILURE;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,105 @@
+#include "timer_wheel.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+static bool test_expiry(void)
+{
+    std::cout << "testing timer wheel expiry..." << std::endl;
+    constexpr std::int64_t tick_ns = 1000;
+    constexpr size_t num_timers = 2000;
+    anysignal::timer_wheel wheel(num_timers, tick_ns, 0);
+
+    // reference deadlines, -1 when not armed
+    std::vector<std::int64_t> deadlines(num_timers, -1);
+    std::mt19937_64 rng(1234);
+    const std::int64_t ranges[] = {100 * tick_ns, 5000 * tick_ns, 300000 * tick_ns, 10000000 * tick_ns};
+
+    std::int64_t now = 0;
+    size_t fired = 0;
+    bool ok = true;
+    while (now < 30000000 * tick_ns and ok)
+    {
+        // arm, re-arm and cancel some timers
+        for (int i = 0; i < 20; i++)
+        {
+            const auto id = std::uint32_t(rng() % num_timers);
+            if (rng() % 8 == 0)
+            {
+                wheel.cancel(id);
+                deadlines[id] = -1;
+                continue;
+            }
+            deadlines[id] = now + std::int64_t(rng() % std::uint64_t(ranges[rng() % 4]));
+            wheel.arm(id, deadlines[id]);
+        }
+
+        // mostly long steps, with short ones in between to hit single ticks
+        now += std::int64_t(rng() % (rng() % 4 == 0 ? 2000 : 4000000));
+        wheel.advance(now, [&](const std::uint32_t id) {
+            fired++;
+            if (deadlines[id] < 0 or deadlines[id] > now)
+            {
+                std::cerr << "timer " << id << " fired early or while disarmed" << std::endl;
+                ok = false;
+            }
+            deadlines[id] = -1;
+        });
+
+        // everything due by now has fired
+        for (size_t id = 0; id < num_timers and ok; id++)
+        {
+            if (deadlines[id] >= 0 and (deadlines[id] + tick_ns - 1) / tick_ns * tick_ns <= now)
+            {
+                std::cerr << "timer " << id << " missed its deadline" << std::endl;
+                ok = false;
+            }
+            if ((deadlines[id] >= 0) != wheel.armed(std::uint32_t(id)))
+            {
+                std::cerr << "timer " << id << " has an unexpected armed state" << std::endl;
+                ok = false;
+            }
+        }
+    }
+    if (not ok)
+        return false;
+
+    std::cout << "fired " << fired << " timers" << std::endl;
+    std::cout << "timer wheel expiry works!" << std::endl;
+    return true;
+}
+
+static bool test_rearm_from_callback(void)
+{
+    std::cout << "testing timer wheel periodic re-arm..." << std::endl;
+    anysignal::timer_wheel wheel(1, 10, 0);
+
+    // a callback re-arming in the past fires again on the next tick, not in a loop
+    size_t fired = 0;
+    wheel.arm(0, 50);
+    for (std::int64_t now = 0; now <= 100; now += 10)
+    {
+        wheel.advance(now, [&](const std::uint32_t id) {
+            fired++;
+            wheel.arm(id, 0);
+        });
+    }
+    if (fired != 6)
+    {
+        std::cerr << "unexpected number of callbacks: " << fired << std::endl;
+        return false;
+    }
+
+    std::cout << "timer wheel periodic re-arm works!" << std::endl;
+    return true;
+}
+
+int main(void)
+{
+    if (not test_expiry())
+        return EXIT_FAILURE;
+    if (not test_rearm_from_callback())
+        return EXIT_FAILURE;
+    return EXIT_SUCCESS;
+}
@@ -1,8 +1,12 @@
 #include "udp.hpp"
+#include <algorithm>
+#include <array>
+#include <chrono>
 #include <cstdlib>
 #include <iostream>
+#include <vector>
 
-int main(void)
+static bool test_send_recv(void)
 {
     std::cout << "testing udp socket class..." << std::endl;
 
@@ -18,14 +22,14 @@ int main(void)
         if (r != int(tx_message.size()))
         {
             std::cerr << "failed to send message " << r << std::endl;
-            return EXIT_FAILURE;
+            return false;
         }
         std::cout << "sent message " << tx_message << std::endl;
     }
     else
     {
         std::cerr << "failed to send message!" << std::endl;
-        return EXIT_FAILURE;
+        return false;
     }
 
     std::array<char, 1024> rx_message = {}; // null terminated string
@@ -35,21 +39,490 @@ int main(void)
         if (r < 0)
         {
             std::cerr << "failed to recv message " << r << std::endl;
-            return EXIT_FAILURE;
+            return false;
         }
         std::cout << "received message " << rx_message.data() << std::endl;
         if (rx_message.data() != tx_message)
         {
             std::cerr << "message mismatch!" << std::endl;
-            return EXIT_FAILURE;
+            return false;
         }
     }
     else
     {
         std::cerr << "failed to recv message!" << std::endl;
-        return EXIT_FAILURE;
+        return false;
     }
 
     std::cout << "udp socket class works!" << std::endl;
+    return true;
+}
+
+static bool test_gso_gro(void)
+{
+    std::cout << "testing udp segmentation offload..." << std::endl;
+
+    anysignal::udp_sock s0;
+    anysignal::udp_sock s1;
+    s0.bind("udp://127.0.0.1:5620");
+    s0.set_gro(true);
+    s1.connect("udp://127.0.0.1:5620");
+
+    // more frames than fit in one super-buffer, each frame tagged with its index
+    constexpr size_t frame_size = 1000;
+    constexpr size_t num_frames = 100;
+    std::vector<std::uint8_t> tx(frame_size * num_frames);
+    for (size_t i = 0; i < tx.size(); i++)
+    {
+        tx[i] = std::uint8_t(i / frame_size);
+    }
+
+    auto r = s1.send_gso(tx.data(), tx.size(), frame_size);
+    if (r != int(tx.size()))
+    {
+        std::cerr << "failed to send gso frames " << r << std::endl;
+        return false;
+    }
+
+    std::vector<std::uint8_t> rx(anysignal::udp_sock::GSO_MAX_BYTES);
+    size_t num_received = 0;
+    size_t num_reads = 0;
+    while (num_received < num_frames and s0.recv_ready(std::chrono::milliseconds(100)))
+    {
+        anysignal::udp_sock::recv_info info;
+        auto n = s0.recv(rx.data(), rx.size(), info);
+        num_reads++;
+        bool ok = true;
+        anysignal::udp_sock::for_each_segment(rx.data(), n, info, [&](const std::uint8_t *frame, size_t length) {
+            ok = ok and length == frame_size and frame[0] == std::uint8_t(num_received) and
+                 frame[length - 1] == std::uint8_t(num_received);
+            num_received++;
+        });
+        if (not ok)
+        {
+            std::cerr << "gso frame mismatch at frame " << num_received << std::endl;
+            return false;
+        }
+    }
+
+    if (num_received != num_frames)
+    {
+        std::cerr << "received " << num_received << " of " << num_frames << " gso frames" << std::endl;
+        return false;
+    }
+
+    std::cout << "received " << num_received << " frames in " << num_reads << " reads" << std::endl;
+    std::cout << "udp segmentation offload works!" << std::endl;
+    return true;
+}
+
+static bool test_filter(void)
+{
+    std::cout << "testing udp socket filter..." << std::endl;
+
+    anysignal::udp_sock s0;
+    anysignal::udp_sock s1;
+    s0.bind("udp://127.0.0.1:5621");
+    s1.connect("udp://127.0.0.1:5621");
+
+    // frames of 16 bytes with a big-endian hash after a 2 byte id, like a sharemap header
+    constexpr std::uint64_t hash = 0x0123456789abcdefULL;
+    s0.attach_filter({anysignal::udp_sock::filter_rule{16, 2, hash}});
+
+    auto make_frame = [](size_t length, std::uint64_t h, std::uint8_t tag) {
+        std::vector<std::uint8_t> frame(length);
+        frame[0] = tag;
+        for (size_t i = 0; i < sizeof(h); i++)
+        {
+            frame[2 + i] = std::uint8_t(h >> ((sizeof(h) - i - 1) * 8));
+        }
+        return frame;
+    };
+
+    const std::vector<std::vector<std::uint8_t>> frames{
+        make_frame(16, hash, 1),     // accepted
+        make_frame(17, hash, 2),     // wrong size
+        make_frame(16, hash + 1, 3), // wrong hash
+        make_frame(4, hash, 4),      // too short to hold the hash
+        make_frame(16, hash, 5),     // accepted
+    };
+    for (const auto &frame : frames)
+    {
+        s1.send(frame.data(), frame.size());
+    }
+
+    std::vector<std::uint8_t> received;
+    std::array<std::uint8_t, 64> rx{};
+    while (s0.recv_ready(std::chrono::milliseconds(50)))
+    {
+        if (s0.recv(rx.data(), rx.size()) > 0)
+        {
+            received.push_back(rx[0]);
+        }
+    }
+    if (received != std::vector<std::uint8_t>{1, 5})
+    {
+        std::cerr << "socket filter passed " << received.size() << " datagrams" << std::endl;
+        return false;
+    }
+
+    // coalesced reads of accepted frames pass once gro is enabled
+    s0.set_gro(true);
+    std::vector<std::uint8_t> burst;
+    for (std::uint8_t tag = 0; tag < 8; tag++)
+    {
+        const auto frame = make_frame(16, hash, tag);
+        burst.insert(burst.end(), frame.begin(), frame.end());
+    }
+    s1.send_gso(burst.data(), burst.size(), 16);
+    const auto bad = make_frame(16, hash + 1, 0);
+    s1.send_gso(bad.data(), bad.size(), 16);
+
+    size_t num_received = 0;
+    std::vector<std::uint8_t> gro_rx(anysignal::udp_sock::GSO_MAX_BYTES);
+    while (s0.recv_ready(std::chrono::milliseconds(50)))
+    {
+        anysignal::udp_sock::recv_info info;
+        auto n = s0.recv(gro_rx.data(), gro_rx.size(), info);
+        anysignal::udp_sock::for_each_segment(gro_rx.data(), n, info,
+                                              [&](const std::uint8_t *, size_t) { num_received++; });
+    }
+    if (num_received != 8)
+    {
+        std::cerr << "socket filter passed " << num_received << " coalesced frames" << std::endl;
+        return false;
+    }
+
+    // a rule without length accepts any size with the right hash
+    s0.set_gro(false);
+    constexpr std::uint64_t any_hash = 0xfedcba9876543210ULL;
+    s0.attach_filter({anysignal::udp_sock::filter_rule{16, 2, hash}, anysignal::udp_sock::filter_rule{0, 2, any_hash}});
+    for (const auto &frame : {make_frame(40, any_hash, 1), make_frame(17, hash, 2), make_frame(10, any_hash, 3),
+                              make_frame(33, any_hash + 1, 4)})
+    {
+        s1.send(frame.data(), frame.size());
+    }
+    received.clear();
+    while (s0.recv_ready(std::chrono::milliseconds(50)))
+    {
+        if (s0.recv(rx.data(), rx.size()) > 0)
+        {
+            received.push_back(rx[0]);
+        }
+    }
+    if (received != std::vector<std::uint8_t>{1, 3})
+    {
+        std::cerr << "any length rule passed " << received.size() << " datagrams" << std::endl;
+        return false;
+    }
+
+    std::cout << "udp socket filter works!" << std::endl;
+    return true;
+}
+
+static bool test_multicast(void)
+{
+    std::cout << "testing udp multicast..." << std::endl;
+
+    // two subscribers of the same group and a publisher, all on loopback
+    anysignal::udp_sock sub0;
+    anysignal::udp_sock sub1;
+    anysignal::udp_sock pub;
+    sub0.bind("udp://239.255.77.1:5622?iface=lo");
+    sub1.bind("udp://239.255.77.1:5622?iface=lo");
+    pub.connect("udp://239.255.77.1:5622?iface=lo&ttl=1&loop=1");
+
+    auto count_received = [](anysignal::udp_sock &s) {
+        size_t count = 0;
+        std::array<char, 64> rx{};
+        while (s.recv_ready(std::chrono::milliseconds(50)))
+        {
+            if (s.recv(rx.data(), rx.size()) > 0)
+                count++;
+        }
+        return count;
+    };
+
+    std::string tx_message = "hello group";
+    pub.send(tx_message.data(), tx_message.size());
+    if (count_received(sub0) != 1 or count_received(sub1) != 1)
+    {
+        std::cerr << "multicast message not received by every subscriber" << std::endl;
+        return false;
+    }
+
+    // a subscriber that left the group no longer receives
+    sub1.leave_group("239.255.77.1", "lo");
+    pub.send(tx_message.data(), tx_message.size());
+    if (count_received(sub0) != 1 or count_received(sub1) != 0)
+    {
+        std::cerr << "multicast leave failed" << std::endl;
+        return false;
+    }
+
+    std::cout << "udp multicast works!" << std::endl;
+    return true;
+}
+
+static bool test_timestamps(void)
+{
+    std::cout << "testing udp kernel timestamps..." << std::endl;
+
+    anysignal::udp_sock rx;
+    anysignal::udp_sock tx;
+    rx.bind("udp://127.0.0.1:5623");
+    rx.set_timestamps(true);
+    tx.connect("udp://127.0.0.1:5623");
+
+    const auto now_ns = [] {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::system_clock::now().time_since_epoch())
+            .count();
+    };
+    const auto before = now_ns();
+    tx.send("stamp", 5);
+    std::array<char, 64> buff{};
+    anysignal::udp_sock::recv_info info;
+    if (not rx.recv_ready(std::chrono::milliseconds(100)) or rx.recv(buff.data(), buff.size(), info) != 5)
+    {
+        std::cerr << "failed to recv timestamped message" << std::endl;
+        return false;
+    }
+    const auto after = now_ns();
+    if (info.kernel_timestamp_ns < before or info.kernel_timestamp_ns > after)
+    {
+        std::cerr << "kernel timestamp " << info.kernel_timestamp_ns << " outside [" << before << ", " << after << "]"
+                  << std::endl;
+        return false;
+    }
+
+    std::cout << "udp kernel timestamps work!" << std::endl;
+    return true;
+}
+
+static bool test_stats(void)
+{
+    std::cout << "testing udp socket stats..." << std::endl;
+
+    anysignal::udp_sock rx;
+    anysignal::udp_sock tx;
+    rx.bind("udp://127.0.0.1:5624");
+    rx.set_expected_length(8);
+    tx.connect("udp://127.0.0.1:5624");
+
+    // right, short, long and cut off datagrams, then an empty queue
+    std::array<std::uint8_t, 64> buff{};
+    for (const size_t length : {8, 4, 16, 32})
+        tx.send(buff.data(), length);
+    anysignal::udp_sock::recv_info info;
+    for (const size_t length : {64, 64, 64, 12})
+    {
+        rx.recv_ready(std::chrono::milliseconds(100));
+        rx.recv(buff.data(), length, info);
+    }
+    const bool truncated = info.truncated;
+    rx.recv(buff.data(), buff.size(), info);
+
+    auto s = rx.stats();
+    if (not truncated or s.datagrams != 4 or s.bytes != 8 + 4 + 16 + 12 or s.undersized != 1 or s.oversized != 2 or
+        s.truncated != 1 or s.eagain != 1 or s.spurious_wakeups != 0 or s.socket_drops != 0)
+    {
+        std::cerr << "unexpected socket stats" << std::endl;
+        return false;
+    }
+
+    // overflow the receive queue; datagrams queued after the drops report them
+    std::array<std::uint8_t, 1024> big{};
+    for (int i = 0; i < 4096; i++)
+        tx.send(big.data(), big.size());
+    while (rx.recv(big.data(), big.size(), info) > 0)
+    {
+    }
+    tx.send(big.data(), big.size());
+    rx.recv_ready(std::chrono::milliseconds(100));
+    rx.recv(big.data(), big.size(), info);
+    s = rx.stats();
+    if (s.socket_drops == 0 or s.socket_drops + s.datagrams != 4 + 4096 + 1)
+    {
+        std::cerr << "unexpected kernel drop count " << s.socket_drops << std::endl;
+        return false;
+    }
+    std::cout << "kernel dropped " << s.socket_drops << " datagrams" << std::endl;
+
+    // datagrams rejected by the filter count as drops too
+    anysignal::udp_sock filtered;
+    filtered.bind("udp://127.0.0.1:5627");
+    filtered.attach_filter({anysignal::udp_sock::filter_rule{8, 0, 0}});
+    anysignal::udp_sock junk;
+    junk.connect("udp://127.0.0.1:5627");
+    for (int i = 0; i < 5; i++)
+        junk.send(buff.data(), 4);
+    junk.send(buff.data(), 8);
+    filtered.recv_ready(std::chrono::milliseconds(100));
+    filtered.recv(buff.data(), buff.size(), info);
+    if (info.socket_drops != 5 or filtered.stats().socket_drops != 5)
+    {
+        std::cerr << "unexpected filtered drop count " << filtered.stats().socket_drops << std::endl;
+        return false;
+    }
+
+    std::cout << "udp socket stats work!" << std::endl;
+    return true;
+}
+
+static bool test_recv_spin(void)
+{
+    std::cout << "testing udp spin receive..." << std::endl;
+
+    anysignal::udp_sock rx;
+    anysignal::udp_sock tx;
+    rx.bind("udp://127.0.0.1:5625");
+    tx.connect("udp://127.0.0.1:5625");
+
+    // data already queued is found while spinning, an idle socket spins out and waits
+    std::array<char, 64> buff{};
+    anysignal::udp_sock::recv_info info;
+    tx.send("spin", 4);
+    const auto r0 = rx.recv_spin(buff.data(), buff.size(), info, std::chrono::microseconds(1000),
+                                 std::chrono::milliseconds(10));
+    const bool spun = info.spun;
+    const auto r1 = rx.recv_spin(buff.data(), buff.size(), info, std::chrono::microseconds(100),
+                                 std::chrono::milliseconds(10));
+    const auto s = rx.stats();
+    if (r0 != 4 or not spun or r1 != -1 or s.spin_hits != 1 or s.spin_misses != 1 or s.eagain != 0)
+    {
+        std::cerr << "unexpected spin receive results" << std::endl;
+        return false;
+    }
+
+    std::cout << "udp spin receive works!" << std::endl;
+    return true;
+}
+
+static bool test_sendv(void)
+{
+    std::cout << "testing udp gather send..." << std::endl;
+
+    anysignal::udp_sock rx;
+    anysignal::udp_sock tx;
+    rx.bind("udp://127.0.0.1:5626");
+    tx.connect("udp://127.0.0.1:5626");
+
+    // header, shared body and patch go out as one datagram
+    std::string header = "hdr:", body = "shared body:", patch = "patch";
+    const std::array<::iovec, 3> iov{::iovec{header.data(), header.size()}, ::iovec{body.data(), body.size()},
+                                     ::iovec{patch.data(), patch.size()}};
+    const auto sent = tx.sendv(iov);
+
+    std::array<char, 64> buff{};
+    if (sent != int(header.size() + body.size() + patch.size()) or not rx.recv_ready(std::chrono::milliseconds(100)) or
+        rx.recv(buff.data(), buff.size()) != sent or std::string(buff.data()) != header + body + patch)
+    {
+        std::cerr << "unexpected gathered datagram" << std::endl;
+        return false;
+    }
+
+    std::cout << "udp gather send works!" << std::endl;
+    return true;
+}
+
+// A socket file left behind by a process that did not clean up
+static void leave_stale_socket(const std::string &path)
+{
+    ::sockaddr_un un{};
+    un.sun_family = AF_UNIX;
+    std::copy(path.begin(), path.end(), un.sun_path);
+    const int sock = ::socket(AF_UNIX, SOCK_DGRAM, 0);
+    ::bind(sock, reinterpret_cast<const ::sockaddr *>(&un), sizeof(un));
+    ::close(sock);
+}
+
+static bool test_unix(const std::string &url)
+{
+    std::cout << "testing unix datagram socket " << url << "..." << std::endl;
+
+    std::string tx_message = "hello unix";
+    std::array<char, 1024> rx_message = {};
+    {
+        anysignal::udp_sock s0;
+        anysignal::udp_sock s1;
+        s0.bind(url);
+        s1.connect(url);
+
+        // set up like the client's metrics socket; gro has no effect on unix sockets
+        s0.set_gro(true);
+        s0.set_timestamps(true);
+
+        // the bpf filter sees unix datagrams without a udp header
+        s0.attach_filter({anysignal::udp_sock::filter_rule{tx_message.size(), 0, 0x68656c6c6f20756eULL}});
+        std::string rejected = "world hello";
+        s1.send(rejected.data(), rejected.size());
+
+        if (s1.send(tx_message.data(), tx_message.size()) != int(tx_message.size()))
+        {
+            std::cerr << "failed to send unix message" << std::endl;
+            return false;
+        }
+        anysignal::udp_sock::recv_info info;
+        if (not s0.recv_ready(std::chrono::milliseconds(10)) or
+            s0.recv(rx_message.data(), rx_message.size(), info) != int(tx_message.size()) or
+            rx_message.data() != tx_message or info.segment_size != 0 or info.kernel_timestamp_ns == 0)
+        {
+            std::cerr << "failed to recv unix message" << std::endl;
+            return false;
+        }
+
+        // a live receiver keeps its address
+        try
+        {
+            anysignal::udp_sock s2;
+            s2.bind(url);
+            std::cerr << "bound the address of a live unix socket" << std::endl;
+            return false;
+        }
+        catch (const std::runtime_error &)
+        {
+        }
+        if (s1.send(tx_message.data(), tx_message.size()) != int(tx_message.size()) or
+            not s0.recv_ready(std::chrono::milliseconds(10)))
+        {
+            std::cerr << "unix receiver lost its address" << std::endl;
+            return false;
+        }
+    }
+
+    // a second bind after the first socket is gone must not trip over a stale socket file
+    anysignal::udp_sock s2;
+    s2.bind(url);
+
+    std::cout << "unix datagram socket works!" << std::endl;
+    return true;
+}
+
+int main(void)
+{
+    if (not test_send_recv())
+        return EXIT_FAILURE;
+    if (not test_gso_gro())
+        return EXIT_FAILURE;
+    if (not test_filter())
+        return EXIT_FAILURE;
+    if (not test_multicast())
+        return EXIT_FAILURE;
+    if (not test_timestamps())
+        return EXIT_FAILURE;
+    if (not test_stats())
+        return EXIT_FAILURE;
+    if (not test_recv_spin())
+        return EXIT_FAILURE;
+    if (not test_sendv())
+        return EXIT_FAILURE;
+    if (not test_unix("unix:///tmp/sharemap_test_udp_socket.sock"))
+        return EXIT_FAILURE;
+    leave_stale_socket("/tmp/sharemap_test_udp_socket.sock");
+    if (not test_unix("unix:///tmp/sharemap_test_udp_socket.sock"))
+        return EXIT_FAILURE;
+    if (not test_unix("unix://@sharemap_test_udp_socket"))
+        return EXIT_FAILURE;
     return EXIT_SUCCESS;
 }
@@ -0,0 +1,184 @@
+#include "sharemap.hpp"
+#include "test_frames.hpp"
+#include <cstdlib>
+#include <algorithm>
+#include <iostream>
+#include <string>
+
+using config_t = anysignal::sharemap_config_t;
+
+static size_t rule(const std::string_view name) { return anysignal::find_by_name(config_t::RULES, name); }
+
+static void print(const anysignal::sharemap_config_errors_t &errors)
+{
+    for (size_t i = 0; i < errors.size(); i++)
+    {
+        if (errors[i])
+        {
+            std::cerr << "    " << config_t::RULES[i].name << std::endl;
+        }
+    }
+}
+
+// config breaks exactly the rule of the name
+static bool breaks(const config_t &config, const std::string_view name)
+{
+    const auto i = rule(name);
+    const auto errors = anysignal::sharemap_validate(config);
+    if (i == config_t::RULES.size() or errors.count() != 1 or not errors[i])
+    {
+        std::cerr << "expected only " << name << " to be broken, got" << std::endl;
+        print(errors);
+        return false;
+    }
+    return true;
+}
+
+static void set(std::array<char, anysignal::STRING_BUFFER_SIZE> &out, const std::string &value)
+{
+    out.fill('\0');
+    std::copy(value.begin(), value.end(), out.data());
+}
+
+// The initial config of sharemap_client
+static config_t initial(void)
+{
+    config_t config{};
+    config.psk_cc_tx_idle_timeout_s = 4;
+    config.psk_cc_tx_fe_frequency = 2.25e9;
+    config.psk_cc_tx_fe_sample_rate = 30.72e6;
+    config.psk_cc_tx_fe_stx1_enable = true;
+    config.psk_cc_tx_fe_stx1_gain = 55;
+    config.psk_cc_tx_fe_stx2_gain = 55;
+    config.psk_cc_tx_symbol_rate = 960e3;
+    set(config.psk_cc_tx_modulation, "QPSK");
+    config.psk_cc_rx_force_on = true;
+    config.psk_cc_rx_idle_timeout_s = 4;
+    config.psk_cc_rx_low_power_timeout_s = 1;
+    set(config.psk_cc_rx_gain_mode, "MANUAL");
+    config.psk_cc_rx_fe_frequency = 2.053e9;
+    config.psk_cc_rx_fe_sample_rate = 30.72e6;
+    config.psk_cc_rx_fe_srx1_enable = true;
+    config.psk_cc_rx_fe_srx1_gain = 40;
+    config.psk_cc_rx_fe_srx2_gain = 40;
+    config.psk_cc_rx_symbol_rate = 960e3;
+    set(config.psk_cc_rx_modulation, "QPSK");
+    config.dvbs2_tx_idle_timeout_s = 4;
+    config.dvbs2_tx_fe_frequency = 8.488e9;
+    config.dvbs2_tx_fe_gain = 69;
+    config.dvbs2_tx_fe_sample_rate = 30.72e6;
+    config.dvbs2_tx_symbol_rate = 3.84e6;
+    set(config.dvbs2_tx_modulation, "QPSK");
+    set(config.dvbs2_tx_coding, "1/4");
+    set(config.dvbs2_tx_rolloff, "35%");
+    set(config.dvbs2_tx_frame_length, "NORMAL");
+    config.dvbs2_tx_signal_scaling = 1.0;
+    config.gfsk_tx_idle_timeout_s = 10;
+    config.gfsk_tx_fe_frequency = 401.5e6;
+    config.gfsk_tx_fe_gain = 10;
+    config.gfsk_tx_fe_sample_rate = 400e3;
+    config.gfsk_tx_symbol_rate = 10e3;
+    config.gfsk_tx_mod_index = 0.5;
+    config.gfsk_tx_max_payload_len = 128;
+    config.gfsk_tx_bt = 1.0;
+    set(config.anylink_active_tx_channel, "tx_sband");
+    return config;
+}
+
+static bool test_initial(void)
+{
+    std::cout << "testing the initial config..." << std::endl;
+    const auto errors = anysignal::sharemap_validate(initial());
+    if (errors.any())
+    {
+        std::cerr << "the initial config is invalid" << std::endl;
+        print(errors);
+        return false;
+    }
+    if (anysignal::sharemap_validate(config_t{}).none())
+    {
+        std::cerr << "an empty config is valid" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+static bool test_rules(void)
+{
+    std::cout << "testing each kind of rule..." << std::endl;
+    auto config = initial();
+    config.psk_cc_tx_fe_stx1_gain = 90.0;
+    if (not breaks(config, "psk_cc_tx_fe_stx1_gain min/max"))
+    {
+        return false;
+    }
+    config = initial();
+    config.psk_cc_tx_fe_stx1_gain = 55.1;
+    if (not breaks(config, "psk_cc_tx_fe_stx1_gain step"))
+    {
+        return false;
+    }
+    config = initial();
+    set(config.psk_cc_tx_modulation, "8PSK");
+    if (not breaks(config, "psk_cc_tx_modulation options"))
+    {
+        return false;
+    }
+    config = initial();
+    config.psk_cc_tx_fe_stx1_enable = true;
+    config.psk_cc_tx_fe_stx2_enable = true;
+    if (not breaks(config, "psk_cc_tx_fe_stx1_enable mutex_with psk_cc_tx_fe_stx2_enable"))
+    {
+        return false;
+    }
+    config = initial();
+    config.gfsk_tx_fe_sample_rate = 400e3;
+    config.gfsk_tx_symbol_rate = 9.6e3;
+    if (not breaks(config, "gfsk_tx_symbol_rate divides gfsk_tx_fe_sample_rate"))
+    {
+        return false;
+    }
+    return true;
+}
+
+static bool test_shared(void)
+{
+    std::cout << "testing the shared sample rate..." << std::endl;
+    auto config = initial();
+    config.psk_cc_tx_force_on = true;
+    config.dvbs2_tx_fe_sample_rate = 7.68e6;
+    if (anysignal::sharemap_validate(config).any())
+    {
+        std::cerr << "a channel not in use may run another sample rate" << std::endl;
+        print(anysignal::sharemap_validate(config));
+        return false;
+    }
+    config.dvbs2_tx_force_on = true;
+    const auto errors = anysignal::sharemap_validate(config);
+    if (errors.count() != 2 or not errors[rule("ad9361: psk_cc_tx_fe_sample_rate == dvbs2_tx_fe_sample_rate")] or
+        not errors[rule("ad9361: psk_cc_rx_fe_sample_rate == dvbs2_tx_fe_sample_rate")])
+    {
+        std::cerr << "unexpected shared sample rate errors" << std::endl;
+        print(errors);
+        return false;
+    }
+    return true;
+}
+
+int main(void)
+{
+    if (not test_initial())
+    {
+        return EXIT_FAILURE;
+    }
+    if (not test_rules())
+    {
+        return EXIT_FAILURE;
+    }
+    if (not test_shared())
+    {
+        return EXIT_FAILURE;
+    }
+    std::cout << "done" << std::endl;
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+namespace anysignal
+{
+
+// Scheduling knobs for latency sensitive threads, such as a receive loop.
+// They apply to the calling thread and throw std::runtime_error when the system refuses.
+
+// Pin the calling thread to one CPU
+void set_thread_affinity(const int cpu);
+
+// Run the calling thread under SCHED_FIFO at priority (1 to 99), usually needs CAP_SYS_NICE
+void set_thread_realtime(const int priority);
+
+} // namespace anysignal
+
+////////////////////////////////////////////////////////////////////////
+// implementation details
+////////////////////////////////////////////////////////////////////////
+
+#include <cstring> //strerror
+#include <pthread.h>
+#include <sched.h>
+#include <stdexcept>
+#include <string>
+
+inline void anysignal::set_thread_affinity(const int cpu)
+{
+    if (cpu < 0 or cpu >= CPU_SETSIZE)
+    {
+        throw std::runtime_error("invalid cpu " + std::to_string(cpu));
+    }
+
+    ::cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    const int r = ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set);
+    if (r != 0)
+    {
+        throw std::runtime_error("failed to pin thread to cpu " + std::to_string(cpu) + ": " + std::strerror(r));
+    }
+}
+
+inline void anysignal::set_thread_realtime(const int priority)
+{
+    ::sched_param param{};
+    param.sched_priority = priority;
+    const int r = ::pthread_setschedparam(::pthread_self(), SCHED_FIFO, &param);
+    if (r != 0)
+    {
+        throw std::runtime_error("failed to set SCHED_FIFO priority " + std::to_string(priority) + ": " +
+                                 std::strerror(r));
+    }
+}
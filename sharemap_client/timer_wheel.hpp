@@ -0,0 +1,201 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace anysignal
+{
+
+// Hierarchical timer wheel for a fixed set of timers identified by 0 <= id < max_timers.
+// Four levels of 64 slots cover 2^24 ticks; timers further out are clamped to that.
+// Timers are kept in intrusive lists linked by index, so arm and cancel are O(1) and
+// nothing is allocated after construction. Not thread safe; meant for the thread that
+// arms the timers, e.g. a receive loop re-arming a deadline on every frame.
+class timer_wheel
+{
+  public:
+    static constexpr size_t SLOT_BITS{6};
+    static constexpr size_t SLOTS{size_t(1) << SLOT_BITS};
+    static constexpr size_t LEVELS{4};
+
+    // tick_ns is the resolution, now_ns the current time of the clock later passed to advance
+    timer_wheel(const size_t max_timers, const std::int64_t tick_ns, const std::int64_t now_ns);
+
+    // Set the deadline of timer id, moving it if it was already armed
+    void arm(const std::uint32_t id, const std::int64_t deadline_ns);
+
+    // Disarm timer id, nothing happens if it was not armed
+    void cancel(const std::uint32_t id);
+
+    bool armed(const std::uint32_t id) const { return _nodes[id].slot != NO_SLOT; }
+
+    // Move the wheel to now_ns and call fcn(std::uint32_t id) for every timer that expired.
+    // Timers are disarmed before their callback runs, so the callback may arm them again.
+    template <typename Fcn>
+    void advance(const std::int64_t now_ns, Fcn &&fcn);
+
+  private:
+    static constexpr std::uint32_t NIL{0xFFFFFFFF};
+    static constexpr std::uint16_t NO_SLOT{0xFFFF};
+    static constexpr std::uint16_t EXPIRED{LEVELS * SLOTS}; // list of timers being fired
+
+    struct node
+    {
+        std::uint64_t expires{0}; // tick
+        std::uint32_t next{NIL};
+        std::uint32_t prev{NIL};
+        std::uint16_t slot{NO_SLOT}; // level * SLOTS + index
+    };
+
+    void insert(const std::uint32_t id);
+    void unlink(const std::uint32_t id);
+    bool cascade(const size_t level);
+
+    std::vector<node> _nodes;
+    std::vector<std::uint32_t> _heads;
+    std::int64_t _origin_ns{0};
+    std::int64_t _tick_ns{1};
+    std::uint64_t _current{0}; // next tick to process
+};
+
+} // namespace anysignal
+
+////////////////////////////////////////////////////////////////////////
+// implementation details
+////////////////////////////////////////////////////////////////////////
+
+#include <stdexcept>
+
+inline anysignal::timer_wheel::timer_wheel(const size_t max_timers, const std::int64_t tick_ns,
+                                           const std::int64_t now_ns)
+    : _nodes(max_timers), _heads(LEVELS * SLOTS + 1, NIL), _origin_ns(now_ns), _tick_ns(tick_ns)
+{
+    if (tick_ns <= 0 or max_timers == 0 or max_timers >= NIL)
+    {
+        throw std::runtime_error("invalid timer wheel configuration");
+    }
+}
+
+inline void anysignal::timer_wheel::arm(const std::uint32_t id, const std::int64_t deadline_ns)
+{
+    if (_nodes[id].slot != NO_SLOT)
+    {
+        unlink(id);
+    }
+    // round up, a timer never fires before its deadline
+    const auto ns = deadline_ns - _origin_ns;
+    _nodes[id].expires = ns <= 0 ? 0 : std::uint64_t((ns + _tick_ns - 1) / _tick_ns);
+    insert(id);
+}
+
+inline void anysignal::timer_wheel::cancel(const std::uint32_t id)
+{
+    if (_nodes[id].slot != NO_SLOT)
+    {
+        unlink(id);
+    }
+}
+
+inline void anysignal::timer_wheel::insert(const std::uint32_t id)
+{
+    // the level is picked by how far out the timer is, the slot by its expiry bits at that level
+    auto &n = _nodes[id];
+    constexpr std::uint64_t max_delta{(std::uint64_t(1) << (SLOT_BITS * LEVELS)) - 1};
+    if (n.expires < _current)
+    {
+        n.expires = _current;
+    }
+    else if (n.expires - _current > max_delta)
+    {
+        n.expires = _current + max_delta;
+    }
+    const auto delta = n.expires - _current;
+
+    size_t level = 0;
+    while (level + 1 < LEVELS and delta >= (std::uint64_t(1) << (SLOT_BITS * (level + 1))))
+    {
+        level++;
+    }
+    const auto slot = level * SLOTS + size_t((n.expires >> (SLOT_BITS * level)) & (SLOTS - 1));
+
+    n.slot = std::uint16_t(slot);
+    n.prev = NIL;
+    n.next = _heads[slot];
+    if (n.next != NIL)
+    {
+        _nodes[n.next].prev = id;
+    }
+    _heads[slot] = id;
+}
+
+inline void anysignal::timer_wheel::unlink(const std::uint32_t id)
+{
+    auto &n = _nodes[id];
+    if (n.prev != NIL)
+    {
+        _nodes[n.prev].next = n.next;
+    }
+    else
+    {
+        _heads[n.slot] = n.next;
+    }
+    if (n.next != NIL)
+    {
+        _nodes[n.next].prev = n.prev;
+    }
+    n.next = n.prev = NIL;
+    n.slot = NO_SLOT;
+}
+
+inline bool anysignal::timer_wheel::cascade(const size_t level)
+{
+    // re-insert every timer of the level's current slot, they all land on lower levels
+    const auto index = size_t((_current >> (SLOT_BITS * level)) & (SLOTS - 1));
+    auto id = _heads[level * SLOTS + index];
+    _heads[level * SLOTS + index] = NIL;
+    while (id != NIL)
+    {
+        const auto next = _nodes[id].next;
+        insert(id);
+        id = next;
+    }
+    return index == 0;
+}
+
+template <typename Fcn>
+void anysignal::timer_wheel::advance(const std::int64_t now_ns, Fcn &&fcn)
+{
+    if (now_ns < _origin_ns)
+    {
+        return;
+    }
+    const auto target = std::uint64_t((now_ns - _origin_ns) / _tick_ns);
+    while (_current <= target)
+    {
+        // when level 0 wraps, refill it from the next level up, and so on
+        const auto index = size_t(_current & (SLOTS - 1));
+        if (index == 0)
+        {
+            for (size_t level = 1; level < LEVELS and cascade(level); level++)
+            {
+            }
+        }
+
+        // detach the slot first: a callback that arms a timer in the past gets the next tick
+        auto id = _heads[index];
+        _heads[index] = NIL;
+        _heads[EXPIRED] = id;
+        for (; id != NIL; id = _nodes[id].next)
+        {
+            _nodes[id].slot = EXPIRED;
+        }
+        _current++;
+
+        while (_heads[EXPIRED] != NIL)
+        {
+            id = _heads[EXPIRED];
+            unlink(id);
+            fcn(id);
+        }
+    }
+}
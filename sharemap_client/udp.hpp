@@ -1,11 +1,20 @@
 #pragma once
+#include <atomic>
 #include <chrono>
+#include <cstdint>
+#include <map>
 #include <netdb.h>
+#include <span>
 #include <string>
+#include <sys/uio.h> //iovec
+#include <tuple>
+#include <vector>
 
 namespace anysignal
 {
 
+// Datagram socket for "udp://host:port" urls.
+// Same-host peers can use "unix:///path/to/socket" or abstract "unix://@name" urls instead.
 class udp_sock
 {
   public:
@@ -21,9 +30,143 @@ class udp_sock
     int recv(void *const buff, const size_t length);
     int send(const void *const buff, const size_t length);
 
+    // Send one datagram gathered from several buffers without staging copies,
+    // e.g. a header, a config body shared by all destinations and a per-destination patch
+    int sendv(std::span<const ::iovec> iov);
+
+    // Most segments the kernel accepts in a single UDP_SEGMENT send
+    static constexpr size_t GSO_MAX_SEGMENTS{64};
+
+    // Largest UDP payload of a GSO super-buffer (and of a GRO-coalesced read)
+    static constexpr size_t GSO_MAX_BYTES{65507};
+
+    // Details about a datagram received with recv(buff, length, info)
+    struct recv_info
+    {
+        // Size of each datagram when the kernel coalesced several (GRO), 0 otherwise
+        size_t segment_size{0};
+
+        // CLOCK_REALTIME when the kernel received the datagram (or the first of a GRO read),
+        // 0 unless enabled with set_timestamps
+        std::int64_t kernel_timestamp_ns{0};
+
+        // Datagrams the kernel dropped on this socket so far (SO_RXQ_OVFL): for a full receive queue
+        // and, as the kernel counts them together, rejected by attach_filter.
+        // Only datagrams queued after a drop carry it, otherwise it is 0.
+        std::uint32_t socket_drops{0};
+
+        // The datagram did not fit the buffer and was cut off (MSG_TRUNC)
+        bool truncated{false};
+
+        // Received by recv_spin while spinning, not after waiting
+        bool spun{false};
+    };
+
+    // Receive counters of this socket, see stats()
+    struct stats_t
+    {
+        std::uint64_t datagrams{0};        // datagrams received, every GRO segment counted
+        std::uint64_t bytes{0};            // payload bytes received
+        std::uint64_t undersized{0};       // datagrams shorter than the expected length
+        std::uint64_t oversized{0};        // datagrams longer than the expected length
+        std::uint64_t truncated{0};        // reads cut off by a too small buffer
+        std::uint64_t eagain{0};           // recv calls that found nothing to read
+        std::uint64_t spurious_wakeups{0}; // recv_ready reported data that the next recv did not find
+        std::uint64_t socket_drops{0};     // datagrams dropped by the kernel, full queue or filtered out
+        std::uint64_t spin_hits{0};        // recv_spin reads that found data while spinning
+        std::uint64_t spin_misses{0};      // recv_spin calls that spun out and went on to wait
+    };
+
+    // Snapshot of the receive counters, safe to call from any thread
+    stats_t stats(void) const;
+
+    // Count datagrams of any other length in stats() as undersized or oversized, 0 to disable
+    void set_expected_length(const size_t length) { _expected_length = length; }
+
+    // Send length bytes of back-to-back segment_size frames using UDP_SEGMENT.
+    // Frames are coalesced into as few super-buffers as the kernel allows.
+    // Returns the number of bytes sent, or -1 if nothing could be sent.
+    int send_gso(const void *const buff, const size_t length, const size_t segment_size);
+
+    // Allow the kernel to coalesce same-size datagrams into one read (UDP_GRO).
+    // Use a GSO_MAX_BYTES buffer and recv(buff, length, info) to split the reads.
+    void set_gro(const bool enable);
+
+    // Have the kernel stamp every received datagram (SO_TIMESTAMPNS) for recv(buff, length, info)
+    void set_timestamps(const bool enable);
+
+    int recv(void *const buff, const size_t length, recv_info &info);
+
+    // Low latency receive: poll without sleeping for up to spin, then wait up to timeout.
+    // Returns like recv(buff, length, info), -1 with errno EAGAIN if nothing arrived.
+    int recv_spin(void *const buff, const size_t length, recv_info &info, const std::chrono::microseconds spin,
+                  const std::chrono::milliseconds timeout);
+
+    // Let the kernel busy poll the device queue for up to timeout on reads (SO_BUSY_POLL).
+    // Raising it above net.core.busy_read needs CAP_NET_ADMIN.
+    void set_busy_poll(const std::chrono::microseconds timeout);
+
+    // Call fcn(const std::uint8_t *, size_t) for every datagram in a received buffer
+    template <typename Fcn>
+    static void for_each_segment(const void *const buff, const int length, const recv_info &info, Fcn &&fcn);
+
+    // Datagrams accepted by attach_filter: exactly length bytes (any length if 0) with hash at hash_offset
+    struct filter_rule
+    {
+        size_t length{0};
+        size_t hash_offset{0};
+        std::uint64_t hash{0};
+    };
+
+    // Filter rule for a sharemap type (uses PACKED_SIZE, SCHEMA_HASH_OFFSET and HASH)
+    template <typename Sharemap>
+    static filter_rule sharemap_filter_rule(void);
+
+    // Attach a classic BPF filter so the kernel drops datagrams matching none of the rules.
+    // With GRO enabled, coalesced reads of whole frames are accepted on their first frame.
+    void attach_filter(const std::vector<filter_rule> &rules);
+    void detach_filter(void);
+
+    // Multicast membership of a bound socket.
+    // bind() joins automatically for a group url, e.g. "udp://239.1.2.3:4444?iface=eth0".
+    // iface is an interface name or an IPv4 interface address, empty for the default.
+    void join_group(const std::string &group, const std::string &iface = "");
+    void leave_group(const std::string &group, const std::string &iface = "");
+
+    // Multicast options of a sending socket.
+    // connect() applies them from a group url, e.g. "udp://239.1.2.3:4444?iface=eth0&ttl=4&loop=1".
+    void set_multicast_interface(const std::string &iface);
+    void set_multicast_ttl(const int ttl);
+    void set_multicast_loop(const bool enable);
+
   private:
     int _sock{-1};
-    static ::addrinfo get_addr_info(const std::string &url);
+    int _family{AF_UNSPEC};
+    std::string _unlink_path;
+    bool _gro{false};
+    std::vector<filter_rule> _filter_rules;
+    size_t _expected_length{0};
+    bool _ready{false}; // recv_ready returned true and no recv has run since
+
+    // written by the receiving thread only, read by stats() from any thread
+    struct stats_counters
+    {
+        std::atomic<std::uint64_t> datagrams{0};
+        std::atomic<std::uint64_t> bytes{0};
+        std::atomic<std::uint64_t> undersized{0};
+        std::atomic<std::uint64_t> oversized{0};
+        std::atomic<std::uint64_t> truncated{0};
+        std::atomic<std::uint64_t> eagain{0};
+        std::atomic<std::uint64_t> spurious_wakeups{0};
+        std::atomic<std::uint64_t> socket_drops{0};
+        std::atomic<std::uint64_t> spin_hits{0};
+        std::atomic<std::uint64_t> spin_misses{0};
+    } _stats;
+    ::ssize_t receive(void *const buff, const size_t length, recv_info &info);
+    void count_recv(const ::ssize_t result, const recv_info &info);
+
+    static std::tuple<::addrinfo, ::sockaddr_storage, ::socklen_t> get_addr_info(const std::string &url);
+    void set_group_membership(const std::string &group, const std::string &iface, const bool join);
 };
 
 } // namespace anysignal
@@ -32,48 +175,287 @@ class udp_sock
 // implementation details
 ////////////////////////////////////////////////////////////////////////
 
+#include <algorithm>
+#include <arpa/inet.h> //inet_pton
+#include <cerrno>
+#include <cstddef> //offsetof
+#include <cstdint>
 #include <cstring> //memset
+#include <linux/filter.h>
+#include <net/if.h> //if_nametoindex
+#include <netinet/in.h>
+#include <netinet/udp.h> //UDP_SEGMENT, UDP_GRO
 #include <stdexcept>
 #include <sys/select.h>
 #include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
 #include <tuple>
 #include <unistd.h> //close
 
+static inline std::tuple<std::string, std::string, std::string> anysignal_url_parse(const std::string &url_with_scheme)
+{
+    if (url_with_scheme.empty())
+    {
+        return {};
+    }
+
+    std::string scheme, url = url_with_scheme.substr(0, url_with_scheme.find("?"));
+    auto scheme_end_pos = url.find("://");
+    if (scheme_end_pos != std::string::npos)
+    {
+        scheme = url.substr(0, scheme_end_pos);
+        url = url.substr(scheme_end_pos + 3);
+    }
+
+    // the rest of a unix url is a path, or an abstract name after '@'
+    if (scheme == "unix")
+    {
+        return {scheme, url, ""};
+    }
+
+    auto open_bracket_pos = url.find("[");
+    auto close_bracket_pos = url.find("]:");
+    if (open_bracket_pos != std::string::npos and close_bracket_pos != std::string::npos and
+        open_bracket_pos < close_bracket_pos)
+    {
+        auto host = url.substr(open_bracket_pos + 1, close_bracket_pos - open_bracket_pos - 1);
+        return {scheme, host, url.substr(close_bracket_pos + 2)};
+    }
+    if (open_bracket_pos == std::string::npos and close_bracket_pos == std::string::npos)
+    {
+        auto colon_pos = url.find(":");
+        if (colon_pos == std::string::npos)
+            return {};
+        return {scheme, url.substr(0, colon_pos), url.substr(colon_pos + 1)};
+    }
+    return {};
+}
+
+// Options after the '?' of a url, e.g. "udp://239.1.2.3:4444?iface=eth0&ttl=4"
+static inline std::map<std::string, std::string> anysignal_url_query(const std::string &url_with_scheme)
+{
+    std::map<std::string, std::string> out;
+    auto query_pos = url_with_scheme.find("?");
+    if (query_pos == std::string::npos)
+    {
+        return out;
+    }
+
+    auto query = url_with_scheme.substr(query_pos + 1);
+    while (not query.empty())
+    {
+        auto amp_pos = query.find("&");
+        auto item = query.substr(0, amp_pos);
+        query = amp_pos == std::string::npos ? "" : query.substr(amp_pos + 1);
+        if (item.empty())
+            continue;
+        auto equal_pos = item.find("=");
+        if (equal_pos == std::string::npos)
+            out[item] = "";
+        else
+            out[item.substr(0, equal_pos)] = item.substr(equal_pos + 1);
+    }
+    return out;
+}
+
+static inline bool anysignal_is_multicast(const ::sockaddr_storage &addr)
+{
+    if (addr.ss_family == AF_INET)
+    {
+        const auto &in = reinterpret_cast<const ::sockaddr_in &>(addr);
+        return IN_MULTICAST(ntohl(in.sin_addr.s_addr));
+    }
+    if (addr.ss_family == AF_INET6)
+    {
+        const auto &in6 = reinterpret_cast<const ::sockaddr_in6 &>(addr);
+        return IN6_IS_ADDR_MULTICAST(&in6.sin6_addr);
+    }
+    return false;
+}
+
+static inline std::tuple<::addrinfo, ::sockaddr_storage, ::socklen_t> anysignal_getaddrinfo(const std::string &node,
+                                                                                            const std::string &service,
+                                                                                            const addrinfo &hints)
+{
+    ::addrinfo *res{nullptr};
+    ::addrinfo out_info{};
+    ::sockaddr_storage out_addr{};
+    ::socklen_t out_len{0};
+    auto s = ::getaddrinfo(node.c_str(), service.c_str(), &hints, &res);
+    if (s != 0)
+    {
+        return {out_info, out_addr, out_len};
+    }
+    for (auto i = res; i != nullptr; i = i->ai_next)
+    {
+        std::memcpy(&out_info, i, sizeof(out_info));
+        std::memcpy(&out_addr, i->ai_addr, i->ai_addrlen);
+        out_len = i->ai_addrlen;
+    }
+    ::freeaddrinfo(res);
+    return {out_info, out_addr, out_len};
+}
+
+static inline std::tuple<::addrinfo, ::sockaddr_storage, ::socklen_t> anysignal_unix_addr(const std::string &path,
+                                                                                          const std::string &url)
+{
+    ::addrinfo out_info{};
+    ::sockaddr_storage out_addr{};
+    auto &un = reinterpret_cast<::sockaddr_un &>(out_addr);
+    if (path.empty() or path.size() >= sizeof(un.sun_path))
+    {
+        throw std::runtime_error("invalid unix socket path for " + url);
+    }
+
+    // abstract names start with a nul byte instead of '@' and are not nul terminated
+    un.sun_family = AF_UNIX;
+    std::memcpy(un.sun_path, path.data(), path.size());
+    ::socklen_t out_len = ::socklen_t(offsetof(::sockaddr_un, sun_path) + path.size());
+    if (path[0] == '@')
+    {
+        un.sun_path[0] = '\0';
+    }
+    else
+    {
+        out_len += 1;
+    }
+
+    out_info.ai_family = AF_UNIX;
+    out_info.ai_socktype = SOCK_DGRAM;
+    out_info.ai_addrlen = out_len;
+    return {out_info, out_addr, out_len};
+}
+
 inline anysignal::udp_sock::~udp_sock(void)
 {
     if (_sock != -1)
     {
         ::close(_sock);
     }
+    if (not _unlink_path.empty())
+    {
+        ::unlink(_unlink_path.c_str());
+    }
 }
 
 inline void anysignal::udp_sock::bind(const std::string &url)
 {
-    auto addrinfo = get_addr_info(url);
+    const auto [addrinfo, addr, addrlen] = get_addr_info(url);
     _sock = ::socket(addrinfo.ai_family, addrinfo.ai_socktype, addrinfo.ai_protocol);
     if (_sock == -1)
     {
         throw std::runtime_error("failed to create socket for " + url);
     }
+    _family = addrinfo.ai_family;
+
+    // several local subscribers can share a multicast group and port,
+    // each receiving only the groups it joined itself
+    const bool multicast = anysignal_is_multicast(addr);
+    if (multicast)
+    {
+        int on = 1;
+        ::setsockopt(_sock, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+        int off = 0;
+        if (_family == AF_INET)
+            ::setsockopt(_sock, IPPROTO_IP, IP_MULTICAST_ALL, &off, sizeof(off));
+        else
+            ::setsockopt(_sock, IPPROTO_IPV6, IPV6_MULTICAST_ALL, &off, sizeof(off));
+    }
+
+    // have the kernel report receive queue drops with the datagrams, for stats()
+    int rxq_ovfl = 1;
+    ::setsockopt(_sock, SOL_SOCKET, SO_RXQ_OVFL, &rxq_ovfl, sizeof(rxq_ovfl));
+
+    // a socket file left behind by a previous process would make bind fail,
+    // but one that still has a live receiver behind it is not ours to take
+    const auto &un = reinterpret_cast<const ::sockaddr_un &>(addr);
+    const bool unix_path = _family == AF_UNIX and un.sun_path[0] != '\0';
+    struct ::stat st{};
+    if (unix_path and ::stat(un.sun_path, &st) == 0 and S_ISSOCK(st.st_mode))
+    {
+        const int probe = ::socket(AF_UNIX, SOCK_DGRAM, 0);
+        const bool stale = probe != -1 and
+                           ::connect(probe, reinterpret_cast<const ::sockaddr *>(&addr), addrlen) != 0 and
+                           errno == ECONNREFUSED;
+        if (probe != -1)
+        {
+            ::close(probe);
+        }
+        if (not stale)
+        {
+            ::close(_sock);
+            _sock = -1;
+            throw std::runtime_error("address in use for " + url);
+        }
+        ::unlink(un.sun_path);
+    }
 
-    if (::bind(_sock, addrinfo.ai_addr, addrinfo.ai_addrlen) != 0)
+    if (::bind(_sock, reinterpret_cast<const ::sockaddr *>(&addr), addrlen) != 0)
     {
         ::close(_sock);
         _sock = -1;
         throw std::runtime_error("failed to bind socket for " + url);
     }
+    if (unix_path)
+    {
+        _unlink_path = un.sun_path;
+    }
+
+    if (multicast)
+    {
+        const auto [scheme, host, port] = anysignal_url_parse(url);
+        const auto query = anysignal_url_query(url);
+        try
+        {
+            join_group(host, query.count("iface") ? query.at("iface") : "");
+        }
+        catch (...)
+        {
+            ::close(_sock);
+            _sock = -1;
+            throw;
+        }
+    }
 }
 
 inline void anysignal::udp_sock::connect(const std::string &url)
 {
-    auto addrinfo = get_addr_info(url);
+    const auto [addrinfo, addr, addrlen] = get_addr_info(url);
     _sock = ::socket(addrinfo.ai_family, addrinfo.ai_socktype, addrinfo.ai_protocol);
     if (_sock == -1)
     {
         throw std::runtime_error("failed to create socket for " + url);
     }
+    _family = addrinfo.ai_family;
+
+    if (anysignal_is_multicast(addr))
+    {
+        const auto query = anysignal_url_query(url);
+        try
+        {
+            if (query.count("iface"))
+            {
+                set_multicast_interface(query.at("iface"));
+            }
+            if (query.count("ttl"))
+            {
+                set_multicast_ttl(std::stoi(query.at("ttl")));
+            }
+            if (query.count("loop"))
+            {
+                set_multicast_loop(query.at("loop") == "1" or query.at("loop") == "true");
+            }
+        }
+        catch (...)
+        {
+            ::close(_sock);
+            _sock = -1;
+            throw;
+        }
+    }
 
-    if (::connect(_sock, addrinfo.ai_addr, addrinfo.ai_addrlen) != 0)
+    if (::connect(_sock, reinterpret_cast<const ::sockaddr *>(&addr), addrlen) != 0)
     {
         ::close(_sock);
         _sock = -1;
@@ -92,6 +474,10 @@ inline bool anysignal::udp_sock::send_ready(const std::chrono::milliseconds time
     tv.tv_usec = (timeout.count() % 1000) * 1000;
 
     int result = ::select(_sock + 1, nullptr, &wfds, nullptr, &tv);
+    if (result == -1 and errno == EINTR)
+    {
+        return false; // a signal, e.g. a shutdown request, the caller checks its state
+    }
     if (result == -1)
     {
         throw std::runtime_error("select failed on send_ready");
@@ -111,12 +497,17 @@ inline bool anysignal::udp_sock::recv_ready(const std::chrono::milliseconds time
     tv.tv_usec = (timeout.count() % 1000) * 1000;
 
     int result = ::select(_sock + 1, &rfds, nullptr, nullptr, &tv);
+    if (result == -1 and errno == EINTR)
+    {
+        return false; // a signal, e.g. a shutdown request, the caller checks its state
+    }
     if (result == -1)
     {
         throw std::runtime_error("select failed on recv_ready");
     }
 
-    return result > 0;
+    _ready = result > 0;
+    return _ready;
 }
 
 inline int anysignal::udp_sock::recv(void *const buff, const size_t length)
@@ -126,7 +517,8 @@ inline int anysignal::udp_sock::recv(void *const buff, const size_t length)
         throw std::runtime_error("recv failed: socket is not initialized");
     }
 
-    return ::recv(_sock, buff, length, MSG_DONTWAIT);
+    recv_info info;
+    return recv(buff, length, info);
 }
 
 inline int anysignal::udp_sock::send(const void *const buff, const size_t length)
@@ -139,71 +531,524 @@ inline int anysignal::udp_sock::send(const void *const buff, const size_t length
     return ::send(_sock, buff, length, MSG_DONTWAIT);
 }
 
-static inline std::tuple<std::string, std::string, std::string> anysignal_url_parse(const std::string &url_with_scheme)
+inline int anysignal::udp_sock::sendv(std::span<const ::iovec> iov)
 {
-    if (url_with_scheme.empty())
+    if (_sock == -1)
     {
-        return {};
+        throw std::runtime_error("send failed: socket is not initialized");
     }
 
-    std::string scheme, url = url_with_scheme;
-    auto scheme_end_pos = url_with_scheme.find("://");
-    if (scheme_end_pos != std::string::npos)
+    ::msghdr msg{};
+    msg.msg_iov = const_cast<::iovec *>(iov.data());
+    msg.msg_iovlen = iov.size();
+    return int(::sendmsg(_sock, &msg, MSG_DONTWAIT));
+}
+
+inline int anysignal::udp_sock::send_gso(const void *const buff, const size_t length, const size_t segment_size)
+{
+    if (_sock == -1)
+    {
+        throw std::runtime_error("send_gso failed: socket is not initialized");
+    }
+    if (segment_size == 0 or segment_size > GSO_MAX_BYTES)
     {
-        scheme = url_with_scheme.substr(0, scheme_end_pos);
-        url = url_with_scheme.substr(scheme_end_pos + 3);
+        throw std::runtime_error("send_gso failed: invalid segment size " + std::to_string(segment_size));
     }
 
-    auto open_bracket_pos = url.find("[");
-    auto close_bracket_pos = url.find("]:");
-    if (open_bracket_pos != std::string::npos and close_bracket_pos != std::string::npos and
-        open_bracket_pos < close_bracket_pos)
+    const size_t max_chunk = std::min(GSO_MAX_SEGMENTS, GSO_MAX_BYTES / segment_size) * segment_size;
+    const auto *bytes = static_cast<const std::uint8_t *>(buff);
+    size_t sent = 0;
+    while (sent < length)
     {
-        auto host = url.substr(open_bracket_pos + 1, close_bracket_pos - open_bracket_pos - 1);
-        return {scheme, host, url.substr(close_bracket_pos + 2)};
+        const size_t chunk = std::min(max_chunk, length - sent);
+
+        ::iovec iov{};
+        iov.iov_base = const_cast<std::uint8_t *>(bytes + sent);
+        iov.iov_len = chunk;
+
+        alignas(::cmsghdr) char control[CMSG_SPACE(sizeof(std::uint16_t))]{};
+        ::msghdr msg{};
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+
+        auto *cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_UDP;
+        cmsg->cmsg_type = UDP_SEGMENT;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(std::uint16_t));
+        const auto gso_size = std::uint16_t(segment_size);
+        std::memcpy(CMSG_DATA(cmsg), &gso_size, sizeof(gso_size));
+
+        const auto r = ::sendmsg(_sock, &msg, MSG_DONTWAIT);
+        if (r < 0)
+        {
+            return sent == 0 ? -1 : int(sent);
+        }
+        sent += size_t(r);
     }
-    if (open_bracket_pos == std::string::npos and close_bracket_pos == std::string::npos)
+    return int(sent);
+}
+
+inline void anysignal::udp_sock::set_gro(const bool enable)
+{
+    if (_sock == -1)
     {
-        auto colon_pos = url.find(":");
-        if (colon_pos == std::string::npos)
-            return {};
-        return {scheme, url.substr(0, colon_pos), url.substr(colon_pos + 1)};
+        throw std::runtime_error("set_gro failed: socket is not initialized");
+    }
+
+    // unix datagrams are never coalesced
+    if (_family == AF_UNIX)
+    {
+        return;
+    }
+
+    const int on = enable ? 1 : 0;
+    if (::setsockopt(_sock, SOL_UDP, UDP_GRO, &on, sizeof(on)) != 0)
+    {
+        throw std::runtime_error("failed to set UDP_GRO on socket");
+    }
+    _gro = enable;
+
+    // the length checks depend on whether reads can be coalesced
+    if (not _filter_rules.empty())
+    {
+        attach_filter(std::vector<filter_rule>(_filter_rules));
     }
-    return {};
 }
 
-static inline std::tuple<::addrinfo, ::sockaddr_storage, ::socklen_t> anysignal_getaddrinfo(const std::string &node,
-                                                                                            const std::string &service,
-                                                                                            const addrinfo &hints)
+inline void anysignal::udp_sock::set_timestamps(const bool enable)
 {
-    ::addrinfo *res{nullptr};
-    ::addrinfo out_info{};
-    ::sockaddr_storage out_addr{};
-    ::socklen_t out_len{0};
-    auto s = ::getaddrinfo(node.c_str(), service.c_str(), &hints, &res);
-    if (s != 0)
+    if (_sock == -1)
     {
-        return {out_info, out_addr, out_len};
+        throw std::runtime_error("set_timestamps failed: socket is not initialized");
     }
-    for (auto i = res; i != nullptr; i = i->ai_next)
+
+    const int on = enable ? 1 : 0;
+    if (::setsockopt(_sock, SOL_SOCKET, SO_TIMESTAMPNS, &on, sizeof(on)) != 0)
     {
-        std::memcpy(&out_info, i, sizeof(out_info));
-        std::memcpy(&out_addr, i->ai_addr, i->ai_addrlen);
-        out_len = i->ai_addrlen;
+        throw std::runtime_error("failed to set SO_TIMESTAMPNS on socket");
     }
-    ::freeaddrinfo(res);
-    return {out_info, out_addr, out_len};
 }
 
-inline ::addrinfo anysignal::udp_sock::get_addr_info(const std::string &url)
+inline void anysignal::udp_sock::set_busy_poll(const std::chrono::microseconds timeout)
+{
+    if (_sock == -1)
+    {
+        throw std::runtime_error("set_busy_poll failed: socket is not initialized");
+    }
+
+    const int usecs = int(timeout.count());
+    if (::setsockopt(_sock, SOL_SOCKET, SO_BUSY_POLL, &usecs, sizeof(usecs)) != 0)
+    {
+        throw std::runtime_error("failed to set SO_BUSY_POLL on socket");
+    }
+}
+
+template <typename Sharemap>
+anysignal::udp_sock::filter_rule anysignal::udp_sock::sharemap_filter_rule(void)
+{
+    return filter_rule{Sharemap::PACKED_SIZE, Sharemap::SCHEMA_HASH_OFFSET, Sharemap::HASH};
+}
+
+inline void anysignal::udp_sock::attach_filter(const std::vector<filter_rule> &rules)
+{
+    if (_sock == -1)
+    {
+        throw std::runtime_error("attach_filter failed: socket is not initialized");
+    }
+    if (rules.empty())
+    {
+        throw std::runtime_error("attach_filter failed: no rules");
+    }
+
+    // socket filters see udp datagrams starting at the udp header
+    const std::uint32_t udp_header_size = _family == AF_UNIX ? 0 : 8;
+
+    // one block per rule: check the length, then both halves of the big-endian hash.
+    // a failed check jumps to the next block, a full match jumps to the accept at the end.
+    std::vector<std::vector<::sock_filter>> blocks;
+    for (const auto &rule : rules)
+    {
+        if (rule.length != 0 and rule.hash_offset + sizeof(rule.hash) > rule.length)
+        {
+            throw std::runtime_error("attach_filter failed: invalid rule");
+        }
+        const auto hash_offset = std::uint32_t(udp_header_size + rule.hash_offset);
+        std::vector<::sock_filter> block;
+        if (rule.length == 0)
+        {
+            // no length check, a datagram too short for the hash fails the load and is dropped
+        }
+        else if (_gro)
+        {
+            block.push_back(BPF_STMT(BPF_LD | BPF_W | BPF_LEN, 0));
+            block.push_back(BPF_STMT(BPF_ALU | BPF_SUB | BPF_K, udp_header_size));
+            block.push_back(BPF_STMT(BPF_ALU | BPF_MOD | BPF_K, std::uint32_t(rule.length)));
+            block.push_back(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0, 0, 4));
+        }
+        else
+        {
+            block.push_back(BPF_STMT(BPF_LD | BPF_W | BPF_LEN, 0));
+            block.push_back(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, std::uint32_t(udp_header_size + rule.length), 0, 4));
+        }
+        block.push_back(BPF_STMT(BPF_LD | BPF_W | BPF_ABS, hash_offset));
+        block.push_back(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, std::uint32_t(rule.hash >> 32), 0, 2));
+        block.push_back(BPF_STMT(BPF_LD | BPF_W | BPF_ABS, hash_offset + 4));
+        block.push_back(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, std::uint32_t(rule.hash), 0, 0));
+        blocks.push_back(block);
+    }
+
+    std::vector<::sock_filter> program;
+    size_t remaining = 0;
+    for (const auto &block : blocks)
+    {
+        remaining += block.size();
+    }
+    for (auto &block : blocks)
+    {
+        remaining -= block.size();
+        const size_t to_accept = remaining + 1;
+        if (to_accept > 255)
+        {
+            throw std::runtime_error("attach_filter failed: too many rules");
+        }
+        block.back().jt = std::uint8_t(to_accept);
+        program.insert(program.end(), block.begin(), block.end());
+    }
+    program.push_back(BPF_STMT(BPF_RET | BPF_K, 0));          // drop
+    program.push_back(BPF_STMT(BPF_RET | BPF_K, 0xffffffff)); // accept
+
+    ::sock_fprog fprog{};
+    fprog.len = static_cast<unsigned short>(program.size());
+    fprog.filter = program.data();
+    if (::setsockopt(_sock, SOL_SOCKET, SO_ATTACH_FILTER, &fprog, sizeof(fprog)) != 0)
+    {
+        throw std::runtime_error("failed to attach socket filter");
+    }
+    _filter_rules = rules;
+}
+
+inline void anysignal::udp_sock::detach_filter(void)
+{
+    if (_sock == -1 or _filter_rules.empty())
+    {
+        return;
+    }
+
+    int dummy = 0;
+    if (::setsockopt(_sock, SOL_SOCKET, SO_DETACH_FILTER, &dummy, sizeof(dummy)) != 0)
+    {
+        throw std::runtime_error("failed to detach socket filter");
+    }
+    _filter_rules.clear();
+}
+
+inline int anysignal::udp_sock::recv(void *const buff, const size_t length, recv_info &info)
+{
+    if (_sock == -1)
+    {
+        throw std::runtime_error("recv failed: socket is not initialized");
+    }
+
+    const auto r = receive(buff, length, info);
+    count_recv(r, info);
+    return int(r);
+}
+
+inline int anysignal::udp_sock::recv_spin(void *const buff, const size_t length, recv_info &info,
+                                          const std::chrono::microseconds spin,
+                                          const std::chrono::milliseconds timeout)
+{
+    if (_sock == -1)
+    {
+        throw std::runtime_error("recv failed: socket is not initialized");
+    }
+
+    // empty polls while spinning are expected, they are not counted as eagain
+    const auto end = std::chrono::steady_clock::now() + spin;
+    do
+    {
+        const auto r = receive(buff, length, info);
+        if (r >= 0 or (errno != EAGAIN and errno != EWOULDBLOCK))
+        {
+            info.spun = r >= 0;
+            count_recv(r, info);
+            _stats.spin_hits.store(_stats.spin_hits.load(std::memory_order_relaxed) + (r >= 0 ? 1 : 0),
+                                   std::memory_order_relaxed);
+            return int(r);
+        }
+    } while (std::chrono::steady_clock::now() < end);
+
+    _stats.spin_misses.store(_stats.spin_misses.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    if (not recv_ready(timeout))
+    {
+        errno = EAGAIN;
+        return -1;
+    }
+    return recv(buff, length, info);
+}
+
+inline ::ssize_t anysignal::udp_sock::receive(void *const buff, const size_t length, recv_info &info)
+{
+    ::iovec iov{};
+    iov.iov_base = buff;
+    iov.iov_len = length;
+
+    alignas(::cmsghdr) char control[CMSG_SPACE(sizeof(int)) + CMSG_SPACE(sizeof(::timespec)) +
+                                    CMSG_SPACE(sizeof(std::uint32_t))]{};
+    ::msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    info = recv_info{};
+    const auto r = ::recvmsg(_sock, &msg, MSG_DONTWAIT);
+    if (r < 0)
+    {
+        return r;
+    }
+    info.truncated = (msg.msg_flags & MSG_TRUNC) != 0;
+
+    for (auto *cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg))
+    {
+        if (cmsg->cmsg_level == SOL_UDP and cmsg->cmsg_type == UDP_GRO)
+        {
+            int gso_size = 0;
+            std::memcpy(&gso_size, CMSG_DATA(cmsg), sizeof(gso_size));
+            info.segment_size = size_t(gso_size);
+        }
+        else if (cmsg->cmsg_level == SOL_SOCKET and cmsg->cmsg_type == SO_TIMESTAMPNS)
+        {
+            ::timespec ts{};
+            std::memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+            info.kernel_timestamp_ns = std::int64_t(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+        }
+        else if (cmsg->cmsg_level == SOL_SOCKET and cmsg->cmsg_type == SO_RXQ_OVFL)
+        {
+            std::memcpy(&info.socket_drops, CMSG_DATA(cmsg), sizeof(info.socket_drops));
+        }
+    }
+    return r;
+}
+
+inline void anysignal::udp_sock::count_recv(const ::ssize_t result, const recv_info &info)
+{
+    // the only writer, plain load and store instead of locked read-modify-write
+    const auto add = [](std::atomic<std::uint64_t> &counter, const std::uint64_t delta) {
+        counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    };
+
+    const bool ready = _ready;
+    _ready = false;
+    if (result < 0)
+    {
+        if (errno == EAGAIN or errno == EWOULDBLOCK)
+        {
+            add(_stats.eagain, 1);
+            add(_stats.spurious_wakeups, ready ? 1 : 0);
+        }
+        return;
+    }
+
+    const auto length = size_t(result);
+    const auto step = (info.segment_size == 0 or length == 0) ? std::max<size_t>(length, 1) : info.segment_size;
+    const auto segments = std::max<size_t>((length + step - 1) / step, 1);
+    add(_stats.datagrams, segments);
+    add(_stats.bytes, length);
+    add(_stats.truncated, info.truncated ? 1 : 0);
+    if (_expected_length != 0)
+    {
+        // every GRO segment has the same size, except possibly a shorter last one
+        const auto last = length - (segments - 1) * step;
+        const auto check = [&](const size_t size, const std::uint64_t count) {
+            add(_stats.undersized, size < _expected_length ? count : 0);
+            add(_stats.oversized, (size > _expected_length or info.truncated) ? count : 0);
+        };
+        check(step, segments - 1);
+        check(last, 1);
+    }
+    if (info.socket_drops > _stats.socket_drops.load(std::memory_order_relaxed))
+    {
+        _stats.socket_drops.store(info.socket_drops, std::memory_order_relaxed);
+    }
+}
+
+inline anysignal::udp_sock::stats_t anysignal::udp_sock::stats(void) const
+{
+    stats_t s;
+    s.datagrams = _stats.datagrams.load(std::memory_order_relaxed);
+    s.bytes = _stats.bytes.load(std::memory_order_relaxed);
+    s.undersized = _stats.undersized.load(std::memory_order_relaxed);
+    s.oversized = _stats.oversized.load(std::memory_order_relaxed);
+    s.truncated = _stats.truncated.load(std::memory_order_relaxed);
+    s.eagain = _stats.eagain.load(std::memory_order_relaxed);
+    s.spurious_wakeups = _stats.spurious_wakeups.load(std::memory_order_relaxed);
+    s.socket_drops = _stats.socket_drops.load(std::memory_order_relaxed);
+    s.spin_hits = _stats.spin_hits.load(std::memory_order_relaxed);
+    s.spin_misses = _stats.spin_misses.load(std::memory_order_relaxed);
+    return s;
+}
+
+template <typename Fcn>
+void anysignal::udp_sock::for_each_segment(const void *const buff, const int length, const recv_info &info, Fcn &&fcn)
+{
+    if (length <= 0)
+    {
+        return;
+    }
+
+    const auto *bytes = static_cast<const std::uint8_t *>(buff);
+    const size_t total = size_t(length);
+    const size_t step = info.segment_size == 0 ? total : info.segment_size;
+    for (size_t offset = 0; offset < total; offset += step)
+    {
+        fcn(bytes + offset, std::min(step, total - offset));
+    }
+}
+
+inline std::tuple<::addrinfo, ::sockaddr_storage, ::socklen_t> anysignal::udp_sock::get_addr_info(
+    const std::string &url)
 {
     const auto [scheme, host, port] = anysignal_url_parse(url);
+    if (scheme == "unix")
+    {
+        return anysignal_unix_addr(host, url);
+    }
+
     ::addrinfo hint{};
     hint.ai_socktype = SOCK_DGRAM;
-    const auto [addrinfo, sockaddr_data, addrlen] = anysignal_getaddrinfo(host, port, hint);
+    auto [addrinfo, sockaddr_data, addrlen] = anysignal_getaddrinfo(host, port, hint);
     if (addrlen == 0)
     {
         throw std::runtime_error("failed to getaddrinfo for " + url);
     }
-    return addrinfo;
+    // the address in addrinfo was freed with the getaddrinfo results, use the copy
+    addrinfo.ai_addr = nullptr;
+    return {addrinfo, sockaddr_data, addrlen};
+}
+
+inline void anysignal::udp_sock::join_group(const std::string &group, const std::string &iface)
+{
+    set_group_membership(group, iface, true);
+}
+
+inline void anysignal::udp_sock::leave_group(const std::string &group, const std::string &iface)
+{
+    set_group_membership(group, iface, false);
+}
+
+static inline unsigned anysignal_iface_index(const std::string &iface)
+{
+    if (iface.empty())
+    {
+        return 0;
+    }
+    const auto index = ::if_nametoindex(iface.c_str());
+    if (index == 0)
+    {
+        throw std::runtime_error("unknown network interface " + iface);
+    }
+    return index;
+}
+
+inline void anysignal::udp_sock::set_group_membership(const std::string &group, const std::string &iface,
+                                                      const bool join)
+{
+    if (_sock == -1)
+    {
+        throw std::runtime_error("multicast membership failed: socket is not initialized");
+    }
+
+    int r = -1;
+    if (_family == AF_INET)
+    {
+        ::ip_mreqn mreq{};
+        if (::inet_pton(AF_INET, group.c_str(), &mreq.imr_multiaddr) != 1)
+        {
+            throw std::runtime_error("invalid IPv4 multicast group " + group);
+        }
+        if (::inet_pton(AF_INET, iface.c_str(), &mreq.imr_address) != 1)
+        {
+            mreq.imr_ifindex = int(anysignal_iface_index(iface));
+        }
+        r = ::setsockopt(_sock, IPPROTO_IP, join ? IP_ADD_MEMBERSHIP : IP_DROP_MEMBERSHIP, &mreq, sizeof(mreq));
+    }
+    else if (_family == AF_INET6)
+    {
+        ::ipv6_mreq mreq{};
+        if (::inet_pton(AF_INET6, group.c_str(), &mreq.ipv6mr_multiaddr) != 1)
+        {
+            throw std::runtime_error("invalid IPv6 multicast group " + group);
+        }
+        mreq.ipv6mr_interface = anysignal_iface_index(iface);
+        r = ::setsockopt(_sock, IPPROTO_IPV6, join ? IPV6_JOIN_GROUP : IPV6_LEAVE_GROUP, &mreq, sizeof(mreq));
+    }
+
+    if (r != 0)
+    {
+        throw std::runtime_error(std::string("failed to ") + (join ? "join" : "leave") + " multicast group " + group);
+    }
+}
+
+inline void anysignal::udp_sock::set_multicast_interface(const std::string &iface)
+{
+    int r = -1;
+    if (_family == AF_INET)
+    {
+        ::ip_mreqn mreq{};
+        if (::inet_pton(AF_INET, iface.c_str(), &mreq.imr_address) != 1)
+        {
+            mreq.imr_ifindex = int(anysignal_iface_index(iface));
+        }
+        r = ::setsockopt(_sock, IPPROTO_IP, IP_MULTICAST_IF, &mreq, sizeof(mreq));
+    }
+    else if (_family == AF_INET6)
+    {
+        const unsigned index = anysignal_iface_index(iface);
+        r = ::setsockopt(_sock, IPPROTO_IPV6, IPV6_MULTICAST_IF, &index, sizeof(index));
+    }
+
+    if (r != 0)
+    {
+        throw std::runtime_error("failed to set multicast interface " + iface);
+    }
+}
+
+inline void anysignal::udp_sock::set_multicast_ttl(const int ttl)
+{
+    int r = -1;
+    if (_family == AF_INET)
+    {
+        r = ::setsockopt(_sock, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl));
+    }
+    else if (_family == AF_INET6)
+    {
+        r = ::setsockopt(_sock, IPPROTO_IPV6, IPV6_MULTICAST_HOPS, &ttl, sizeof(ttl));
+    }
+
+    if (r != 0)
+    {
+        throw std::runtime_error("failed to set multicast ttl " + std::to_string(ttl));
+    }
+}
+
+inline void anysignal::udp_sock::set_multicast_loop(const bool enable)
+{
+    const int on = enable ? 1 : 0;
+    int r = -1;
+    if (_family == AF_INET)
+    {
+        r = ::setsockopt(_sock, IPPROTO_IP, IP_MULTICAST_LOOP, &on, sizeof(on));
+    }
+    else if (_family == AF_INET6)
+    {
+        r = ::setsockopt(_sock, IPPROTO_IPV6, IPV6_MULTICAST_LOOP, &on, sizeof(on));
+    }
+
+    if (r != 0)
+    {
+        throw std::runtime_error("failed to set multicast loop");
+    }
 }
@@ -1,5 +1,6 @@
 #!/usr/bin/env python3
 
+import math
 import pathlib
 from sharemap_lib import Sharemap
 import yaml
@@ -15,24 +16,120 @@ def load_template(template_path):
     env = Environment(loader=FileSystemLoader(str(template_path.parent)))
     return env.get_template(str(template_path.name))
 
+# Check alarm rules against a sharemap and lower them to the kinds of the C++ ALARMS table:
+# above and below a threshold with a clear threshold for hysteresis, or increases
+def compile_alarms(sharemap_name, sharemap, rules):
+    fields = {field["name"]: (index, field) for index, field in enumerate(sharemap.get_fields())}
+    compiled = []
+    for name, rule in rules.items():
+        where = f"alarm {sharemap_name}.{name}"
+        if rule.get("field") not in fields:
+            raise Exception(f"{where}: no field {rule.get('field')} in sharemap {sharemap_name}")
+        index, field = fields[rule["field"]]
+        conditions = [key for key in ("above", "below", "is", "increases") if key in rule]
+        if len(conditions) != 1:
+            raise Exception(f"{where}: expected exactly one of above, below, is or increases")
+        condition = conditions[0]
+
+        if condition in ("above", "below"):
+            if field["type"] in ("string", "boolean"):
+                raise Exception(f"{where}: {condition} needs a numeric field")
+            kind, threshold = condition, float(rule[condition])
+            clear = float(rule.get("clear", threshold))
+            if (kind == "above" and clear > threshold) or (kind == "below" and clear < threshold):
+                raise Exception(f"{where}: clear must be on the safe side of {condition}")
+        elif condition == "is":
+            if field["type"] != "boolean":
+                raise Exception(f"{where}: is needs a boolean field")
+            kind = "above" if rule["is"] else "below"
+            threshold, clear = 0.5, 0.5
+        else:
+            if field["type"] not in ("u8", "u16", "u32", "u64", "i8", "i16", "i32", "i64") or not rule["increases"]:
+                raise Exception(f"{where}: increases needs an integer field and true")
+            kind, threshold, clear = "increases", 0.0, 0.0
+
+        compiled.append(dict(name=name, field=index, kind=kind, set=repr(threshold), clear=repr(clear)))
+    return compiled
+
+# Validation rules of a sharemap from its schema, in the form of the C++ RULES table:
+# min/max and step of numbers, options of strings, mutex_with of booleans, divides (the other
+# field is a whole multiple of this one) and shared_by (fields of a group are equal while their
+# active_when booleans are all true)
+def compile_rules(sharemap_name, fields):
+    fields = {name: details for name, details in fields.items() if not name.startswith("_")}
+    rules = []
+    options = []
+
+    def field(name, where):
+        if name not in fields:
+            raise Exception(f"{where}: no field {name} in sharemap {sharemap_name}")
+        return dict(name=name, type=fields[name]["type"])
+
+    def number(value):
+        value = float(value)
+        if math.isinf(value):
+            return ("-" if value < 0 else "") + "std::numeric_limits<double>::infinity()"
+        return repr(value)
+
+    def rule(name, kind, a, b=None, when_a=None, when_b=None, low=0.0, high=0.0, step=0.0, first_option=0, count=0):
+        rules.append(dict(name=name, kind=kind, a=a, b=b, when_a=when_a, when_b=when_b, low=number(low),
+                          high=number(high), step=number(step), first_option=first_option, count=count))
+
+    mutexes = set()
+    for name, details in fields.items():
+        this = field(name, name)
+        if "min" in details or "max" in details:
+            rule(f"{name} min/max", "range", this, low=float(details.get("min", "-inf")),
+                 high=float(details.get("max", "inf")))
+        if "step" in details:
+            rule(f"{name} step", "step", this, low=float(details.get("min", 0)), step=float(details["step"]))
+        if "options" in details:
+            rule(f"{name} options", "options", this, first_option=len(options), count=len(details["options"]))
+            options.extend(str(option) for option in details["options"])
+        if "mutex_with" in details and frozenset((name, details["mutex_with"])) not in mutexes:
+            mutexes.add(frozenset((name, details["mutex_with"])))
+            rule(f"{name} mutex_with {details['mutex_with']}", "mutex", this, field(details["mutex_with"], name))
+        if "divides" in details:
+            rule(f"{name} divides {details['divides']}", "divides", this, field(details["divides"], name))
+
+    # every pair of a shared group, so each mismatch has its own bit
+    groups = {}
+    for name, details in fields.items():
+        if "shared_by" in details:
+            groups.setdefault(details["shared_by"], []).append(name)
+    for group, names in groups.items():
+        for i, a in enumerate(names):
+            for b in names[i + 1:]:
+                rule(f"{group}: {a} == {b}", "equal", field(a, group), field(b, group),
+                     field(fields[a]["active_when"], a) if "active_when" in fields[a] else None,
+                     field(fields[b]["active_when"], b) if "active_when" in fields[b] else None)
+    return rules, options
+
 # Generate C++ code from templates
-def generate_code(schema, template):
+def generate_code(schema, template, alarms=None):
+    alarms = alarms or {}
     sharemaps = []
+    compiled_alarms = {}
+    compiled_rules = {}
 
     for top_key, top_sharemap_config in schema.items():
         sharemap = Sharemap(schema.get(top_key, {}))
         sharemaps.append((top_key, sharemap))
+        compiled_alarms[top_key] = compile_alarms(top_key, sharemap, alarms.get(top_key) or {})
+        compiled_rules[top_key] = compile_rules(top_key, top_sharemap_config)
 
     # Render class definitions
-    class_definitions = template.render(sharemaps=sharemaps, Sharemap=Sharemap)
+    class_definitions = template.render(sharemaps=sharemaps, Sharemap=Sharemap, alarms=compiled_alarms,
+                                        rules=compiled_rules)
 
     return class_definitions
 
 
-def main(schema_path, output_file_path, template_path):
+def main(schema_path, output_file_path, template_path, alarms_path=None):
     schema = load_yaml_schema(schema_path)
+    alarms = load_yaml_schema(alarms_path) if alarms_path else {}
     template = load_template(template_path)
-    class_definitions = generate_code(schema, template)
+    class_definitions = generate_code(schema, template, alarms)
 
     # Ensure output directory exists
     output_file_path.parent.mkdir(parents=True, exist_ok=True)
@@ -61,6 +158,12 @@ if __name__ == "__main__":
         default=pathlib.Path("./sharemap.cpp.jinja"),
         help="File name of Jinja template",
     )
+    parser.add_argument(
+        "--alarms",
+        type=pathlib.Path,
+        default=None,
+        help="YAML file of alarm rules to compile into the ALARMS tables",
+    )
 
     args = parser.parse_args()
-    main(args.schema, args.output, args.template)
+    main(args.schema, args.output, args.template, args.alarms)
@@ -7,6 +7,15 @@ import copy
 
 class Sharemap:
 
+    # Schema hash of a bundle, a datagram carrying several sharemap frames:
+    # a common header (source_id, schema_hash, unix_timestamp_ns) plus a u16 entry count,
+    # then per entry a u64 frame schema hash, a u16 frame length and the packed frame
+    BUNDLE_HASH = int(hashlib.sha256("sharemap_bundle".encode()).hexdigest()[:16], 16)
+    BUNDLE_HEADER_FORMAT = '!HQqH'
+    BUNDLE_ENTRY_FORMAT = '!QH'
+    # largest datagram payload that fits a 1500 byte MTU over IPv4
+    BUNDLE_MTU_PAYLOAD = 1472
+
     # pylint: disable=use-dict-literal
     SCHEMA_TYPES = dict(
         # tuple of size in bytes, c++ type, python struct format
@@ -26,8 +35,16 @@ class Sharemap:
 
     def __init__(self, schema):
 
+        # keys starting with an underscore are sharemap options, not fields
+        self._has_sequence = bool(schema.get("_sequence", False))
+        self._sequence = 0
+        schema = {name: details for name, details in schema.items() if not name.startswith("_")}
+
         # create hash
         schema_hash = hashlib.sha256()
+        if self._has_sequence:
+            schema_hash.update("sequence".encode())
+            schema_hash.update("u32".encode())
         for name, details in schema.items():
             schema_hash.update(name.encode())
             schema_hash.update(details["type"].encode())
@@ -59,6 +76,15 @@ class Sharemap:
                 default="time_ns_since_epoch()",
             )
         )
+        if self._has_sequence:
+            self._fields.append(
+                dict(
+                    name="sequence",
+                    desc="per-source frame counter, incremented on every pack to detect loss and reordering",
+                    type="u32",
+                    default="",
+                )
+            )
 
         for name, details in schema.items():
             self._fields.append(
@@ -67,6 +93,8 @@ class Sharemap:
                     desc=details["desc"],
                     type=details["type"],
                     default="",
+                    # monotonic count, summarized as a rate rather than a value
+                    counter=bool(details.get("counter", False)),
                 )
             )
 
@@ -78,8 +106,17 @@ class Sharemap:
 
     def get_hash(self): return self._hash
 
+    def has_sequence(self): return self._has_sequence
+
     def get_fields(self): return self._fields
 
+    def fits_mtu_bundle(self):
+        """
+        True if a frame fits a bundle of at most BUNDLE_MTU_PAYLOAD bytes
+        """
+        overhead = struct.calcsize(Sharemap.BUNDLE_HEADER_FORMAT) + struct.calcsize(Sharemap.BUNDLE_ENTRY_FORMAT)
+        return overhead + self._packed_size <= Sharemap.BUNDLE_MTU_PAYLOAD
+
     def unpack(self, buff):
         """
         Unpack a sharemap buffer into a dictionary of key/values
@@ -108,6 +145,9 @@ class Sharemap:
         config['schema_hash'] = self._hash
         config['unix_timestamp_ns'] = time.time_ns()
         config['source_id'] = 0
+        if self._has_sequence:
+            self._sequence = (self._sequence + 1) & 0xFFFFFFFF
+            config['sequence'] = self._sequence
         args = list()
         known_keys = set()
         for i, field in enumerate(self._fields):
@@ -124,3 +164,64 @@ class Sharemap:
         unknown_keys = config.keys() - known_keys
         if unknown_keys: raise Exception(f"sharemap unreconginized fields {unknown_keys}")
         return struct.pack(self._struct_format, *args)
+
+    @staticmethod
+    def pack_bundle(frames, source_id=0, mtu=BUNDLE_MTU_PAYLOAD):
+        """
+        Pack a list of packed sharemap frames into one bundle buffer of at most mtu bytes
+        """
+        size = struct.calcsize(Sharemap.BUNDLE_HEADER_FORMAT)
+        entry_size = struct.calcsize(Sharemap.BUNDLE_ENTRY_FORMAT)
+        for frame in frames:
+            if len(frame) > 0xFFFF: raise Exception(f"sharemap frame of {len(frame)} bytes is too long for a bundle")
+            size += entry_size + len(frame)
+        if size > mtu: raise Exception(f"sharemap bundle of {size} bytes does not fit the mtu of {mtu} bytes")
+        if len(frames) > 0xFFFF: raise Exception(f"too many frames for a sharemap bundle: {len(frames)}")
+        out = bytearray(struct.pack(Sharemap.BUNDLE_HEADER_FORMAT, source_id, Sharemap.BUNDLE_HASH, time.time_ns(), len(frames)))
+        for frame in frames:
+            frame_hash = struct.unpack_from('!Q', frame, 2)[0]
+            out += struct.pack(Sharemap.BUNDLE_ENTRY_FORMAT, frame_hash, len(frame))
+            out += frame
+        return bytes(out)
+
+    @staticmethod
+    def pack_bundles(frames, source_id=0, mtu=BUNDLE_MTU_PAYLOAD):
+        """
+        Pack a list of packed sharemap frames, in order, into as few bundle buffers of at most mtu bytes as it takes
+        """
+        header_size = struct.calcsize(Sharemap.BUNDLE_HEADER_FORMAT)
+        entry_size = struct.calcsize(Sharemap.BUNDLE_ENTRY_FORMAT)
+        out = list()
+        group = list()
+        size = header_size
+        for frame in frames:
+            if header_size + entry_size + len(frame) > mtu: raise Exception(f"sharemap frame of {len(frame)} bytes does not fit a bundle within the mtu of {mtu} bytes")
+            if size + entry_size + len(frame) > mtu or len(group) == 0xFFFF:
+                out.append(Sharemap.pack_bundle(group, source_id, mtu))
+                group = list()
+                size = header_size
+            group.append(frame)
+            size += entry_size + len(frame)
+        if group: out.append(Sharemap.pack_bundle(group, source_id, mtu))
+        return out
+
+    @staticmethod
+    def unpack_bundle(buff):
+        """
+        Split a bundle buffer into a list of (schema hash, packed frame) tuples
+        """
+        header_size = struct.calcsize(Sharemap.BUNDLE_HEADER_FORMAT)
+        entry_size = struct.calcsize(Sharemap.BUNDLE_ENTRY_FORMAT)
+        if len(buff) < header_size: raise Exception("incomplete sharemap bundle header")
+        _, bundle_hash, _, count = struct.unpack_from(Sharemap.BUNDLE_HEADER_FORMAT, buff)
+        if bundle_hash != Sharemap.BUNDLE_HASH: raise Exception(f"not a sharemap bundle: hash {hex(bundle_hash)}")
+        out = list()
+        offset = header_size
+        for _ in range(count):
+            if offset + entry_size > len(buff): raise Exception("incomplete sharemap bundle entry")
+            frame_hash, length = struct.unpack_from(Sharemap.BUNDLE_ENTRY_FORMAT, buff, offset)
+            offset += entry_size
+            if offset + length > len(buff): raise Exception("incomplete sharemap bundle frame")
+            out.append((frame_hash, bytes(buff[offset:offset + length])))
+            offset += length
+        return out